@@ -268,6 +268,100 @@ BENCHMARK_REGISTER_F(benchmark_helper, lookup_finalized_colliding_fields)
   ->Args({64, 255, 8})
   ->Args({100, 255, 8});
 
+BENCHMARK_DEFINE_F(benchmark_helper, lookup_finalized_prefixed_fields) (benchmark::State& state) {
+  // Generate keys that all share a long common prefix, like namespaced metric names.
+  std::unordered_set<std::string> keys;
+  size_t num_keys = state.range(1), key_len = state.range(2);
+  while (keys.size() != num_keys) keys.insert(rand_string(key_len, "metrics.host.cpu."));
+
+  // Generate the packet.
+  auto pkt = unsafe_heap::make_object();
+  for (auto const& key : keys) pkt.add_field(key, key);
+
+  // Run the test.
+  auto opts = dart::finalize_options {};
+  if (state.range(0)) opts.prefix = dart::prefix_policy::discriminating;
+  auto data = pkt.finalize(opts);
+  for (auto _ : state) {
+    for (auto const& key : keys) benchmark::DoNotOptimize(data[key]);
+    rate_counter += data.size();
+  }
+  state.counters["finalized prefixed field lookups"] = rate_counter;
+}
+
+BENCHMARK_REGISTER_F(benchmark_helper, lookup_finalized_prefixed_fields)
+  ->Args({0, 16, 24})
+  ->Args({1, 16, 24})
+  ->Args({0, 64, 24})
+  ->Args({1, 64, 24})
+  ->Args({0, 255, 24})
+  ->Args({1, 255, 24});
+
+BENCHMARK_DEFINE_F(benchmark_helper, lookup_finalized_compact_fields) (benchmark::State& state) {
+  // Generate a small message, the kind that fits comfortably inside 16-bit offsets.
+  std::unordered_set<std::string> keys;
+  size_t num_keys = state.range(1), key_len = state.range(2);
+  while (keys.size() != num_keys) keys.insert(rand_string(key_len));
+
+  // Generate the packet.
+  auto pkt = unsafe_heap::make_object();
+  for (auto const& key : keys) pkt.add_field(key, static_cast<int64_t>(key.size()));
+
+  // Run the test.
+  auto opts = dart::finalize_options {};
+  if (state.range(0)) opts.offsets = dart::offset_policy::automatic;
+  auto data = pkt.finalize(opts);
+  for (auto _ : state) {
+    for (auto const& key : keys) benchmark::DoNotOptimize(data[key]);
+    rate_counter += data.size();
+  }
+  state.counters["finalized compact field lookups"] = rate_counter;
+  state.counters["finalized bytes"] = data.get_bytes().size();
+}
+
+BENCHMARK_REGISTER_F(benchmark_helper, lookup_finalized_compact_fields)
+  ->Args({0, 8, 8})
+  ->Args({1, 8, 8})
+  ->Args({0, 64, 8})
+  ->Args({1, 64, 8})
+  ->Args({0, 255, 8})
+  ->Args({1, 255, 8});
+
+BENCHMARK_DEFINE_F(benchmark_helper, lookup_finalized_dictionary_fields) (benchmark::State& state) {
+  // Generate a small telemetry record, whose keys every other record shares.
+  std::unordered_set<std::string> keys;
+  size_t num_keys = state.range(1), key_len = state.range(2);
+  while (keys.size() != num_keys) keys.insert(rand_string(key_len));
+  std::vector<std::string> key_list {keys.begin(), keys.end()};
+  dart::key_dictionary dict {gsl::make_span(key_list)};
+
+  // Generate the packet.
+  auto pkt = unsafe_heap::make_object();
+  for (auto const& key : keys) pkt.add_field(key, static_cast<int64_t>(key.size()));
+
+  // Run the test, looking up by string, or by keys resolved ahead of time.
+  auto opts = dart::finalize_options {};
+  if (state.range(0)) opts.dictionary = dict;
+  auto data = pkt.finalize(opts);
+  std::vector<dart::key_dictionary::key> resolved;
+  for (auto const& key : key_list) resolved.push_back(dict.lookup(key));
+  for (auto _ : state) {
+    if (state.range(0) > 1) for (auto const& key : resolved) benchmark::DoNotOptimize(data[key]);
+    else for (auto const& key : key_list) benchmark::DoNotOptimize(data[key]);
+    rate_counter += data.size();
+  }
+  state.counters["finalized dictionary field lookups"] = rate_counter;
+  state.counters["finalized bytes"] = data.get_bytes().size();
+}
+
+BENCHMARK_REGISTER_F(benchmark_helper, lookup_finalized_dictionary_fields)
+  ->Args({0, 16, 12})
+  ->Args({1, 16, 12})
+  ->Args({2, 16, 12})
+  ->Args({0, 64, 12})
+  ->Args({1, 64, 12})
+  ->Args({2, 64, 12});
+
 #ifdef DART_HAS_FLEXBUFFERS
 BENCHMARK_DEFINE_F(benchmark_helper, flexbuffer_lookup_finalized_random_fields) (benchmark::State& state) {
   // Generate some random strings.
@@ -332,6 +426,35 @@ BENCHMARK_F(benchmark_helper, lookup_dynamic_fields) (benchmark::State& state) {
   state.counters["dynamic field lookups"] = rate_counter;
 }
 
+BENCHMARK_F(benchmark_helper, lookup_finalized_packet_fields) (benchmark::State& state) {
+  unsafe_packet data {flat_fin};
+  for (auto _ : state) {
+    for (auto const& key : flat_keys) benchmark::DoNotOptimize(data[key]);
+    rate_counter += flat_keys.size();
+  }
+  state.counters["finalized packet field lookups"] = rate_counter;
+}
+
+BENCHMARK_F(benchmark_helper, lookup_finalized_packet_fields_with_buffer) (benchmark::State& state) {
+  unsafe_packet data {flat_fin};
+  for (auto _ : state) {
+    data.with_buffer([&] (auto& buf) {
+      for (auto const& key : flat_keys) benchmark::DoNotOptimize(buf[key]);
+    });
+    rate_counter += flat_keys.size();
+  }
+  state.counters["finalized packet field lookups"] = rate_counter;
+}
+
+BENCHMARK_F(benchmark_helper, lookup_dynamic_packet_fields) (benchmark::State& state) {
+  unsafe_packet data {flat};
+  for (auto _ : state) {
+    for (auto const& key : flat_keys) benchmark::DoNotOptimize(data[key]);
+    rate_counter += flat_keys.size();
+  }
+  state.counters["dynamic packet field lookups"] = rate_counter;
+}
+
 BENCHMARK_DEFINE_F(benchmark_helper, lookup_dynamic_random_fields) (benchmark::State& state) {
   // Generate some random strings.
   std::vector<std::string> keys(state.range(0));
@@ -373,6 +496,30 @@ BENCHMARK_DEFINE_F(benchmark_helper, iterate_finalized_random_fields) (benchmark
 
 BENCHMARK_REGISTER_F(benchmark_helper, iterate_finalized_random_fields)->Ranges({{1 << 0, 1 << 8}});
 
+BENCHMARK_DEFINE_F(benchmark_helper, visit_finalized_random_fields) (benchmark::State& state) {
+  // Generate some random strings.
+  std::vector<std::string> keys(state.range(0));
+  std::generate(keys.begin(), keys.end(), [&] { return rand_string(static_string_size); });
+
+  // Generate a packet.
+  unsafe_packet::object pkt;
+  for (auto const& key : keys) pkt.add_field(key, key);
+
+  // Run the test.
+  auto size = pkt.size();
+  unsafe_buffer::object data {pkt};
+  for (auto _ : state) {
+    data.dynamic().for_each_pair([] (auto key, auto val) {
+      benchmark::DoNotOptimize(key);
+      benchmark::DoNotOptimize(val);
+    });
+    rate_counter += size;
+  }
+  state.counters["finalized random field visits"] = rate_counter;
+}
+
+BENCHMARK_REGISTER_F(benchmark_helper, visit_finalized_random_fields)->Ranges({{1 << 0, 1 << 8}});
+
 BENCHMARK_DEFINE_F(benchmark_helper, iterate_finalized_random_elements) (benchmark::State& state) {
   // Generate some random strings.
   std::vector<std::string> strs(state.range(0));
@@ -395,6 +542,80 @@ BENCHMARK_DEFINE_F(benchmark_helper, iterate_finalized_random_elements) (benchma
 
 BENCHMARK_REGISTER_F(benchmark_helper, iterate_finalized_random_elements)->Ranges({{1 << 0, 1 << 8}});
 
+BENCHMARK_DEFINE_F(benchmark_helper, visit_finalized_random_elements) (benchmark::State& state) {
+  // Generate some random strings.
+  std::vector<std::string> strs(state.range(0));
+  std::generate(strs.begin(), strs.end(), [&] { return rand_string(static_string_size); });
+
+  // Generate a packet.
+  unsafe_packet::array pkt;
+  pkt.reserve(strs.size());
+  for (auto const& str : strs) pkt.push_back(str);
+
+  // Run the test.
+  auto size = pkt.size();
+  auto data = unsafe_buffer::object {"arr", std::move(pkt)}["arr"];
+  for (auto _ : state) {
+    data.for_each_elem([] (auto val) { benchmark::DoNotOptimize(val); });
+    rate_counter += size;
+  }
+  state.counters["finalized random element visits"] = rate_counter;
+}
+
+BENCHMARK_REGISTER_F(benchmark_helper, visit_finalized_random_elements)->Ranges({{1 << 0, 1 << 8}});
+
+BENCHMARK_DEFINE_F(benchmark_helper, sum_finalized_decimal_elements) (benchmark::State& state) {
+  // Generate an array of samples.
+  size_t num_elems = state.range(1);
+  auto arr = unsafe_heap::make_array();
+  arr.reserve(num_elems);
+  for (auto i = 0U; i < num_elems; ++i) arr.push_back(i * 0.1);
+
+  // Finalize it, packed or not.
+  auto opts = dart::finalize_options {};
+  if (state.range(0)) opts.arrays = dart::array_policy::packed;
+  auto obj = unsafe_heap::make_object("arr", std::move(arr)).finalize(opts);
+  auto data = obj["arr"];
+
+  // Run the test, reading packed arrays through a span when asked to.
+  for (auto _ : state) {
+    double sum = 0;
+    if (state.range(0) > 1) for (auto val : data.as_span<double>()) sum += val;
+    else data.for_each_elem([&] (auto val) { sum += val.decimal(); });
+    benchmark::DoNotOptimize(sum);
+    rate_counter += num_elems;
+  }
+  state.counters["finalized decimal element sums"] = rate_counter;
+  state.counters["finalized bytes"] = obj.get_bytes().size();
+}
+
+BENCHMARK_REGISTER_F(benchmark_helper, sum_finalized_decimal_elements)
+  ->Args({0, 1 << 16})
+  ->Args({1, 1 << 16})
+  ->Args({2, 1 << 16});
+
+BENCHMARK_DEFINE_F(benchmark_helper, convert_decimal_samples) (benchmark::State& state) {
+  // Generate a vector of samples.
+  size_t num_elems = state.range(1);
+  std::vector<double> samples(num_elems), storage(num_elems);
+  for (auto i = 0U; i < num_elems; ++i) samples[i] = i * 0.1;
+  auto packed = dart::convert::cast<unsafe_buffer>(samples);
+
+  // Run the test, converting into a heap, into a buffer, or back out of a buffer.
+  for (auto _ : state) {
+    if (state.range(0) == 0) benchmark::DoNotOptimize(dart::convert::cast<unsafe_heap>(samples));
+    else if (state.range(0) == 1) benchmark::DoNotOptimize(dart::convert::cast<unsafe_buffer>(samples));
+    else benchmark::DoNotOptimize(dart::convert::cast_into(packed, gsl::make_span(storage)));
+    rate_counter += num_elems;
+  }
+  state.counters["decimal sample conversions"] = rate_counter;
+}
+
+BENCHMARK_REGISTER_F(benchmark_helper, convert_decimal_samples)
+  ->Args({0, 100000})
+  ->Args({1, 100000})
+  ->Args({2, 100000});
+
 BENCHMARK_DEFINE_F(benchmark_helper, iterate_dynamic_random_fields) (benchmark::State& state) {
   // Generate some random strings.
   std::vector<std::string> keys(state.range(0));
@@ -655,6 +876,113 @@ BENCHMARK_F(benchmark_helper, finalize_dynamic_packet) (benchmark::State& state)
   state.counters["finalized packets"] = rate_counter;
 }
 
+BENCHMARK_F(benchmark_helper, finalize_dynamic_nested_packet) (benchmark::State& state) {
+  unsafe_heap nester {nested};
+  for (auto _ : state) {
+    auto copy = nester;
+    auto buf = copy.finalize().get_bytes();
+    benchmark::DoNotOptimize(buf.data());
+    ++rate_counter;
+  }
+  state.counters["finalized packets"] = rate_counter;
+}
+
+BENCHMARK_DEFINE_F(benchmark_helper, finalize_repeated_strings) (benchmark::State& state) {
+  // Generate a catalog of records, each drawing its status from a handful of strings.
+  std::vector<std::string> statuses(state.range(1));
+  std::generate(statuses.begin(), statuses.end(), [&] { return rand_string(24); });
+  auto catalog = unsafe_heap::make_array();
+  for (auto i = 0; i < 4096; ++i) catalog.push_back(statuses[i % statuses.size()]);
+  auto pkt = unsafe_heap::make_object("catalog", std::move(catalog));
+
+  // Run the test, with or without sharing strings.
+  dart::finalize_options opts;
+  if (state.range(0)) opts.strings = dart::string_policy::shared;
+  size_t bytes = 0;
+  for (auto _ : state) {
+    auto buf = pkt.finalize(opts);
+    bytes = buf.get_bytes().size();
+    benchmark::DoNotOptimize(buf.get_bytes().data());
+    ++rate_counter;
+  }
+  state.counters["finalized packets"] = rate_counter;
+  state.counters["bytes"] = bytes;
+}
+
+BENCHMARK_REGISTER_F(benchmark_helper, finalize_repeated_strings)
+  ->Args({0, 8})
+  ->Args({1, 8})
+  ->Args({0, 1024})
+  ->Args({1, 1024});
+
+BENCHMARK_F(benchmark_helper, hash_finalized_nested_packet) (benchmark::State& state) {
+  unsafe_buffer nester {nested_fin};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(nester.hash());
+    ++rate_counter;
+  }
+  state.counters["hashed packets"] = rate_counter;
+}
+
+BENCHMARK_F(benchmark_helper, hash_dynamic_nested_packet) (benchmark::State& state) {
+  unsafe_heap nester {nested};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(nester.hash());
+    ++rate_counter;
+  }
+  state.counters["hashed packets"] = rate_counter;
+}
+
+BENCHMARK_F(benchmark_helper, inject_into_finalized_packet) (benchmark::State& state) {
+  unsafe_buffer base {flat_fin};
+  for (auto _ : state) {
+    auto buf = base.inject("time", "atom heart mother", "echoes", "meddle").get_bytes();
+    benchmark::DoNotOptimize(buf.data());
+    ++rate_counter;
+  }
+  state.counters["injected packets"] = rate_counter;
+}
+
+BENCHMARK_F(benchmark_helper, project_finalized_packet) (benchmark::State& state) {
+  unsafe_buffer base {flat_fin};
+  for (auto _ : state) {
+    auto buf = base.project({"time", "money", "eclipse", "have a cigar", "echoes"}).get_bytes();
+    benchmark::DoNotOptimize(buf.data());
+    ++rate_counter;
+  }
+  state.counters["projected packets"] = rate_counter;
+}
+
+BENCHMARK_F(benchmark_helper, deep_merge_finalized_packet) (benchmark::State& state) {
+  auto base = unsafe_buffer::make_object("flat", flat_fin, "nested", nested_fin);
+  auto overlay = unsafe_buffer::make_object(
+    "flat", unsafe_packet::make_object("time", "atom heart mother"),
+    "nested", unsafe_packet::make_object("meddle", "echoes")
+  );
+  for (auto _ : state) {
+    auto buf = base.deep_merge(overlay).get_bytes();
+    benchmark::DoNotOptimize(buf.data());
+    ++rate_counter;
+  }
+  state.counters["merged packets"] = rate_counter;
+}
+
+BENCHMARK_F(benchmark_helper, definalize_merge_finalize_packet) (benchmark::State& state) {
+  auto base = unsafe_buffer::make_object("flat", flat_fin, "nested", nested_fin);
+  for (auto _ : state) {
+    auto heap = base.definalize();
+    auto flatter = heap["flat"];
+    auto nester = heap["nested"];
+    flatter.add_field("time", "atom heart mother");
+    nester.add_field("meddle", "echoes");
+    heap.add_field("flat", std::move(flatter)).add_field("nested", std::move(nester));
+    auto buf = heap.finalize().get_bytes();
+    benchmark::DoNotOptimize(buf.data());
+    ++rate_counter;
+  }
+  state.counters["merged packets"] = rate_counter;
+}
+
 BENCHMARK_F(benchmark_helper, serialize_finalized_packet_into_json) (benchmark::State& state) {
   for (auto _ : state) {
     benchmark::DoNotOptimize(flat_fin.to_json().data());
@@ -815,6 +1143,129 @@ BENCHMARK_F(benchmark_helper, unwrap_dynamic_boolean) (benchmark::State& state)
   state.counters["dynamic boolean value accesses"] = rate_counter;
 }
 
+BENCHMARK_F(benchmark_helper, unwrap_finalized_packet_string) (benchmark::State& state) {
+  // Generate some random strings.
+  std::vector<unsafe_packet> strs;
+  for (auto i = 0; i < 1024; ++i) {
+    strs.emplace_back(unsafe_packet::make_object("str", rand_string(static_string_size)).finalize()["str"]);
+  }
+
+  // Benchmark unwrapping the string into a machine type.
+  auto const pkts = strs.size();
+  for (auto _ : state) {
+    for (auto const& str : strs) benchmark::DoNotOptimize(str.strv());
+    rate_counter += pkts;
+  }
+  state.counters["finalized packet string value accesses"] = rate_counter;
+}
+
+BENCHMARK_F(benchmark_helper, unwrap_finalized_packet_integer) (benchmark::State& state) {
+  // Generate some random integers.
+  std::vector<unsafe_packet> ints;
+  for (auto i = 0; i < 1024; ++i) {
+    ints.emplace_back(unsafe_packet::make_object("int", rand_int()).finalize()["int"]);
+  }
+
+  // Benchmark unwrapping the integer into a machine type.
+  auto const pkts = ints.size();
+  for (auto _ : state) {
+    for (auto const& integer : ints) benchmark::DoNotOptimize(integer.integer());
+    rate_counter += pkts;
+  }
+  state.counters["finalized packet integer value accesses"] = rate_counter;
+}
+
+BENCHMARK_F(benchmark_helper, unwrap_dynamic_packet_integer) (benchmark::State& state) {
+  // Generate some random integers.
+  std::vector<unsafe_packet> ints;
+  for (auto i = 0; i < 1024; ++i) ints.emplace_back(unsafe_packet::make_integer(rand_int()));
+
+  // Benchmark unwrapping the integer into a machine type.
+  auto const pkts = ints.size();
+  for (auto _ : state) {
+    for (auto const& integer : ints) benchmark::DoNotOptimize(integer.integer());
+    rate_counter += pkts;
+  }
+  state.counters["dynamic packet integer value accesses"] = rate_counter;
+}
+
+template <class Packet>
+Packet generate_shareable_packet() {
+  auto base = Packet::make_object("dark side of the moon", "wish you were here", "the wall", "animals");
+  return base.finalize();
+}
+
+template <class Packet>
+void copy_shared_packet(benchmark::State& state) {
+  // Every thread hammers on the same reference count.
+  static auto const shared = generate_shareable_packet<Packet>();
+
+  int64_t copies = 0;
+  for (auto _ : state) {
+    for (auto i = 0; i < static_array_size; ++i) {
+      Packet copy = shared;
+      benchmark::DoNotOptimize(copy);
+    }
+    copies += static_array_size;
+  }
+  state.counters["shared packet copies"] = benchmark::Counter(copies, benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(copy_shared_packet, dart::packet)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(copy_shared_packet, dart::biased_packet)->ThreadRange(1, 64)->UseRealTime();
+
+template <class Packet>
+void copy_thread_local_packet(benchmark::State& state) {
+  // Every thread copies a packet it created itself.
+  auto const local = generate_shareable_packet<Packet>();
+
+  int64_t copies = 0;
+  for (auto _ : state) {
+    for (auto i = 0; i < static_array_size; ++i) {
+      Packet copy = local;
+      benchmark::DoNotOptimize(copy);
+    }
+    copies += static_array_size;
+  }
+  state.counters["local packet copies"] = benchmark::Counter(copies, benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(copy_thread_local_packet, dart::packet)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(copy_thread_local_packet, dart::unsafe_packet)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(copy_thread_local_packet, dart::biased_packet)->ThreadRange(1, 64)->UseRealTime();
+
+template <class Packet>
+void load_published_packet(benchmark::State& state) {
+  // Every thread reads the current version out of the same publisher.
+  static dart::publisher<Packet> current {generate_shareable_packet<Packet>()};
+
+  int64_t loads = 0;
+  for (auto _ : state) {
+    for (auto i = 0; i < static_array_size; ++i) {
+      auto copy = current.load();
+      benchmark::DoNotOptimize(copy);
+    }
+    loads += static_array_size;
+  }
+  state.counters["published packet loads"] = benchmark::Counter(loads, benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(load_published_packet, dart::packet)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(load_published_packet, dart::split_packet)->ThreadRange(1, 64)->UseRealTime();
+
+void load_atomic_buffer_view(benchmark::State& state) {
+  // Every thread views the current version of the same buffer.
+  static dart::atomic_buffer current {generate_shareable_packet<dart::buffer>()};
+
+  int64_t loads = 0;
+  for (auto _ : state) {
+    for (auto i = 0; i < static_array_size; ++i) {
+      auto view = current.load_view();
+      benchmark::DoNotOptimize(view);
+    }
+    loads += static_array_size;
+  }
+  state.counters["atomic buffer view loads"] = benchmark::Counter(loads, benchmark::Counter::kIsRate);
+}
+BENCHMARK(load_atomic_buffer_view)->ThreadRange(1, 64)->UseRealTime();
+
 BENCHMARK_MAIN();
 
 /*----- Helper Implementations -----*/
@@ -39,6 +39,7 @@ static_assert(false, "libdart requires a c++14 enabled compiler.");
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 #include <cstddef>
 #include <sstream>
 #include <cstring>
@@ -6364,6 +6365,26 @@ namespace dart {
       >
       basic_heap project(gsl::span<shim::string_view const> keys) const;
 
+      /**
+       *  @brief
+       *  Function recursively merges another object into this one, returning a new
+       *  object with the union of both keysets.
+       *
+       *  @details
+       *  Behaves like dart::heap::inject, except that when both objects contain an object
+       *  under the same key, the two nested objects are merged (recursively) instead
+       *  of the incoming one replacing the original.
+       *  In all other cases, values from the incoming object take precedence.
+       *  Nested objects that aren't modified are shared with the originals, and so are
+       *  only copied along the paths the incoming object actually touches.
+       */
+      template <bool enabled = refcount::is_owner<RefCount>::value, class EnableIf =
+        std::enable_if_t<
+          enabled
+        >
+      >
+      basic_heap deep_merge(basic_heap const& incoming) const;
+
       /*----- State Manipulation Functions -----*/
 
       /**
@@ -6634,6 +6655,24 @@ namespace dart {
       >
       basic_buffer<RefCount> finalize() const;
 
+      /**
+       *  @brief
+       *  Function transitions to a finalized state by returning a dart::buffer instance that
+       *  describes the same object tree, laid out according to the given options.
+       *
+       *  @details
+       *  Options only affect the representation of the resulting buffer, never its contents,
+       *  and buffers record whatever readers need to know about how they were laid out.
+       *  Buffers finalized with different options still compare equal if they
+       *  describe the same object tree.
+       */
+      template <bool enabled = refcount::is_owner<RefCount>::value, class EnableIf =
+        std::enable_if_t<
+          enabled
+        >
+      >
+      basic_buffer<RefCount> finalize(finalize_options const& opts) const;
+
       /**
        *  @brief
        *  Function transitions to a finalized state by returning a dart::buffer instance that
@@ -7420,6 +7459,16 @@ namespace dart {
        */
       bool empty() const;
 
+      /**
+       *  @brief
+       *  Function returns a hash of the contents of the current packet.
+       *
+       *  @details
+       *  Hashes are structural, so any two packets that compare equal hash equal,
+       *  whether they're dynamic or finalized, and however they were finalized.
+       */
+      size_t hash() const noexcept;
+
       /*----- Introspection Functions -----*/
 
       /**
@@ -7751,8 +7800,14 @@ namespace dart {
       basic_heap project_keys(Spannable const& keys) const;
 
       void copy_on_write(size_type overcount = 1);
-      auto upper_bound() const -> size_type;
-      auto layout(gsl::byte* buffer) const noexcept -> size_type;
+      auto upper_bound(finalize_options const& opts = {}, detail::layout_plan* plan = nullptr) const -> size_type;
+      auto layout(gsl::byte* buffer, finalize_options const& opts = {},
+          detail::layout_plan const* plan = nullptr) const -> size_type;
+      auto plan_width(finalize_options const& opts,
+          size_type bound, detail::layout_plan* plan) const -> detail::layout_format;
+      auto layout_width(finalize_options const& opts, detail::layout_plan const* plan) const noexcept -> detail::layout_format;
+      void const* layout_key() const noexcept;
+      auto packed_type(finalize_options const& opts) const noexcept -> detail::raw_type;
       detail::raw_type get_raw_type() const noexcept;
 
       template <class Deref>
@@ -7770,6 +7825,8 @@ namespace dart {
       auto try_get_elements() noexcept -> packet_elements*;
       auto try_get_elements() const noexcept -> packet_elements const*;
 
+      uint64_t hash_impl() const noexcept;
+
       /*----- Private Members -----*/
 
       type_data data;
@@ -8011,6 +8068,27 @@ namespace dart {
         buffer_ref(allocate_pointer(buffer))
       {}
 
+      /**
+       *  @brief
+       *  Copying network object constructor for packets keyed against a dictionary.
+       *
+       *  @details
+       *  Reconstitutes a packet previously finalized against the given dictionary,
+       *  which is kept alive for as long as the packet is.
+       *  Throws std::invalid_argument if the packet was keyed against a different dictionary.
+       */
+      template <bool enabled = refcount::is_owner<RefCount>::value, class EnableIf =
+        std::enable_if_t<
+          enabled
+        >
+      >
+      basic_buffer(gsl::span<gsl::byte const> buffer, key_dictionary const& dict) :
+        raw({detail::raw_type::null, nullptr}),
+        buffer_ref(allocate_pointer(buffer, dict))
+      {
+        raw = {detail::raw_type::object, buffer_ref.get()};
+      }
+
       /**
        *  @brief
        *  Network object constructor.
@@ -8278,6 +8356,16 @@ namespace dart {
        */
       basic_buffer operator [](shim::string_view key) const&;
 
+      /**
+       *  @brief
+       *  Object subscript operator.
+       *
+       *  @details
+       *  If this object was keyed against the dictionary that resolved the given key,
+       *  lookup compares integer ids instead of strings.
+       */
+      basic_buffer operator [](key_dictionary::key const& key) const&;
+
       /**
        *  @brief
        *  Object subscript operator.
@@ -8704,6 +8792,63 @@ namespace dart {
       >
       basic_buffer project(gsl::span<shim::string_view const> keys) const;
 
+      /**
+       *  @brief
+       *  Function merges any number of objects into a new object containing
+       *  the union of all of their keysets.
+       *
+       *  @details
+       *  Function performs a single walk across all of the provided objects and
+       *  writes the result into a single allocation, which makes it considerably
+       *  cheaper than chaining calls to dart::buffer::inject.
+       *  When a key is present in multiple objects, the value from the object
+       *  that appears last in the sequence wins.
+       */
+      template <bool enabled = refcount::is_owner<RefCount>::value, class EnableIf =
+        std::enable_if_t<
+          enabled
+        >
+      >
+      static basic_buffer merge(std::initializer_list<basic_buffer> objs);
+
+      /**
+       *  @brief
+       *  Function merges any number of objects into a new object containing
+       *  the union of all of their keysets.
+       *
+       *  @details
+       *  Function performs a single walk across all of the provided objects and
+       *  writes the result into a single allocation, which makes it considerably
+       *  cheaper than chaining calls to dart::buffer::inject.
+       *  When a key is present in multiple objects, the value from the object
+       *  that appears last in the sequence wins.
+       */
+      template <bool enabled = refcount::is_owner<RefCount>::value, class EnableIf =
+        std::enable_if_t<
+          enabled
+        >
+      >
+      static basic_buffer merge(gsl::span<basic_buffer const> objs);
+
+      /**
+       *  @brief
+       *  Function recursively merges another object into this one, returning a new
+       *  object with the union of both keysets.
+       *
+       *  @details
+       *  Behaves like dart::buffer::inject, except that when both objects contain an object
+       *  under the same key, the two nested objects are merged (recursively) instead
+       *  of the incoming one replacing the original.
+       *  In all other cases, values from the incoming object take precedence.
+       *  The result is written in a single pass across both objects, into a single allocation.
+       */
+      template <bool enabled = refcount::is_owner<RefCount>::value, class EnableIf =
+        std::enable_if_t<
+          enabled
+        >
+      >
+      basic_buffer deep_merge(basic_buffer const& incoming) const;
+
       /*----- State Manipulation Functions -----*/
 
       /**
@@ -9236,6 +9381,16 @@ namespace dart {
        */
       basic_buffer get(shim::string_view key) const&;
 
+      /**
+       *  @brief
+       *  Object access method, precisely equivalent to the corresponding subscript operator.
+       *
+       *  @details
+       *  If this object was keyed against the dictionary that resolved the given key,
+       *  lookup compares integer ids instead of strings.
+       */
+      basic_buffer get(key_dictionary::key const& key) const&;
+
       /**
        *  @brief
        *  Object access method, precisely equivalent to the corresponding subscript operator.
@@ -9880,6 +10035,16 @@ namespace dart {
        */
       bool empty() const;
 
+      /**
+       *  @brief
+       *  Function returns a hash of the contents of the current packet.
+       *
+       *  @details
+       *  Hashes are structural, so any two packets that compare equal hash equal,
+       *  whether they're dynamic or finalized, and however they were finalized.
+       */
+      size_t hash() const noexcept;
+
       /*----- Introspection Functions -----*/
 
       /**
@@ -9974,6 +10139,41 @@ namespace dart {
        */
       gsl::span<gsl::byte const> get_bytes() const;
 
+      /**
+       *  @brief
+       *  Function returns the dictionary a finalized packet was keyed against, if any.
+       *
+       *  @details
+       *  The bytes of a packet keyed against a dictionary can only be reconstituted
+       *  alongside the same dictionary.
+       */
+      key_dictionary dictionary() const;
+
+      /**
+       *  @brief
+       *  Function returns whether the current packet is an array packed with elements of type T.
+       *
+       *  @details
+       *  If it is, as_span<T> will view its elements without throwing.
+       */
+      template <class T>
+      bool is_packed() const noexcept;
+
+      /**
+       *  @brief
+       *  Function returns a view of the elements of a packed array, in place.
+       *
+       *  @details
+       *  Arrays are packed when finalized with array_policy::packed, if every element is an
+       *  integer (viewed as int64_t), every element is a decimal (viewed as double),
+       *  or every element is a boolean (viewed as bool).
+       *  Like get_bytes, the lifetime of the returned view is equal to the lifetime of the
+       *  current packet.
+       *  Throws if this is not an array, or is not packed with elements of type T.
+       */
+      template <class T>
+      gsl::span<T const> as_span() const;
+
       /**
        *  @brief
        *  Function allows the network buffer of the current packet to be exported
@@ -10198,6 +10398,38 @@ namespace dart {
        */
       auto rkvend() const -> std::tuple<reverse_iterator, reverse_iterator>;
 
+      /*----- Visitor Functions -----*/
+
+      /**
+       *  @brief
+       *  Function invokes the given callback with every key-value pair of the
+       *  current object, in iteration order.
+       *
+       *  @details
+       *  Callback is invoked as cb(key, value), where both are non-owning
+       *  dart::buffer::view instances that are valid for the lifetime of the
+       *  current buffer.
+       *  Walks the vtable linearly with everything inlined, avoiding the per-element
+       *  indirect call and reference count traffic of dart::buffer::iterator, and so
+       *  should be preferred for full-object scans.
+       *  Throws if this is not an object.
+       */
+      template <class Callback>
+      void for_each_pair(Callback&& cb) const;
+
+      /**
+       *  @brief
+       *  Function invokes the given callback with every element of the current
+       *  array, in order.
+       *
+       *  @details
+       *  Callback is invoked as cb(elem), where elem is a non-owning dart::buffer::view
+       *  that is valid for the lifetime of the current buffer.
+       *  Throws if this is not an array.
+       */
+      template <class Callback>
+      void for_each_elem(Callback&& cb) const;
+
       /*----- Member Ownership Helpers -----*/
 
       /**
@@ -10228,7 +10460,18 @@ namespace dart {
 
       basic_buffer(detail::raw_element raw, buffer_ref_type ref);
 
+      /*----- Private Helpers -----*/
+
+      auto make_view(detail::raw_element elem) const noexcept -> view;
+
       auto allocate_pointer(gsl::span<gsl::byte const> buffer) const -> buffer_ref_type;
+      auto allocate_pointer(gsl::span<gsl::byte const> buffer,
+          key_dictionary const& dict) const -> buffer_ref_type;
+      template <class Pointer>
+      Pointer&& check_keyed(Pointer&& ptr) const;
+      auto get_dictionary(detail::object<RefCount> const* obj) const noexcept -> detail::dictionary_storage const*;
+      auto load_dictionary() const noexcept -> detail::dictionary_storage const*;
+      auto lazy_dictionary() const noexcept -> detail::dictionary_ref;
       template <class Pointer>
       Pointer&& validate_pointer(Pointer&& ptr) const;
       template <class Pointer>
@@ -10782,6 +11025,16 @@ namespace dart {
        */
       basic_packet operator [](shim::string_view key) const&;
 
+      /**
+       *  @brief
+       *  Object subscript operator.
+       *
+       *  @details
+       *  If this is a finalized object keyed against the dictionary that resolved the given key,
+       *  lookup compares integer ids instead of strings.
+       */
+      basic_packet operator [](key_dictionary::key const& key) const&;
+
       /**
        *  @brief
        *  Object subscript operator.
@@ -11886,6 +12139,26 @@ namespace dart {
       >
       basic_packet project(gsl::span<shim::string_view const> keys) const;
 
+      /**
+       *  @brief
+       *  Function recursively merges another object into this one, returning a new
+       *  object with the union of both keysets.
+       *
+       *  @details
+       *  Behaves like dart::packet::inject, except that when both objects contain an object
+       *  under the same key, the two nested objects are merged (recursively) instead
+       *  of the incoming one replacing the original.
+       *  In all other cases, values from the incoming object take precedence.
+       *  Merge is performed in the current representation of this packet,
+       *  converting the incoming packet to match if necessary.
+       */
+      template <bool enabled = refcount::is_owner<RefCount>::value, class EnableIf =
+        std::enable_if_t<
+          enabled
+        >
+      >
+      basic_packet deep_merge(basic_packet const& incoming) const;
+
       /*----- State Manipulation Functions -----*/
 
       /**
@@ -12070,6 +12343,40 @@ namespace dart {
       >
       basic_packet&& finalize() &&;
 
+      /**
+       *  @brief
+       *  Function transitions the current packet from being non-finalized to finalized in place,
+       *  laid out according to the given options.
+       *
+       *  @details
+       *  Options only affect the representation of the resulting buffer, never its contents.
+       *  If the packet is already finalized it is left as is, whatever options it was
+       *  originally finalized with.
+       */
+      template <bool enabled = refcount::is_owner<RefCount>::value, class EnableIf =
+        std::enable_if_t<
+          enabled
+        >
+      >
+      basic_packet& finalize(finalize_options const& opts) &;
+
+      /**
+       *  @brief
+       *  Function transitions the current packet from being non-finalized to finalized in place,
+       *  laid out according to the given options.
+       *
+       *  @details
+       *  Options only affect the representation of the resulting buffer, never its contents.
+       *  If the packet is already finalized it is left as is, whatever options it was
+       *  originally finalized with.
+       */
+      template <bool enabled = refcount::is_owner<RefCount>::value, class EnableIf =
+        std::enable_if_t<
+          enabled
+        >
+      >
+      basic_packet&& finalize(finalize_options const& opts) &&;
+
       /**
        *  @brief
        *  Function transitions the current packet from being non-finalized to finalized in place.
@@ -12449,6 +12756,16 @@ namespace dart {
        */
       basic_packet get(shim::string_view key) const&;
 
+      /**
+       *  @brief
+       *  Object access method, precisely equivalent to the corresponding subscript operator.
+       *
+       *  @details
+       *  If this is a finalized object keyed against the dictionary that resolved the given key,
+       *  lookup compares integer ids instead of strings.
+       */
+      basic_packet get(key_dictionary::key const& key) const&;
+
       /**
        *  @brief
        *  Object access method, precisely equivalent to the corresponding subscript operator.
@@ -13221,6 +13538,16 @@ namespace dart {
        */
       bool empty() const;
 
+      /**
+       *  @brief
+       *  Function returns a hash of the contents of the current packet.
+       *
+       *  @details
+       *  Hashes are structural, so any two packets that compare equal hash equal,
+       *  whether they're dynamic or finalized, and however they were finalized.
+       */
+      size_t hash() const noexcept;
+
       /*----- Introspection Functions -----*/
 
       /**
@@ -13302,6 +13629,39 @@ namespace dart {
        */
       auto refcount() const noexcept -> size_type;
 
+      /*----- Representation Dispatch Functions -----*/
+
+      /**
+       *  @brief
+       *  Function invokes the given callback with the concrete representation
+       *  backing the current packet.
+       *
+       *  @details
+       *  Callback is invoked with a dart::basic_buffer const& if the packet is finalized,
+       *  and a dart::basic_heap const& otherwise, and must return the same type for both.
+       *  Unlike a general variant visit, dispatch is a single, predictable, branch that
+       *  checks for the finalized representation first, after which the callback is
+       *  inlined against the concrete type.
+       */
+      template <class Callback>
+      decltype(auto) visit_finalized(Callback&& cb) const;
+
+      /**
+       *  @brief
+       *  Function invokes the given callback with the underlying dart::basic_buffer
+       *  if, and only if, the current packet is finalized.
+       *
+       *  @details
+       *  Intended for hot paths that are expected to operate on finalized data,
+       *  and would prefer to fall back explicitly rather than pay for dispatch on
+       *  every access.
+       *
+       *  @return
+       *  Whether the callback was invoked.
+       */
+      template <class Callback>
+      bool with_buffer(Callback&& cb) const;
+
       /*----- Network Buffer Accessors -----*/
 
       /**
@@ -13315,6 +13675,31 @@ namespace dart {
        */
       gsl::span<gsl::byte const> get_bytes() const;
 
+      /**
+       *  @brief
+       *  Function returns whether the current packet is an array packed with elements of type T.
+       *
+       *  @details
+       *  If it is, as_span<T> will view its elements without throwing.
+       */
+      template <class T>
+      bool is_packed() const noexcept;
+
+      /**
+       *  @brief
+       *  Function returns a view of the elements of a packed array, in place.
+       *
+       *  @details
+       *  Arrays are packed when finalized with array_policy::packed, if every element is an
+       *  integer (viewed as int64_t), every element is a decimal (viewed as double),
+       *  or every element is a boolean (viewed as bool).
+       *  Like get_bytes, the lifetime of the returned view is equal to the lifetime of the
+       *  current packet.
+       *  Throws if this is not an array, or is not packed with elements of type T.
+       */
+      template <class T>
+      gsl::span<T const> as_span() const;
+
       /**
        *  @brief
        *  Function allows the network buffer of the current packet to be exported
@@ -13573,6 +13958,11 @@ namespace dart {
       auto layout(gsl::byte* buffer) const noexcept -> size_type;
       detail::raw_type get_raw_type() const noexcept;
 
+      template <class Callback>
+      decltype(auto) visit_impl(Callback&& cb);
+      template <class Callback>
+      decltype(auto) visit_impl(Callback&& cb) const;
+
       basic_heap<RefCount>& get_heap();
       basic_heap<RefCount> const& get_heap() const;
       basic_heap<RefCount>* try_get_heap();
@@ -13600,6 +13990,104 @@ namespace dart {
 
   };
 
+  /**
+   *  @brief
+   *  Class holds the current version of a finalized buffer, and allows it to be
+   *  hot-swapped by writers while any number of threads read it.
+   *
+   *  @details
+   *  Built on dart::publisher, so load() never blocks and never takes a mutex.
+   *  On top of that, load_view() returns a view of the current version itself,
+   *  which it pins for the calling thread without copying it, so a load_view() is
+   *  a handful of atomic operations on the thread's own cache line, never allocates,
+   *  and touches no reference counts at all.
+   *
+   *  @remarks
+   *  A view returned by load_view() remains valid, even across stores, until the
+   *  same thread calls load_view() again, on any instance, calls trim(), or exits,
+   *  or the instance is destroyed.
+   *  Each thread pins a single version at a time, across every instance, so a thread
+   *  keeps at most one superseded version alive, and only until then. Writers release
+   *  it on the first store after it's unpinned. Threads that need to hold on to several
+   *  versions at once should use load() instead.
+   */
+  template <template <class> class RefCount>
+  class basic_atomic_buffer {
+
+    public:
+
+      /*----- Public Types -----*/
+
+      using buffer_type = basic_buffer<RefCount>;
+      using view_type = typename buffer_type::view;
+
+      /*----- Lifecycle Functions -----*/
+
+      basic_atomic_buffer() : basic_atomic_buffer(buffer_type {}) {}
+      explicit basic_atomic_buffer(buffer_type buf);
+      basic_atomic_buffer(basic_atomic_buffer const&) = delete;
+      ~basic_atomic_buffer() = default;
+
+      /*----- Operators -----*/
+
+      basic_atomic_buffer& operator =(basic_atomic_buffer const&) = delete;
+
+      /*----- Public API -----*/
+
+      /**
+       *  @brief
+       *  Function returns an owning snapshot of the current version.
+       *
+       *  @details
+       *  Snapshot remains valid for as long as it's held, regardless of any
+       *  subsequent stores.
+       */
+      buffer_type load() const;
+
+      /**
+       *  @brief
+       *  Function returns a view of the current version, without touching
+       *  any reference counts, and pins it for the calling thread.
+       *
+       *  @details
+       *  Returns a null view if called while the calling thread is exiting,
+       *  after its bookkeeping has been destroyed.
+       */
+      view_type load_view() const noexcept;
+
+      /**
+       *  @brief
+       *  Function swaps in a new version, and returns the one it replaced.
+       *
+       *  @details
+       *  Waits for any readers still in the middle of copying the previous version,
+       *  but never for readers holding snapshots or views.
+       */
+      buffer_type exchange(buffer_type buf);
+      void store(buffer_type buf);
+
+      /**
+       *  @brief
+       *  Function returns the number of times a new version has been stored.
+       */
+      uint64_t version() const noexcept;
+
+      /**
+       *  @brief
+       *  Function unpins whatever version the calling thread last viewed with load_view(),
+       *  invalidating the view.
+       */
+      static void trim() noexcept;
+
+    private:
+
+      /*----- Private Members -----*/
+
+      publisher<buffer_type> current;
+      std::atomic<uint64_t> generation;
+
+  };
+
   using heap = basic_heap<std::shared_ptr>;
   using buffer = basic_buffer<std::shared_ptr>;
   using packet = basic_packet<std::shared_ptr>;
@@ -13608,6 +14096,16 @@ namespace dart {
   using unsafe_buffer = basic_buffer<unsafe_ptr>;
   using unsafe_packet = basic_packet<unsafe_ptr>;
 
+  using biased_heap = basic_heap<biased_ptr>;
+  using biased_buffer = basic_buffer<biased_ptr>;
+  using biased_packet = basic_packet<biased_ptr>;
+
+  using split_heap = basic_heap<split_ptr>;
+  using split_buffer = basic_buffer<split_ptr>;
+  using split_packet = basic_packet<split_ptr>;
+
+  using atomic_buffer = basic_atomic_buffer<std::shared_ptr>;
+
   using object = packet::object;
   using array = packet::array;
   using string = packet::string;
@@ -13699,6 +14197,21 @@ namespace dart {
     return detail::valid_buffer<true, std::shared_ptr>(raw, buffer.size());
   }
 
+  /**
+   *  @brief
+   *  Function provides a way to check if an arbitrary buffer of bytes
+   *  can be successfully interpreted as a Dart buffer keyed against the given dictionary.
+   *
+   *  @details
+   *  Function behaves identically to the overload without a dictionary, except that
+   *  objects keyed against a dictionary are only accepted if it is the given one.
+   */
+  inline bool is_valid(gsl::span<gsl::byte const> buffer, key_dictionary const& dict) noexcept {
+    detail::raw_element raw {detail::raw_type::object, buffer.data()};
+    auto* storage = detail::dictionary_access::get(dict).get();
+    return detail::valid_buffer<true, std::shared_ptr>(raw, buffer.size(), storage);
+  }
+
   /**
    *  @brief
    *  Function provides a way to check if an arbitrary buffer of bytes
@@ -13850,6 +14363,21 @@ namespace dart {
     detail::valid_buffer<false, std::shared_ptr>(raw, buffer.size());
   }
 
+  /**
+   *  @brief
+   *  Function provides a way to check if an arbitrary buffer of bytes
+   *  can be successfully interpreted as a Dart buffer keyed against the given dictionary.
+   *
+   *  @details
+   *  Function behaves identically to the overload without a dictionary, except that
+   *  objects keyed against a dictionary are only accepted if it is the given one.
+   */
+  inline void validate(gsl::span<gsl::byte const> buffer, key_dictionary const& dict) {
+    detail::raw_element raw {detail::raw_type::object, buffer.data()};
+    auto* storage = detail::dictionary_access::get(dict).get();
+    detail::valid_buffer<false, std::shared_ptr>(raw, buffer.size(), storage);
+  }
+
   /**
    *  @brief
    *  Function provides a way to check if an arbitrary buffer of bytes
@@ -14054,10 +14582,38 @@ namespace dart {
 
 }
 
+/*----- Standard Library Specializations -----*/
+
+namespace std {
+
+  template <template <class> class RefCount>
+  struct hash<dart::basic_heap<RefCount>> {
+    size_t operator ()(dart::basic_heap<RefCount> const& pkt) const noexcept {
+      return pkt.hash();
+    }
+  };
+
+  template <template <class> class RefCount>
+  struct hash<dart::basic_buffer<RefCount>> {
+    size_t operator ()(dart::basic_buffer<RefCount> const& pkt) const noexcept {
+      return pkt.hash();
+    }
+  };
+
+  template <template <class> class RefCount>
+  struct hash<dart::basic_packet<RefCount>> {
+    size_t operator ()(dart::basic_packet<RefCount> const& pkt) const noexcept {
+      return pkt.hash();
+    }
+  };
+
+}
+
 /*----- Function Template Implementations -----*/
 
 #include "dart/api.tcc"
 #include "dart/array.tcc"
+#include "dart/dictionary.tcc"
 #include "dart/iterator.tcc"
 #include "dart/object.tcc"
 #include "dart/operators.tcc"
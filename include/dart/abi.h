@@ -146,7 +146,8 @@ extern "C" {
   enum dart_packet_type {
     DART_HEAP = 1,
     DART_BUFFER,
-    DART_PACKET
+    DART_PACKET,
+    DART_BUFFER_VIEW
   };
   typedef enum dart_packet_type dart_packet_type_t;
 
@@ -160,14 +161,21 @@ extern "C" {
    *  DART_RC_SAFE means that the Dart type should use a thread-safe
    *  reference counter implementation, DART_RC_UNSAFE means that the
    *  Dart type should use a thread-unsafe reference counter implementation.
+   *  DART_RC_BIASED means that the Dart type should use a thread-safe
+   *  reference counter implementation that avoids atomic operations
+   *  on the thread that created the object.
    *
    *  @remarks
    *  A thread-unsafe reference counter makes copies cheaper, but also makes
    *  it much easier to break things accidentally.
+   *  A biased reference counter makes copies on the creating thread nearly as
+   *  cheap as the thread-unsafe implementation, at the cost of somewhat more
+   *  expensive copies everywhere else.
    */
   enum dart_rc_type {
     DART_RC_SAFE = 1,
-    DART_RC_UNSAFE
+    DART_RC_UNSAFE,
+    DART_RC_BIASED
   };
   typedef enum dart_rc_type dart_rc_type_t;
 
@@ -268,6 +276,42 @@ extern "C" {
   };
   typedef struct dart_buffer dart_buffer_t;
 
+  /**
+   *  @brief
+   *  Struct is used to encode state for a non-owning, read-only, view into a dart_buffer_t.
+   *
+   *  @details
+   *  See documentation for dart::buffer::view in the Doxygen docs.
+   *  Views can be used to walk a dart_buffer_t without touching its reference count,
+   *  and are only valid for as long as the dart_buffer_t they were derived from remains
+   *  alive, unmodified, and at the same address.
+   *
+   *  @remarks
+   *  Views can only be used with the dart_buffer_view functions, and the generic
+   *  functions will reject them.
+   *  Treat these types as opaque handles to state that is managed FOR you by the
+   *  public API functions.
+   */
+  struct dart_buffer_view {
+    dart_type_id_t rtti;
+    char bytes[DART_BUFFER_MAX_SIZE];
+  };
+  typedef struct dart_buffer_view dart_buffer_view_t;
+
+  /**
+   *  @brief
+   *  Struct is used to encode iteration state while walking across
+   *  the views of a dart_buffer_view_t aggregate (object or array).
+   *
+   *  @remarks
+   *  Subject to the same lifetime rules as dart_buffer_view_t.
+   */
+  struct dart_buffer_view_iterator {
+    dart_type_id_t rtti;
+    char bytes[DART_ITERATOR_MAX_SIZE];
+  };
+  typedef struct dart_buffer_view_iterator dart_buffer_view_iterator_t;
+
   /**
    *  @brief
    *  Struct is used to encode state for any type of Dart object, mutable or otherwise.
@@ -302,6 +346,24 @@ extern "C" {
   };
   typedef struct dart_string_view dart_string_view_t;
 
+  /**
+   *  @brief
+   *  Struct describes a single field to be extracted by dart_buffer_extract_typed.
+   *
+   *  @details
+   *  The value for the possibly unterminated key is converted according to the
+   *  given type, and written into the output struct at the given byte offset (use offsetof).
+   *  DART_STRING fields are written as a dart_string_view_t, DART_INTEGER fields as an
+   *  int64_t, DART_DECIMAL fields as a double, and DART_BOOLEAN fields as an int.
+   */
+  struct dart_field {
+    char const* key;
+    size_t len;
+    dart_type_t type;
+    size_t offset;
+  };
+  typedef struct dart_field dart_field_t;
+
   /*----- Public Function Declarations -----*/
 
   /*----- dart_heap Functions -----*/
@@ -3017,6 +3079,22 @@ extern "C" {
    */
   DART_ABI_EXPORT int dart_heap_equal(dart_heap_t const* lhs, dart_heap_t const* rhs);
 
+  /**
+   *  @brief
+   *  Function recursively calculates a hash for the given instance.
+   *
+   *  @details
+   *  Hashes are structural, and agree with dart_heap_equal, so any two instances that
+   *  compare equal hash equal.
+   *
+   *  @param[in] src
+   *  The instance to be hashed.
+   *
+   *  @return
+   *  The hash of the given instance.
+   */
+  DART_ABI_EXPORT size_t dart_heap_hash(dart_heap_t const* src);
+
   /**
    *  @brief
    *  Function checks whether the given instance is of object type.
@@ -3651,6 +3729,83 @@ extern "C" {
    */
   DART_ABI_EXPORT dart_err_t dart_buffer_arr_get_err(dart_buffer_t* dst, dart_buffer_t const* src, size_t idx);
 
+  /**
+   *  @brief
+   *  Function attempts to lookup the given key in a dart_buffer_t object without
+   *  touching the thread-local error string.
+   *
+   *  @details
+   *  Behaves like dart_buffer_obj_get_err, but never throws, allocates, or writes to the
+   *  error string returned by dart_get_error, making it suitable for hot paths where
+   *  failed lookups are expected.
+   *  Missing keys initialize dst to null and return DART_NO_ERROR.
+   *  Non-object instances return DART_TYPE_ERROR, invalid handles return DART_CLIENT_ERROR.
+   *
+   *  @param[out] dst
+   *  The dart_buffer_t instance that should be initialized with the result of this lookup.
+   *
+   *  @param[in] src
+   *  The object to lookup into.
+   *
+   *  @param[in] key
+   *  The null-terminated key to lookup.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_obj_try_get(dart_buffer_t* dst, dart_buffer_t const* src, char const* key);
+
+  /**
+   *  @brief
+   *  Function attempts to lookup the given key in a dart_buffer_t object without
+   *  touching the thread-local error string.
+   *
+   *  @details
+   *  Behaves like dart_buffer_obj_try_get, but accepts an explicit key length.
+   *
+   *  @param[out] dst
+   *  The dart_buffer_t instance that should be initialized with the result of this lookup.
+   *
+   *  @param[in] src
+   *  The object to lookup into.
+   *
+   *  @param[in] key
+   *  The key to lookup.
+   *
+   *  @param[in] len
+   *  The length of the key.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_obj_try_get_len(dart_buffer_t* dst,
+      dart_buffer_t const* src, char const* key, size_t len);
+
+  /**
+   *  @brief
+   *  Function attempts to lookup the given index in a dart_buffer_t array without
+   *  touching the thread-local error string.
+   *
+   *  @details
+   *  Behaves like dart_buffer_arr_get_err, but never throws, allocates, or writes to the
+   *  error string returned by dart_get_error.
+   *  Out of bounds indices initialize dst to null and return DART_NO_ERROR.
+   *  Non-array instances return DART_TYPE_ERROR, invalid handles return DART_CLIENT_ERROR.
+   *
+   *  @param[out] dst
+   *  The dart_buffer_t instance that should be initialized with the result of this lookup.
+   *
+   *  @param[in] src
+   *  The array to lookup into.
+   *
+   *  @param[in] idx
+   *  The index to lookup.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_arr_try_get(dart_buffer_t* dst, dart_buffer_t const* src, size_t idx);
+
   /**
    *  @brief
    *  Unwraps a given dart_buffer string instance.
@@ -3815,6 +3970,22 @@ extern "C" {
    */
   DART_ABI_EXPORT int dart_buffer_equal(dart_buffer_t const* lhs, dart_buffer_t const* rhs);
 
+  /**
+   *  @brief
+   *  Function recursively calculates a hash for the given instance.
+   *
+   *  @details
+   *  Hashes are structural, and agree with dart_buffer_equal, so any two instances that
+   *  compare equal hash equal.
+   *
+   *  @param[in] src
+   *  The instance to be hashed.
+   *
+   *  @return
+   *  The hash of the given instance.
+   */
+  DART_ABI_EXPORT size_t dart_buffer_hash(dart_buffer_t const* src);
+
   /**
    *  @brief
    *  Function checks whether the given instance is of object type.
@@ -3863,6 +4034,233 @@ extern "C" {
    */
   DART_ABI_EXPORT dart_type_t dart_buffer_get_type(dart_buffer_t const* src);
 
+  /*----- dart_buffer Batched Retrieval Operations -----*/
+
+  /**
+   *  @brief
+   *  Function is used to retrieve the values for many keys within a given object
+   *  in a single call.
+   *
+   *  @details
+   *  Behaves like calling dart_buffer_obj_get_len_err once per key, but only resolves the
+   *  type of the given object once, which matters when pulling many fields out of a message.
+   *  Function returns null instances for non-existent keys.
+   *  Function expects to receive uninitialized memory for all n destinations, and on error
+   *  none of them are left initialized.
+   *
+   *  @param[out] dst
+   *  Array of n dart_buffer_t instances that should be initialized with the results.
+   *
+   *  @param[in] src
+   *  The object instance to query from.
+   *
+   *  @param[in] keys
+   *  Array of n possibly unterminated keys to locate within the given object.
+   *
+   *  @param[in] lens
+   *  Array of n key lengths, or NULL if every key is null-terminated.
+   *
+   *  @param[in] n
+   *  The number of keys to lookup.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookups.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_obj_get_many(dart_buffer_t* dst,
+      dart_buffer_t const* src, char const* const* keys, size_t const* lens, size_t n);
+
+  /**
+   *  @brief
+   *  Function is used to retrieve a contiguous range of values within a given array
+   *  in a single call.
+   *
+   *  @details
+   *  Behaves like calling dart_buffer_arr_get_err for each index in [start, start + n),
+   *  but only resolves the type of the given array once.
+   *  Function returns null instances for out-of-bounds indices, just as dart_buffer_arr_get does.
+   *  Function expects to receive uninitialized memory for all n destinations, and on error
+   *  none of them are left initialized.
+   *
+   *  @param[out] dst
+   *  Array of n dart_buffer_t instances that should be initialized with the results.
+   *
+   *  @param[in] src
+   *  The array to lookup into.
+   *
+   *  @param[in] start
+   *  The first index to lookup.
+   *
+   *  @param[in] n
+   *  The number of indices to lookup.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookups.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_arr_get_range(dart_buffer_t* dst,
+      dart_buffer_t const* src, size_t start, size_t n);
+
+  /**
+   *  @brief
+   *  Function is used to unpack many fields of a given object directly into a
+   *  user-defined struct in a single call.
+   *
+   *  @details
+   *  Each field is looked up and converted as described by dart_field_t, without
+   *  allocating and without constructing any intermediate dart_buffer_t instances.
+   *  Fields that don't exist in the object are skipped and their destinations are
+   *  left untouched, so defaults can be assigned ahead of time.
+   *  Fields that exist but hold a different type are an error.
+   *  Strings are returned as views into the given buffer, and are only valid for as
+   *  long as the buffer is.
+   *
+   *  @remarks
+   *  On error, some subset of the fields may already have been written.
+   *
+   *  @param[in] src
+   *  The object instance to unpack.
+   *
+   *  @param[in] fields
+   *  Array of n field descriptions.
+   *
+   *  @param[in] n
+   *  The number of fields to unpack.
+   *
+   *  @param[out] out
+   *  The struct to unpack into.
+   *
+   *  @return
+   *  Whether anything went wrong while unpacking.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_extract_typed(dart_buffer_t const* src,
+      dart_field_t const* fields, size_t n, void* out);
+
+  /**
+   *  @brief
+   *  Function is used to unwrap every string in a given array in a single call.
+   *
+   *  @details
+   *  Writes a view of the first cap strings into the given output array, and the total
+   *  number of elements in the array into count, so that callers can detect truncation.
+   *  Strings are returned as views into the given buffer, and are only valid for as
+   *  long as the buffer is.
+   *
+   *  @remarks
+   *  If the array contains anything but strings, some subset of the output may
+   *  already have been written.
+   *
+   *  @param[in] src
+   *  The array to unwrap.
+   *
+   *  @param[out] out
+   *  Array of at least cap string views to write into.
+   *
+   *  @param[in] cap
+   *  The capacity of the output array.
+   *
+   *  @param[out] count
+   *  The number of elements in the given array, may be NULL.
+   *
+   *  @return
+   *  Whether anything went wrong while unwrapping.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_arr_get_strs(dart_buffer_t const* src,
+      dart_string_view_t* out, size_t cap, size_t* count);
+
+  /**
+   *  @brief
+   *  Function is used to unwrap every integer in a given array in a single call.
+   *
+   *  @details
+   *  Writes the first cap integers into the given output array, and the total
+   *  number of elements in the array into count, so that callers can detect truncation.
+   *
+   *  @remarks
+   *  If the array contains anything but integers, some subset of the output may
+   *  already have been written.
+   *
+   *  @param[in] src
+   *  The array to unwrap.
+   *
+   *  @param[out] out
+   *  Array of at least cap integers to write into.
+   *
+   *  @param[in] cap
+   *  The capacity of the output array.
+   *
+   *  @param[out] count
+   *  The number of elements in the given array, may be NULL.
+   *
+   *  @return
+   *  Whether anything went wrong while unwrapping.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_arr_get_ints(dart_buffer_t const* src,
+      int64_t* out, size_t cap, size_t* count);
+
+  /**
+   *  @brief
+   *  Function is used to unwrap every decimal in a given array in a single call.
+   *
+   *  @details
+   *  Writes the first cap decimals into the given output array, and the total
+   *  number of elements in the array into count, so that callers can detect truncation.
+   *
+   *  @remarks
+   *  If the array contains anything but decimals, some subset of the output may
+   *  already have been written.
+   *
+   *  @param[in] src
+   *  The array to unwrap.
+   *
+   *  @param[out] out
+   *  Array of at least cap decimals to write into.
+   *
+   *  @param[in] cap
+   *  The capacity of the output array.
+   *
+   *  @param[out] count
+   *  The number of elements in the given array, may be NULL.
+   *
+   *  @return
+   *  Whether anything went wrong while unwrapping.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_arr_get_dcms(dart_buffer_t const* src,
+      double* out, size_t cap, size_t* count);
+
+  /**
+   *  @brief
+   *  Function is used to retrieve every key-value pair of a given object in a single call.
+   *
+   *  @details
+   *  Writes the first cap keys, as string views, and values, as dart_buffer_view_t
+   *  instances, into the given output arrays, and the total number of pairs in the object
+   *  into count.
+   *  Pairs are returned in the object's internal order, with keys[i] corresponding to vals[i].
+   *  Nothing returned holds a reference, so everything is only valid for as long as the
+   *  given buffer is.
+   *  Function expects vals to point to uninitialized memory, and every view written to
+   *  it must be passed to dart_buffer_view_destroy.
+   *
+   *  @param[in] src
+   *  The object to unwrap.
+   *
+   *  @param[out] keys
+   *  Array of at least cap string views to write keys into, may be NULL.
+   *
+   *  @param[out] vals
+   *  Array of at least cap views to initialize with values, may be NULL.
+   *
+   *  @param[in] cap
+   *  The capacity of the output arrays.
+   *
+   *  @param[out] count
+   *  The number of pairs in the given object, may be NULL.
+   *
+   *  @return
+   *  Whether anything went wrong while unwrapping.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_obj_get_all(dart_buffer_t const* src,
+      dart_string_view_t* keys, dart_buffer_view_t* vals, size_t cap, size_t* count);
+
   /*----- dart_buffer JSON Manipulation Functions -----*/
 
   /**
@@ -4110,6 +4508,19 @@ extern "C" {
    */
   DART_ABI_EXPORT void const* dart_buffer_get_bytes(dart_buffer_t const* src, size_t* len);
 
+  /**
+   *  @brief
+   *  Function returns the version of the finalized buffer layout produced by this library.
+   *
+   *  @details
+   *  Used by the inlineable readers in abi_fast.h to verify that they understand
+   *  the buffers returned from dart_buffer_get_bytes.
+   *
+   *  @return
+   *  The layout version.
+   */
+  DART_ABI_EXPORT uint32_t dart_buffer_layout_version(void);
+
   /**
    *  @brief
    *  Function returns an owning pointer to a copy of the underlying network buffer for a dart_buffer_t
@@ -4278,65 +4689,442 @@ extern "C" {
    */
   DART_ABI_EXPORT dart_err_t dart_buffer_take_bytes_rc_err(dart_buffer_t* dst, dart_rc_type_t rc, void* bytes);
 
-  /*----- Generic Lifecycle Functions -----*/
+  /*----- dart_buffer_view Functions -----*/
+
+  /*----- dart_buffer_view Lifecycle Functions -----*/
 
   /**
    *  @brief
-   *  Function is used to default-initialize a dart_packet_t instance to null.
+   *  Function is used to initialize a non-owning view of a given dart_buffer_t.
    *
-   *  @remarks
-   *  Function cannot meaningfully fail, but has an error overload for API consistency.
+   *  @details
+   *  Does not touch the reference count of the given buffer, which must outlive the view.
+   *
+   *  @param[in] src
+   *  The buffer to view.
    *
    *  @return
-   *  The dart_packet instance initialized to null.
+   *  The initialized view, or a null view on error.
    */
-  DART_ABI_EXPORT dart_packet_t dart_init();
+  DART_ABI_EXPORT dart_buffer_view_t dart_buffer_view_init(dart_buffer_t const* src);
 
   /**
    *  @brief
-   *  Function is used to default-initialize a dart_packet_instance to null.
+   *  Function is used to initialize a non-owning view of a given dart_buffer_t.
    *
    *  @details
-   *  Function expects to receive a pointer to uninitialized memory, and does not call
-   *  dart_destroy before constructing the object. If you already have a live Dart object,
-   *  you must pass it through one of the dart_destroy functions before calling this function.
+   *  Does not touch the reference count of the given buffer, which must outlive the view.
+   *  Function expects to receive uninitialized memory.
    *
-   *  @remarks
-   *  Function cannot meaningfully fail, but has an error overload for API consistency.
+   *  @param[out] dst
+   *  The view to initialize.
    *
-   *  @param[out] pkt
-   *  The dart_packet_t instance to be initialized.
+   *  @param[in] src
+   *  The buffer to view.
    *
    *  @return
    *  Whether anything went wrong during initialization.
    */
-  DART_ABI_EXPORT dart_err_t dart_init_err(dart_packet_t* dst);
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_init_err(dart_buffer_view_t* dst, dart_buffer_t const* src);
 
   /**
    *  @brief
-   *  Function is used to default-initialize a dart_packet instance to null with an explicitly
-   *  set reference counter type.
+   *  Function is used to initialize an owning dart_buffer_t from a given view, so that
+   *  the value can outlive the buffer it was viewed from.
    *
-   *  @remarks
-   *  Function cannot meaningfully fail, but has an error overload for API consistency.
+   *  @details
+   *  Takes a single reference on the underlying network buffer.
+   *  Function expects to receive uninitialized memory.
    *
-   *  @param[in] rc
-   *  The reference counter type the initialized Dart type should use.
+   *  @param[out] dst
+   *  The buffer to initialize.
+   *
+   *  @param[in] src
+   *  The view to take ownership of.
    *
    *  @return
-   *  The dart_packet instance initialized to null.
+   *  Whether anything went wrong during initialization.
    */
-  DART_ABI_EXPORT dart_packet_t dart_init_rc(dart_rc_type_t rc);
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_to_buffer_err(dart_buffer_t* dst, dart_buffer_view_t const* src);
 
   /**
    *  @brief
-   *  Function is used to default-initialize a dart_packet instance to null with an explicitly
-   *  set reference counter type.
+   *  Function destroys a given view.
    *
    *  @details
-   *  Function expects to receive a pointer to uninitialized memory, and does not call
-   *  dart_destroy before constructing the object. If you already have a live Dart object,
-   *  you must pass it through one of the dart_destroy functions before calling this function.
+   *  Never touches a reference count, but is still required for API consistency.
+   *
+   *  @param[in] dst
+   *  The view to destroy.
+   *
+   *  @return
+   *  Whether anything went wrong during destruction.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_destroy(dart_buffer_view_t* dst);
+
+  /*----- dart_buffer_view Retrieval Operations -----*/
+
+  /**
+   *  @brief
+   *  Function is used to retrieve a view of the value for a given key within a given object,
+   *  without touching any reference counts.
+   *
+   *  @details
+   *  Function returns null views for non-existent keys.
+   *  Function expects to receive uninitialized memory.
+   *
+   *  @param[out] dst
+   *  The view to initialize with the result of the lookup.
+   *
+   *  @param[in] src
+   *  The object to query from.
+   *
+   *  @param[in] key
+   *  The null-terminated key to locate within the given object.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_obj_get_view(dart_buffer_view_t* dst, dart_buffer_t const* src, char const* key);
+
+  /**
+   *  @brief
+   *  Function is used to retrieve a view of the value for a given key within a given object,
+   *  without touching any reference counts.
+   *
+   *  @details
+   *  Function returns null views for non-existent keys.
+   *  Function expects to receive uninitialized memory.
+   *
+   *  @param[out] dst
+   *  The view to initialize with the result of the lookup.
+   *
+   *  @param[in] src
+   *  The object to query from.
+   *
+   *  @param[in] key
+   *  The possibly unterminated key to locate within the given object.
+   *
+   *  @param[in] len
+   *  The length of the given key.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_obj_get_view_len(dart_buffer_view_t* dst,
+      dart_buffer_t const* src, char const* key, size_t len);
+
+  /**
+   *  @brief
+   *  Function is used to retrieve a view of the value at a given index within a given array,
+   *  without touching any reference counts.
+   *
+   *  @details
+   *  Function returns null views for out-of-bounds indices.
+   *  Function expects to receive uninitialized memory.
+   *
+   *  @param[out] dst
+   *  The view to initialize with the result of the lookup.
+   *
+   *  @param[in] src
+   *  The array to lookup into.
+   *
+   *  @param[in] idx
+   *  The index to lookup.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_arr_get_view(dart_buffer_view_t* dst, dart_buffer_t const* src, size_t idx);
+
+  /**
+   *  @brief
+   *  Function is used to retrieve a view of the value for a given key within a given
+   *  object view.
+   *
+   *  @details
+   *  Function returns null views for non-existent keys.
+   *  Function expects to receive uninitialized memory.
+   *
+   *  @param[out] dst
+   *  The view to initialize with the result of the lookup.
+   *
+   *  @param[in] src
+   *  The object view to query from.
+   *
+   *  @param[in] key
+   *  The null-terminated key to locate within the given object.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_obj_get(dart_buffer_view_t* dst, dart_buffer_view_t const* src, char const* key);
+
+  /**
+   *  @brief
+   *  Function is used to retrieve a view of the value for a given key within a given
+   *  object view.
+   *
+   *  @details
+   *  Function returns null views for non-existent keys.
+   *  Function expects to receive uninitialized memory.
+   *
+   *  @param[out] dst
+   *  The view to initialize with the result of the lookup.
+   *
+   *  @param[in] src
+   *  The object view to query from.
+   *
+   *  @param[in] key
+   *  The possibly unterminated key to locate within the given object.
+   *
+   *  @param[in] len
+   *  The length of the given key.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_obj_get_len(dart_buffer_view_t* dst,
+      dart_buffer_view_t const* src, char const* key, size_t len);
+
+  /**
+   *  @brief
+   *  Function is used to retrieve a view of the value at a given index within a given
+   *  array view.
+   *
+   *  @details
+   *  Function returns null views for out-of-bounds indices.
+   *  Function expects to receive uninitialized memory.
+   *
+   *  @param[out] dst
+   *  The view to initialize with the result of the lookup.
+   *
+   *  @param[in] src
+   *  The array view to lookup into.
+   *
+   *  @param[in] idx
+   *  The index to lookup.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_arr_get(dart_buffer_view_t* dst, dart_buffer_view_t const* src, size_t idx);
+
+  /**
+   *  @brief
+   *  Unwraps a given string view.
+   *
+   *  @details
+   *  String is gauranteed to be terminated, but may contain additional nulls.
+   *  The returned pointer points into the viewed buffer.
+   *
+   *  @param[in] src
+   *  The string view to unwrap.
+   *
+   *  @param[out] len
+   *  The length of the unwrapped string.
+   *
+   *  @return
+   *  A pointer to the character data for the given string, or NULL on error.
+   */
+  DART_ABI_EXPORT char const* dart_buffer_view_str_get_len(dart_buffer_view_t const* src, size_t* len);
+
+  /**
+   *  @brief
+   *  Unwraps a given integer view.
+   *
+   *  @param[in] src
+   *  The integer view to unwrap.
+   *
+   *  @param[out] val
+   *  The integer value of the given view.
+   *
+   *  @return
+   *  Whether anything went wrong while unwrapping.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_int_get_err(dart_buffer_view_t const* src, int64_t* val);
+
+  /**
+   *  @brief
+   *  Unwraps a given decimal view.
+   *
+   *  @param[in] src
+   *  The decimal view to unwrap.
+   *
+   *  @param[out] val
+   *  The decimal value of the given view.
+   *
+   *  @return
+   *  Whether anything went wrong while unwrapping.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_dcm_get_err(dart_buffer_view_t const* src, double* val);
+
+  /**
+   *  @brief
+   *  Unwraps a given boolean view.
+   *
+   *  @param[in] src
+   *  The boolean view to unwrap.
+   *
+   *  @param[out] val
+   *  The boolean value of the given view.
+   *
+   *  @return
+   *  Whether anything went wrong while unwrapping.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_bool_get_err(dart_buffer_view_t const* src, int* val);
+
+  /**
+   *  @brief
+   *  Returns the size of the given aggregate or string view.
+   *
+   *  @return
+   *  The size of the view, or DART_FAILURE on error.
+   */
+  DART_ABI_EXPORT size_t dart_buffer_view_size(dart_buffer_view_t const* src);
+
+  /**
+   *  @brief
+   *  Returns the type of the given view.
+   */
+  DART_ABI_EXPORT dart_type_t dart_buffer_view_get_type(dart_buffer_view_t const* src);
+
+  /*----- dart_buffer_view Iteration Functions -----*/
+
+  /**
+   *  @brief
+   *  Function initializes an iterator over the values of a given aggregate view.
+   *
+   *  @details
+   *  Function expects to receive uninitialized memory.
+   *
+   *  @param[out] dst
+   *  The iterator to initialize.
+   *
+   *  @param[in] src
+   *  The object or array view to iterate over.
+   *
+   *  @return
+   *  Whether anything went wrong during initialization.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_iterator_init_err(dart_buffer_view_iterator_t* dst, dart_buffer_view_t const* src);
+
+  /**
+   *  @brief
+   *  Function initializes an iterator over the keys of a given object view.
+   *
+   *  @details
+   *  Function expects to receive uninitialized memory.
+   *
+   *  @param[out] dst
+   *  The iterator to initialize.
+   *
+   *  @param[in] src
+   *  The object view to iterate over.
+   *
+   *  @return
+   *  Whether anything went wrong during initialization.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_iterator_init_key_err(dart_buffer_view_iterator_t* dst, dart_buffer_view_t const* src);
+
+  /**
+   *  @brief
+   *  Function initializes a view of the current element of a given iterator.
+   *
+   *  @details
+   *  Function expects to receive uninitialized memory.
+   *
+   *  @param[out] dst
+   *  The view to initialize.
+   *
+   *  @param[in] src
+   *  The iterator to dereference.
+   *
+   *  @return
+   *  Whether anything went wrong, including the iterator being exhausted.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_iterator_get_err(dart_buffer_view_t* dst, dart_buffer_view_iterator_t const* src);
+
+  /**
+   *  @brief
+   *  Function advances a given iterator, and does nothing if it's already exhausted.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_iterator_next(dart_buffer_view_iterator_t* dst);
+
+  /**
+   *  @brief
+   *  Function checks whether a given iterator has been exhausted.
+   *
+   *  @return
+   *  Whether the iterator is exhausted, or true on error.
+   */
+  DART_ABI_EXPORT int dart_buffer_view_iterator_done(dart_buffer_view_iterator_t const* src);
+
+  /**
+   *  @brief
+   *  Function destroys a given iterator.
+   */
+  DART_ABI_EXPORT dart_err_t dart_buffer_view_iterator_destroy(dart_buffer_view_iterator_t* dst);
+
+  /*----- Generic Lifecycle Functions -----*/
+
+  /**
+   *  @brief
+   *  Function is used to default-initialize a dart_packet_t instance to null.
+   *
+   *  @remarks
+   *  Function cannot meaningfully fail, but has an error overload for API consistency.
+   *
+   *  @return
+   *  The dart_packet instance initialized to null.
+   */
+  DART_ABI_EXPORT dart_packet_t dart_init();
+
+  /**
+   *  @brief
+   *  Function is used to default-initialize a dart_packet_instance to null.
+   *
+   *  @details
+   *  Function expects to receive a pointer to uninitialized memory, and does not call
+   *  dart_destroy before constructing the object. If you already have a live Dart object,
+   *  you must pass it through one of the dart_destroy functions before calling this function.
+   *
+   *  @remarks
+   *  Function cannot meaningfully fail, but has an error overload for API consistency.
+   *
+   *  @param[out] pkt
+   *  The dart_packet_t instance to be initialized.
+   *
+   *  @return
+   *  Whether anything went wrong during initialization.
+   */
+  DART_ABI_EXPORT dart_err_t dart_init_err(dart_packet_t* dst);
+
+  /**
+   *  @brief
+   *  Function is used to default-initialize a dart_packet instance to null with an explicitly
+   *  set reference counter type.
+   *
+   *  @remarks
+   *  Function cannot meaningfully fail, but has an error overload for API consistency.
+   *
+   *  @param[in] rc
+   *  The reference counter type the initialized Dart type should use.
+   *
+   *  @return
+   *  The dart_packet instance initialized to null.
+   */
+  DART_ABI_EXPORT dart_packet_t dart_init_rc(dart_rc_type_t rc);
+
+  /**
+   *  @brief
+   *  Function is used to default-initialize a dart_packet instance to null with an explicitly
+   *  set reference counter type.
+   *
+   *  @details
+   *  Function expects to receive a pointer to uninitialized memory, and does not call
+   *  dart_destroy before constructing the object. If you already have a live Dart object,
+   *  you must pass it through one of the dart_destroy functions before calling this function.
    *
    *  @remarks
    *  Function cannot meaningfully fail, but has an error overload for API consistency.
@@ -7150,6 +7938,178 @@ extern "C" {
    */
   DART_ABI_EXPORT dart_err_t dart_bool_get_err(void const* src, int* val);
 
+  /**
+   *  @brief
+   *  Function attempts to lookup the given key in an object without touching the
+   *  thread-local error string.
+   *
+   *  @details
+   *  Behaves like dart_obj_get_err, but never throws, allocates an error message, or writes
+   *  to the error string returned by dart_get_error, making it suitable for hot paths where
+   *  failed lookups are expected.
+   *  Missing keys initialize dst to null and return DART_NO_ERROR.
+   *  Non-object instances return DART_TYPE_ERROR, invalid handles return DART_CLIENT_ERROR.
+   *
+   *  @remarks
+   *  Function is generic and will exhibit sensible semantics for any input Dart type.
+   *  The result is always a dart_packet_t.
+   *
+   *  @param[out] dst
+   *  The dart_packet_t instance that should be initialized with the result of this lookup.
+   *
+   *  @param[in] src
+   *  The object to lookup into.
+   *
+   *  @param[in] key
+   *  The null-terminated key to lookup.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_obj_try_get(dart_packet_t* dst, void const* src, char const* key);
+
+  /**
+   *  @brief
+   *  Function attempts to lookup the given key in an object without touching the
+   *  thread-local error string.
+   *
+   *  @details
+   *  Behaves like dart_obj_try_get, but accepts an explicit key length.
+   *
+   *  @param[out] dst
+   *  The dart_packet_t instance that should be initialized with the result of this lookup.
+   *
+   *  @param[in] src
+   *  The object to lookup into.
+   *
+   *  @param[in] key
+   *  The key to lookup.
+   *
+   *  @param[in] len
+   *  The length of the key.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_obj_try_get_len(dart_packet_t* dst, void const* src, char const* key, size_t len);
+
+  /**
+   *  @brief
+   *  Function attempts to lookup the given index in an array without touching the
+   *  thread-local error string.
+   *
+   *  @details
+   *  Out of bounds indices initialize dst to null and return DART_NO_ERROR.
+   *  Non-array instances return DART_TYPE_ERROR, invalid handles return DART_CLIENT_ERROR.
+   *
+   *  @param[out] dst
+   *  The dart_packet_t instance that should be initialized with the result of this lookup.
+   *
+   *  @param[in] src
+   *  The array to lookup into.
+   *
+   *  @param[in] idx
+   *  The index to lookup.
+   *
+   *  @return
+   *  Whether anything went wrong during the lookup.
+   */
+  DART_ABI_EXPORT dart_err_t dart_arr_try_get(dart_packet_t* dst, void const* src, size_t idx);
+
+  /**
+   *  @brief
+   *  Attempts to unwrap a string instance without touching the thread-local error string.
+   *
+   *  @details
+   *  Returns DART_TYPE_ERROR if the instance is not a string.
+   *
+   *  @param[in] src
+   *  The string instance that should be unwrapped.
+   *
+   *  @param[out] str
+   *  A pointer that will be set to the (non-owning) character data of the string.
+   *
+   *  @param[out] len
+   *  An optional pointer that will be set to the length of the string. May be NULL.
+   *
+   *  @return
+   *  Whether anything went wrong during the unwrap.
+   */
+  DART_ABI_EXPORT dart_err_t dart_str_try_get(void const* src, char const** str, size_t* len);
+
+  /**
+   *  @brief
+   *  Attempts to unwrap an integer instance without touching the thread-local error string.
+   *
+   *  @details
+   *  Returns DART_TYPE_ERROR if the instance is not an integer.
+   *
+   *  @param[in] src
+   *  The integer instance that should be unwrapped.
+   *
+   *  @param[out] val
+   *  A pointer to the integer that should be initialized to the unwrapped value.
+   *
+   *  @return
+   *  Whether anything went wrong during the unwrap.
+   */
+  DART_ABI_EXPORT dart_err_t dart_int_try_get(void const* src, int64_t* val);
+
+  /**
+   *  @brief
+   *  Attempts to unwrap a decimal instance without touching the thread-local error string.
+   *
+   *  @details
+   *  Returns DART_TYPE_ERROR if the instance is not a decimal.
+   *
+   *  @param[in] src
+   *  The decimal instance that should be unwrapped.
+   *
+   *  @param[out] val
+   *  A pointer to the decimal that should be initialized to the unwrapped value.
+   *
+   *  @return
+   *  Whether anything went wrong during the unwrap.
+   */
+  DART_ABI_EXPORT dart_err_t dart_dcm_try_get(void const* src, double* val);
+
+  /**
+   *  @brief
+   *  Attempts to unwrap a boolean instance without touching the thread-local error string.
+   *
+   *  @details
+   *  Returns DART_TYPE_ERROR if the instance is not a boolean.
+   *
+   *  @param[in] src
+   *  The boolean instance that should be unwrapped.
+   *
+   *  @param[out] val
+   *  A pointer to the boolean that should be initialized to the unwrapped value.
+   *
+   *  @return
+   *  Whether anything went wrong during the unwrap.
+   */
+  DART_ABI_EXPORT dart_err_t dart_bool_try_get(void const* src, int* val);
+
+  /**
+   *  @brief
+   *  Attempts to query the type of an instance without touching the thread-local error string.
+   *
+   *  @details
+   *  Unlike dart_get_type, an invalid handle is reported as DART_CLIENT_ERROR rather than
+   *  collapsing into DART_INVALID.
+   *
+   *  @param[in] src
+   *  The instance whose type should be queried.
+   *
+   *  @param[out] type
+   *  A pointer that will be set to the type of the instance.
+   *
+   *  @return
+   *  Whether anything went wrong during the query.
+   */
+  DART_ABI_EXPORT dart_err_t dart_try_get_type(void const* src, dart_type_t* type);
+
   /**
    *  @brief
    *  Function returns the size of a Dart aggregate (object or array) or string
@@ -7191,6 +8151,23 @@ extern "C" {
    */
   DART_ABI_EXPORT int dart_equal(void const* lhs, void const* rhs);
 
+  /**
+   *  @brief
+   *  Function recursively calculates a hash for the given instance.
+   *
+   *  @remarks
+   *  Function is generic and will exhibit sensible semantics for any input Dart type.
+   *  Hashes agree with dart_equal, even across separate Dart implementation types,
+   *  so a dart_heap_t* and a dart_buffer_t* that compare equal hash equal.
+   *
+   *  @param[in] src
+   *  The instance to be hashed.
+   *
+   *  @return
+   *  The hash of the given instance.
+   */
+  DART_ABI_EXPORT size_t dart_hash(void const* src);
+
   /**
    *  @brief
    *  Function checks whether the given instance is of object type.
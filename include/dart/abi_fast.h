@@ -0,0 +1,682 @@
+/**
+ *  @file
+ *  abi_fast.h
+ *
+ *  @brief
+ *  Contains an optional, header-only, set of inlineable readers for finalized
+ *  Dart buffers, intended to be used alongside the ABI declared in abi.h.
+ *
+ *  @details
+ *  Every function in abi.h is an out-of-line call into libdart_abi, which means
+ *  that even trivial reads like dart_buffer_int_get can't be inlined into C callers.
+ *  The functions in this file instead decode the finalized representation directly
+ *  out of the memory returned by dart_buffer_get_bytes, and can be used for hot,
+ *  read-only, paths (type checks, scalar/string reads, and key/index lookups).
+ *
+ *  The finalized representation is a private detail of the library, and so the
+ *  layout this file understands is versioned by DART_FAST_LAYOUT_VERSION.
+ *  Callers must check dart_fast_compatible() (once is enough) before using any other
+ *  function in this file, and fall back on the regular ABI if it returns zero.
+ *  A compatible library can still produce aggregates this file can't fully search
+ *  (objects keyed against a dictionary). Lookups into those return a handle for which
+ *  dart_fast_is_unsupported() is non-zero, instead of null, and callers must repeat
+ *  the lookup through the regular ABI when they see one.
+ *
+ *  Element handles returned from this file are non-owning, and are only valid as long
+ *  as the dart_buffer_t they were derived from.
+ */
+
+#ifndef DART_ABI_FAST_H
+#define DART_ABI_FAST_H
+
+/*----- System Includes -----*/
+
+#include <string.h>
+
+/*----- Local Includes -----*/
+
+#include "abi.h"
+
+/*----- Macros ------*/
+
+// Version of the finalized buffer layout understood by this file.
+// Must match the value reported by dart_buffer_layout_version().
+#define DART_FAST_LAYOUT_VERSION  9U
+
+// Type of the handle returned by lookups this file can't answer on its own.
+// Lies outside of the range of dart_fast_raw_type.
+#define DART_FAST_RAW_UNSUPPORTED 0xFFU
+
+#if defined(_MSC_VER)
+#define DART_FAST_INLINE static __inline
+#else
+#define DART_FAST_INLINE static inline
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /*----- Public Type Declarations -----*/
+
+  /**
+   *  @brief
+   *  Enum mirrors the low-level machine types used inside a finalized buffer.
+   *
+   *  @details
+   *  Values are part of the versioned layout, and must not be reordered.
+   */
+  enum dart_fast_raw_type {
+    DART_FAST_RAW_OBJECT,
+    DART_FAST_RAW_ARRAY,
+    DART_FAST_RAW_STRING,
+    DART_FAST_RAW_SMALL_STRING,
+    DART_FAST_RAW_BIG_STRING,
+    DART_FAST_RAW_SHORT_INTEGER,
+    DART_FAST_RAW_INTEGER,
+    DART_FAST_RAW_LONG_INTEGER,
+    DART_FAST_RAW_DECIMAL,
+    DART_FAST_RAW_LONG_DECIMAL,
+    DART_FAST_RAW_BOOLEAN,
+    DART_FAST_RAW_NULL
+  };
+
+  /**
+   *  @brief
+   *  Struct is a non-owning handle to a single value inside of a finalized buffer.
+   *
+   *  @details
+   *  A handle with a NULL ptr represents null (the result of a failed lookup).
+   */
+  struct dart_fast_elem {
+    unsigned char const* ptr;
+    unsigned type;
+  };
+  typedef struct dart_fast_elem dart_fast_elem_t;
+
+  /*----- Private Helpers -----*/
+
+  // Aggregates share a header of {uint32_t bytes; uint32_t elems;} followed by
+  // a vtable of 8 byte entries of {uint32_t offset; uint8_t type; ...}.
+  // Object entries additionally store {uint8_t len; char prefix[2];} for the key.
+  // The top bit of the type of an object entry (DART_FAST_SHARED_FLAG) marks a string value
+  // shared with an earlier copy, in which case its key is followed by the offset of that copy,
+  // as wide as, and aligned like, the offsets of the vtable.
+  // The top three bits of elems tag the encoding of the aggregate. Keyed objects
+  // extend the header with {uint32_t skip; uint16_t min_len; uint16_t max_len;}, and cache
+  // the two characters following the first skip bytes of each key with a length inside of
+  // [min_len, max_len] instead of the first two.
+  // Compact aggregates store 16 bit offsets instead, packing object entries
+  // into 6 bytes, and array entries into 4.
+  // Wide aggregates store 64 bit offsets in 16 byte entries, behind a header of
+  // {uint64_t bytes; uint64_t elems;}, where the top three bits of bytes tag the encoding
+  // (and so land in the same byte as every other encoding).
+  // Packed arrays have no vtable, and instead store the type of their elements in the
+  // first byte of the 8 following the header, after which the elements are stored back to back.
+  // Objects keyed against a dictionary extend the header with {uint64_t version;}, and use
+  // 8 byte entries of {uint32_t offset; uint8_t type; uint8_t reserved; uint16_t id;}, sorted by id.
+  // Keys stored in the dictionary aren't stored in the object at all, and their entries point
+  // straight at their values. Any other key has an id of DART_FAST_INLINE_ID, sorting it last,
+  // and is stored, followed by its value, exactly as it would be in the standard encoding.
+  // All integers are stored little endian.
+#define DART_FAST_HEADER_LEN        8U
+#define DART_FAST_WIDE_HEADER_LEN   16U
+#define DART_FAST_EXTENSION_LEN     8U
+#define DART_FAST_ENTRY_LEN         8U
+#define DART_FAST_COMPACT_OBJ_LEN   6U
+#define DART_FAST_COMPACT_ARR_LEN   4U
+#define DART_FAST_WIDE_ENTRY_LEN    16U
+#define DART_FAST_PACKED_HEADER_LEN 16U
+#define DART_FAST_DICTIONARY_LEN    16U
+#define DART_FAST_INLINE_ID         0xFFFFU
+#define DART_FAST_LEN_MAX           0xFFU
+#define DART_FAST_SHARED_FLAG       0x80U
+#define DART_FAST_FORMAT_SHIFT      29U
+#define DART_FAST_SIZE_MASK         0x1FFFFFFFU
+#define DART_FAST_STANDARD          0U
+#define DART_FAST_KEYED             1U
+#define DART_FAST_COMPACT           2U
+#define DART_FAST_COMPACT_KEYED     3U
+#define DART_FAST_WIDE              4U
+#define DART_FAST_WIDE_KEYED        5U
+#define DART_FAST_PACKED            6U
+#define DART_FAST_DICTIONARY        7U
+
+  DART_FAST_INLINE uint16_t dart_fast_load_u16(unsigned char const* ptr) {
+    return (uint16_t) (ptr[0] | (ptr[1] << 8U));
+  }
+
+  DART_FAST_INLINE uint32_t dart_fast_load_u32(unsigned char const* ptr) {
+    return (uint32_t) ptr[0] | ((uint32_t) ptr[1] << 8U)
+      | ((uint32_t) ptr[2] << 16U) | ((uint32_t) ptr[3] << 24U);
+  }
+
+  DART_FAST_INLINE uint64_t dart_fast_load_u64(unsigned char const* ptr) {
+    return (uint64_t) dart_fast_load_u32(ptr) | ((uint64_t) dart_fast_load_u32(ptr + 4) << 32U);
+  }
+
+  DART_FAST_INLINE size_t dart_fast_alignment_of(unsigned type) {
+    switch (type) {
+      case DART_FAST_RAW_OBJECT:
+      case DART_FAST_RAW_ARRAY:
+      case DART_FAST_RAW_LONG_INTEGER:
+      case DART_FAST_RAW_LONG_DECIMAL:
+        return 8;
+      case DART_FAST_RAW_BIG_STRING:
+      case DART_FAST_RAW_INTEGER:
+      case DART_FAST_RAW_DECIMAL:
+        return 4;
+      case DART_FAST_RAW_STRING:
+      case DART_FAST_RAW_SMALL_STRING:
+      case DART_FAST_RAW_SHORT_INTEGER:
+        return 2;
+      default:
+        return 1;
+    }
+  }
+
+  DART_FAST_INLINE unsigned char const* dart_fast_align(unsigned char const* ptr, unsigned type) {
+    uintptr_t const mask = dart_fast_alignment_of(type) - 1;
+    return (unsigned char const*) (((uintptr_t) ptr + mask) & ~mask);
+  }
+
+  DART_FAST_INLINE unsigned dart_fast_format(dart_fast_elem_t aggr) {
+    return dart_fast_load_u32(aggr.ptr + sizeof(uint32_t)) >> DART_FAST_FORMAT_SHIFT;
+  }
+
+  DART_FAST_INLINE int dart_fast_is_wide(unsigned format) {
+    return (format & ~DART_FAST_KEYED) == DART_FAST_WIDE;
+  }
+
+  DART_FAST_INLINE size_t dart_fast_elem_count(dart_fast_elem_t aggr) {
+    if (dart_fast_is_wide(dart_fast_format(aggr))) return (size_t) dart_fast_load_u64(aggr.ptr + sizeof(uint64_t));
+    return dart_fast_load_u32(aggr.ptr + sizeof(uint32_t)) & DART_FAST_SIZE_MASK;
+  }
+
+  DART_FAST_INLINE unsigned char const* dart_fast_extension(dart_fast_elem_t aggr) {
+    return aggr.ptr + (dart_fast_is_wide(dart_fast_format(aggr)) ? DART_FAST_WIDE_HEADER_LEN : DART_FAST_HEADER_LEN);
+  }
+
+  DART_FAST_INLINE unsigned char const* dart_fast_vtable(dart_fast_elem_t aggr) {
+    return dart_fast_extension(aggr) + ((dart_fast_format(aggr) & DART_FAST_KEYED) ? DART_FAST_EXTENSION_LEN : 0);
+  }
+
+  // Entries begin with their offset, then their type, so the width of the offset
+  // is enough to find everything else in them.
+  DART_FAST_INLINE size_t dart_fast_offset_len(unsigned format) {
+    if (dart_fast_is_wide(format)) return sizeof(uint64_t);
+    return (format & DART_FAST_COMPACT) ? sizeof(uint16_t) : sizeof(uint32_t);
+  }
+
+  DART_FAST_INLINE size_t dart_fast_load_offset(unsigned char const* entry, size_t width) {
+    switch (width) {
+      case sizeof(uint16_t):
+        return dart_fast_load_u16(entry);
+      case sizeof(uint32_t):
+        return dart_fast_load_u32(entry);
+      default:
+        return (size_t) dart_fast_load_u64(entry);
+    }
+  }
+
+  DART_FAST_INLINE dart_fast_elem_t dart_fast_unsupported(dart_fast_elem_t aggr) {
+    aggr.type = DART_FAST_RAW_UNSUPPORTED;
+    return aggr;
+  }
+
+  // Keys are ordered first by length, then lexicographically as unsigned bytes.
+  DART_FAST_INLINE int dart_fast_key_compare(unsigned char const* entry, size_t width,
+      unsigned char const* base, char const* key, size_t len, size_t skip) {
+    // The vtable caches the (capped) key length, and two characters following the skipped bytes.
+    size_t const cached = entry[width + 1];
+    if (cached != DART_FAST_LEN_MAX || len < DART_FAST_LEN_MAX) {
+      if (len != cached) return (len < cached) ? -1 : 1;
+      if (len > skip) {
+        size_t const prefix = (len - skip < 2) ? len - skip : 2;
+        int const cmp = memcmp(key + skip, entry + width + 2, prefix);
+        if (cmp || (!skip && len <= 2)) return cmp;
+      }
+    }
+
+    // Fall back on the full key.
+    unsigned char const* str = base + dart_fast_load_offset(entry, width);
+    size_t const actual = dart_fast_load_u16(str);
+    if (len != actual) return (len < actual) ? -1 : 1;
+    return memcmp(key, str + sizeof(uint16_t), len);
+  }
+
+  // Searches the keys an object keyed against a dictionary stores inline.
+  // Keys stored in the dictionary can't be told apart from absent ones without it,
+  // so the object is reported as unsupported if the key isn't found inline.
+  DART_FAST_INLINE dart_fast_elem_t dart_fast_dictionary_get(dart_fast_elem_t obj, char const* key, size_t len) {
+    unsigned char const* vtable = obj.ptr + DART_FAST_DICTIONARY_LEN;
+    size_t const count = dart_fast_elem_count(obj);
+
+    // Find the first inline entry.
+    size_t low = 0, high = count;
+    while (low < high) {
+      size_t const mid = low + (high - low) / 2;
+      unsigned char const* entry = vtable + mid * DART_FAST_ENTRY_LEN;
+      if (dart_fast_load_u16(entry + sizeof(uint32_t) + 2) < DART_FAST_INLINE_ID) low = mid + 1;
+      else high = mid;
+    }
+
+    // Binary search the inline entries by their full keys.
+    high = count;
+    while (low < high) {
+      size_t const mid = low + (high - low) / 2;
+      unsigned char const* entry = vtable + mid * DART_FAST_ENTRY_LEN;
+      unsigned char const* str = obj.ptr + dart_fast_load_u32(entry);
+      size_t const actual = dart_fast_load_u16(str);
+      int const cmp = (len == actual) ? memcmp(key, str + sizeof(uint16_t), len) : ((len < actual) ? -1 : 1);
+      if (cmp > 0) {
+        low = mid + 1;
+      } else if (cmp < 0) {
+        high = mid;
+      } else {
+        dart_fast_elem_t val;
+        val.type = entry[sizeof(uint32_t)];
+        val.ptr = dart_fast_align(str + sizeof(uint16_t) + actual + 1, val.type);
+        return val;
+      }
+    }
+    return dart_fast_unsupported(obj);
+  }
+
+  /*----- Public Function Declarations -----*/
+
+  /**
+   *  @brief
+   *  Function checks whether the linked library lays out buffers the way this
+   *  file expects.
+   *
+   *  @details
+   *  Result never changes for the lifetime of a process, and so can be cached.
+   *
+   *  @return
+   *  Non-zero if the functions in this file can be used.
+   */
+  DART_FAST_INLINE int dart_fast_compatible(void) {
+    return dart_buffer_layout_version() == DART_FAST_LAYOUT_VERSION;
+  }
+
+  /**
+   *  @brief
+   *  Function checks whether a lookup produced a handle this file can't answer for.
+   *
+   *  @details
+   *  Lookups into unsupported handles return them unchanged, so a chain of lookups
+   *  only needs to be checked once, at the end.
+   *
+   *  @param[in] elem
+   *  The handle to inspect.
+   *
+   *  @return
+   *  Non-zero if the lookup must be repeated through the regular ABI.
+   */
+  DART_FAST_INLINE int dart_fast_is_unsupported(dart_fast_elem_t elem) {
+    return elem.ptr && elem.type == DART_FAST_RAW_UNSUPPORTED;
+  }
+
+  /**
+   *  @brief
+   *  Function returns a handle to the root object of a finalized network buffer.
+   *
+   *  @param[in] bytes
+   *  The buffer returned from dart_buffer_get_bytes.
+   *
+   *  @return
+   *  A handle to the root object, or null if bytes is NULL.
+   */
+  DART_FAST_INLINE dart_fast_elem_t dart_fast_root(void const* bytes) {
+    dart_fast_elem_t elem;
+    elem.ptr = (unsigned char const*) bytes;
+    elem.type = bytes ? DART_FAST_RAW_OBJECT : DART_FAST_RAW_NULL;
+    return elem;
+  }
+
+  /**
+   *  @brief
+   *  Function returns a handle to the given dart_buffer_t, which must be an object.
+   *
+   *  @details
+   *  Makes a single out-of-line call to dart_buffer_get_bytes.
+   *
+   *  @param[in] src
+   *  The object to read from.
+   *
+   *  @return
+   *  A handle to the object, or null if src is not an object.
+   */
+  DART_FAST_INLINE dart_fast_elem_t dart_fast_from_buffer(dart_buffer_t const* src) {
+    return dart_fast_root(dart_buffer_get_bytes(src, NULL));
+  }
+
+  /**
+   *  @brief
+   *  Function returns the user-facing type of a handle.
+   *
+   *  @param[in] elem
+   *  The handle to inspect.
+   *
+   *  @return
+   *  The type of the value.
+   */
+  DART_FAST_INLINE dart_type_t dart_fast_get_type(dart_fast_elem_t elem) {
+    if (!elem.ptr) return DART_NULL;
+    switch (elem.type) {
+      case DART_FAST_RAW_OBJECT:
+        return DART_OBJECT;
+      case DART_FAST_RAW_ARRAY:
+        return DART_ARRAY;
+      case DART_FAST_RAW_STRING:
+      case DART_FAST_RAW_SMALL_STRING:
+      case DART_FAST_RAW_BIG_STRING:
+        return DART_STRING;
+      case DART_FAST_RAW_SHORT_INTEGER:
+      case DART_FAST_RAW_INTEGER:
+      case DART_FAST_RAW_LONG_INTEGER:
+        return DART_INTEGER;
+      case DART_FAST_RAW_DECIMAL:
+      case DART_FAST_RAW_LONG_DECIMAL:
+        return DART_DECIMAL;
+      case DART_FAST_RAW_BOOLEAN:
+        return DART_BOOLEAN;
+      case DART_FAST_RAW_NULL:
+        return DART_NULL;
+      default:
+        return DART_INVALID;
+    }
+  }
+
+  DART_FAST_INLINE int dart_fast_is_obj(dart_fast_elem_t elem) {
+    return dart_fast_get_type(elem) == DART_OBJECT;
+  }
+
+  DART_FAST_INLINE int dart_fast_is_arr(dart_fast_elem_t elem) {
+    return dart_fast_get_type(elem) == DART_ARRAY;
+  }
+
+  DART_FAST_INLINE int dart_fast_is_str(dart_fast_elem_t elem) {
+    return dart_fast_get_type(elem) == DART_STRING;
+  }
+
+  DART_FAST_INLINE int dart_fast_is_int(dart_fast_elem_t elem) {
+    return dart_fast_get_type(elem) == DART_INTEGER;
+  }
+
+  DART_FAST_INLINE int dart_fast_is_dcm(dart_fast_elem_t elem) {
+    return dart_fast_get_type(elem) == DART_DECIMAL;
+  }
+
+  DART_FAST_INLINE int dart_fast_is_bool(dart_fast_elem_t elem) {
+    return dart_fast_get_type(elem) == DART_BOOLEAN;
+  }
+
+  DART_FAST_INLINE int dart_fast_is_null(dart_fast_elem_t elem) {
+    return dart_fast_get_type(elem) == DART_NULL;
+  }
+
+  /**
+   *  @brief
+   *  Function returns the number of elements in an aggregate, or the length of a string.
+   *
+   *  @param[in] elem
+   *  The handle to inspect.
+   *
+   *  @return
+   *  The size of the value, or DART_FAILURE if it has none.
+   */
+  DART_FAST_INLINE size_t dart_fast_size(dart_fast_elem_t elem) {
+    switch (dart_fast_get_type(elem)) {
+      case DART_OBJECT:
+      case DART_ARRAY:
+        return dart_fast_elem_count(elem);
+      case DART_STRING:
+        if (elem.type == DART_FAST_RAW_BIG_STRING) return dart_fast_load_u32(elem.ptr);
+        else return dart_fast_load_u16(elem.ptr);
+      default:
+        return DART_FAILURE;
+    }
+  }
+
+  /**
+   *  @brief
+   *  Function looks up a possibly unterminated key in an object.
+   *
+   *  @param[in] obj
+   *  The object to lookup into.
+   *
+   *  @param[in] key
+   *  The key to lookup.
+   *
+   *  @param[in] len
+   *  The length of the key.
+   *
+   *  @return
+   *  A handle to the value, null if obj is not an object or the key is absent,
+   *  or unsupported if obj is, or the key may be stored in a dictionary.
+   */
+  DART_FAST_INLINE dart_fast_elem_t dart_fast_obj_get_len(dart_fast_elem_t obj, char const* key, size_t len) {
+    dart_fast_elem_t val;
+    val.ptr = NULL;
+    val.type = DART_FAST_RAW_NULL;
+    if (dart_fast_is_unsupported(obj)) return obj;
+    else if (!dart_fast_is_obj(obj)) return val;
+
+    // Keyed objects record how many leading bytes their cached prefixes skip over,
+    // for keys within a range of lengths.
+    // Objects keyed against a dictionary can only be searched for the keys they store inline.
+    size_t skip = 0;
+    unsigned const format = dart_fast_format(obj);
+    if (format == DART_FAST_DICTIONARY) return dart_fast_dictionary_get(obj, key, len);
+    else if (format > DART_FAST_WIDE_KEYED) return dart_fast_unsupported(obj);
+    else if (format & DART_FAST_KEYED) {
+      unsigned char const* ext = dart_fast_extension(obj);
+      if (len >= dart_fast_load_u16(ext + 4) && len <= dart_fast_load_u16(ext + 6)) skip = dart_fast_load_u32(ext);
+    }
+
+    // Binary search the vtable.
+    size_t const width = dart_fast_offset_len(format);
+    size_t stride = DART_FAST_ENTRY_LEN;
+    if (format & DART_FAST_COMPACT) stride = DART_FAST_COMPACT_OBJ_LEN;
+    else if (dart_fast_is_wide(format)) stride = DART_FAST_WIDE_ENTRY_LEN;
+    unsigned char const* vtable = dart_fast_vtable(obj);
+    size_t low = 0, high = dart_fast_elem_count(obj);
+    while (low < high) {
+      size_t const mid = low + (high - low) / 2;
+      unsigned char const* entry = vtable + mid * stride;
+      int const cmp = dart_fast_key_compare(entry, width, obj.ptr, key, len, skip);
+      if (cmp > 0) {
+        low = mid + 1;
+      } else if (cmp < 0) {
+        high = mid;
+      } else {
+        // Values live immediately after their (null-terminated) key, aligned to their type.
+        // Unless the key is too long for the vtable to record, its length is known up front.
+        // Shared values store the offset of an earlier copy there instead.
+        unsigned char const* str = obj.ptr + dart_fast_load_offset(entry, width);
+        size_t const cached = entry[width + 1];
+        size_t const key_len = (cached != DART_FAST_LEN_MAX) ? cached : dart_fast_load_u16(str);
+        unsigned char const* const key_end = str + sizeof(uint16_t) + key_len + 1;
+        val.type = entry[width] & ~DART_FAST_SHARED_FLAG;
+        if (entry[width] & DART_FAST_SHARED_FLAG) {
+          uintptr_t const mask = width - 1;
+          unsigned char const* slot = (unsigned char const*) (((uintptr_t) key_end + mask) & ~mask);
+          val.ptr = obj.ptr + dart_fast_load_offset(slot, width);
+        } else {
+          val.ptr = dart_fast_align(key_end, val.type);
+        }
+        break;
+      }
+    }
+    return val;
+  }
+
+  /**
+   *  @brief
+   *  Function looks up a null-terminated key in an object.
+   *
+   *  @param[in] obj
+   *  The object to lookup into.
+   *
+   *  @param[in] key
+   *  The key to lookup.
+   *
+   *  @return
+   *  A handle to the value, null if obj is not an object or the key is absent,
+   *  or unsupported if obj is, or the key may be stored in a dictionary.
+   */
+  DART_FAST_INLINE dart_fast_elem_t dart_fast_obj_get(dart_fast_elem_t obj, char const* key) {
+    return dart_fast_obj_get_len(obj, key, strlen(key));
+  }
+
+  /**
+   *  @brief
+   *  Function looks up an index in an array.
+   *
+   *  @param[in] arr
+   *  The array to lookup into.
+   *
+   *  @param[in] idx
+   *  The index to lookup.
+   *
+   *  @return
+   *  A handle to the value, null if arr is not an array or the index is out of bounds,
+   *  or unsupported if arr is, or uses an encoding this file doesn't understand.
+   */
+  DART_FAST_INLINE dart_fast_elem_t dart_fast_arr_get(dart_fast_elem_t arr, size_t idx) {
+    dart_fast_elem_t val;
+    val.ptr = NULL;
+    val.type = DART_FAST_RAW_NULL;
+    if (dart_fast_is_unsupported(arr)) return arr;
+    else if (!dart_fast_is_arr(arr) || idx >= dart_fast_elem_count(arr)) return val;
+
+    // Elements of packed arrays are aligned to their own width, and stored back to back.
+    unsigned const format = dart_fast_format(arr);
+    if (format == DART_FAST_PACKED) {
+      val.type = arr.ptr[DART_FAST_HEADER_LEN];
+      val.ptr = arr.ptr + DART_FAST_PACKED_HEADER_LEN + idx * dart_fast_alignment_of(val.type);
+      return val;
+    }
+
+    // Anything newer than this file understands has to be looked up through the regular ABI.
+    if (format != DART_FAST_STANDARD && format != DART_FAST_COMPACT && format != DART_FAST_WIDE) {
+      return dart_fast_unsupported(arr);
+    }
+
+    size_t const width = dart_fast_offset_len(format);
+    size_t stride = DART_FAST_ENTRY_LEN;
+    if (format & DART_FAST_COMPACT) stride = DART_FAST_COMPACT_ARR_LEN;
+    else if (dart_fast_is_wide(format)) stride = DART_FAST_WIDE_ENTRY_LEN;
+    unsigned char const* entry = dart_fast_vtable(arr) + idx * stride;
+    val.type = entry[width];
+    val.ptr = arr.ptr + dart_fast_load_offset(entry, width);
+    return val;
+  }
+
+  /**
+   *  @brief
+   *  Function unwraps a string handle without copying.
+   *
+   *  @param[in] elem
+   *  The string to unwrap.
+   *
+   *  @param[out] out
+   *  A view that will be pointed at the (null-terminated) character data.
+   *
+   *  @return
+   *  DART_NO_ERROR on success, DART_TYPE_ERROR if elem is not a string.
+   */
+  DART_FAST_INLINE dart_err_t dart_fast_str_get(dart_fast_elem_t elem, dart_string_view_t* out) {
+    if (!dart_fast_is_str(elem)) return DART_TYPE_ERROR;
+    if (elem.type == DART_FAST_RAW_BIG_STRING) {
+      out->len = dart_fast_load_u32(elem.ptr);
+      out->ptr = (char const*) elem.ptr + sizeof(uint32_t);
+    } else {
+      out->len = dart_fast_load_u16(elem.ptr);
+      out->ptr = (char const*) elem.ptr + sizeof(uint16_t);
+    }
+    return DART_NO_ERROR;
+  }
+
+  /**
+   *  @brief
+   *  Function unwraps an integer handle of any width.
+   *
+   *  @param[in] elem
+   *  The integer to unwrap.
+   *
+   *  @param[out] out
+   *  The unwrapped value.
+   *
+   *  @return
+   *  DART_NO_ERROR on success, DART_TYPE_ERROR if elem is not an integer.
+   */
+  DART_FAST_INLINE dart_err_t dart_fast_int_get(dart_fast_elem_t elem, int64_t* out) {
+    switch (dart_fast_get_type(elem) == DART_INTEGER ? elem.type : (unsigned) DART_FAST_RAW_NULL) {
+      case DART_FAST_RAW_SHORT_INTEGER:
+        *out = (int16_t) dart_fast_load_u16(elem.ptr);
+        return DART_NO_ERROR;
+      case DART_FAST_RAW_INTEGER:
+        *out = (int32_t) dart_fast_load_u32(elem.ptr);
+        return DART_NO_ERROR;
+      case DART_FAST_RAW_LONG_INTEGER:
+        *out = (int64_t) dart_fast_load_u64(elem.ptr);
+        return DART_NO_ERROR;
+      default:
+        return DART_TYPE_ERROR;
+    }
+  }
+
+  /**
+   *  @brief
+   *  Function unwraps a decimal handle of any precision.
+   *
+   *  @param[in] elem
+   *  The decimal to unwrap.
+   *
+   *  @param[out] out
+   *  The unwrapped value.
+   *
+   *  @return
+   *  DART_NO_ERROR on success, DART_TYPE_ERROR if elem is not a decimal.
+   */
+  DART_FAST_INLINE dart_err_t dart_fast_dcm_get(dart_fast_elem_t elem, double* out) {
+    if (!dart_fast_is_dcm(elem)) return DART_TYPE_ERROR;
+    if (elem.type == DART_FAST_RAW_DECIMAL) {
+      float val;
+      uint32_t const bits = dart_fast_load_u32(elem.ptr);
+      memcpy(&val, &bits, sizeof(val));
+      *out = val;
+    } else {
+      uint64_t const bits = dart_fast_load_u64(elem.ptr);
+      memcpy(out, &bits, sizeof(*out));
+    }
+    return DART_NO_ERROR;
+  }
+
+  /**
+   *  @brief
+   *  Function unwraps a boolean handle.
+   *
+   *  @param[in] elem
+   *  The boolean to unwrap.
+   *
+   *  @param[out] out
+   *  The unwrapped value.
+   *
+   *  @return
+   *  DART_NO_ERROR on success, DART_TYPE_ERROR if elem is not a boolean.
+   */
+  DART_FAST_INLINE dart_err_t dart_fast_bool_get(dart_fast_elem_t elem, int* out) {
+    if (!dart_fast_is_bool(elem)) return DART_TYPE_ERROR;
+    *out = *elem.ptr != 0;
+    return DART_NO_ERROR;
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
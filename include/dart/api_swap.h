@@ -360,6 +360,180 @@ namespace dart {
     new(&dst->bytes) unsafe_packet(std::move(src));
   }
 
+  /**
+   *  @brief
+   *  When used correctly, function can efficiently swap between
+   *  the C++ and C APIs for Dart, without copies/allocations/etc
+   *  Function is for expert use, here be dragons
+   *
+   *  @details
+   *  Dart is primarily a header-only template library, which means
+   *  it has interesting ABI properties.
+   *  The pure C interface exports a shared library, and if you
+   *  _*exclusively*_ use the C interface, you can swap out different
+   *  versions of the shared library without having to recompile
+   *  your program.
+   *  The C++ interface, however, has almost no binary portability,
+   *  and so if your program is compiled against one version of this
+   *  library, but dynamically links against another, and you call
+   *  this function, it will explode in fantastically awful ways.
+   */
+  inline void unsafe_api_swap(dart_heap_t* dst, biased_heap const& src) {
+    // Initialize our RTTI structure properly so the C functions
+    // will know what this object is.
+    dst->rtti.p_id = DART_HEAP;
+    dst->rtti.rc_id = DART_RC_BIASED;
+
+    // Placement-new copy-construct the packet we were given into
+    // the C structure.
+    new(&dst->bytes) biased_heap(src);
+  }
+
+  /**
+   *  @brief
+   *  When used correctly, function can efficiently swap between
+   *  the C++ and C APIs for Dart, without copies/allocations/etc
+   *  Function is for expert use, here be dragons
+   *
+   *  @details
+   *  Dart is primarily a header-only template library, which means
+   *  it has interesting ABI properties.
+   *  The pure C interface exports a shared library, and if you
+   *  _*exclusively*_ use the C interface, you can swap out different
+   *  versions of the shared library without having to recompile
+   *  your program.
+   *  The C++ interface, however, has almost no binary portability,
+   *  and so if your program is compiled against one version of this
+   *  library, but dynamically links against another, and you call
+   *  this function, it will explode in fantastically awful ways.
+   */
+  inline void unsafe_api_swap(dart_heap_t* dst, biased_heap&& src) {
+    // Initialize our RTTI structure properly so the C functions
+    // will know what this object is.
+    dst->rtti.p_id = DART_HEAP;
+    dst->rtti.rc_id = DART_RC_BIASED;
+
+    // Placement-new copy-construct the packet we were given into
+    // the C structure.
+    new(&dst->bytes) biased_heap(std::move(src));
+  }
+
+  /**
+   *  @brief
+   *  When used correctly, function can efficiently swap between
+   *  the C++ and C APIs for Dart, without copies/allocations/etc
+   *  Function is for expert use, here be dragons
+   *
+   *  @details
+   *  Dart is primarily a header-only template library, which means
+   *  it has interesting ABI properties.
+   *  The pure C interface exports a shared library, and if you
+   *  _*exclusively*_ use the C interface, you can swap out different
+   *  versions of the shared library without having to recompile
+   *  your program.
+   *  The C++ interface, however, has almost no binary portability,
+   *  and so if your program is compiled against one version of this
+   *  library, but dynamically links against another, and you call
+   *  this function, it will explode in fantastically awful ways.
+   */
+  inline void unsafe_api_swap(dart_buffer_t* dst, biased_buffer const& src) {
+    // Initialize our RTTI structure properly so the C functions
+    // will know what this object is.
+    dst->rtti.p_id = DART_BUFFER;
+    dst->rtti.rc_id = DART_RC_BIASED;
+
+    // Placement-new copy-construct the packet we were given into
+    // the C structure.
+    new(&dst->bytes) biased_buffer(src);
+  }
+
+  /**
+   *  @brief
+   *  When used correctly, function can efficiently swap between
+   *  the C++ and C APIs for Dart, without copies/allocations/etc
+   *  Function is for expert use, here be dragons
+   *
+   *  @details
+   *  Dart is primarily a header-only template library, which means
+   *  it has interesting ABI properties.
+   *  The pure C interface exports a shared library, and if you
+   *  _*exclusively*_ use the C interface, you can swap out different
+   *  versions of the shared library without having to recompile
+   *  your program.
+   *  The C++ interface, however, has almost no binary portability,
+   *  and so if your program is compiled against one version of this
+   *  library, but dynamically links against another, and you call
+   *  this function, it will explode in fantastically awful ways.
+   */
+  inline void unsafe_api_swap(dart_buffer_t* dst, biased_buffer&& src) {
+    // Initialize our RTTI structure properly so the C functions
+    // will know what this object is.
+    dst->rtti.p_id = DART_BUFFER;
+    dst->rtti.rc_id = DART_RC_BIASED;
+
+    // Placement-new copy-construct the packet we were given into
+    // the C structure.
+    new(&dst->bytes) biased_buffer(std::move(src));
+  }
+
+  /**
+   *  @brief
+   *  When used correctly, function can efficiently swap between
+   *  the C++ and C APIs for Dart, without copies/allocations/etc
+   *  Function is for expert use, here be dragons
+   *
+   *  @details
+   *  Dart is primarily a header-only template library, which means
+   *  it has interesting ABI properties.
+   *  The pure C interface exports a shared library, and if you
+   *  _*exclusively*_ use the C interface, you can swap out different
+   *  versions of the shared library without having to recompile
+   *  your program.
+   *  The C++ interface, however, has almost no binary portability,
+   *  and so if your program is compiled against one version of this
+   *  library, but dynamically links against another, and you call
+   *  this function, it will explode in fantastically awful ways.
+   */
+  inline void unsafe_api_swap(dart_packet_t* dst, biased_packet const& src) {
+    // Initialize our RTTI structure properly so the C functions
+    // will know what this object is.
+    dst->rtti.p_id = DART_PACKET;
+    dst->rtti.rc_id = DART_RC_BIASED;
+
+    // Placement-new copy-construct the packet we were given into
+    // the C structure.
+    new(&dst->bytes) biased_packet(src);
+  }
+
+  /**
+   *  @brief
+   *  When used correctly, function can efficiently swap between
+   *  the C++ and C APIs for Dart, without copies/allocations/etc
+   *  Function is for expert use, here be dragons
+   *
+   *  @details
+   *  Dart is primarily a header-only template library, which means
+   *  it has interesting ABI properties.
+   *  The pure C interface exports a shared library, and if you
+   *  _*exclusively*_ use the C interface, you can swap out different
+   *  versions of the shared library without having to recompile
+   *  your program.
+   *  The C++ interface, however, has almost no binary portability,
+   *  and so if your program is compiled against one version of this
+   *  library, but dynamically links against another, and you call
+   *  this function, it will explode in fantastically awful ways.
+   */
+  inline void unsafe_api_swap(dart_packet_t* dst, biased_packet&& src) {
+    // Initialize our RTTI structure properly so the C functions
+    // will know what this object is.
+    dst->rtti.p_id = DART_PACKET;
+    dst->rtti.rc_id = DART_RC_BIASED;
+
+    // Placement-new copy-construct the packet we were given into
+    // the C structure.
+    new(&dst->bytes) biased_packet(std::move(src));
+  }
+
   /*----- Swap from C to C++ -----*/
 
   /**
@@ -548,6 +722,99 @@ namespace dart {
     dst = *reinterpret_cast<unsafe_packet const*>(&src->bytes);
   }
 
+  /**
+   *  @brief
+   *  When used correctly, function can efficiently swap between
+   *  the C++ and C APIs for Dart, without copies/allocations/etc
+   *  Function is for expert use, here be dragons
+   *
+   *  @details
+   *  Dart is primarily a header-only template library, which means
+   *  it has interesting ABI properties.
+   *  The pure C interface exports a shared library, and if you
+   *  _*exclusively*_ use the C interface, you can swap out different
+   *  versions of the shared library without having to recompile
+   *  your program.
+   *  The C++ interface, however, has almost no binary portability,
+   *  and so if your program is compiled against one version of this
+   *  library, but dynamically links against another, and you call
+   *  this function, it will explode in fantastically awful ways.
+   */
+  inline void unsafe_api_swap(biased_heap& dst, dart_heap_t const* src) {
+    // Check to make sure the user is respecting our API invariants
+    if (src->rtti.rc_id != DART_RC_BIASED) {
+      throw type_error("dart::biased_heap cannot be"
+          " initialized from a C type with unbiased reference counting");
+    }
+
+    // Unfortunately we don't have access to the ABI layer helpers
+    // in this header, so we have to just do the reinterpret cast manually
+    // The function has "unsafe" in its name, so I'm going to say it's fine
+    dst = *reinterpret_cast<biased_heap const*>(&src->bytes);
+  }
+
+  /**
+   *  @brief
+   *  When used correctly, function can efficiently swap between
+   *  the C++ and C APIs for Dart, without copies/allocations/etc
+   *  Function is for expert use, here be dragons
+   *
+   *  @details
+   *  Dart is primarily a header-only template library, which means
+   *  it has interesting ABI properties.
+   *  The pure C interface exports a shared library, and if you
+   *  _*exclusively*_ use the C interface, you can swap out different
+   *  versions of the shared library without having to recompile
+   *  your program.
+   *  The C++ interface, however, has almost no binary portability,
+   *  and so if your program is compiled against one version of this
+   *  library, but dynamically links against another, and you call
+   *  this function, it will explode in fantastically awful ways.
+   */
+  inline void unsafe_api_swap(biased_buffer& dst, dart_buffer_t const* src) {
+    // Check to make sure the user is respecting our API invariants
+    if (src->rtti.rc_id != DART_RC_BIASED) {
+      throw type_error("dart::biased_buffer cannot be"
+          " initialized from a C type with unbiased reference counting");
+    }
+
+    // Unfortunately we don't have access to the ABI layer helpers
+    // in this header, so we have to just do the reinterpret cast manually
+    // The function has "unsafe" in its name, so I'm going to say it's fine
+    dst = *reinterpret_cast<biased_buffer const*>(&src->bytes);
+  }
+
+  /**
+   *  @brief
+   *  When used correctly, function can efficiently swap between
+   *  the C++ and C APIs for Dart, without copies/allocations/etc
+   *  Function is for expert use, here be dragons
+   *
+   *  @details
+   *  Dart is primarily a header-only template library, which means
+   *  it has interesting ABI properties.
+   *  The pure C interface exports a shared library, and if you
+   *  _*exclusively*_ use the C interface, you can swap out different
+   *  versions of the shared library without having to recompile
+   *  your program.
+   *  The C++ interface, however, has almost no binary portability,
+   *  and so if your program is compiled against one version of this
+   *  library, but dynamically links against another, and you call
+   *  this function, it will explode in fantastically awful ways.
+   */
+  inline void unsafe_api_swap(biased_packet& dst, dart_packet_t const* src) {
+    // Check to make sure the user is respecting our API invariants
+    if (src->rtti.rc_id != DART_RC_BIASED) {
+      throw type_error("dart::biased_packet cannot be"
+          " initialized from a C type with unbiased reference counting");
+    }
+
+    // Unfortunately we don't have access to the ABI layer helpers
+    // in this header, so we have to just do the reinterpret cast manually
+    // The function has "unsafe" in its name, so I'm going to say it's fine
+    dst = *reinterpret_cast<biased_packet const*>(&src->bytes);
+  }
+
 }
 
 #endif
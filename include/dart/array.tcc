@@ -191,7 +191,7 @@ namespace dart {
 
         // Using the current offset, align a pointer for the next element type.
         auto* unaligned = DART_FROM_THIS_MUT + offset;
-        auto* aligned = detail::align_pointer<RefCount>(unaligned, val_type);
+        auto* aligned = detail::zero_align_pointer<RefCount>(unaligned, val_type);
         offset += aligned - unaligned;
 
         // Add an entry to the vtable.
@@ -221,7 +221,7 @@ namespace dart {
 
         // Using the current offset, align a pointer for the next element type.
         auto* unaligned = DART_FROM_THIS_MUT + offset;
-        auto* aligned = detail::align_pointer<RefCount>(unaligned, val_type);
+        auto* aligned = detail::zero_align_pointer<RefCount>(unaligned, val_type);
         offset += aligned - unaligned;
 
         // Add an entry to the vtable.
@@ -236,29 +236,98 @@ namespace dart {
     }
 #endif
 
-    // FIXME: Audit this function. A LOT has changed since it was written.
     template <template <class> class RefCount>
-    array<RefCount>::array(packet_elements<RefCount> const* vals) noexcept :
+    array<RefCount>::array(packet_elements<RefCount> const* vals,
+        finalize_options const& opts, layout_format width, layout_plan const* plan) :
+      elems(static_cast<uint32_t>(vals->size()))
+    {
+      // Whoever sized our buffer decided how wide our offsets can be.
+      set_format(width, vals->size());
+      if (is_compact(width)) layout_elements<compact_array_entry>(vals, opts, plan);
+      else if (is_wide(width)) layout_elements<wide_array_entry>(vals, opts, plan);
+      else layout_elements<array_entry>(vals, opts, plan);
+    }
+
+    template <template <class> class RefCount>
+    array<RefCount>::array(packet_elements<RefCount> const* vals, raw_type packed) noexcept :
       elems(static_cast<uint32_t>(vals->size()))
     {
+      // Whoever chose to pack us already checked that every element has the given type,
+      // and every element type we can be packed as is aligned to its own width,
+      // so the elements can be written back to back.
+      auto* curr = init_packed(packed);
+      auto pack = [&] (auto read) {
+        for (auto const& elem : *vals) {
+          auto val = read(elem);
+          new(curr) primitive<decltype(val)>(val);
+          curr += sizeof(val);
+        }
+      };
+      switch (packed) {
+        case raw_type::long_integer:
+          pack([] (auto& elem) { return elem.integer(); });
+          break;
+        case raw_type::long_decimal:
+          pack([] (auto& elem) { return elem.decimal(); });
+          break;
+        default:
+          DART_ASSERT(packed == raw_type::boolean);
+          pack([] (auto& elem) { return elem.boolean(); });
+      }
+      set_sizeof(curr - DART_FROM_THIS);
+    }
+
+    template <template <class> class RefCount>
+    template <class T>
+    array<RefCount>::array(gsl::span<T const> vals) noexcept :
+      elems(static_cast<uint32_t>(vals.size()))
+    {
+      static_assert(DART_BYTE_ORDER == DART_LITTLE_ENDIAN,
+          "dart::buffer can only pack arrays in bulk on little endian hosts");
+
+      // The caller's elements are already laid out the way we'd lay them out.
+      auto* data = init_packed(packed_element<T>::value);
+      if (!vals.empty()) std::copy_n(reinterpret_cast<gsl::byte const*>(vals.data()), vals.size() * sizeof(T), data);
+      set_sizeof(packed_sizeof(packed_element<T>::value, vals.size()));
+    }
+
+    // FIXME: Audit this function. A LOT has changed since it was written.
+    template <template <class> class RefCount>
+    template <class Entry>
+    void array<RefCount>::layout_elements(packet_elements<RefCount> const* vals,
+        finalize_options const& opts, layout_plan const* plan) {
       // Iterate over our elements and write each one into the buffer.
-      array_entry* entry = vtable();
-      size_t offset = reinterpret_cast<gsl::byte*>(&vtable()[elems]) - DART_FROM_THIS_MUT;
+      Entry* entry = vtable<Entry>();
+      size_t offset = reinterpret_cast<gsl::byte*>(&vtable<Entry>()[size()]) - DART_FROM_THIS_MUT;
+      string_offsets strings;
+      if (opts.strings == string_policy::shared) strings.reserve(size());
       for (auto const& elem : *vals) {
+        // If we've been asked to, point any string we've already laid out at its first occurrence.
+        auto const type = elem.get_raw_type();
+        auto const shared = opts.strings == string_policy::shared && simplify_type(type) == detail::type::string;
+        if (shared) {
+          auto const it = strings.find(elem.strv());
+          if (it != strings.end()) {
+            new(entry++) Entry(type, it->second);
+            continue;
+          }
+        }
+
         // Using the current offset, align a pointer for the next element type.
         auto* unaligned = DART_FROM_THIS_MUT + offset;
-        auto* aligned = detail::align_pointer<RefCount>(unaligned, elem.get_raw_type());
+        auto* aligned = detail::zero_align_pointer<RefCount>(unaligned, type);
         offset += aligned - unaligned;
 
         // Add an entry to the vtable.
-        new(entry++) array_entry(elem.get_raw_type(), static_cast<uint32_t>(offset));
+        new(entry++) Entry(type, offset);
+        if (shared) strings.emplace(elem.strv(), offset);
 
         // Recurse.
-        offset += elem.layout(aligned);
+        offset += elem.layout(aligned, opts, plan);
       }
 
       // array is laid out, write in our final size.
-      bytes = static_cast<uint32_t>(offset);
+      set_sizeof(offset);
     }
 
 // Unfortunately some versions of GCC and MSVC aren't smart enough to figure
@@ -274,13 +343,28 @@ namespace dart {
 
     template <template <class> class RefCount>
     template <bool silent>
-    bool array<RefCount>::is_valid(size_t bytes) const noexcept(silent) {
+    bool array<RefCount>::is_valid(size_t bytes, dictionary_storage const* dict) const noexcept(silent) {
       // Check if we even have enough space left for the array header.
       if (bytes < header_len) {
         if (silent) return false;
         else throw validation_error("Serialized array is truncated");
       }
 
+      // Make sure we understand how the array was encoded, and that its header fits,
+      // as the wide encoding stores a wider length.
+      auto const fmt = format();
+      if (fmt != layout_format::standard && fmt != layout_format::compact
+          && fmt != layout_format::wide && fmt != layout_format::packed) {
+        if (silent) return false;
+        else throw validation_error("Serialized array uses an unknown encoding");
+      } else if (header_sizeof() > bytes) {
+        if (silent) return false;
+        else throw validation_error("Serialized array is truncated");
+      } else if (fmt == layout_format::packed && !is_packable(packed_type())) {
+        if (silent) return false;
+        else throw validation_error("Serialized array is packed with elements of no packable type");
+      }
+
       // We now know it's safe to access the array length, but it could still be garbage,
       // so check if the array claims to be larger than our total buffer.
       // After this check, all other length checks will use the length reported by the array
@@ -290,11 +374,19 @@ namespace dart {
       if (total_size > static_cast<ssize_t>(bytes)) {
         if (silent) return false;
         else throw validation_error("Serialized array length is out of bounds");
+      } else if (static_cast<std::ptrdiff_t>(header_sizeof()) > total_size) {
+        if (silent) return false;
+        else throw validation_error("Serialized array header is truncated");
       }
 
-      // The array reports a reasonable length,
-      // so now check if the vtable is within bounds.
-      auto* vtable_end = raw_vtable() + (size() * sizeof(array_entry));
+      // The array reports a reasonable length, but wide arrays carry a full 64-bit count,
+      // so make sure the count can't overflow the vtable length before checking its bounds.
+      auto const max_entries = (static_cast<size_t>(total_size) - header_sizeof()) / entry_sizeof();
+      if (size() > max_entries) {
+        if (silent) return false;
+        else throw validation_error("Serialized array vtable length is out of bounds");
+      }
+      auto* vtable_end = raw_vtable() + (size() * entry_sizeof());
       if (vtable_end - DART_FROM_THIS > total_size) {
         if (silent) return false;
         else throw validation_error("Serialized array vtable length is out of bounds");
@@ -302,34 +394,43 @@ namespace dart {
 
       // We now know that the vtable is fully within bounds, but it could still be full of crap
       // Check that every element in the vtable has a valid type
-      for (size_t i = 0; i < size(); ++i) {
-        if (!valid_type(vtable()[i].get_type())) {
-          if (silent) return false;
-          else throw validation_error("Serialized object value is of no known type");
+      // Packed arrays have no vtable, and we already checked the type of their elements.
+      auto const types_valid = fmt == layout_format::packed || visit_vtable([&] (auto const* entries) {
+        for (size_t i = 0; i < size(); ++i) {
+          if (!valid_type(entries[i].get_type())) return false;
         }
+        return true;
+      });
+      if (!types_valid) {
+        if (silent) return false;
+        else throw validation_error("Serialized object value is of no known type");
       }
 
       // We now know the entire vtable is within bounds,
       // so iterate over it and check all contained children.
+      // Strings can be shared (see string_policy::shared), so they're allowed to point back at
+      // anything past the vtable, which is safe as strings can't point anywhere themselves.
       void const* prev = this;
       for (auto raw_val : *this) {
         // Load the base address of the value and verify that it's within bounds.
         auto val_offset = raw_val.buffer - DART_FROM_THIS;
+        auto const shared = raw_val.buffer <= prev
+          && simplify_type(raw_val.type) == detail::type::string && raw_val.buffer >= vtable_end;
         if (val_offset > total_size) {
           if (silent) return false;
           else throw validation_error("Serialized array value offset is out of bounds");
-        } else if (raw_val.buffer <= prev) {
+        } else if (raw_val.buffer <= prev && !shared) {
           if (silent) return false;
           else throw validation_error("Serialized array value contained a negative or cyclic offset");
         } else if (align_pointer<RefCount>(raw_val.buffer, raw_val.type) != raw_val.buffer) {
           if (silent) return false;
           else throw validation_error("Serialized array value offset does not meet alignment requirements");
         }
-        prev = raw_val.buffer;
+        if (!shared) prev = raw_val.buffer;
 
         // We now know that at least up to the base of the value is within bounds, so recurse on the value.
         // If the buffer validation routine returns false, it means we're not throwing errors.
-        auto valid_val = valid_buffer<silent, RefCount>(raw_val, total_size - val_offset);
+        auto valid_val = valid_buffer<silent, RefCount>(raw_val, total_size - val_offset, dict);
         if (!valid_val) return false;
       }
       return true;
@@ -343,12 +444,19 @@ namespace dart {
 
     template <template <class> class RefCount>
     size_t array<RefCount>::size() const noexcept {
-      return elems;
+      if (is_wide(format())) return get_wide_header()->elems;
+      else return elems & size_mask;
     }
 
     template <template <class> class RefCount>
     size_t array<RefCount>::get_sizeof() const noexcept {
-      return bytes;
+      if (is_wide(format())) return get_wide_header()->bytes & wide_header::size_mask;
+      else return bytes;
+    }
+
+    template <template <class> class RefCount>
+    layout_format array<RefCount>::format() const noexcept {
+      return layout_format(elems >> format_shift);
     }
 
     template <template <class> class RefCount>
@@ -372,7 +480,47 @@ namespace dart {
     }
 
     template <template <class> class RefCount>
-    auto array<RefCount>::load_elem(gsl::byte const* base, size_t idx) noexcept
+    template <class Callback>
+    void array<RefCount>::for_each_elem(Callback&& cb) const {
+      if (format() == layout_format::packed) {
+        auto const type = packed_type();
+        auto const stride = alignment_of<RefCount>(type);
+        auto const* curr = raw_vtable();
+        for (size_t idx = 0, len = size(); idx < len; ++idx, curr += stride) cb(raw_element {type, curr});
+        return;
+      }
+
+      gsl::byte const* const base = DART_FROM_THIS;
+      visit_vtable([&] (auto const* entries) {
+        for (size_t idx = 0, len = size(); idx < len; ++idx) {
+          auto const& entry = entries[idx];
+          cb(raw_element {entry.get_type(), base + entry.get_offset()});
+        }
+      });
+    }
+
+    template <template <class> class RefCount>
+    bool array<RefCount>::is_packed(raw_type type) const noexcept {
+      return format() == layout_format::packed && packed_type() == type;
+    }
+
+    template <template <class> class RefCount>
+    template <class T>
+    gsl::span<T const> array<RefCount>::as_span() const {
+      static_assert(DART_BYTE_ORDER == DART_LITTLE_ENDIAN,
+          "dart::buffer can only view packed arrays in place on little endian hosts");
+
+      // Empty arrays are trivially a span of anything, packed or not.
+      if (!size()) {
+        return {};
+      } else if (!is_packed(packed_element<T>::value)) {
+        throw type_error("dart::buffer is not an array packed with elements of the requested type");
+      }
+      return gsl::make_span(shim::launder(reinterpret_cast<T const*>(raw_vtable())), size());
+    }
+
+    template <template <class> class RefCount>
+    auto array<RefCount>::load_elem(gsl::byte const* base, size_t idx, dictionary_storage const*) noexcept
       -> typename ll_iterator<RefCount>::value_type
     {
       return get_array<RefCount>({raw_type::array, base})->get_elem(idx);
@@ -382,8 +530,14 @@ namespace dart {
     auto array<RefCount>::get_elem_impl(size_t index, bool throw_if_absent) const -> raw_element {
       // Grab the value, or null, if the index is out of range.
       if (index < size()) {
-        auto const& meta = vtable()[index];
-        return {meta.get_type(), DART_FROM_THIS + meta.get_offset()};
+        if (format() == layout_format::packed) {
+          auto const type = packed_type();
+          return {type, raw_vtable() + index * alignment_of<RefCount>(type)};
+        }
+        return visit_vtable([&] (auto const* entries) -> raw_element {
+          auto const& meta = entries[index];
+          return {meta.get_type(), DART_FROM_THIS + meta.get_offset()};
+        });
       } else if (!throw_if_absent) {
         return {raw_type::null, nullptr};
       } else {
@@ -392,25 +546,106 @@ namespace dart {
     }
 
     template <template <class> class RefCount>
-    array_entry* array<RefCount>::vtable() noexcept {
-      auto* base = DART_FROM_THIS_MUT + sizeof(bytes) + sizeof(elems);
-      return shim::launder(reinterpret_cast<array_entry*>(base));
+    gsl::byte* array<RefCount>::init_packed(raw_type packed) noexcept {
+      // Record the type of our elements where the vtable would otherwise start.
+      // The rest of the word is padding, and so must be zeroed (see zero_align_pointer).
+      set_format(layout_format::packed);
+      auto* type = DART_FROM_THIS_MUT + header_len;
+      std::fill(type, raw_vtable(), gsl::byte {});
+      *type = static_cast<gsl::byte>(packed);
+      return raw_vtable();
+    }
+
+    template <template <class> class RefCount>
+    void array<RefCount>::set_format(layout_format fmt) noexcept {
+      set_format(fmt, size());
+    }
+
+    template <template <class> class RefCount>
+    void array<RefCount>::set_format(layout_format fmt, size_t count) noexcept {
+      if (is_wide(fmt)) {
+        // The wide header overlaps the standard one, and our caller already read out our size.
+        auto* header = get_wide_header();
+        header->bytes = static_cast<uint64_t>(fmt) << wide_header::format_shift;
+        header->elems = count;
+      } else {
+        elems = (static_cast<uint32_t>(count) & size_mask) | (static_cast<uint32_t>(fmt) << format_shift);
+      }
+    }
+
+    template <template <class> class RefCount>
+    void array<RefCount>::set_sizeof(size_t len) noexcept {
+      if (is_wide(format())) {
+        auto* header = get_wide_header();
+        header->bytes = len | (static_cast<uint64_t>(format()) << wide_header::format_shift);
+      } else {
+        bytes = static_cast<uint32_t>(len);
+      }
+    }
+
+    template <template <class> class RefCount>
+    size_t array<RefCount>::packed_sizeof(raw_type packed, size_t count) noexcept {
+      return packed_header_len + count * alignment_of<RefCount>(packed);
+    }
+
+    template <template <class> class RefCount>
+    size_t array<RefCount>::header_sizeof() const noexcept {
+      auto const fmt = format();
+      if (is_wide(fmt)) return sizeof(wide_header);
+      else if (fmt == layout_format::packed) return packed_header_len;
+      else return header_len;
+    }
+
+    template <template <class> class RefCount>
+    size_t array<RefCount>::entry_sizeof() const noexcept {
+      // Elements of packed arrays take up exactly their own width.
+      if (format() == layout_format::packed) return alignment_of<RefCount>(packed_type());
+      return visit_vtable([] (auto const* entries) { return sizeof(*entries); });
+    }
+
+    template <template <class> class RefCount>
+    raw_type array<RefCount>::packed_type() const noexcept {
+      return static_cast<raw_type>(DART_FROM_THIS[header_len]);
+    }
+
+    template <template <class> class RefCount>
+    template <class Callback>
+    decltype(auto) array<RefCount>::visit_vtable(Callback&& cb) const {
+      if (is_compact(format())) return cb(vtable<compact_array_entry>());
+      else if (is_wide(format())) return cb(vtable<wide_array_entry>());
+      else return cb(vtable<array_entry>());
+    }
+
+    template <template <class> class RefCount>
+    template <class Entry>
+    Entry* array<RefCount>::vtable() noexcept {
+      return shim::launder(reinterpret_cast<Entry*>(raw_vtable()));
     }
 
     template <template <class> class RefCount>
-    array_entry const* array<RefCount>::vtable() const noexcept {
-      auto* base = DART_FROM_THIS + sizeof(bytes) + sizeof(elems);
-      return shim::launder(reinterpret_cast<array_entry const*>(base));
+    template <class Entry>
+    Entry const* array<RefCount>::vtable() const noexcept {
+      return shim::launder(reinterpret_cast<Entry const*>(raw_vtable()));
     }
 
     template <template <class> class RefCount>
     gsl::byte* array<RefCount>::raw_vtable() noexcept {
-      return DART_FROM_THIS_MUT + sizeof(bytes) + sizeof(elems);
+      return DART_FROM_THIS_MUT + header_sizeof();
     }
 
     template <template <class> class RefCount>
     gsl::byte const* array<RefCount>::raw_vtable() const noexcept {
-      return DART_FROM_THIS + sizeof(bytes) + sizeof(elems);
+      return DART_FROM_THIS + header_sizeof();
+    }
+
+    template <template <class> class RefCount>
+    wide_header* array<RefCount>::get_wide_header() noexcept {
+      return shim::launder(reinterpret_cast<wide_header*>(DART_FROM_THIS_MUT));
+    }
+
+    template <template <class> class RefCount>
+    wide_header const* array<RefCount>::get_wide_header() const noexcept {
+      return shim::launder(reinterpret_cast<wide_header const*>(DART_FROM_THIS));
     }
 
   }
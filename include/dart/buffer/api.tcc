@@ -54,10 +54,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   basic_buffer<RefCount>::operator view() const& noexcept {
-    view tmp;
-    tmp.raw = raw;
-    tmp.buffer_ref = typename view::ref_type {buffer_ref.raw()};
-    return tmp;
+    return make_view(raw);
   }
 
   template <template <class> class RefCount>
@@ -185,6 +182,8 @@ namespace dart {
   template <template <class> class RefCount>
   template <template <class> class NewCount>
   basic_buffer<NewCount> basic_buffer<RefCount>::transmogrify(basic_buffer const& buffer) {
+    auto dict = buffer.dictionary();
+    if (!dict.empty()) return basic_buffer<NewCount> {buffer.get_bytes(), dict};
     return basic_buffer<NewCount> {buffer.dup_bytes()};
   }
 
@@ -252,6 +251,13 @@ namespace dart {
     return gsl::make_span(raw.buffer, len);
   }
 
+  template <template <class> class RefCount>
+  key_dictionary basic_buffer<RefCount>::dictionary() const {
+    auto* handle = detail::find_dictionary<RefCount>(buffer_ref.get());
+    if (!handle) return key_dictionary {};
+    return detail::dictionary_access::make(*handle);
+  }
+
   template <template <class> class RefCount>
   size_t basic_buffer<RefCount>::share_bytes(RefCount<gsl::byte const>& bytes) const {
     if (is_null()) throw type_error("dart::buffer is null and has no network buffer");
@@ -300,6 +306,13 @@ namespace dart {
     return size() == 0ULL;
   }
 
+  template <template <class> class RefCount>
+  size_t basic_buffer<RefCount>::hash() const noexcept {
+    // Nested objects may be keyed even if we aren't, so look the dictionary up once, up front.
+    auto const* dict = is_aggregate() ? load_dictionary() : nullptr;
+    return static_cast<size_t>(detail::hash_raw<RefCount>(raw, dict));
+  }
+
   template <template <class> class RefCount>
   bool basic_buffer<RefCount>::is_object() const noexcept {
     return detail::simplify_type(raw.type) == type::object;
@@ -399,9 +412,25 @@ namespace dart {
     return reverse_iterator {begin()};
   }
 
+  template <template <class> class RefCount>
+  template <class Callback>
+  void basic_buffer<RefCount>::for_each_pair(Callback&& cb) const {
+    auto const* obj = detail::get_object<RefCount>(raw);
+    obj->for_each_pair([&] (auto key, auto val) {
+      cb(make_view(key), make_view(val));
+    }, get_dictionary(obj));
+  }
+
+  template <template <class> class RefCount>
+  template <class Callback>
+  void basic_buffer<RefCount>::for_each_elem(Callback&& cb) const {
+    detail::get_array<RefCount>(raw)->for_each_elem([&] (auto elem) { cb(make_view(elem)); });
+  }
+
   template <template <class> class RefCount>
   auto basic_buffer<RefCount>::key_begin() const -> iterator {
-    return iterator(*this, detail::get_object<RefCount>(raw)->key_begin());
+    auto const* obj = detail::get_object<RefCount>(raw);
+    return iterator(*this, obj->key_begin(get_dictionary(obj)));
   }
 
   template <template <class> class RefCount>
@@ -411,7 +440,8 @@ namespace dart {
 
   template <template <class> class RefCount>
   auto basic_buffer<RefCount>::key_end() const -> iterator {
-    return iterator(*this, detail::get_object<RefCount>(raw)->key_end());
+    auto const* obj = detail::get_object<RefCount>(raw);
+    return iterator(*this, obj->key_end(get_dictionary(obj)));
   }
 
   template <template <class> class RefCount>
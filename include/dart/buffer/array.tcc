@@ -141,6 +141,18 @@ namespace dart {
     return std::move(*this);
   }
 
+  template <template <class> class RefCount>
+  template <class T>
+  bool basic_buffer<RefCount>::is_packed() const noexcept {
+    return is_array() && detail::get_array<RefCount>(raw)->is_packed(detail::packed_element<T>::value);
+  }
+
+  template <template <class> class RefCount>
+  template <class T>
+  gsl::span<T const> basic_buffer<RefCount>::as_span() const {
+    return detail::get_array<RefCount>(raw)->template as_span<T>();
+  }
+
   template <template <class> class RefCount>
   auto basic_buffer<RefCount>::capacity() const -> size_type {
     return size();
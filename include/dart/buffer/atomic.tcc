@@ -0,0 +1,55 @@
+#ifndef DART_BUFFER_ATOMIC_H
+#define DART_BUFFER_ATOMIC_H
+
+/*----- Project Includes -----*/
+
+#include "../common.h"
+
+/*----- Function Implementations -----*/
+
+namespace dart {
+
+  template <template <class> class RefCount>
+  basic_atomic_buffer<RefCount>::basic_atomic_buffer(buffer_type buf) :
+    current(std::move(buf)),
+    generation(0)
+  {}
+
+  template <template <class> class RefCount>
+  auto basic_atomic_buffer<RefCount>::load() const -> buffer_type {
+    return current.load();
+  }
+
+  template <template <class> class RefCount>
+  auto basic_atomic_buffer<RefCount>::load_view() const noexcept -> view_type {
+    // The pinned version outlives any store until this thread pins something else.
+    auto const* curr = current.pin();
+    if (!curr) return view_type {};
+    return *curr;
+  }
+
+  template <template <class> class RefCount>
+  auto basic_atomic_buffer<RefCount>::exchange(buffer_type buf) -> buffer_type {
+    auto prev = current.exchange(std::move(buf));
+    generation.fetch_add(1, std::memory_order_release);
+    return prev;
+  }
+
+  template <template <class> class RefCount>
+  void basic_atomic_buffer<RefCount>::store(buffer_type buf) {
+    exchange(std::move(buf));
+  }
+
+  template <template <class> class RefCount>
+  uint64_t basic_atomic_buffer<RefCount>::version() const noexcept {
+    return generation.load(std::memory_order_acquire);
+  }
+
+  template <template <class> class RefCount>
+  void basic_atomic_buffer<RefCount>::trim() noexcept {
+    publisher<buffer_type>::unpin();
+  }
+
+}
+
+#endif
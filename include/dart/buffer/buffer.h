@@ -18,4 +18,7 @@
 #include "string.tcc"
 #include "primitive.tcc"
 
+// Atomic publication API functions
+#include "atomic.tcc"
+
 #endif
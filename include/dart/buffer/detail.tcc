@@ -25,9 +25,61 @@ namespace dart {
     auto owner = detail::aligned_alloc<RefCount>(buffer.size(), detail::raw_type::object, [&] (auto* bytes) {
       std::copy(std::begin(buffer), std::end(buffer), bytes);
     });
+    return buffer_ref_type {check_keyed(std::move(owner))};
+  }
+
+  template <template <class> class RefCount>
+  auto basic_buffer<RefCount>::allocate_pointer(gsl::span<gsl::byte const> buffer,
+      key_dictionary const& dict) const -> buffer_ref_type
+  {
+    if (buffer.empty()) throw std::invalid_argument("dart::packet buffer must not be empty");
+
+    // Copy the data into a new buffer, alongside the dictionary it was keyed against.
+    auto owner = detail::keyed_alloc<RefCount>(buffer.size(),
+        detail::dictionary_access::get(dict), [&] (auto* bytes) {
+      std::copy(std::begin(buffer), std::end(buffer), bytes);
+    });
+
+    // Make sure it's the dictionary the packet was actually keyed against.
+    auto const* obj = detail::get_object<RefCount>({detail::raw_type::object, owner.get()});
+    if (obj->format() == detail::layout_format::dictionary && obj->dictionary_version() != dict.version()) {
+      throw std::invalid_argument("dart::packet buffer is keyed against a different dictionary");
+    }
     return buffer_ref_type {std::move(owner)};
   }
 
+  template <template <class> class RefCount>
+  template <class Pointer>
+  Pointer&& basic_buffer<RefCount>::check_keyed(Pointer&& ptr) const {
+    // Packets keyed against a dictionary can only be reconstituted alongside it.
+    auto const* obj = detail::get_object<RefCount>({detail::raw_type::object, ptr.get()});
+    if (obj->format() == detail::layout_format::dictionary) {
+      throw std::invalid_argument("dart::packet buffer is keyed against a dictionary that was not provided");
+    }
+    return std::forward<Pointer>(ptr);
+  }
+
+  template <template <class> class RefCount>
+  auto basic_buffer<RefCount>::get_dictionary(detail::object<RefCount> const* obj) const noexcept
+    -> detail::dictionary_storage const*
+  {
+    // Only objects keyed against a dictionary need it, so don't go looking for it otherwise.
+    if (DART_UNLIKELY(obj->format() == detail::layout_format::dictionary)) return load_dictionary();
+    else return nullptr;
+  }
+
+  template <template <class> class RefCount>
+  auto basic_buffer<RefCount>::lazy_dictionary() const noexcept -> detail::dictionary_ref {
+    // Lookups leave it to the object being searched to decide whether it needs the dictionary.
+    return detail::dictionary_ref::from_root(buffer_ref.get());
+  }
+
+  template <template <class> class RefCount>
+  DART_NOINLINE auto basic_buffer<RefCount>::load_dictionary() const noexcept -> detail::dictionary_storage const* {
+    auto* handle = detail::find_dictionary<RefCount>(buffer_ref.get());
+    return handle ? handle->get() : nullptr;
+  }
+
   template <template <class> class RefCount>
   template <class Pointer>
   Pointer&& basic_buffer<RefCount>::validate_pointer(Pointer&& ptr) const {
@@ -37,7 +89,7 @@ namespace dart {
     } else if (detail::align_pointer<RefCount>(ptr.get(), detail::raw_type::object) != ptr.get()) {
       throw std::invalid_argument("dart::packet pointer must be aligned to a 64-bit word boundary");
     }
-    return std::forward<Pointer>(ptr);
+    return check_keyed(std::forward<Pointer>(ptr));
   }
 
   template <template <class> class RefCount>
@@ -51,6 +103,14 @@ namespace dart {
     return tmp;
   }
 
+  template <template <class> class RefCount>
+  auto basic_buffer<RefCount>::make_view(detail::raw_element elem) const noexcept -> view {
+    view tmp;
+    tmp.raw = elem;
+    tmp.buffer_ref = typename view::ref_type {buffer_ref.raw()};
+    return tmp;
+  }
+
   template <template <class> class RefCount>
   template <class Span>
   basic_buffer<RefCount> basic_buffer<RefCount>::dynamic_make_object(Span pairs) {
@@ -92,6 +92,24 @@ namespace dart {
     return detail::buffer_builder<RefCount>::project_keys(*this, keys);
   }
 
+  template <template <class> class RefCount>
+  template <bool enabled, class EnableIf>
+  basic_buffer<RefCount> basic_buffer<RefCount>::merge(std::initializer_list<basic_buffer> objs) {
+    return detail::buffer_builder<RefCount>::merge_many(gsl::make_span(objs.begin(), objs.size()));
+  }
+
+  template <template <class> class RefCount>
+  template <bool enabled, class EnableIf>
+  basic_buffer<RefCount> basic_buffer<RefCount>::merge(gsl::span<basic_buffer const> objs) {
+    return detail::buffer_builder<RefCount>::merge_many(objs);
+  }
+
+  template <template <class> class RefCount>
+  template <bool enabled, class EnableIf>
+  basic_buffer<RefCount> basic_buffer<RefCount>::deep_merge(basic_buffer const& incoming) const {
+    return detail::buffer_builder<RefCount>::deep_merge_buffers(*this, incoming);
+  }
+
   template <template <class> class RefCount>
   template <class String>
   basic_buffer<RefCount> basic_buffer<RefCount>::operator [](basic_string<String> const& key) const& {
@@ -129,17 +147,27 @@ namespace dart {
 
   template <template <class> class RefCount>
   basic_buffer<RefCount> basic_buffer<RefCount>::get(shim::string_view key) const& {
-    return basic_buffer(detail::get_object<RefCount>(raw)->get_value(key), buffer_ref);
+    return basic_buffer(detail::get_object<RefCount>(raw)->get_value(key, lazy_dictionary()), buffer_ref);
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_buffer<RefCount>&& basic_buffer<RefCount>::get(shim::string_view key) && {
-    raw = detail::get_object<RefCount>(raw)->get_value(key);
+    raw = detail::get_object<RefCount>(raw)->get_value(key, lazy_dictionary());
     if (is_null()) buffer_ref = nullptr;
     return std::move(*this);
   }
 
+  template <template <class> class RefCount>
+  basic_buffer<RefCount> basic_buffer<RefCount>::get(key_dictionary::key const& key) const& {
+    return basic_buffer(detail::get_object<RefCount>(raw)->get_value(key, lazy_dictionary()), buffer_ref);
+  }
+
+  template <template <class> class RefCount>
+  basic_buffer<RefCount> basic_buffer<RefCount>::operator [](key_dictionary::key const& key) const& {
+    return get(key);
+  }
+
   template <template <class> class RefCount>
   basic_buffer<RefCount> basic_buffer<RefCount>::get_nested(shim::string_view path, char separator) const {
     return detail::get_nested_impl(*this, path, separator);
@@ -159,13 +187,13 @@ namespace dart {
 
   template <template <class> class RefCount>
   basic_buffer<RefCount> basic_buffer<RefCount>::at(shim::string_view key) const& {
-    return basic_buffer(detail::get_object<RefCount>(raw)->at_value(key), buffer_ref);
+    return basic_buffer(detail::get_object<RefCount>(raw)->at_value(key, lazy_dictionary()), buffer_ref);
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_buffer<RefCount>&& basic_buffer<RefCount>::at(shim::string_view key) && {
-    raw = detail::get_object<RefCount>(raw)->at_value(key);
+    raw = detail::get_object<RefCount>(raw)->at_value(key, lazy_dictionary());
     if (is_null()) buffer_ref = nullptr;
     return std::move(*this);
   }
@@ -178,7 +206,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   auto basic_buffer<RefCount>::find(shim::string_view key) const -> iterator {
-    return iterator(*this, detail::get_object<RefCount>(raw)->get_it(key));
+    return iterator(*this, detail::get_object<RefCount>(raw)->get_it(key, lazy_dictionary()));
   }
 
   template <template <class> class RefCount>
@@ -189,7 +217,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   auto basic_buffer<RefCount>::find_key(shim::string_view key) const -> iterator {
-    return iterator(*this, detail::get_object<RefCount>(raw)->get_key_it(key));
+    return iterator(*this, detail::get_object<RefCount>(raw)->get_key_it(key, lazy_dictionary()));
   }
 
   template <template <class> class RefCount>
@@ -205,7 +233,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   bool basic_buffer<RefCount>::has_key(shim::string_view key) const {
-    auto elem = detail::get_object<RefCount>(raw)->get_key(key, [] (auto) {});
+    auto elem = detail::get_object<RefCount>(raw)->get_key(key, [] (auto) {}, lazy_dictionary());
     return elem.buffer != nullptr;
   }
 
@@ -15,6 +15,9 @@
 
 #include <map>
 #include <vector>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <math.h>
 #include <gsl/gsl>
 #include <errno.h>
@@ -40,6 +43,8 @@
 #include "shim.h"
 #include "meta.h"
 #include "support/ptrs.h"
+#include "support/pool.h"
+#include "support/publisher.h"
 #include "support/ordered.h"
 
 /*----- System Includes with Compiler Flags -----*/
@@ -106,6 +111,227 @@ namespace dart {
     validation_error(char const* msg) : runtime_error(msg) {}
   };
 
+  /**
+   *  @brief
+   *  Enum selects which bytes of each key are cached in the vtables of finalized objects.
+   *
+   *  @details
+   *  Finalized objects binary search their vtables, which cache a couple of bytes of every key
+   *  so that lookup only has to touch the keys themselves once it's found a likely match.
+   *  prefix_policy::leading caches the first bytes of every key, and is the default.
+   *  prefix_policy::discriminating caches the bytes following whatever prefix the keys of an
+   *  object share (think "metric.cpu.user", "metric.cpu.sys"), which keeps lookups inside the
+   *  vtable for keyspaces the default serves poorly, at the cost of 8 bytes per object.
+   *  The prefix is measured over the largest group of same-length keys that shares one,
+   *  and only skipped for keys with lengths near theirs, so unrelated keys don't defeat it.
+   */
+  enum class prefix_policy : uint8_t {
+    leading,
+    discriminating
+  };
+
+  /**
+   *  @brief
+   *  Enum selects how wide the offsets stored in the vtables of finalized aggregates are.
+   *
+   *  @details
+   *  offset_policy::standard stores 32-bit offsets, and is the default.
+   *  offset_policy::automatic stores 16-bit offsets, in packed vtable entries, for every aggregate
+   *  small enough to be addressed that way, and falls back on the standard width for the rest.
+   *  For the small packets typical of most messaging workloads this saves two bytes for every
+   *  field, and four for every array element, without changing how values are read.
+   *  offset_policy::wide stores 64-bit offsets for every aggregate, which is otherwise only done
+   *  for aggregates too large to address with 32-bit offsets (whatever the policy).
+   */
+  enum class offset_policy : uint8_t {
+    standard,
+    automatic,
+    wide
+  };
+
+  /**
+   *  @brief
+   *  Enum selects how finalized arrays of scalars are laid out.
+   *
+   *  @details
+   *  array_policy::standard lays out every array with a vtable entry per element, and is the default.
+   *  array_policy::packed lays out non-empty arrays whose elements are all integers, all decimals,
+   *  or all booleans as a contiguous run of int64_t, double, or bool, with no vtable at all.
+   *  Elements read the same either way, but packed arrays take roughly half the space,
+   *  and can be viewed in place as a gsl::span (see dart::buffer::as_span).
+   */
+  enum class array_policy : uint8_t {
+    standard,
+    packed
+  };
+
+  /**
+   *  @brief
+   *  Enum selects whether finalized aggregates store repeated strings more than once.
+   *
+   *  @details
+   *  string_policy::standard lays out every string in full, and is the default.
+   *  string_policy::shared lays out each distinct string an aggregate holds once, and points every
+   *  other occurrence of it at the same bytes, which can save a lot of space for enum-like values.
+   *  Arrays, and objects keyed against a dictionary, point their vtable entries straight at the
+   *  earlier copy. Every other object stores its values directly after their keys, so a repeat
+   *  stores the offset of the earlier copy there instead, and is flagged as such in the vtable.
+   *  Strings shorter than twice the width of that offset aren't worth pointing at, and are
+   *  laid out in full regardless.
+   *  Strings are never shared between aggregates, so that any of them can still be copied out
+   *  of the packet on its own (see dart::buffer::get_bytes).
+   */
+  enum class string_policy : uint8_t {
+    standard,
+    shared
+  };
+
+  namespace detail {
+    struct dictionary_storage;
+    struct dictionary_access;
+  }
+
+  /**
+   *  @brief
+   *  Class is an immutable, shared, set of keys that finalized objects can refer to by id
+   *  instead of storing the keys themselves.
+   *
+   *  @details
+   *  Streams of packets that share a schema repeat the same keys in every single buffer,
+   *  which, for small records, can easily account for half of their size.
+   *  Buffers finalized against a dictionary (see finalize_options::dictionary) store a 16-bit id
+   *  in place of every key the dictionary contains, and record the version of the dictionary
+   *  they were written against, so that readers can refuse to interpret them against any other.
+   *  Keys can also be resolved against a dictionary ahead of time (see key_dictionary::lookup),
+   *  in which case looking them up in buffers keyed against the same dictionary compares
+   *  integers instead of strings.
+   *
+   *  @remarks
+   *  The version of a dictionary is a fingerprint of its keys, so dictionaries built
+   *  independently out of the same keys (in any order) are interchangeable.
+   *  Copies are cheap, and share the same underlying storage.
+   */
+  class key_dictionary {
+
+    public:
+
+      /*----- Public Types -----*/
+
+      using size_type = size_t;
+
+      /**
+       *  @brief
+       *  Class represents a key that has already been resolved against a dictionary.
+       *
+       *  @details
+       *  Keeps the dictionary it was resolved against alive, and can be used to look up values
+       *  in any object, although it's only faster than a plain string for objects keyed
+       *  against the same dictionary.
+       */
+      class key {
+
+        public:
+
+          /*----- Lifecycle Functions -----*/
+
+          key() = delete;
+          key(key const&) = default;
+          key(key&&) noexcept = default;
+          ~key() = default;
+
+          /*----- Operators -----*/
+
+          key& operator =(key const&) = default;
+          key& operator =(key&&) noexcept = default;
+
+          /*----- Public API -----*/
+
+          shim::string_view strv() const noexcept;
+          uint16_t id() const noexcept;
+          uint64_t version() const noexcept;
+
+        private:
+
+          /*----- Private Lifecycle Functions -----*/
+
+          key(std::shared_ptr<detail::dictionary_storage const> impl, uint16_t id) noexcept;
+
+          /*----- Private Members -----*/
+
+          std::shared_ptr<detail::dictionary_storage const> impl;
+          uint16_t idx;
+
+          /*----- Friends -----*/
+
+          friend class key_dictionary;
+
+      };
+
+      /*----- Lifecycle Functions -----*/
+
+      key_dictionary() = default;
+      key_dictionary(std::initializer_list<shim::string_view> keys);
+      explicit key_dictionary(gsl::span<shim::string_view const> keys);
+      explicit key_dictionary(gsl::span<std::string const> keys);
+      key_dictionary(key_dictionary const&) = default;
+      key_dictionary(key_dictionary&&) noexcept = default;
+      ~key_dictionary() = default;
+
+      /*----- Operators -----*/
+
+      key_dictionary& operator =(key_dictionary const&) = default;
+      key_dictionary& operator =(key_dictionary&&) noexcept = default;
+
+      bool operator ==(key_dictionary const& other) const noexcept;
+      bool operator !=(key_dictionary const& other) const noexcept;
+
+      /*----- Public API -----*/
+
+      size_type size() const noexcept;
+      bool empty() const noexcept;
+      uint64_t version() const noexcept;
+
+      bool contains(shim::string_view key) const noexcept;
+      key lookup(shim::string_view key) const;
+
+    private:
+
+      /*----- Private Lifecycle Functions -----*/
+
+      explicit key_dictionary(std::shared_ptr<detail::dictionary_storage const> impl) noexcept;
+
+      /*----- Private Members -----*/
+
+      std::shared_ptr<detail::dictionary_storage const> impl;
+
+      /*----- Friends -----*/
+
+      friend struct detail::dictionary_access;
+
+  };
+
+  /**
+   *  @brief
+   *  Struct collects the options that control how a packet is laid out when it's finalized.
+   *
+   *  @details
+   *  Finalized buffers record whatever they need to about how they were laid out,
+   *  so readers never need to know which options were used to write them.
+   *  The one exception is the dictionary, which buffers only record the version of,
+   *  and must be provided again when reconstituting them from their bytes.
+   *
+   *  @remarks
+   *  Not every option applies to every aggregate. In particular, string_policy::shared never
+   *  applies to packed arrays, which can't hold strings, nor to strings too short to point at.
+   */
+  struct finalize_options {
+    prefix_policy prefix = prefix_policy::leading;
+    offset_policy offsets = offset_policy::standard;
+    array_policy arrays = array_policy::standard;
+    string_policy strings = string_policy::standard;
+    key_dictionary dictionary;
+  };
+
   namespace detail {
 
     template <class T>
@@ -212,6 +438,89 @@ namespace dart {
       null
     };
 
+    /**
+     *  @brief
+     *  Version of the finalized network representation.
+     *
+     *  @details
+     *  Exported through the ABI so that readers that decode buffers directly
+     *  (see abi_fast.h) can detect when they no longer understand the layout.
+     *  Must be bumped whenever the finalized representation changes.
+     *  Since version 7, the key length cached in object vtable entries is exact,
+     *  even for keys with embedded nulls, and readers use it to find values.
+     *  Since version 8, keyed objects only skip over the leading bytes of keys
+     *  whose lengths fall inside of the range recorded after the skip.
+     *  Since version 9, the top bit of the type of an object vtable entry flags
+     *  a value that was shared with an earlier copy (see string_policy::shared).
+     */
+    constexpr uint32_t buffer_layout_version = 9;
+
+    /**
+     *  @brief
+     *  Alternative encodings a finalized aggregate can be laid out in.
+     *
+     *  @details
+     *  Recorded in the top three bits of an aggregate's element count, which are always
+     *  zero in the standard encoding (every element costs at least eight bytes of vtable,
+     *  and aggregates are capped at 4GB), so buffers written before alternative encodings
+     *  existed are still read correctly.
+     *  The lowest bit records whether an object carries a key extension (see prefix_policy),
+     *  the bits above it record the width of the offsets in its vtable (see offset_policy).
+     *  Wide aggregates widen their header to a pair of 64-bit integers, and record their
+     *  encoding in the top three bits of their length instead, which keeps it in the same byte.
+     *  Packed arrays have no vtable, and instead record the type of their elements in the
+     *  8 bytes following their header, after which the elements themselves are stored back to back.
+     *  Objects keyed against a dictionary record its version in the 8 bytes following their header,
+     *  and don't fit the bit pattern above (they always use 32-bit offsets, and never skip prefixes).
+     */
+    enum class layout_format : uint8_t {
+      standard,
+      keyed,
+      compact,
+      compact_keyed,
+      wide,
+      wide_keyed,
+      packed,
+      dictionary
+    };
+
+    constexpr bool is_keyed(layout_format fmt) noexcept {
+      return fmt != layout_format::dictionary && (static_cast<uint8_t>(fmt) & 1U);
+    }
+
+    constexpr layout_format offset_format(layout_format fmt) noexcept {
+      return layout_format(static_cast<uint8_t>(fmt) & ~1U);
+    }
+
+    constexpr bool is_compact(layout_format fmt) noexcept {
+      return offset_format(fmt) == layout_format::compact;
+    }
+
+    constexpr bool is_wide(layout_format fmt) noexcept {
+      return offset_format(fmt) == layout_format::wide;
+    }
+
+    // Maps the C++ types packed arrays can be viewed as onto the types of their elements.
+    // Defined, but empty, for every other type, so that it can be detected.
+    template <class T>
+    struct packed_element {};
+    template <>
+    struct packed_element<int16_t> : std::integral_constant<raw_type, raw_type::short_integer> {};
+    template <>
+    struct packed_element<int32_t> : std::integral_constant<raw_type, raw_type::integer> {};
+    template <>
+    struct packed_element<int64_t> : std::integral_constant<raw_type, raw_type::long_integer> {};
+    template <>
+    struct packed_element<float> : std::integral_constant<raw_type, raw_type::decimal> {};
+    template <>
+    struct packed_element<double> : std::integral_constant<raw_type, raw_type::long_decimal> {};
+    template <>
+    struct packed_element<bool> : std::integral_constant<raw_type, raw_type::boolean> {};
+
+    constexpr bool is_packable(raw_type type) noexcept {
+      return type >= raw_type::short_integer && type <= raw_type::boolean;
+    }
+
     /**
      *  @brief
      *  Used internally in scenarios where two dart types aren't contained within
@@ -341,27 +650,61 @@ namespace dart {
     template <template <class> class RefCount>
     using buffer_refcount_type = shareable_ptr<RefCount<gsl::byte const>>;
 
-    class prefix_entry;
-    template <class>
+    template <class Offset>
+    class basic_prefix_entry;
+    template <class, class Offset = uint32_t>
     struct table_layout {
-      using offset_type = uint32_t;
+      using offset_type = Offset;
       static constexpr auto max_offset = std::numeric_limits<offset_type>::max();
 
-      alignas(4) little_order<offset_type> offset;
-      alignas(4) little_order<uint8_t> type;
+      alignas(sizeof(offset_type)) little_order<offset_type> offset;
+      alignas(sizeof(offset_type)) little_order<uint8_t> type;
     };
-    template <>
-    struct table_layout<prefix_entry> {
-      using offset_type = uint32_t;
+    template <class Offset>
+    struct table_layout<basic_prefix_entry<Offset>, Offset> {
+      using offset_type = Offset;
       using prefix_type = uint16_t;
       static constexpr auto max_offset = std::numeric_limits<offset_type>::max();
 
-      alignas(4) little_order<uint32_t> offset;
+      alignas(sizeof(offset_type)) little_order<offset_type> offset;
       alignas(1) little_order<uint8_t> type;
       alignas(1) little_order<uint8_t> len;
       alignas(2) prefix_type prefix;
     };
 
+    class dictionary_entry;
+    template <>
+    struct table_layout<dictionary_entry, uint32_t> {
+      using offset_type = uint32_t;
+      static constexpr auto max_offset = std::numeric_limits<offset_type>::max();
+
+      alignas(4) little_order<uint32_t> offset;
+      alignas(1) little_order<uint8_t> type;
+      alignas(1) little_order<uint8_t> reserved;
+      alignas(2) little_order<uint16_t> id;
+    };
+
+    // Header of aggregates in the wide encoding, which replaces the usual pair of 32-bit integers.
+    struct wide_header {
+      static constexpr auto format_shift = 61U;
+      static constexpr auto size_mask = (1ULL << format_shift) - 1;
+
+      alignas(8) little_order<uint64_t> bytes;
+      alignas(8) little_order<uint64_t> elems;
+    };
+
+    // How many leading bytes the vtable of a keyed object skips over before caching each prefix.
+    // Only keys with lengths inside of the range share them, all others cache their leading bytes.
+    struct prefix_skip {
+      size_t for_length(size_t len) const noexcept {
+        return (len >= min_len && len <= max_len) ? skip : 0;
+      }
+
+      size_t skip;
+      size_t min_len;
+      size_t max_len;
+    };
+
     /**
      *  @brief
      *  Macro customizes functionality usually provided by assert().
@@ -373,14 +716,18 @@ namespace dart {
      *  @remarks
      *  Don't actually know if Doxygen lets you document macros, guess we'll see.
      */
-    template <class T>
+    template <class T, class Offset = uint32_t>
     class vtable_entry {
 
       public:
 
+        /*----- Public Types -----*/
+
+        using offset_type = Offset;
+
         /*----- Lifecycle Functions -----*/
 
-        vtable_entry(detail::raw_type type, uint32_t offset);
+        vtable_entry(detail::raw_type type, size_t offset);
         vtable_entry(vtable_entry const&) = default;
 
         /*----- Operators -----*/
@@ -390,7 +737,7 @@ namespace dart {
         /*----- Public API -----*/
 
         raw_type get_type() const noexcept;
-        uint32_t get_offset() const noexcept;
+        size_t get_offset() const noexcept;
 
         // This sucks, but we need it for dart::buffer::inject
         void adjust_offset(std::ptrdiff_t diff) noexcept;
@@ -399,7 +746,7 @@ namespace dart {
 
         /*----- Protected Members -----*/
 
-        table_layout<T> layout;
+        table_layout<T, Offset> layout;
 
     };
 
@@ -416,46 +763,128 @@ namespace dart {
      *  Although class inherts from vtable_entry, and can be safely
      *  be used as such, it remains a standard layout type due to some
      *  hackery with its internals.
+     *  Templated on the width of the offset it stores, which is the
+     *  only thing that differs between the encodings of an object vtable.
      */
-    class prefix_entry : public vtable_entry<prefix_entry> {
+    template <class Offset>
+    class basic_prefix_entry : public vtable_entry<basic_prefix_entry<Offset>, Offset> {
 
       public:
 
         /*----- Public Types -----*/
 
-        using prefix_type = table_layout<prefix_entry>::prefix_type;
+        using prefix_type = typename table_layout<basic_prefix_entry, Offset>::prefix_type;
 
         /*----- Lifecycle Functions -----*/
 
-        inline prefix_entry(detail::raw_type type, uint32_t offset, shim::string_view prefix) noexcept;
-        prefix_entry(prefix_entry const&) = default;
+        basic_prefix_entry(detail::raw_type type, size_t offset, shim::string_view key, size_t skip = 0) noexcept;
+        basic_prefix_entry(basic_prefix_entry const&) = default;
 
         /*----- Operators -----*/
 
-        prefix_entry& operator =(prefix_entry const&) = default;
+        basic_prefix_entry& operator =(basic_prefix_entry const&) = default;
 
         /*----- Public API -----*/
 
-        inline int prefix_compare(shim::string_view str) const noexcept;
+        // Function orders a key against this entry, given how many leading bytes of every key
+        // were skipped over when the prefix was cached.
+        int prefix_compare(shim::string_view str, size_t skip = 0) const noexcept;
+
+        // Function orders two entries using only what's stored in the vtable.
+        // Returns zero if the entries can't be told apart without consulting the full keys.
+        // Only meaningful for entries that were cached with the same skip over keys known
+        // to share that many leading bytes.
+        template <class OtherOffset>
+        int entry_compare(basic_prefix_entry<OtherOffset> const& other) const noexcept;
+
+        // Functions expose the key length cached in the vtable.
+        // The cached length is only authoritative if it isn't capped, in which
+        // case it can be used to find the value without touching the key itself.
+        size_t get_length() const noexcept;
+        bool is_capped() const noexcept;
+
+        // Functions expose whether the value of this entry was shared (see string_policy::shared),
+        // in which case the key is followed by the offset of an earlier copy of the value,
+        // aligned as an offset_type, instead of by the value itself.
+        // The flag is stored in the top bit of the type, which get_type strips back off.
+        raw_type get_type() const noexcept;
+        bool is_shared() const noexcept;
+        void set_shared() noexcept;
+
+        /*----- Public Members -----*/
+
+        static constexpr uint8_t shared_flag = 0x80;
 
       private:
 
         /*----- Private Helpers -----*/
 
-        inline int compare_impl(char const* const str, size_t const len) const noexcept;
+        int compare_impl(char const* const str, size_t const len) const noexcept;
 
         /*----- Private Types -----*/
 
         using storage_t = std::aligned_storage_t<sizeof(prefix_type), 4>;
 
+        /*----- Friends -----*/
+
+        template <class>
+        friend class basic_prefix_entry;
+
     };
 
-    using object_entry = prefix_entry;
+    /**
+     *  @brief
+     *  Class represents an entry in the vtable of an object keyed against a dictionary.
+     *
+     *  @details
+     *  Entries for keys the dictionary contains record the id of the key, and the offset
+     *  of the value itself, as the key isn't stored in the object at all.
+     *  Entries for any other key record inline_id instead, and the offset of the key, which
+     *  is stored, and followed by its value, exactly as it would be in the standard encoding.
+     *  Entries are sorted by id, which places the inline keys last, in the usual order.
+     */
+    class dictionary_entry : public vtable_entry<dictionary_entry> {
+
+      public:
+
+        /*----- Public Types -----*/
+
+        using id_type = uint16_t;
+
+        /*----- Lifecycle Functions -----*/
+
+        dictionary_entry(detail::raw_type type, size_t offset, size_t id) noexcept;
+        dictionary_entry(dictionary_entry const&) = default;
+
+        /*----- Operators -----*/
+
+        dictionary_entry& operator =(dictionary_entry const&) = default;
+
+        /*----- Public API -----*/
+
+        size_t get_id() const noexcept;
+        bool is_inline() const noexcept;
+
+        /*----- Public Members -----*/
+
+        static constexpr id_type inline_id = std::numeric_limits<id_type>::max();
+
+    };
+
+    using object_entry = basic_prefix_entry<uint32_t>;
+    using compact_object_entry = basic_prefix_entry<uint16_t>;
     using array_entry = vtable_entry<void>;
-    using object_layout = table_layout<prefix_entry>;
+    using compact_array_entry = vtable_entry<void, uint16_t>;
+    using wide_object_entry = basic_prefix_entry<uint64_t>;
+    using wide_array_entry = vtable_entry<void, uint64_t>;
+    using object_layout = table_layout<object_entry>;
     using array_layout = table_layout<void>;
+    using compact_layout = table_layout<void, uint16_t>;
     static_assert(std::is_standard_layout<array_entry>::value, "dart library is misconfigured");
     static_assert(std::is_standard_layout<object_entry>::value, "dart library is misconfigured");
+    static_assert(sizeof(compact_object_entry) == 6 && sizeof(compact_array_entry) == 4, "dart library is misconfigured");
+    static_assert(sizeof(wide_object_entry) == 16 && sizeof(wide_array_entry) == 16, "dart library is misconfigured");
+    static_assert(sizeof(dictionary_entry) == 8, "dart library is misconfigured");
 
     // Aliases for STL structures.
     template <template <class> class RefCount>
@@ -482,6 +911,81 @@ namespace dart {
       gsl::byte const* buffer;
     };
 
+    // Seeds and steps the 64-bit FNV-1a hash.
+    constexpr uint64_t fnv_offset_basis = 14695981039346656037ULL;
+    inline uint64_t fnv1a(uint64_t hash, void const* data, size_t len) noexcept;
+
+    /**
+     *  @brief
+     *  Struct holds the keys of a dart::key_dictionary.
+     *
+     *  @details
+     *  Keys are sorted in the order finalized objects sort them (length first, then bytes),
+     *  and each key's id is its position in that order, so objects can sort their keys by id
+     *  without ever looking at them.
+     *  Keys are laid out back to back, in the same format finalized objects store them in,
+     *  so that iteration can hand them out as raw_elements exactly as it does inline keys.
+     */
+    struct strv_hasher {
+      size_t operator ()(shim::string_view key) const noexcept;
+    };
+
+    // Maps each distinct string an aggregate has laid out to where it was laid out.
+    using string_offsets = std::unordered_map<shim::string_view, size_t, strv_hasher>;
+
+    // Maps the storage of every heap aggregate that isn't laid out in the standard encoding
+    // to the format chosen for it while sizing, so that layout doesn't have to size it again.
+    using layout_plan = std::unordered_map<void const*, layout_format>;
+
+    struct dictionary_storage {
+
+      /*----- Lifecycle Functions -----*/
+
+      explicit dictionary_storage(std::vector<shim::string_view> keys);
+      dictionary_storage(dictionary_storage const&) = delete;
+      ~dictionary_storage() = default;
+
+      /*----- Operators -----*/
+
+      dictionary_storage& operator =(dictionary_storage const&) = delete;
+
+      /*----- API -----*/
+
+      size_t size() const noexcept;
+
+      // Returns dictionary_entry::inline_id for keys the dictionary doesn't contain.
+      size_t find(shim::string_view key) const noexcept;
+      raw_element key_at(size_t id) const noexcept;
+      shim::string_view strv_at(size_t id) const noexcept;
+
+      /*----- Members -----*/
+
+      uint64_t version;
+      std::unique_ptr<gsl::byte[]> keys;
+      std::vector<size_t> offsets;
+      std::unordered_map<shim::string_view, uint16_t, strv_hasher> ids;
+
+    };
+
+    // Grants the internals access to the storage behind a dart::key_dictionary.
+    struct dictionary_access {
+      static auto get(key_dictionary const& dict) noexcept -> std::shared_ptr<dictionary_storage const> const&;
+      static key_dictionary make(std::shared_ptr<dictionary_storage const> impl) noexcept;
+    };
+
+    // Names the dictionary an object was keyed against, either directly, or by the root of the
+    // packet holding it, in which case nothing looks for it until an object keyed against it asks.
+    // Only call get on behalf of such an object, as packets rooted elsewhere have no slot to read.
+    struct dictionary_ref {
+      dictionary_ref(dictionary_storage const* dict = nullptr) noexcept : dict(dict), root(nullptr) {}
+
+      static dictionary_ref from_root(gsl::byte const* root) noexcept;
+      dictionary_storage const* get() const noexcept;
+
+      dictionary_storage const* dict;
+      gsl::byte const* root;
+    };
+
     /**
      *  @brief
      *  Struct is the lowest level abstraction for safe iteration over a dart::buffer
@@ -502,15 +1006,17 @@ namespace dart {
       /*----- Types -----*/
 
       using value_type = raw_element;
-      using loading_function = value_type (gsl::byte const*, size_t idx);
+      using loading_function = value_type (gsl::byte const*, size_t idx, dictionary_storage const* dict);
 
       /*----- Lifecycle Functions -----*/
 
       ll_iterator() = delete;
-      ll_iterator(size_t idx, gsl::byte const* base, loading_function* load_func) noexcept :
+      ll_iterator(size_t idx, gsl::byte const* base,
+          loading_function* load_func, dictionary_storage const* dict = nullptr) noexcept :
         idx(idx),
         base(base),
-        load_func(load_func)
+        load_func(load_func),
+        dict(dict)
       {}
       ll_iterator(ll_iterator const&) = default;
       ll_iterator(ll_iterator&&) noexcept = default;
@@ -537,6 +1043,9 @@ namespace dart {
       gsl::byte const* base;
       loading_function* load_func;
 
+      // Dictionary the aggregate is keyed against, if any, which is needed to load its keys.
+      dictionary_storage const* dict;
+
     };
 
     /**
@@ -605,6 +1114,9 @@ namespace dart {
     template <template <class> class RefCount>
     using dynamic_iterator = refcount::owner_indirection_t<dn_iterator, RefCount>;
 
+    // Used to select the recursive flavor of the object merge constructor.
+    struct deep_merge_tag {};
+
     /**
      *  @brief
      *  Class is the lowest level abstraction for safe interaction with
@@ -620,6 +1132,14 @@ namespace dart {
 
       public:
 
+        /*----- Public Types -----*/
+
+        // Read position within one of the objects consumed by the N-way merge constructor.
+        struct merge_source {
+          object const* obj;
+          size_t idx;
+        };
+
         /*----- Lifecycle Functions -----*/
 
         object() = delete;
@@ -634,12 +1154,15 @@ namespace dart {
 
         // Direct constructors
         explicit object(gsl::span<packet_pair<RefCount>> pairs) noexcept;
-        explicit object(packet_fields<RefCount> const* fields) noexcept;
+        object(packet_fields<RefCount> const* fields, finalize_options const& opts,
+            layout_format width = layout_format::standard, layout_plan const* plan = nullptr);
 
         // Special constructors
         object(object const* base, object const* incoming) noexcept;
+        object(object const* base, object const* incoming, deep_merge_tag) noexcept;
         template <class Key>
         object(object const* base, gsl::span<Key const*> key_ptrs) noexcept;
+        object(gsl::span<merge_source> sources, size_t total) noexcept;
 
         object(object const&) = delete;
         ~object() = delete;
@@ -650,26 +1173,61 @@ namespace dart {
 
         /*----- Public API -----*/
 
+        // Objects keyed against a dictionary can only find their keys, given their dictionary,
+        // which callers pass through from wherever the buffer they came out of stores it
+        // (see find_dictionary). Objects in any other encoding ignore it.
         template <bool silent>
-        bool is_valid(size_t bytes) const noexcept(silent);
+        bool is_valid(size_t bytes, dictionary_storage const* dict = nullptr) const noexcept(silent);
 
         size_t size() const noexcept;
         size_t get_sizeof() const noexcept;
+        layout_format format() const noexcept;
+        uint64_t dictionary_version() const noexcept;
+
+        // Function returns whether any of our values were shared (see string_policy::shared),
+        // in which case we may be larger once copied out into a new object.
+        bool shares_strings() const noexcept;
+
+        // The standard header only has room for 29 bits of our size, so anything switching
+        // to the wide encoding has to say how many fields we really have.
+        void set_format(layout_format fmt, size_t count) noexcept;
 
         auto begin() const noexcept -> ll_iterator<RefCount>;
-        auto key_begin() const noexcept -> ll_iterator<RefCount>;
+        auto key_begin(dictionary_storage const* dict = nullptr) const noexcept -> ll_iterator<RefCount>;
         auto end() const noexcept -> ll_iterator<RefCount>;
-        auto key_end() const noexcept -> ll_iterator<RefCount>;
+        auto key_end(dictionary_storage const* dict = nullptr) const noexcept -> ll_iterator<RefCount>;
+
+        template <class Callback>
+        auto get_key(shim::string_view const key, Callback&& cb, dictionary_ref dict = {}) const noexcept -> raw_element;
+        template <class Callback>
+        auto get_key(key_dictionary::key const& key, Callback&& cb, dictionary_ref dict = {}) const noexcept -> raw_element;
+        auto get_it(shim::string_view const key, dictionary_ref dict = {}) const noexcept -> ll_iterator<RefCount>;
+        auto get_key_it(shim::string_view const key, dictionary_ref dict = {}) const noexcept -> ll_iterator<RefCount>;
+        auto get_value(shim::string_view const key, dictionary_ref dict = {}) const noexcept -> raw_element;
+        auto get_value(key_dictionary::key const& key, dictionary_ref dict = {}) const noexcept -> raw_element;
+        auto at_value(shim::string_view const key, dictionary_ref dict = {}) const -> raw_element;
+
+        template <class Callback>
+        void for_each_pair(Callback&& cb, dictionary_storage const* dict = nullptr) const;
 
+        // Walks this object and another of the same size and format side by side, passing
+        // the key and value of each entry from both, until the callback returns false.
+        // Dictionary keyed objects aren't supported, as their keys need their dictionaries.
         template <class Callback>
-        auto get_key(shim::string_view const key, Callback&& cb) const noexcept -> raw_element;
-        auto get_it(shim::string_view const key) const noexcept -> ll_iterator<RefCount>;
-        auto get_key_it(shim::string_view const key) const noexcept -> ll_iterator<RefCount>;
-        auto get_value(shim::string_view const key) const noexcept -> raw_element;
-        auto at_value(shim::string_view const key) const -> raw_element;
+        bool for_each_pair_with(object const& other, Callback&& cb) const;
 
-        static auto load_key(gsl::byte const* base, size_t idx) noexcept -> typename ll_iterator<RefCount>::value_type;
-        static auto load_value(gsl::byte const* base, size_t idx) noexcept -> typename ll_iterator<RefCount>::value_type;
+        static auto load_key(gsl::byte const* base, size_t idx,
+            dictionary_storage const* dict = nullptr) noexcept -> typename ll_iterator<RefCount>::value_type;
+        static auto load_value(gsl::byte const* base, size_t idx,
+            dictionary_storage const* dict = nullptr) noexcept -> typename ll_iterator<RefCount>::value_type;
+
+        static size_t merged_sizeof(gsl::span<merge_source> sources) noexcept;
+        static size_t merged_sizeof(gsl::span<merge_source> sources, size_t& count) noexcept;
+        static size_t deep_merged_sizeof(object const* base, object const* incoming) noexcept;
+        template <class Key>
+        static size_t projected_sizeof(object const* base, gsl::span<Key const*> key_ptrs) noexcept;
+
+        static size_t extension_sizeof(finalize_options const& opts) noexcept;
 
         /*----- Public Members -----*/
 
@@ -679,23 +1237,90 @@ namespace dart {
 
         /*----- Private Helpers -----*/
 
-        size_t realign(size_t guess, size_t offset) noexcept;
+        template <class Entry>
+        void layout_fields(packet_fields<RefCount> const* fields,
+            finalize_options const& opts, layout_plan const* plan, prefix_skip skip);
+        size_t layout_key(object_entry* entry, size_t offset, raw_element raw_key, raw_type val_type) noexcept;
+        size_t layout_pair(object_entry* entry, size_t offset, raw_element raw_key, raw_element raw_val) noexcept;
+
+        static int compare_keys(object const* lhs, size_t lhs_idx, object const* rhs, size_t rhs_idx) noexcept;
+        template <class Callback>
+        static void each_merged_pair(object const* base, object const* incoming, Callback&& cb) noexcept;
+        template <class Callback>
+        static void each_merged_entry(gsl::span<merge_source> sources, Callback&& cb) noexcept;
+        static size_t count_unique_keys(object const* base, object const* incoming) noexcept;
+        template <class Key>
+        static size_t count_projected_keys(object const* base, gsl::span<Key const*> key_ptrs) noexcept;
+
+        template <class Callback>
+        auto get_standard_key(shim::string_view const key, Callback&& cb) const noexcept -> raw_element;
+        template <class Callback>
+        auto get_value_impl(shim::string_view const key, Callback&& cb, dictionary_ref dict) const -> raw_element;
 
+        void layout_keyed(packet_fields<RefCount> const* fields, finalize_options const& opts, layout_plan const* plan);
+        template <class Callback>
+        auto get_keyed(shim::string_view const key, size_t id, Callback&& cb) const noexcept -> raw_element;
+        template <class Callback>
+        auto get_keyed_value(shim::string_view const key, size_t id, Callback&& cb) const -> raw_element;
+        template <class Callback>
+        auto get_dictionary_key(shim::string_view const key, Callback&& cb, dictionary_ref dict) const noexcept -> raw_element;
+        template <class Callback>
+        auto get_dictionary_value(shim::string_view const key, Callback&& cb, dictionary_ref dict) const -> raw_element;
+        template <bool silent>
+        bool is_valid_keyed(size_t total_size, dictionary_storage const* dict) const noexcept(silent);
+
+        template <class Entry>
+        static gsl::byte const* value_address(gsl::byte const* base, Entry const& entry) noexcept;
+        static gsl::byte const* value_address(gsl::byte const* base, dictionary_entry const& entry) noexcept;
+
+        template <class Fields>
+        static prefix_skip discriminating_skip(Fields const& fields) noexcept;
+        prefix_skip key_skip() const noexcept;
+        void set_key_skip(prefix_skip skip) noexcept;
+        void set_format(layout_format fmt) noexcept;
+        void set_sizeof(size_t len) noexcept;
+        size_t header_sizeof() const noexcept;
+        size_t entry_sizeof() const noexcept;
+
+        wide_header* get_wide_header() noexcept;
+        wide_header const* get_wide_header() const noexcept;
+
+        // Function calls the given callback with a pointer to the vtable, typed according
+        // to the encoding of the object.
         template <class Callback>
-        auto get_value_impl(shim::string_view const key, Callback&& cb) const -> raw_element;
+        decltype(auto) visit_vtable(Callback&& cb) const;
 
-        object_entry* vtable() noexcept;
-        object_entry const* vtable() const noexcept;
+        template <class Entry = object_entry>
+        Entry* vtable() noexcept;
+        template <class Entry = object_entry>
+        Entry const* vtable() const noexcept;
 
         gsl::byte* raw_vtable() noexcept;
         gsl::byte const* raw_vtable() const noexcept;
 
+        /*----- Private Types -----*/
+
+        // Follows the header of objects in the keyed format.
+        // Records a prefix_skip, limited to keys shorter than 64KB.
+        struct key_extension {
+          alignas(4) little_order<uint32_t> skip;
+          alignas(2) little_order<uint16_t> min_len;
+          alignas(2) little_order<uint16_t> max_len;
+        };
+
+        // Follows the header of objects keyed against a dictionary.
+        struct dictionary_extension {
+          alignas(8) little_order<uint64_t> version;
+        };
+
         /*----- Private Members -----*/
 
         alignas(4) little_order<uint32_t> bytes;
         alignas(4) little_order<uint32_t> elems;
 
         static constexpr auto header_len = sizeof(bytes) + sizeof(elems);
+        static constexpr auto format_shift = 29U;
+        static constexpr auto size_mask = (1U << format_shift) - 1;
 
     };
     static_assert(std::is_standard_layout<object<std::shared_ptr>>::value, "dart library is misconfigured");
@@ -724,7 +1349,11 @@ namespace dart {
 #if DART_HAS_RAPIDJSON
         explicit array(rapidjson::Value const& elems) noexcept;
 #endif
-        array(packet_elements<RefCount> const* elems) noexcept;
+        array(packet_elements<RefCount> const* elems, finalize_options const& opts,
+            layout_format width = layout_format::standard, layout_plan const* plan = nullptr);
+        array(packet_elements<RefCount> const* elems, raw_type packed) noexcept;
+        template <class T>
+        explicit array(gsl::span<T const> elems) noexcept;
         array(array const&) = delete;
         ~array() = delete;
 
@@ -734,11 +1363,17 @@ namespace dart {
 
         /*----- Public API -----*/
 
+        // Arrays pass the dictionary through to any objects nested inside of them.
         template <bool silent>
-        bool is_valid(size_t bytes) const noexcept(silent);
+        bool is_valid(size_t bytes, dictionary_storage const* dict = nullptr) const noexcept(silent);
 
         size_t size() const noexcept;
         size_t get_sizeof() const noexcept;
+        layout_format format() const noexcept;
+
+        // The standard header only has room for 29 bits of our size, so anything switching
+        // to the wide encoding has to say how many elements we really have.
+        void set_format(layout_format fmt, size_t count) noexcept;
 
         auto begin() const noexcept -> ll_iterator<RefCount>;
         auto end() const noexcept -> ll_iterator<RefCount>;
@@ -746,20 +1381,52 @@ namespace dart {
         auto get_elem(size_t index) const noexcept -> raw_element;
         auto at_elem(size_t index) const -> raw_element;
 
-        static auto load_elem(gsl::byte const* base, size_t idx) noexcept -> typename ll_iterator<RefCount>::value_type;
+        template <class Callback>
+        void for_each_elem(Callback&& cb) const;
+
+        bool is_packed(raw_type type) const noexcept;
+        template <class T>
+        gsl::span<T const> as_span() const;
+
+        static auto load_elem(gsl::byte const* base, size_t idx,
+            dictionary_storage const* dict) noexcept -> typename ll_iterator<RefCount>::value_type;
+        static size_t packed_sizeof(raw_type packed, size_t count) noexcept;
 
         /*----- Public Members -----*/
 
         static constexpr auto alignment = sizeof(int64_t);
 
+        // Packed arrays store their element count alongside their format, and address their
+        // elements with 32-bit lengths, so anything larger is laid out with a vtable instead.
+        static constexpr auto max_packed_elems = (1U << 29U) - 1;
+
       private:
 
         /*----- Private Helpers -----*/
 
+        template <class Entry>
+        void layout_elements(packet_elements<RefCount> const* vals, finalize_options const& opts, layout_plan const* plan);
         auto get_elem_impl(size_t index, bool throw_if_absent) const -> raw_element;
+        gsl::byte* init_packed(raw_type packed) noexcept;
+        void set_format(layout_format fmt) noexcept;
+        void set_sizeof(size_t len) noexcept;
+        size_t header_sizeof() const noexcept;
+        size_t entry_sizeof() const noexcept;
+        raw_type packed_type() const noexcept;
+
+        wide_header* get_wide_header() noexcept;
+        wide_header const* get_wide_header() const noexcept;
+
+        // Function calls the given callback with a pointer to the vtable, typed according
+        // to the encoding of the array.
+        // Packed arrays have no vtable, and must be checked for before calling.
+        template <class Callback>
+        decltype(auto) visit_vtable(Callback&& cb) const;
 
-        array_entry* vtable() noexcept;
-        array_entry const* vtable() const noexcept;
+        template <class Entry = array_entry>
+        Entry* vtable() noexcept;
+        template <class Entry = array_entry>
+        Entry const* vtable() const noexcept;
 
         gsl::byte* raw_vtable() noexcept;
         gsl::byte const* raw_vtable() const noexcept;
@@ -770,6 +1437,9 @@ namespace dart {
         alignas(4) little_order<uint32_t> elems;
 
         static constexpr auto header_len = sizeof(bytes) + sizeof(elems);
+        static constexpr auto packed_header_len = header_len + sizeof(int64_t);
+        static constexpr auto format_shift = 29U;
+        static constexpr auto size_mask = (1U << format_shift) - 1;
 
     };
     static_assert(std::is_standard_layout<array<std::shared_ptr>>::value, "dart library is misconfigured");
@@ -899,10 +1569,16 @@ namespace dart {
       template <class Span>
       static auto build_buffer(Span pairs) -> buffer;
       static auto merge_buffers(buffer const& base, buffer const& incoming) -> buffer;
+      static auto merge_many(gsl::span<buffer const> objs) -> buffer;
+      static auto deep_merge_buffers(buffer const& base, buffer const& incoming) -> buffer;
 
       template <class Spannable>
       static auto project_keys(buffer const& base, Spannable const& keys) -> buffer;
 
+      template <class T>
+      static auto pack_array(gsl::span<T const> elems) -> buffer;
+      static auto merge_keyed(gsl::span<buffer const* const> objs, key_dictionary const& dict) -> buffer;
+
       template <class Callback>
       static void each_unique_pair(object<RefCount> const* base, object<RefCount> const* incoming, Callback&& cb);
       template <class Key, class Callback>
@@ -910,6 +1586,7 @@ namespace dart {
 
       template <class Span>
       static size_t max_bytes(Span pairs);
+      static size_t check_bytes(size_t bytes);
     };
 
     // Used for tag dispatch from factory functions.
@@ -1274,6 +1951,14 @@ namespace dart {
       return reinterpret_cast<T*>((offset + (alignment - 1)) & ~(alignment - 1));
     }
 
+    // Function behaves like align_pointer, but for a plain integer of the given type,
+    // such as the offset a shared value stores in place of itself.
+    template <class Int, class T>
+    constexpr T* align_pointer_for(T* ptr) noexcept {
+      uintptr_t offset = reinterpret_cast<uintptr_t>(ptr);
+      return reinterpret_cast<T*>((offset + (alignof(Int) - 1)) & ~(alignof(Int) - 1));
+    }
+
     template <template <class> class RefCount, class T>
     constexpr T pad_bytes(T bytes, raw_type type) noexcept {
       // Get the required alignment for a pointer of this type.
@@ -1283,6 +1968,33 @@ namespace dart {
       return (bytes + (alignment - 1)) & ~(alignment - 1);
     }
 
+    // Function behaves like align_pointer, but additionally zeroes any padding bytes it skips.
+    // Finalized buffers are not zero-filled up front, and so every byte of padding
+    // MUST be written here to ensure that finalized packets can be compared via memcmp.
+    template <template <class> class RefCount>
+    gsl::byte* zero_align_pointer(gsl::byte* ptr, raw_type type) noexcept {
+      auto* aligned = align_pointer<RefCount>(ptr, type);
+      std::fill(ptr, aligned, gsl::byte {});
+      return aligned;
+    }
+
+    template <class Int>
+    gsl::byte* zero_align_pointer_for(gsl::byte* ptr) noexcept {
+      auto* aligned = align_pointer_for<Int>(ptr);
+      std::fill(ptr, aligned, gsl::byte {});
+      return aligned;
+    }
+
+    // Function behaves like pad_bytes, but additionally zeroes the trailing padding
+    // of the aggregate starting at base.
+    // See zero_align_pointer for rationale.
+    template <template <class> class RefCount>
+    size_t zero_pad_bytes(gsl::byte* base, size_t bytes, raw_type type) noexcept {
+      auto padded = pad_bytes<RefCount>(bytes, type);
+      std::fill(base + bytes, base + padded, gsl::byte {});
+      return padded;
+    }
+
     template <template <class> class RefCount>
     size_t find_sizeof(raw_element elem) noexcept {
       if (elem.type != raw_type::null) {
@@ -1293,17 +2005,111 @@ namespace dart {
     }
 
     template <bool silent, template <class> class RefCount>
-    bool valid_buffer(raw_element elem, size_t bytes) noexcept(silent) {
+    bool valid_buffer(raw_element elem, size_t bytes, dictionary_storage const* dict = nullptr) noexcept(silent) {
       // Null is a special case because it occupies zero space in the network buffer
       // Check if the given element has a valid type.
       // If we're validating against corrupted garbage it likely won't
       if (elem.type == raw_type::null) return true;
       else if (!valid_type(elem.type)) return false;
 
+      // Aggregates need the dictionary to validate any objects keyed against it.
+      if (elem.type == raw_type::object) return get_object<RefCount>(elem)->template is_valid<silent>(bytes, dict);
+      else if (elem.type == raw_type::array) return get_array<RefCount>(elem)->template is_valid<silent>(bytes, dict);
+
       // Call through to our implementation
       return generic_deref<RefCount>([=] (auto& v) { return v.template is_valid<silent>(bytes); }, elem);
     }
 
+    // Packets are hashed structurally, rather than over their bytes, as packets that compare
+    // equal can be stored very differently (dynamic vs finalized, or finalized with different options).
+    // Every value is hashed together with its simplified type, so 1 and "1" don't collide, and the
+    // fields of objects are summed, so that the order they happen to be stored in doesn't matter.
+    constexpr uint64_t hash_multiplier = 0xC6A4A7935BD1E995ULL;
+
+    inline uint64_t hash_mix(uint64_t hash) noexcept {
+      hash ^= hash >> 33;
+      hash *= 0xFF51AFD7ED558CCDULL;
+      hash ^= hash >> 33;
+      hash *= 0xC4CEB9FE1A85EC53ULL;
+      hash ^= hash >> 33;
+      return hash;
+    }
+
+    inline uint64_t hash_combine(uint64_t hash, uint64_t val) noexcept {
+      return hash_mix(hash ^ (val + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2)));
+    }
+
+    // Strings are hashed eight bytes at a time (MurmurHash64A), as they're the only values
+    // that can be arbitrarily long.
+    inline uint64_t hash_bytes(char const* data, size_t len, uint64_t seed) noexcept {
+      uint64_t hash = seed ^ (len * hash_multiplier);
+      auto mix = [&] (uint64_t word) {
+        word *= hash_multiplier;
+        word ^= word >> 47;
+        word *= hash_multiplier;
+        hash ^= word;
+        hash *= hash_multiplier;
+      };
+
+      auto const* const end = data + (len & ~size_t {7});
+      for (; data != end; data += sizeof(uint64_t)) {
+        uint64_t word;
+        std::copy_n(data, sizeof(word), reinterpret_cast<char*>(&word));
+        mix(word);
+      }
+      if (len & 7) {
+        uint64_t word = 0;
+        std::copy_n(data, len & 7, reinterpret_cast<char*>(&word));
+        hash ^= word;
+        hash *= hash_multiplier;
+      }
+
+      hash ^= hash >> 47;
+      hash *= hash_multiplier;
+      hash ^= hash >> 47;
+      return hash;
+    }
+
+    inline uint64_t hash_string(shim::string_view str) noexcept {
+      return hash_bytes(str.data(), str.size(), static_cast<uint64_t>(type::string));
+    }
+
+    inline uint64_t hash_integer(int64_t val) noexcept {
+      return hash_combine(static_cast<uint64_t>(type::integer), static_cast<uint64_t>(val));
+    }
+
+    inline uint64_t hash_decimal(double val) noexcept {
+      // Zero and negative zero compare equal, so they have to hash equal too.
+      uint64_t bits = 0;
+      if (val != 0.0) std::copy_n(reinterpret_cast<char const*>(&val), sizeof(bits), reinterpret_cast<char*>(&bits));
+      return hash_combine(static_cast<uint64_t>(type::decimal), bits);
+    }
+
+    inline uint64_t hash_boolean(bool val) noexcept {
+      return hash_combine(static_cast<uint64_t>(type::boolean), val);
+    }
+
+    inline uint64_t hash_null() noexcept {
+      return hash_combine(static_cast<uint64_t>(type::null), 0);
+    }
+
+    // Arrays fold each element into the hash in order, starting from hash_array(size).
+    inline uint64_t hash_array(size_t size) noexcept {
+      return hash_combine(static_cast<uint64_t>(type::array), size);
+    }
+
+    // Objects sum hash_field over their fields, in any order, and pass the sum to hash_object.
+    inline uint64_t hash_field(shim::string_view key, uint64_t val) noexcept {
+      return hash_combine(hash_string(key), val);
+    }
+
+    inline uint64_t hash_object(size_t size, uint64_t fields) noexcept {
+      return hash_combine(hash_combine(static_cast<uint64_t>(type::object), size), fields);
+    }
+
+    template <template <class> class RefCount>
+    uint64_t hash_raw(raw_element elem, dictionary_storage const* dict) noexcept;
+
     template <template <class> class RefCount>
     constexpr size_t sso_bytes() {
       return basic_heap<RefCount>::sso_bytes;
@@ -1367,8 +2173,19 @@ namespace dart {
 #pragma clang diagnostic pop
 #endif
 
-    template <template <class> class RefCount, class Owner = buffer_refcount_type<RefCount>, class Callback>
-    Owner aligned_alloc(size_t bytes, raw_type type, Callback&& cb) {
+    template <template <class> class RefCount, class Owner, class Callback>
+    Owner aligned_alloc_impl(size_t bytes, raw_type type, Callback&& cb, std::true_type) {
+      // Let the reference counter co-locate the allocation with its own bookkeeping.
+      gsl::byte* tmp;
+      auto ref = allocate_shareable<RefCount<gsl::byte const>>(bytes, alignment_of<RefCount>(type), &tmp);
+
+      // Hand out mutable access and return.
+      cb(tmp);
+      return ref;
+    }
+
+    template <template <class> class RefCount, class Owner, class Callback>
+    Owner aligned_alloc_impl(size_t bytes, raw_type type, Callback&& cb, std::false_type) {
       // Make an aligned allocation.
       gsl::byte* tmp;
       int retval = shim::aligned_alloc(reinterpret_cast<void**>(&tmp), alignment_of<RefCount>(type), bytes);
@@ -1382,6 +2199,78 @@ namespace dart {
       return ref;
     }
 
+    template <template <class> class RefCount, class Owner = buffer_refcount_type<RefCount>, class Callback>
+    Owner aligned_alloc(size_t bytes, raw_type type, Callback&& cb) {
+      return aligned_alloc_impl<RefCount, Owner>(bytes, type,
+          std::forward<Callback>(cb), std::is_same<Owner, buffer_refcount_type<RefCount>> {});
+    }
+
+    // Function makes an allocation suitable for laying out a finalized packet into.
+    // Memory is NOT zeroed. Layout code is responsible for writing every byte up to the
+    // final size of the packet, zeroing any padding along the way (see zero_align_pointer),
+    // which is REQUIRED so that finalized packets can be compared with memcmp.
+    // If DART_USE_BUFFER_POOL is defined, memory is recycled through a thread-caching pool.
+    template <template <class> class RefCount, class Owner = buffer_refcount_type<RefCount>, class Callback>
+    Owner layout_alloc(size_t bytes, raw_type type, Callback&& cb) {
+#ifdef DART_USE_BUFFER_POOL
+      // Grab a block from the pool.
+      auto* tmp = buffer_pool::allocate(bytes, alignment_of<RefCount>(type));
+      if (!tmp) throw std::bad_alloc();
+
+      // Associate it with an owner in case anything goes wrong.
+      Owner ref {tmp, +[] (gsl::byte const* ptr) { buffer_pool::deallocate(ptr); }};
+
+      // Hand out mutable access and return.
+      cb(tmp);
+      return ref;
+#else
+      return aligned_alloc<RefCount, Owner>(bytes, type, std::forward<Callback>(cb));
+#endif
+    }
+
+    // Packets keyed against a dictionary keep it alive through a slot reserved directly in front
+    // of their root, which lets every buffer into the packet find it again without growing
+    // dart::buffer itself (see find_dictionary).
+    using dictionary_handle = std::shared_ptr<dictionary_storage const>;
+    constexpr size_t dictionary_slot_bytes = 16;
+    static_assert(sizeof(dictionary_handle) <= dictionary_slot_bytes, "dart library is misconfigured");
+
+    // Function makes an allocation suitable for laying out a packet keyed against the given
+    // dictionary into, and behaves otherwise identically to layout_alloc.
+    // The slot has to be found from the root of the packet, so these allocations can neither
+    // be co-located with the reference count, nor recycled through the buffer pool.
+    template <template <class> class RefCount, class Owner = buffer_refcount_type<RefCount>, class Callback>
+    Owner keyed_alloc(size_t bytes, dictionary_handle dict, Callback&& cb) {
+      // Make an aligned allocation, with room for the slot.
+      gsl::byte* tmp;
+      auto const total = bytes + dictionary_slot_bytes;
+      int retval = shim::aligned_alloc(reinterpret_cast<void**>(&tmp), alignment_of<RefCount>(raw_type::object), total);
+      if (retval) throw std::bad_alloc();
+      new(tmp) dictionary_handle(std::move(dict));
+
+      // Associate it with an owner in case anything goes wrong.
+      Owner ref {tmp + dictionary_slot_bytes, +[] (gsl::byte const* ptr) {
+        auto* base = const_cast<gsl::byte*>(ptr) - dictionary_slot_bytes;
+        shim::launder(reinterpret_cast<dictionary_handle*>(base))->~dictionary_handle();
+        shim::aligned_free(base);
+      }};
+
+      // Hand out mutable access and return.
+      cb(tmp + dictionary_slot_bytes);
+      return ref;
+    }
+
+    // Function returns the dictionary the packet with the given root is keyed against, if any.
+    // Only objects are ever keyed against a dictionary, and every object in a packet keyed
+    // against one is, so the root is all we ever have to check.
+    template <template <class> class RefCount>
+    dictionary_handle const* find_dictionary(gsl::byte const* root) noexcept {
+      if (!root) return nullptr;
+      auto const* obj = get_object<RefCount>({raw_type::object, root});
+      if (obj->format() != layout_format::dictionary) return nullptr;
+      return shim::launder(reinterpret_cast<dictionary_handle const*>(root - dictionary_slot_bytes));
+    }
+
     template <template <class> class RefCount, size_t static_elems = 8, class Spannable, class Callback>
     decltype(auto) sort_spannable(Spannable const& elems, Callback&& cb) {
       // XXX: This is necessary because I'm supporting an ANCIENT version of gsl-lite that
@@ -11,6 +11,41 @@ namespace dart {
 
   namespace detail {
 
+    template <template <class> class RefCount>
+    uint64_t hash_raw(raw_element elem, dictionary_storage const* dict) noexcept {
+      // Walk the buffer directly, rather than through dart::buffer, so that hashing
+      // never touches the reference count, and packed arrays are read straight out of place.
+      switch (simplify_type(elem.type)) {
+        case type::object:
+          {
+            uint64_t fields = 0;
+            auto const* obj = get_object<RefCount>(elem);
+            obj->for_each_pair([&] (auto key, auto val) {
+              fields += hash_field(get_string(key)->get_strv(), hash_raw<RefCount>(val, dict));
+            }, dict);
+            return hash_object(obj->size(), fields);
+          }
+        case type::array:
+          {
+            auto const* arr = get_array<RefCount>(elem);
+            auto hash = hash_array(arr->size());
+            arr->for_each_elem([&] (auto val) { hash = hash_combine(hash, hash_raw<RefCount>(val, dict)); });
+            return hash;
+          }
+        case type::string:
+          return hash_string(string_deref([] (auto& val) { return val.get_strv(); }, elem));
+        case type::integer:
+          return hash_integer(integer_deref([] (auto& val) { return val.get_data(); }, elem));
+        case type::decimal:
+          return hash_decimal(decimal_deref([] (auto& val) { return val.get_data(); }, elem));
+        case type::boolean:
+          return hash_boolean(get_primitive<bool>(elem)->get_data());
+        default:
+          DART_ASSERT(elem.type == raw_type::null);
+          return hash_null();
+      }
+    }
+
     template <size_t bytes>
     int prefix_compare_impl(char const* prefix, char const* str, size_t const len) noexcept {
       if (len && *prefix != *str) return *prefix - *str;
@@ -141,18 +176,22 @@ namespace dart {
 #pragma warning(pop)
 #endif
 
-    template <class T>
-    vtable_entry<T>::vtable_entry(detail::raw_type type, uint32_t offset) {
+    template <class T, class Offset>
+    vtable_entry<T, Offset>::vtable_entry(detail::raw_type type, size_t offset) {
       // Truncate dynamic type information.
       if (type == detail::raw_type::small_string) type = detail::raw_type::string;
 
+      // Our layout may contain padding, and finalized buffers aren't zero-filled up front,
+      // so zero the whole entry to keep buffers comparable via memcmp.
+      std::fill_n(reinterpret_cast<gsl::byte*>(&layout), sizeof(layout), gsl::byte {});
+
       // Create our combined entry for the vtable.
-      layout.offset = offset;
+      layout.offset = static_cast<Offset>(offset);
       layout.type = static_cast<uint8_t>(type);
     }
 
-    template <class T>
-    raw_type vtable_entry<T>::get_type() const noexcept {
+    template <class T, class Offset>
+    raw_type vtable_entry<T, Offset>::get_type() const noexcept {
       // Apparently this CAN'T use brace-initialization for... REASONS???
       // Put it down as _yet another_ painful edge case for "uniform" initialization.
       // I'm asking for an explicit, non-narrowing, conversion either way,
@@ -160,26 +199,29 @@ namespace dart {
       return raw_type(layout.type.get());
     }
 
-    template <class T>
-    uint32_t vtable_entry<T>::get_offset() const noexcept {
+    template <class T, class Offset>
+    size_t vtable_entry<T, Offset>::get_offset() const noexcept {
       return layout.offset;
     }
 
-    template <class T>
-    void vtable_entry<T>::adjust_offset(std::ptrdiff_t diff) noexcept {
-      layout.offset += diff;
+    template <class T, class Offset>
+    void vtable_entry<T, Offset>::adjust_offset(std::ptrdiff_t diff) noexcept {
+      layout.offset += static_cast<Offset>(diff);
     }
 
-    inline prefix_entry::prefix_entry(detail::raw_type type, uint32_t offset, shim::string_view prefix) noexcept :
-      vtable_entry<prefix_entry>(type, offset)
+    template <class Offset>
+    basic_prefix_entry<Offset>::basic_prefix_entry(detail::raw_type type,
+        size_t offset, shim::string_view key, size_t skip) noexcept :
+      vtable_entry<basic_prefix_entry, Offset>(type, offset)
     {
       // Decide how many bytes we're going to copy out of the key.
+      auto prefix = (key.size() > skip) ? key.substr(skip) : shim::string_view {};
       auto bytes = prefix.size();
       if (bytes > sizeof(this->layout.prefix)) bytes = sizeof(this->layout.prefix);
 
       // Set the length, truncating down to 256.
       auto max_len = std::numeric_limits<uint8_t>::max();
-      if (prefix.size() < max_len) this->layout.len = static_cast<uint8_t>(prefix.size());
+      if (key.size() < max_len) this->layout.len = static_cast<uint8_t>(key.size());
       else this->layout.len = max_len;
 
       // Try SO HARD not to violate strict aliasing rules, while copying those characters into an integer.
@@ -191,7 +233,8 @@ namespace dart {
       this->layout.prefix = *shim::launder(reinterpret_cast<prefix_type const*>(&raw));
     }
 
-    inline int prefix_entry::prefix_compare(shim::string_view str) const noexcept {
+    template <class Offset>
+    int basic_prefix_entry<Offset>::prefix_compare(shim::string_view str, size_t skip) const noexcept {
       // Cache all of our lengths and stuff.
       auto const their_len = str.size();
       auto const our_len = this->layout.len;
@@ -201,11 +244,64 @@ namespace dart {
       // If they are longer than us, but we're capped at the max value,
       // return equality to force key lookup to fall back on the general case.
       if (our_len < their_len) return (our_len == max_len) ? 0 : -1;
-      else if (our_len == their_len) return compare_impl(str.data(), their_len);
-      else return 1;
+      else if (our_len != their_len) return 1;
+      else if (!skip) return compare_impl(str.data(), their_len);
+
+      // Our prefix was cached from somewhere in the middle of the key.
+      // Keys too short to have reached it have an empty prefix, which compares
+      // equal to anything and falls back on the general case.
+      if (their_len <= skip) return 0;
+      else return compare_impl(str.data() + skip, their_len - skip);
     }
 
-    inline int prefix_entry::compare_impl(char const* const str, size_t const len) const noexcept {
+    template <class Offset>
+    template <class OtherOffset>
+    int basic_prefix_entry<Offset>::entry_compare(basic_prefix_entry<OtherOffset> const& other) const noexcept {
+      // Cache all of our lengths and stuff.
+      uint8_t const their_len = other.layout.len;
+      uint8_t const our_len = this->layout.len;
+      constexpr auto max_len = std::numeric_limits<uint8_t>::max();
+
+      // Lengths are authoritative unless both of them are capped.
+      if (our_len != their_len) return (our_len < their_len) ? -1 : 1;
+      else if (our_len == max_len) return 0;
+
+      // Same length, compare the prefixes as unsigned bytes to match std::string_view ordering.
+      auto* ours = reinterpret_cast<unsigned char const*>(&this->layout.prefix);
+      auto* theirs = reinterpret_cast<unsigned char const*>(&other.layout.prefix);
+      for (size_t idx = 0; idx < sizeof(prefix_type) && idx < our_len; ++idx) {
+        if (ours[idx] != theirs[idx]) return (ours[idx] < theirs[idx]) ? -1 : 1;
+      }
+      return 0;
+    }
+
+    template <class Offset>
+    size_t basic_prefix_entry<Offset>::get_length() const noexcept {
+      return this->layout.len;
+    }
+
+    template <class Offset>
+    bool basic_prefix_entry<Offset>::is_capped() const noexcept {
+      return this->layout.len == std::numeric_limits<uint8_t>::max();
+    }
+
+    template <class Offset>
+    raw_type basic_prefix_entry<Offset>::get_type() const noexcept {
+      return raw_type(this->layout.type.get() & ~shared_flag);
+    }
+
+    template <class Offset>
+    bool basic_prefix_entry<Offset>::is_shared() const noexcept {
+      return this->layout.type.get() & shared_flag;
+    }
+
+    template <class Offset>
+    void basic_prefix_entry<Offset>::set_shared() noexcept {
+      this->layout.type = static_cast<uint8_t>(this->layout.type.get() | shared_flag);
+    }
+
+    template <class Offset>
+    int basic_prefix_entry<Offset>::compare_impl(char const* const str, size_t const len) const noexcept {
       // Fast path where we attempt to perform a direct integer comparison.
       if (len >= sizeof(prefix_type)) {
         // Despite all my hard work, this is probably still undefined behavior.
@@ -231,13 +327,18 @@ namespace dart {
       // Low level object code assumes keys are sorted, so validate that assumption.
       std::sort(std::begin(pairs), std::end(pairs), dart_comparator<RefCount> {});
 
+      // Values keyed against a dictionary can't be copied into an object that isn't,
+      // so lay them out again from scratch.
+      for (auto& pair : pairs) {
+        auto* buf = shim::get_if<buffer>(&pair.value.impl);
+        if (buf && find_dictionary<RefCount>(buf->buffer_ref.get())) pair.value = basic_packet<RefCount> {basic_heap<RefCount> {*buf}};
+      }
+
       // Calculate how much space we'll need.
-      auto bytes = max_bytes(pairs);
+      auto bytes = check_bytes(max_bytes(pairs));
 
       // Build it.
-      auto ref = aligned_alloc<RefCount>(max_bytes(pairs), raw_type::object, [&] (auto* ptr) {
-        // XXX: std::fill_n is REQUIRED here so that we can perform memcmps for finalized packets.
-        std::fill_n(ptr, bytes, gsl::byte {});
+      auto ref = layout_alloc<RefCount>(bytes, raw_type::object, [&] (auto* ptr) {
         new(ptr) detail::object<RefCount>(pairs);
       });
       return basic_buffer<RefCount> {std::move(ref)};
@@ -245,38 +346,161 @@ namespace dart {
 
     template <template <class> class RefCount>
     auto buffer_builder<RefCount>::merge_buffers(buffer const& base, buffer const& incoming) -> buffer {
+      // Objects keyed against a dictionary have to be merged through the heap.
+      auto dict = base.dictionary();
+      if (dict.empty()) dict = incoming.dictionary();
+      if (!dict.empty()) {
+        buffer const* objs[] = {&base, &incoming};
+        return merge_keyed(objs, dict);
+      }
+
       // Unwrap our buffers to get the underlying machine representation.
       auto* raw_base = get_object<RefCount>(base.raw);
       auto* raw_incoming = get_object<RefCount>(incoming.raw);
       
       // Figure out the maximum amount of space we could need for the merged object.
+      // Merges are always laid out in the standard encoding, and lay out shared strings in full,
+      // so if either input was laid out with narrower offsets, or shares strings (or the inputs are
+      // simply too large) the sum of their sizes isn't good enough, and we have to count exactly.
       auto total_size = raw_base->get_sizeof() + raw_incoming->get_sizeof();
+      auto const narrow = is_compact(raw_base->format()) || is_compact(raw_incoming->format());
+      auto const shared = raw_base->shares_strings() || raw_incoming->shares_strings();
+      if (narrow || shared || total_size > object_layout::max_offset) {
+        typename object<RefCount>::merge_source sources[] = {{raw_base, 0}, {raw_incoming, 0}};
+        total_size = check_bytes(object<RefCount>::merged_sizeof(sources));
+      }
 
       // Merge it.
-      auto ref = aligned_alloc<RefCount>(total_size, raw_type::object, [&] (auto* ptr) {
-        std::fill_n(ptr, total_size, gsl::byte {});
+      auto ref = layout_alloc<RefCount>(total_size, raw_type::object, [&] (auto* ptr) {
         new(ptr) detail::object<RefCount>(raw_base, raw_incoming);
       });
       return basic_buffer<RefCount> {std::move(ref)};
     }
 
+    template <template <class> class RefCount>
+    auto buffer_builder<RefCount>::deep_merge_buffers(buffer const& base, buffer const& incoming) -> buffer {
+      // Objects keyed against a dictionary have to be merged through the heap.
+      auto dict = base.dictionary();
+      if (dict.empty()) dict = incoming.dictionary();
+      if (!dict.empty()) {
+        finalize_options opts;
+        opts.dictionary = std::move(dict);
+        auto merged = basic_heap<RefCount> {base}.deep_merge(basic_heap<RefCount> {incoming});
+        return merged.finalize(opts);
+      }
+
+      // Unwrap our buffers to get the underlying machine representation.
+      auto* raw_base = get_object<RefCount>(base.raw);
+      auto* raw_incoming = get_object<RefCount>(incoming.raw);
+
+      // Nested merges can shift the alignment of everything after them,
+      // so figure out exactly how much space we need and merge it.
+      auto total_size = check_bytes(object<RefCount>::deep_merged_sizeof(raw_base, raw_incoming));
+      auto ref = layout_alloc<RefCount>(total_size, raw_type::object, [&] (auto* ptr) {
+        new(ptr) detail::object<RefCount>(raw_base, raw_incoming, deep_merge_tag {});
+      });
+      return basic_buffer<RefCount> {std::move(ref)};
+    }
+
+    template <template <class> class RefCount>
+    auto buffer_builder<RefCount>::merge_many(gsl::span<buffer const> objs) -> buffer {
+      using source = typename object<RefCount>::merge_source;
+
+      // Objects keyed against a dictionary have to be merged through the heap.
+      for (auto& obj : objs) {
+        auto dict = obj.dictionary();
+        if (dict.empty()) continue;
+
+        std::vector<buffer const*> ptrs;
+        ptrs.reserve(objs.size());
+        for (auto& other : objs) ptrs.push_back(&other);
+        return merge_keyed(ptrs, dict);
+      }
+
+      // Unwrap our buffers to get the underlying machine representation.
+      std::vector<source> sources;
+      sources.reserve(objs.size());
+      for (auto& obj : objs) sources.push_back({get_object<RefCount>(obj.raw), 0});
+
+      // Layered objects tend to override the same keys over and over, so summing the inputs
+      // would badly overestimate. Figure out exactly how much space we need and merge it.
+      size_t count;
+      auto srcs = gsl::make_span(sources);
+      auto total_size = check_bytes(object<RefCount>::merged_sizeof(srcs, count));
+      auto ref = layout_alloc<RefCount>(total_size, raw_type::object, [&] (auto* ptr) {
+        new(ptr) detail::object<RefCount>(srcs, count);
+      });
+      return basic_buffer<RefCount> {std::move(ref)};
+    }
+
     template <template <class> class RefCount>
     template <class Spannable>
     auto buffer_builder<RefCount>::project_keys(buffer const& base, Spannable const& keys) -> buffer {
+      // Objects keyed against a dictionary have to be projected through the heap.
+      auto dict = base.dictionary();
+      if (!dict.empty()) {
+        finalize_options opts;
+        opts.dictionary = std::move(dict);
+        return basic_heap<RefCount> {base}.project(keys).finalize(opts);
+      }
+
       return detail::sort_spannable<RefCount>(keys, [&] (auto key_ptrs) {
         // Unwrap our buffers to get the underlying machine representation.
         auto* raw_base = get_object<RefCount>(base.raw);
 
-        // Maximum required size is that of the current object, as the new one must be smaller.
+        // Maximum required size is that of the current object, as the new one must be smaller,
+        // unless the current object was laid out with different offsets than the projection will be,
+        // or shares strings the projection will lay out in full.
         auto total_size = raw_base->get_sizeof();
-        auto ref = aligned_alloc<RefCount>(total_size, raw_type::object, [&] (auto* ptr) {
-          std::fill_n(ptr, total_size, gsl::byte {});
+        auto const recount = is_compact(raw_base->format()) || raw_base->shares_strings();
+        if (recount || total_size > object_layout::max_offset) {
+          total_size = check_bytes(object<RefCount>::projected_sizeof(raw_base, key_ptrs));
+        }
+        auto ref = layout_alloc<RefCount>(total_size, raw_type::object, [&] (auto* ptr) {
           new(ptr) detail::object<RefCount>(raw_base, key_ptrs);
         });
         return basic_buffer<RefCount> {std::move(ref)};
       });
     }
 
+    template <template <class> class RefCount>
+    auto buffer_builder<RefCount>::merge_keyed(gsl::span<buffer const* const> objs,
+        key_dictionary const& dict) -> buffer
+    {
+      // Later objects override earlier ones, as in any other merge.
+      auto merged = basic_heap<RefCount>::make_object();
+      for (auto* obj : objs) {
+        typename buffer::iterator k, v;
+        std::tie(k, v) = obj->kvbegin();
+        while (v != obj->end()) {
+          merged.add_field(basic_heap<RefCount> {*k}, basic_heap<RefCount> {*v});
+          ++k, ++v;
+        }
+      }
+
+      finalize_options opts;
+      opts.dictionary = dict;
+      return merged.finalize(opts);
+    }
+
+    template <template <class> class RefCount>
+    template <class T>
+    auto buffer_builder<RefCount>::pack_array(gsl::span<T const> elems) -> buffer {
+      // Packed arrays record their length alongside their format, and address everything with
+      // 32-bit lengths, so anything larger has to be built element by element.
+      auto const count = static_cast<size_t>(elems.size());
+      if (count > array<RefCount>::max_packed_elems) {
+        throw std::length_error("dart::buffer cannot pack an array of that many elements");
+      }
+
+      auto bytes = check_bytes(array<RefCount>::packed_sizeof(packed_element<T>::value, count));
+      auto ref = layout_alloc<RefCount>(bytes, raw_type::array, [&] (auto* ptr) {
+        new(ptr) detail::array<RefCount>(elems);
+      });
+      auto* base = ref.get();
+      return basic_buffer<RefCount> {{raw_type::array, base}, std::move(ref)};
+    }
+
     template <template <class> class RefCount>
     template <class Span>
     size_t buffer_builder<RefCount>::max_bytes(Span pairs) {
@@ -302,6 +526,15 @@ namespace dart {
       return bytes + detail::pad_bytes<RefCount>(bytes, detail::raw_type::object);
     }
 
+    template <template <class> class RefCount>
+    size_t buffer_builder<RefCount>::check_bytes(size_t bytes) {
+      // Objects built out of other buffers are always laid out in the standard encoding.
+      if (bytes > object_layout::max_offset) {
+        throw std::length_error("Offset required for encoding is too large for dart::packet vtable");
+      }
+      return bytes;
+    }
+
     template <template <class> class RefCount>
     template <class Callback>
     void buffer_builder<
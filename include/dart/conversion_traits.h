@@ -3,6 +3,7 @@
 
 /*----- System Includes -----*/
 
+#include <cstring>
 #include <type_traits>
 
 /*----- Local Includes -----*/
@@ -121,22 +122,51 @@ namespace dart {
 
         template <class Heap>
         static buffer convert(Heap&& hp) {
+          return convert(std::forward<Heap>(hp), finalize_options {});
+        }
+
+        template <class Heap>
+        static buffer convert(Heap&& hp, finalize_options const& opts) {
           if (!hp.is_object()) {
             throw type_error("dart::buffer can only be constructed from an object heap");
           }
 
           // Calculate the maximum amount of memory that could be required to represent this dart::packet and
           // allocate the whole thing in one go.
+          // Sizing also decides which aggregates need something other than the standard encoding,
+          // so layout can follow the plan rather than sizing each of them again.
           buffer buff;
-          size_t bytes = hp.upper_bound();
-          auto buftype = dart::detail::raw_type::object;
-          buff.buffer_ref = dart::detail::aligned_alloc<RefCount>(bytes, buftype, [&] (auto* buff) {
-            std::fill_n(buff, bytes, gsl::byte {});
-            hp.layout(buff);
-          });
+          dart::detail::layout_plan plan;
+          size_t bytes = hp.upper_bound(opts, &plan);
+          if (!opts.dictionary.empty() && bytes > dart::detail::object_layout::max_offset) {
+            throw std::length_error("dart::buffer keyed against a dictionary cannot exceed 4GB");
+          }
+          buff.buffer_ref = alloc(bytes, opts, [&] (auto* buff) { hp.layout(buff, opts, &plan); });
+
+          // The bound assumes every string is laid out in full, so if we shared any of them,
+          // we may have used much less memory than we asked for. Hand it back.
+          if (opts.strings == string_policy::shared) {
+            auto const used = dart::detail::find_sizeof<RefCount>({dart::detail::raw_type::object, buff.buffer_ref.get()});
+            if (used < bytes) {
+              buff.buffer_ref = alloc(used, opts, [&] (auto* dup) {
+                std::copy_n(buff.buffer_ref.get(), used, dup);
+              });
+            }
+          }
           buff.raw = {dart::detail::raw_type::object, buff.buffer_ref.get()};
           return buff;
         }
+
+        template <class Callback>
+        static auto alloc(size_t bytes, finalize_options const& opts, Callback&& cb) {
+          // Packets keyed against a dictionary keep it alive alongside them.
+          if (!opts.dictionary.empty()) {
+            auto const& dict = dart::detail::dictionary_access::get(opts.dictionary);
+            return dart::detail::keyed_alloc<RefCount>(bytes, dict, std::forward<Callback>(cb));
+          } else {
+            return dart::detail::layout_alloc<RefCount>(bytes, dart::detail::raw_type::object, std::forward<Callback>(cb));
+          }
+        }
       };
       template <template <class> class RefCount>
       struct api_converter<basic_packet<RefCount>, basic_heap<RefCount>> {
@@ -242,6 +272,9 @@ namespace dart {
           }, lhs.data, rhs.data);
         }
       };
+      template <class Lhs, class Rhs>
+      bool generic_compare(Lhs const& lhs, Rhs const& rhs) noexcept;
+
       template <template <class> class RefCount>
       struct typed_compare<basic_buffer<RefCount>> {
         template <class OtherBuffer>
@@ -260,13 +293,56 @@ namespace dart {
           // Fall back on a comparison of the underlying buffers.
           auto lhs_size = dart::detail::find_sizeof<RefCount>(rawlhs);
           auto rhs_size = dart::detail::find_sizeof<RefCount>(rawrhs);
-          if (lhs_size == rhs_size) {
-            return std::equal(rawlhs.buffer, rawlhs.buffer + lhs_size, rawrhs.buffer);
-          } else {
+          if (lhs_size == rhs_size && !std::memcmp(rawlhs.buffer, rawrhs.buffer, lhs_size)) {
+            return true;
+          } else if (!lhs.is_aggregate()) {
+            if (rawlhs.type == rawrhs.type) return false;
+          } else if (lhs.size() != rhs.size()) {
+            // Every encoding records its element count up front.
             return false;
+          } else if (lhs.is_object() && same_layout(rawlhs, rawrhs)) {
+            return lockstep_compare(lhs, rhs);
           }
+
+          // Aggregates finalized with different options (or merged out of pieces that were)
+          // can hold the same tree in different bytes, so compare them structurally.
+          // Identical subtrees still compare equal on their bytes alone.
+          // Packed arrays widen their elements, so numbers are compared on their values too.
+          return generic_compare(lhs, rhs);
+        }
+
+        // Function checks whether two objects were laid out in the same format, and
+        // so order their keys the same way.
+        // Dictionary keyed objects need their dictionaries to load keys, and are left
+        // to the structural comparison.
+        static bool same_layout(dart::detail::raw_element lhs, dart::detail::raw_element rhs) noexcept {
+          auto format = dart::detail::get_object<RefCount>(lhs)->format();
+          if (format == dart::detail::layout_format::dictionary) return false;
+          return format == dart::detail::get_object<RefCount>(rhs)->format();
+        }
+
+        // Function walks two objects with matching layouts side by side.
+        // Their bytes can still differ below the top level, as buffers don't record which
+        // options their children were laid out with, but equal objects line up entry for
+        // entry, so the walk stops at the first difference without a lookup per key, and
+        // only values whose bytes differ are compared any further.
+        template <class OtherBuffer>
+        static bool lockstep_compare(basic_buffer<RefCount> const& lhs, OtherBuffer const& rhs) noexcept {
+          auto* lobj = dart::detail::get_object<RefCount>(lhs.raw);
+          auto* robj = dart::detail::get_object<RefCount>(rhs.raw);
+          return lobj->for_each_pair_with(*robj, [&] (auto lkey, auto lval, auto rkey, auto rval) {
+            // Outside of dictionary keyed objects, values directly follow their keys,
+            // so a matching entry can usually be confirmed with a single comparison.
+            auto lspan = static_cast<size_t>(lval.buffer - lkey.buffer) + dart::detail::find_sizeof<RefCount>(lval);
+            auto rspan = static_cast<size_t>(rval.buffer - rkey.buffer) + dart::detail::find_sizeof<RefCount>(rval);
+            if (lval.type == rval.type && lspan == rspan && !std::memcmp(lkey.buffer, rkey.buffer, lspan)) return true;
+
+            if (dart::detail::get_string(lkey)->get_strv() != dart::detail::get_string(rkey)->get_strv()) return false;
+            return basic_buffer<RefCount> {lval, lhs.buffer_ref} == OtherBuffer {rval, rhs.buffer_ref};
+          });
         }
       };
+
       template <template <class> class RefCount>
       struct typed_compare<basic_packet<RefCount>> {
         template <class OtherPacket>
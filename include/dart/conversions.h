@@ -167,6 +167,69 @@ namespace dart {
         return generic_multimap_compare_impl(pkt, map, extract, next);
       }
 
+      template <class T>
+      using packed_element_t = decltype(dart::detail::packed_element<std::remove_const_t<T>>::value);
+      template <class T, class Packet>
+      using is_packed_t = decltype(std::declval<Packet const&>().template is_packed<T>());
+
+      // Only dart::buffer can be built from a contiguous range of elements in one go,
+      // every other packet type stays mutable, and so must be built element by element.
+      template <class T, class Packet>
+      struct is_packable_into : std::false_type {};
+      template <class T, template <class> class RefCount>
+      struct is_packable_into<T, dart::basic_buffer<RefCount>> :
+        meta::is_detected<packed_element_t, T>
+      {};
+
+      template <class T, class Packet>
+      struct is_packed_viewable :
+        meta::conjunction<
+          meta::is_detected<packed_element_t, T>,
+          meta::is_detected<is_packed_t, T, Packet>
+        >
+      {};
+
+      template <class Packet>
+      struct array_packer;
+      template <template <class> class RefCount>
+      struct array_packer<dart::basic_buffer<RefCount>> {
+        template <class T>
+        static dart::basic_buffer<RefCount> pack(gsl::span<T const> elems) {
+          return dart::detail::buffer_builder<RefCount>::pack_array(elems);
+        }
+      };
+
+      template <class Packet, class T>
+      Packet array_from_span(gsl::span<T const> elems, std::true_type) {
+        return array_packer<Packet>::pack(elems);
+      }
+
+      template <class Packet, class T>
+      Packet array_from_span(gsl::span<T const> elems, std::false_type) {
+        auto pkt = Packet::make_array();
+        pkt.reserve(elems.size());
+        for (auto& val : elems) pkt.push_back(val);
+        return pkt;
+      }
+
+      // Returns the elements of the given packet in place if it's an array
+      // packed with elements of type T, and an empty span otherwise.
+      template <class T, class Packet>
+      gsl::span<T const> packed_view(Packet const& pkt, std::true_type) {
+        if (pkt.template is_packed<T>()) return pkt.template as_span<T>();
+        else return {};
+      }
+
+      template <class T, class Packet>
+      gsl::span<T const> packed_view(Packet const&, std::false_type) {
+        return {};
+      }
+
+      template <class T, class Packet>
+      gsl::span<T const> packed_view(Packet const& pkt) {
+        return packed_view<T>(pkt, is_packed_viewable<T, Packet> {});
+      }
+
     }
 
     // Specialization for interoperability with gsl::span
@@ -181,13 +244,12 @@ namespace dart {
       template <class Packet, class =
         std::enable_if_t<
           convert::is_castable<T, Packet>::value
+          ||
+          detail::is_packable_into<T, Packet>::value
         >
       >
       Packet to_dart(gsl::span<T const> span) {
-        auto pkt = Packet::make_array();
-        pkt.reserve(span.size());
-        for (auto& val : span) pkt.push_back(val);
-        return pkt;
+        return detail::array_from_span<Packet>(span, detail::is_packable_into<T, Packet> {});
       }
 
       // Equality
@@ -219,17 +281,23 @@ namespace dart {
     // Specialization for interoperability with std::vector
     template <class T, class Alloc>
     struct conversion_traits<std::vector<T, Alloc>> {
+      // std::vector<bool> isn't contiguous, and so can't be packed in one go.
+      template <class Packet>
+      using is_packable_into = meta::conjunction<
+        detail::is_packable_into<T, Packet>,
+        meta::negation<std::is_same<T, bool>>
+      >;
+
       // Copy conversion
       template <class Packet, class =
         std::enable_if_t<
           convert::is_castable<T, Packet>::value
+          ||
+          is_packable_into<Packet>::value
         >
       >
       Packet to_dart(std::vector<T, Alloc> const& vec) {
-        auto pkt = Packet::make_array();
-        pkt.reserve(vec.size());
-        for (auto& val : vec) pkt.push_back(val);
-        return pkt;
+        return to_dart_impl<Packet>(vec, is_packable_into<Packet> {});
       }
       template <class Packet, class =
         std::enable_if_t<
@@ -246,6 +314,9 @@ namespace dart {
         // to anyone who understands why this is necessary and useful,
         // you're welcome
         typename Packet::view v = pkt;
+        auto packed = detail::packed_view<T>(v);
+        if (!packed.empty()) return std::vector<T, Alloc>(packed.begin(), packed.end());
+
         std::vector<T, Alloc> vec;
         vec.reserve(pkt.size());
         for (auto val : v) {
@@ -258,9 +329,29 @@ namespace dart {
       template <class Packet, class =
         std::enable_if_t<
           convert::is_castable<T, Packet>::value
+          ||
+          is_packable_into<Packet>::value
         >
       >
       Packet to_dart(std::vector<T, Alloc>&& vec) {
+        return to_dart_impl<Packet>(std::move(vec), is_packable_into<Packet> {});
+      }
+
+      template <class Packet>
+      Packet to_dart_impl(std::vector<T, Alloc> const& vec, std::true_type) {
+        return detail::array_from_span<Packet>(gsl::span<T const>(vec.data(), vec.size()), std::true_type {});
+      }
+
+      template <class Packet>
+      Packet to_dart_impl(std::vector<T, Alloc> const& vec, std::false_type) {
+        auto pkt = Packet::make_array();
+        pkt.reserve(vec.size());
+        for (auto& val : vec) pkt.push_back(val);
+        return pkt;
+      }
+
+      template <class Packet>
+      Packet to_dart_impl(std::vector<T, Alloc>&& vec, std::false_type) {
         auto pkt = Packet::make_array();
         pkt.reserve(vec.size());
         for (auto& val : vec) pkt.push_back(std::move(val));
@@ -316,13 +407,12 @@ namespace dart {
       template <class Packet, class =
         std::enable_if_t<
           convert::is_castable<T, Packet>::value
+          ||
+          detail::is_packable_into<T, Packet>::value
         >
       >
       Packet to_dart(std::array<T, len> const& arr) {
-        auto pkt = Packet::make_array();
-        pkt.reserve(len);
-        for (auto& val : arr) pkt.push_back(val);
-        return pkt;
+        return to_dart_impl<Packet>(arr, detail::is_packable_into<T, Packet> {});
       }
       template <class Packet, class =
         std::enable_if_t<
@@ -343,9 +433,29 @@ namespace dart {
       template <class Packet, class =
         std::enable_if_t<
           convert::is_castable<T, Packet>::value
+          ||
+          detail::is_packable_into<T, Packet>::value
         >
       >
       Packet to_dart(std::array<T, len>&& arr) {
+        return to_dart_impl<Packet>(std::move(arr), detail::is_packable_into<T, Packet> {});
+      }
+
+      template <class Packet>
+      Packet to_dart_impl(std::array<T, len> const& arr, std::true_type) {
+        return detail::array_from_span<Packet>(gsl::span<T const>(arr.data(), len), std::true_type {});
+      }
+
+      template <class Packet>
+      Packet to_dart_impl(std::array<T, len> const& arr, std::false_type) {
+        auto pkt = Packet::make_array();
+        pkt.reserve(len);
+        for (auto& val : arr) pkt.push_back(val);
+        return pkt;
+      }
+
+      template <class Packet>
+      Packet to_dart_impl(std::array<T, len>&& arr, std::false_type) {
         auto pkt = Packet::make_array();
         pkt.reserve(len);
         for (auto& val : arr) pkt.push_back(std::move(val));
@@ -1587,6 +1697,44 @@ namespace dart {
       }
     };
 
+    /**
+     *  @brief
+     *  Function converts the elements of a Dart array into caller-provided storage.
+     *
+     *  @details
+     *  Useful for marshalling large arrays of samples without allocating:
+     *  ```
+     *  std::vector<double> samples(buf["samples"].size());
+     *  dart::convert::cast_into(buf["samples"], gsl::make_span(samples));
+     *  ```
+     *  If the array was packed with elements of type T, its elements are copied
+     *  out in one go, otherwise each element is converted individually.
+     *  Returns the number of elements written, throws std::out_of_range if the
+     *  given storage is too small.
+     */
+    template <class T, class Packet, class =
+      std::enable_if_t<
+        convert::is_castable<Packet const&, T>::value
+      >
+    >
+    size_t cast_into(Packet const& pkt, gsl::span<T> out) {
+      if (!pkt.is_array()) {
+        detail::report_type_mismatch(dart::detail::type::array, pkt.get_type());
+      } else if (pkt.size() > static_cast<size_t>(out.size())) {
+        throw std::out_of_range("dart::convert::cast_into was given too little storage for the array");
+      }
+
+      typename Packet::view v = pkt;
+      auto packed = detail::packed_view<T>(v);
+      if (!packed.empty()) {
+        std::copy(packed.begin(), packed.end(), out.begin());
+      } else {
+        auto it = out.begin();
+        for (auto val : v) *it++ = convert::cast<T>(std::move(val));
+      }
+      return v.size();
+    }
+
   }
 
 }
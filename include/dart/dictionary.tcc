@@ -0,0 +1,185 @@
+#ifndef DART_DICTIONARY_H
+#define DART_DICTIONARY_H
+
+/*----- Project Includes -----*/
+
+#include "common.h"
+
+/*----- Function Implementations -----*/
+
+namespace dart {
+
+  inline key_dictionary::key_dictionary(std::initializer_list<shim::string_view> keys) :
+    key_dictionary(gsl::make_span(keys.begin(), keys.size()))
+  {}
+
+  inline key_dictionary::key_dictionary(gsl::span<shim::string_view const> keys) :
+    impl(std::make_shared<detail::dictionary_storage>(std::vector<shim::string_view>(keys.begin(), keys.end())))
+  {}
+
+  inline key_dictionary::key_dictionary(gsl::span<std::string const> keys) :
+    impl(std::make_shared<detail::dictionary_storage>(std::vector<shim::string_view>(keys.begin(), keys.end())))
+  {}
+
+  inline key_dictionary::key_dictionary(std::shared_ptr<detail::dictionary_storage const> impl) noexcept :
+    impl(std::move(impl))
+  {}
+
+  inline bool key_dictionary::operator ==(key_dictionary const& other) const noexcept {
+    return version() == other.version();
+  }
+
+  inline bool key_dictionary::operator !=(key_dictionary const& other) const noexcept {
+    return !(*this == other);
+  }
+
+  inline auto key_dictionary::size() const noexcept -> size_type {
+    return impl ? impl->size() : 0;
+  }
+
+  inline bool key_dictionary::empty() const noexcept {
+    return !size();
+  }
+
+  inline uint64_t key_dictionary::version() const noexcept {
+    return impl ? impl->version : 0;
+  }
+
+  inline bool key_dictionary::contains(shim::string_view key) const noexcept {
+    return impl && impl->find(key) != detail::dictionary_entry::inline_id;
+  }
+
+  inline auto key_dictionary::lookup(shim::string_view key) const -> key_dictionary::key {
+    auto const id = impl ? impl->find(key) : detail::dictionary_entry::inline_id;
+    if (id == detail::dictionary_entry::inline_id) {
+      throw std::out_of_range("dart::key_dictionary does not contain the requested key");
+    }
+    return {impl, static_cast<uint16_t>(id)};
+  }
+
+  inline key_dictionary::key::key(std::shared_ptr<detail::dictionary_storage const> impl, uint16_t id) noexcept :
+    impl(std::move(impl)),
+    idx(id)
+  {}
+
+  inline shim::string_view key_dictionary::key::strv() const noexcept {
+    return impl->strv_at(idx);
+  }
+
+  inline uint16_t key_dictionary::key::id() const noexcept {
+    return idx;
+  }
+
+  inline uint64_t key_dictionary::key::version() const noexcept {
+    return impl->version;
+  }
+
+  namespace detail {
+
+    inline uint64_t fnv1a(uint64_t hash, void const* data, size_t len) noexcept {
+      auto const* bytes = static_cast<unsigned char const*>(data);
+      for (size_t i = 0; i < len; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+    }
+
+    inline size_t strv_hasher::operator ()(shim::string_view key) const noexcept {
+      return static_cast<size_t>(fnv1a(fnv_offset_basis, key.data(), key.size()));
+    }
+
+    inline dictionary_storage::dictionary_storage(std::vector<shim::string_view> sorted) : version(fnv_offset_basis) {
+      // Ids are handed out in the same order objects sort their keys in.
+      std::sort(sorted.begin(), sorted.end(), dart_comparator<std::shared_ptr> {});
+      sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+      if (sorted.size() > dictionary_entry::inline_id) {
+        throw std::length_error("dart::key_dictionary cannot hold more than UINT16_MAX keys");
+      }
+
+      // Figure out where each key will live, and fingerprint the whole set as we go.
+      // Lengths are mixed in so that the fingerprint can't be fooled by moving bytes between keys.
+      size_t bytes = 0;
+      offsets.reserve(sorted.size());
+      for (auto key : sorted) {
+        if (key.size() > std::numeric_limits<string::size_type>::max()) {
+          throw std::length_error("dart::key_dictionary keys cannot be longer than UINT16_MAX");
+        }
+        uint32_t const len = static_cast<uint32_t>(key.size());
+        version = fnv1a(version, &len, sizeof(len));
+        version = fnv1a(version, key.data(), key.size());
+
+        bytes = pad_bytes<std::shared_ptr>(bytes, raw_type::string);
+        offsets.push_back(bytes);
+        bytes += string::static_sizeof(static_cast<string::size_type>(key.size()));
+      }
+
+      // Lay the keys out, and index them.
+      keys = std::make_unique<gsl::byte[]>(bytes ? bytes : 1);
+      ids.reserve(sorted.size());
+      for (size_t id = 0; id < sorted.size(); ++id) {
+        new(keys.get() + offsets[id]) string(sorted[id]);
+        ids.emplace(strv_at(id), static_cast<uint16_t>(id));
+      }
+    }
+
+    inline size_t dictionary_storage::size() const noexcept {
+      return offsets.size();
+    }
+
+    inline DART_NOINLINE size_t dictionary_storage::find(shim::string_view key) const noexcept {
+      auto it = ids.find(key);
+      if (it == ids.end()) return dictionary_entry::inline_id;
+      else return it->second;
+    }
+
+    inline raw_element dictionary_storage::key_at(size_t id) const noexcept {
+      return {raw_type::string, keys.get() + offsets[id]};
+    }
+
+    inline shim::string_view dictionary_storage::strv_at(size_t id) const noexcept {
+      return get_string(key_at(id))->get_strv();
+    }
+
+    inline auto dictionary_access::get(key_dictionary const& dict) noexcept
+      -> std::shared_ptr<dictionary_storage const> const&
+    {
+      return dict.impl;
+    }
+
+    inline key_dictionary dictionary_access::make(std::shared_ptr<dictionary_storage const> impl) noexcept {
+      return key_dictionary {std::move(impl)};
+    }
+
+    inline dictionary_ref dictionary_ref::from_root(gsl::byte const* root) noexcept {
+      dictionary_ref ref;
+      ref.root = root;
+      return ref;
+    }
+
+    inline dictionary_storage const* dictionary_ref::get() const noexcept {
+      // Our caller is keyed against a dictionary, so every object in its packet is,
+      // including the root, which keeps it in the slot in front of itself (see find_dictionary).
+      if (dict || !root) return dict;
+      return shim::launder(reinterpret_cast<dictionary_handle const*>(root - dictionary_slot_bytes))->get();
+    }
+
+    inline dictionary_entry::dictionary_entry(detail::raw_type type, size_t offset, size_t id) noexcept :
+      vtable_entry<dictionary_entry>(type, offset)
+    {
+      layout.id = static_cast<id_type>(id);
+    }
+
+    inline size_t dictionary_entry::get_id() const noexcept {
+      return layout.id;
+    }
+
+    inline bool dictionary_entry::is_inline() const noexcept {
+      return layout.id == inline_id;
+    }
+
+  }
+
+}
+
+#endif
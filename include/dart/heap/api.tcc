@@ -314,6 +314,12 @@ namespace dart {
     return basic_buffer<RefCount> {*this};
   }
 
+  template <template <class> class RefCount>
+  template <bool enabled, class EnableIf>
+  basic_buffer<RefCount> basic_heap<RefCount>::finalize(finalize_options const& opts) const {
+    return convert::detail::api_converter<basic_heap, basic_buffer<RefCount>>::convert(*this, opts);
+  }
+
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_buffer<RefCount> basic_heap<RefCount>::lower() const {
@@ -422,6 +428,11 @@ namespace dart {
     return size() == 0ULL;
   }
 
+  template <template <class> class RefCount>
+  size_t basic_heap<RefCount>::hash() const noexcept {
+    return static_cast<size_t>(hash_impl());
+  }
+
   template <template <class> class RefCount>
   bool basic_heap<RefCount>::is_object() const noexcept {
     return shim::holds_alternative<fields_type>(data);
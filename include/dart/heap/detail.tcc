@@ -55,14 +55,14 @@ namespace dart {
   template <template <class> class RefCount>
   void basic_heap<RefCount>::copy_on_write(size_type overcount) {
     if (refcount() > overcount) {
-      if (is_object()) data = fields_type(new packet_fields(get_fields()));
-      else if (is_array()) data = elements_type(new packet_elements(get_elements()));
+      if (is_object()) data = make_shareable<fields_rc_type>(get_fields());
+      else if (is_array()) data = make_shareable<elements_rc_type>(get_elements());
     }
   }
 
   // FIXME: Audit this function. A LOT has changed since it was written.
   template <template <class> class RefCount>
-  auto basic_heap<RefCount>::upper_bound() const -> size_type {
+  auto basic_heap<RefCount>::upper_bound(finalize_options const& opts, detail::layout_plan* plan) const -> size_type {
     switch (get_raw_type()) {
       case detail::raw_type::object:
         {
@@ -70,11 +70,12 @@ namespace dart {
           // The plus one is to account for any potentially required padding.
           auto* fields = try_get_fields();
           size_t max = sizeof(detail::object<RefCount>) + ((sizeof(detail::object_entry) * (fields->size() + 1)));
+          max += detail::object<RefCount>::extension_sizeof(opts);
 
           // Now iterate over our fields and calculate the max memory required for each.
           for (auto& field : *fields) {
             // Get the maximum size of both our key and value.
-            size_t key_max = field.first.upper_bound(), val_max = field.second.upper_bound();
+            size_t key_max = field.first.upper_bound(opts, plan), val_max = field.second.upper_bound(opts, plan);
 
             // Total size required for this field is the max size of the key, plus the maximum required
             // padding for the value type (minus 1), plus the max size of the value, plus the maximum
@@ -87,29 +88,40 @@ namespace dart {
           // without ruining their alignment.
           max = detail::pad_bytes<RefCount>(max, detail::raw_type::object);
 
-          // Make sure we aren't going to exceed the maximum offset value we can encode in our vtable.
-          if (max > max_aggregate_size) {
-            throw std::length_error("Offset required for encoding is too large for dart::packet vtable");
+          // Objects too large to address with 32-bit offsets are laid out in the wide encoding,
+          // which costs another 8 bytes of header, and another 8 bytes for every vtable entry.
+          auto const width = plan_width(opts, max, plan);
+          if (width == detail::layout_format::wide) {
+            max += sizeof(detail::wide_header) - sizeof(detail::object<RefCount>);
+            max += (sizeof(detail::wide_object_entry) - sizeof(detail::object_entry)) * (fields->size() + 1);
           }
           return max;
         }
       case detail::raw_type::array:
         {
+          // Packed arrays are exactly as large as their elements, plus a fixed header.
+          auto* elements = try_get_elements();
+          auto const packed = packed_type(opts);
+          if (packed != detail::raw_type::null) {
+            return detail::array<RefCount>::packed_sizeof(packed, elements->size());
+          }
+
           // Start with the base size of the array structure, then add the size of our vtable.
           // The plus one is to account for any potentially required padding.
-          auto* elements = try_get_elements();
           size_t max = sizeof(detail::array<RefCount>) + (sizeof(detail::array_entry) * (elements->size() + 1));
 
           // Now iterate over each element and add their max size.
           // Max size for each element is considered to be their reported maximum size, plus the maximum required
           // padding for the next element.
           for (auto& elem : *elements) {
-            max += elem.upper_bound() + detail::alignment_of<RefCount>(elem.get_raw_type()) - 1;
+            max += elem.upper_bound(opts, plan) + detail::alignment_of<RefCount>(elem.get_raw_type()) - 1;
           }
 
-          // Make sure we aren't going to exceed the maximum offset value we can encode in our vtable.
-          if (max > max_aggregate_size) {
-            throw std::length_error("Offset required for encoding is too large for dart::packet vtable");
+          // Same as for objects, arrays too large for 32-bit offsets are laid out in the wide encoding.
+          auto const width = plan_width(opts, max, plan);
+          if (width == detail::layout_format::wide) {
+            max += sizeof(detail::wide_header) - sizeof(detail::array<RefCount>);
+            max += (sizeof(detail::wide_array_entry) - sizeof(detail::array_entry)) * (elements->size() + 1);
           }
           return max;
         }
@@ -141,17 +153,22 @@ namespace dart {
   }
 
   template <template <class> class RefCount>
-  auto basic_heap<RefCount>::layout(gsl::byte* buffer) const noexcept -> size_type {
+  auto basic_heap<RefCount>::layout(gsl::byte* buffer,
+      finalize_options const& opts, detail::layout_plan const* plan) const -> size_type {
     // Construct a wrapper class of the correct type in the provided buffer, and return the number
     // of bytes used.
     auto raw = get_raw_type();
     switch (raw) {
       case detail::raw_type::object:
-        new(buffer) detail::object<RefCount>(try_get_fields());
+        new(buffer) detail::object<RefCount>(try_get_fields(), opts, layout_width(opts, plan), plan);
         break;
       case detail::raw_type::array:
-        new(buffer) detail::array<RefCount>(try_get_elements());
-        break;
+        {
+          auto const packed = packed_type(opts);
+          if (packed != detail::raw_type::null) new(buffer) detail::array<RefCount>(try_get_elements(), packed);
+          else new(buffer) detail::array<RefCount>(try_get_elements(), opts, layout_width(opts, plan), plan);
+          break;
+        }
       case detail::raw_type::small_string:
       case detail::raw_type::string:
         {
@@ -190,6 +207,43 @@ namespace dart {
     return detail::find_sizeof<RefCount>({raw, buffer});
   }
 
+  template <template <class> class RefCount>
+  auto basic_heap<RefCount>::plan_width(finalize_options const& opts,
+      size_type bound, detail::layout_plan* plan) const -> detail::layout_format {
+    // Aggregates that don't fit in 32-bit offsets have to be wide, whatever the policy.
+    // Compact aggregates can only address 64KB, and the bound assumes the standard encoding
+    // for everything beneath us, so choosing them off of it is conservative.
+    auto width = detail::layout_format::standard;
+    if (opts.offsets == offset_policy::wide || bound > max_aggregate_size) {
+      width = detail::layout_format::wide;
+    } else if (opts.offsets == offset_policy::automatic && bound <= detail::compact_layout::max_offset) {
+      width = detail::layout_format::compact;
+    }
+
+    // Remember the decision so that layout_width doesn't have to size us again.
+    if (plan && width != detail::layout_format::standard) plan->emplace(layout_key(), width);
+    return width;
+  }
+
+  template <template <class> class RefCount>
+  auto basic_heap<RefCount>::layout_width(finalize_options const& opts,
+      detail::layout_plan const* plan) const noexcept -> detail::layout_format {
+    // This has to agree with the decision upper_bound made when sizing our buffer, which it
+    // recorded in the plan. Without one, nothing beneath us can need anything but the policy.
+    if (opts.offsets == offset_policy::wide) return detail::layout_format::wide;
+    else if (!plan || plan->empty()) return detail::layout_format::standard;
+
+    auto it = plan->find(layout_key());
+    if (it == plan->end()) return detail::layout_format::standard;
+    return it->second;
+  }
+
+  template <template <class> class RefCount>
+  void const* basic_heap<RefCount>::layout_key() const noexcept {
+    if (is_object()) return try_get_fields();
+    else return try_get_elements();
+  }
+
   template <template <class> class RefCount>
   detail::raw_type basic_heap<RefCount>::get_raw_type() const noexcept {
     switch (get_type()) {
@@ -253,12 +307,84 @@ namespace dart {
     else return nullptr;
   }
 
+  template <template <class> class RefCount>
+  auto basic_heap<RefCount>::packed_type(finalize_options const& opts) const noexcept -> detail::raw_type {
+    // Only arrays can be packed, and only if they were asked to be.
+    auto* elements = try_get_elements();
+    if (opts.arrays != array_policy::packed || !elements || elements->empty()) {
+      return detail::raw_type::null;
+    } else if (elements->size() > detail::array<RefCount>::max_packed_elems) {
+      return detail::raw_type::null;
+    }
+
+    // Every element has to share a type, but not necessarily a width.
+    // Elements are packed at the width we store them at, rather than the narrowest width that
+    // fits them all, so that readers can view them as the same types they were written with.
+    auto const simple = detail::simplify_type(elements->front().get_raw_type());
+    for (auto const& elem : *elements) {
+      if (detail::simplify_type(elem.get_raw_type()) != simple) return detail::raw_type::null;
+    }
+
+    auto packed = detail::raw_type::null;
+    switch (simple) {
+      case detail::type::integer:
+        packed = detail::raw_type::long_integer;
+        break;
+      case detail::type::decimal:
+        packed = detail::raw_type::long_decimal;
+        break;
+      case detail::type::boolean:
+        packed = detail::raw_type::boolean;
+        break;
+      default:
+        return detail::raw_type::null;
+    }
+
+    // Packed arrays still record their length in 32 bits.
+    if (detail::array<RefCount>::packed_sizeof(packed, elements->size()) > max_aggregate_size) {
+      return detail::raw_type::null;
+    }
+    return packed;
+  }
+
   template <template <class> class RefCount>
   auto basic_heap<RefCount>::try_get_elements() const noexcept -> packet_elements const* {
     if (is_array()) return shim::get<elements_type>(data).get();
     else return nullptr;
   }
 
+  template <template <class> class RefCount>
+  uint64_t basic_heap<RefCount>::hash_impl() const noexcept {
+    // Mirrors detail::hash_raw, which hashes finalized packets, value for value.
+    switch (get_type()) {
+      case type::object:
+        {
+          uint64_t fields = 0;
+          auto const* fs = try_get_fields();
+          for (auto const& field : *fs) fields += detail::hash_field(field.first.strv(), field.second.hash_impl());
+          return detail::hash_object(fs->size(), fields);
+        }
+      case type::array:
+        {
+          auto const* elems = try_get_elements();
+          auto hash = detail::hash_array(elems->size());
+          for (auto const& elem : *elems) hash = detail::hash_combine(hash, elem.hash_impl());
+          return hash;
+        }
+      case type::string:
+        return detail::hash_string(strv());
+      case type::integer:
+        return detail::hash_integer(integer());
+      case type::decimal:
+        return detail::hash_decimal(decimal());
+      case type::boolean:
+        return detail::hash_boolean(boolean());
+      default:
+        DART_ASSERT(is_null());
+        return detail::hash_null();
+    }
+  }
+
 }
 
 #endif
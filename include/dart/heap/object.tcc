@@ -154,6 +154,32 @@ namespace dart {
     return project_keys(keys);
   }
 
+  template <template <class> class RefCount>
+  template <bool enabled, class EnableIf>
+  basic_heap<RefCount> basic_heap<RefCount>::deep_merge(basic_heap const& incoming) const {
+    // Validate that what we're being asked to do makes sense.
+    if (!is_object() || !incoming.is_object()) {
+      throw type_error("dart::heap is not an object and cannot be merged");
+    }
+
+    // Copies are shallow, so nested objects only end up being copied
+    // along the paths the incoming object actually modifies.
+    auto obj {*this};
+    for (auto& field : *incoming.try_get_fields()) {
+      auto& key = field.first;
+      auto& val = field.second;
+      if (val.is_object()) {
+        auto curr = obj.get(key.strv());
+        if (curr.is_object()) {
+          obj.insert(key, curr.deep_merge(val));
+          continue;
+        }
+      }
+      obj.insert(key, val);
+    }
+    return obj;
+  }
+
   template <template <class> class RefCount>
   template <class String>
   basic_heap<RefCount> basic_heap<RefCount>::operator [](basic_string<String> const& key) const {
@@ -53,7 +53,7 @@ namespace dart {
 
     template <template <class> class RefCount>
     auto ll_iterator<RefCount>::operator *() const noexcept -> value_type {
-      return load_func(base, idx);
+      return load_func(base, idx, dict);
     }
 
     template <template <class> class RefCount>
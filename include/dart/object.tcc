@@ -208,7 +208,7 @@ namespace dart {
       for (auto idx = 0U; idx < elems; ++idx) {
         // Using the current offset, align a pointer for the key (string type).
         auto* unaligned = DART_FROM_THIS_MUT + offset;
-        auto* aligned = align_pointer<RefCount>(unaligned, detail::raw_type::string);
+        auto* aligned = zero_align_pointer<RefCount>(unaligned, detail::raw_type::string);
         offset += aligned - unaligned;
 
         // Get our key/value from sajson.
@@ -226,7 +226,7 @@ namespace dart {
 
         // Realign our pointer for our value type.
         unaligned = DART_FROM_THIS_MUT + offset;
-        aligned = align_pointer<RefCount>(unaligned, val_type);
+        aligned = zero_align_pointer<RefCount>(unaligned, val_type);
         offset += aligned - unaligned;
 
         // Layout our value (or copy it in if it's already been finalized).
@@ -235,7 +235,7 @@ namespace dart {
 
       // This is necessary to ensure packets can be naively stored in
       // contiguous buffers without ruining their alignment.
-      offset = pad_bytes<RefCount>(offset, detail::raw_type::object);
+      offset = zero_pad_bytes<RefCount>(DART_FROM_THIS_MUT, offset, detail::raw_type::object);
 
       // object is laid out, write in our final size.
       bytes = static_cast<uint32_t>(offset);
@@ -275,19 +275,20 @@ namespace dart {
       for (auto& it : sorted) {
         // Using the current offset, align a pointer for the key (string type).
         auto* unaligned = DART_FROM_THIS_MUT + offset;
-        auto* aligned = align_pointer<RefCount>(unaligned, detail::raw_type::string);
+        auto* aligned = zero_align_pointer<RefCount>(unaligned, detail::raw_type::string);
         offset += aligned - unaligned;
 
         // Add an entry to the vtable.
         auto val_type = json_identify<RefCount>(it->value);
-        new(entry++) object_entry(val_type, static_cast<uint32_t>(offset), it->name.GetString());
+        shim::string_view keyv {it->name.GetString(), it->name.GetStringLength()};
+        new(entry++) object_entry(val_type, static_cast<uint32_t>(offset), keyv);
 
         // Layout our key.
         offset += json_lower<RefCount>(aligned, it->name);
 
         // Realign our pointer for our value type.
         unaligned = DART_FROM_THIS_MUT + offset;
-        aligned = align_pointer<RefCount>(unaligned, val_type);
+        aligned = zero_align_pointer<RefCount>(unaligned, val_type);
         offset += aligned - unaligned;
 
         // Layout our value (or copy it in if it's already been finalized).
@@ -296,7 +297,7 @@ namespace dart {
 
       // This is necessary to ensure packets can be naively stored in
       // contiguous buffers without ruining their alignment.
-      offset = pad_bytes<RefCount>(offset, detail::raw_type::object);
+      offset = zero_pad_bytes<RefCount>(DART_FROM_THIS_MUT, offset, detail::raw_type::object);
 
       // object is laid out, write in our final size.
       bytes = static_cast<uint32_t>(offset);
@@ -313,20 +314,20 @@ namespace dart {
       for (auto& pair : pairs) {
         // Using the current offset, align a pointer for the key (string type).
         auto* unaligned = DART_FROM_THIS_MUT + offset;
-        auto* aligned = align_pointer<RefCount>(unaligned, detail::raw_type::string);
+        auto* aligned = zero_align_pointer<RefCount>(unaligned, detail::raw_type::string);
         offset += aligned - unaligned;
 
         // Add an entry to the vtable.
         new(entry++)
           object_entry(pair.value.get_raw_type(),
-            static_cast<uint32_t>(offset), pair.key.str());
+            static_cast<uint32_t>(offset), pair.key.strv());
 
         // Layout our key.
         offset += pair.key.layout(aligned);
 
         // Realign our pointer for our value type.
         unaligned = DART_FROM_THIS_MUT + offset;
-        aligned = align_pointer<RefCount>(unaligned, pair.value.get_raw_type());
+        aligned = zero_align_pointer<RefCount>(unaligned, pair.value.get_raw_type());
         offset += aligned - unaligned;
 
         // Layout our value (or copy it in if it's already been finalized).
@@ -335,107 +336,218 @@ namespace dart {
 
       // This is necessary to ensure packets can be naively stored in
       // contiguous buffers without ruining their alignment.
-      offset = pad_bytes<RefCount>(offset, detail::raw_type::object);
+      offset = zero_pad_bytes<RefCount>(DART_FROM_THIS_MUT, offset, detail::raw_type::object);
 
       // object is laid out, write in our final size.
       bytes = static_cast<uint32_t>(offset);
     }
 
-    // FIXME: Audit this function. A LOT has changed since it was written.
     template <template <class> class RefCount>
-    object<RefCount>::object(packet_fields<RefCount> const* fields) noexcept :
+    object<RefCount>::object(packet_fields<RefCount> const* fields,
+        finalize_options const& opts, layout_format width, layout_plan const* plan) :
       elems(static_cast<uint32_t>(fields->size()))
     {
+      // Objects keyed against a dictionary only ever use 32-bit offsets, and never cache prefixes.
+      if (!opts.dictionary.empty()) {
+        layout_keyed(fields, opts, plan);
+        return;
+      }
+
+      // Whoever sized our buffer decided how wide our offsets can be.
+      // If we've been asked to, and our keys share any leading bytes, also record how many
+      // of them the vtable should skip over before caching each prefix.
+      prefix_skip skip {};
+      if (opts.prefix == prefix_policy::discriminating) skip = discriminating_skip(*fields);
+      set_format(width, fields->size());
+      if (skip.skip) set_key_skip(skip);
+
+      if (is_compact(width)) layout_fields<compact_object_entry>(fields, opts, plan, skip);
+      else if (is_wide(width)) layout_fields<wide_object_entry>(fields, opts, plan, skip);
+      else layout_fields<object_entry>(fields, opts, plan, skip);
+    }
+
+    // FIXME: Audit this function. A LOT has changed since it was written.
+    template <template <class> class RefCount>
+    template <class Entry>
+    void object<RefCount>::layout_fields(packet_fields<RefCount> const* fields,
+        finalize_options const& opts, layout_plan const* plan, prefix_skip skip) {
       // Iterate over our elements and write each one into the buffer.
-      object_entry* entry = vtable();
-      size_t offset = reinterpret_cast<gsl::byte*>(&vtable()[elems]) - DART_FROM_THIS_MUT;
+      using offset_type = typename Entry::offset_type;
+      Entry* entry = vtable<Entry>();
+      size_t offset = reinterpret_cast<gsl::byte*>(&vtable<Entry>()[size()]) - DART_FROM_THIS_MUT;
+      string_offsets strings;
+      if (opts.strings == string_policy::shared) strings.reserve(size());
       for (auto const& field : *fields) {
         // Using the current offset, align a pointer for the key (string type).
         auto* unaligned = DART_FROM_THIS_MUT + offset;
-        auto* aligned = align_pointer<RefCount>(unaligned, detail::raw_type::string);
+        auto* aligned = zero_align_pointer<RefCount>(unaligned, detail::raw_type::string);
         offset += aligned - unaligned;
 
         // Add an entry to the vtable.
-        new(entry++)
-          object_entry(field.second.get_raw_type(),
-              static_cast<uint32_t>(offset), field.first.str());
+        auto const key = field.first.strv();
+        auto const type = field.second.get_raw_type();
+        auto* curr = new(entry++) Entry(type, offset, key, skip.for_length(key.size()));
 
         // Layout our key.
-        offset += field.first.layout(aligned);
+        offset += field.first.layout(aligned, opts);
+
+        // If we've been asked to, and the value is a string we've already laid out, follow the key
+        // with the offset of the earlier copy instead of the value. Strings at least twice as long as
+        // the offset always take more space than it does, even once it's padded out.
+        auto const shared = opts.strings == string_policy::shared && simplify_type(type) == detail::type::string
+          && field.second.strv().size() >= 2 * sizeof(offset_type);
+        if (shared) {
+          auto const it = strings.find(field.second.strv());
+          if (it != strings.end()) {
+            unaligned = DART_FROM_THIS_MUT + offset;
+            aligned = zero_align_pointer_for<offset_type>(unaligned);
+            offset += aligned - unaligned;
+            curr->set_shared();
+            new(aligned) little_order<offset_type>(static_cast<offset_type>(it->second));
+            offset += sizeof(offset_type);
+            continue;
+          }
+        }
 
         // Realign our pointer for our value type.
         unaligned = DART_FROM_THIS_MUT + offset;
-        aligned = align_pointer<RefCount>(unaligned, field.second.get_raw_type());
+        aligned = zero_align_pointer<RefCount>(unaligned, type);
         offset += aligned - unaligned;
+        if (shared) strings.emplace(field.second.strv(), offset);
 
         // Layout our value (or copy it in if it's already been finalized).
-        offset += field.second.layout(aligned);
+        offset += field.second.layout(aligned, opts, plan);
       }
 
       // This is necessary to ensure packets can be naively stored in
       // contiguous buffers without ruining their alignment.
-      offset = pad_bytes<RefCount>(offset, detail::raw_type::object);
+      offset = zero_pad_bytes<RefCount>(DART_FROM_THIS_MUT, offset, detail::raw_type::object);
 
       // object is laid out, write in our final size.
-      bytes = static_cast<uint32_t>(offset);
+      set_sizeof(offset);
+    }
+
+    template <template <class> class RefCount>
+    void object<RefCount>::layout_keyed(packet_fields<RefCount> const* fields,
+        finalize_options const& opts, layout_plan const* plan) {
+      // Record which dictionary we're keyed against, so that readers can refuse to use any other.
+      auto const& dict = *dictionary_access::get(opts.dictionary);
+      set_format(layout_format::dictionary);
+      auto* ext = new(raw_vtable() - sizeof(dictionary_extension)) dictionary_extension;
+      ext->version = dict.version;
+
+      // Our fields are sorted in the same order the dictionary handed out its ids in,
+      // so one pass over the keys it contains lays them out in order of id,
+      // and a second pass lays out the rest after them.
+      auto* entry = vtable<dictionary_entry>();
+      size_t offset = reinterpret_cast<gsl::byte*>(&entry[size()]) - DART_FROM_THIS_MUT;
+      string_offsets strings;
+      if (opts.strings == string_policy::shared) strings.reserve(size());
+      for (auto const& field : *fields) {
+        auto const id = dict.find(field.first.strv());
+        if (id == dictionary_entry::inline_id) continue;
+
+        // Keys the dictionary contains aren't stored at all, so point the entry straight at the value,
+        // which, if we've been asked to, can be a string we've already laid out.
+        auto const type = field.second.get_raw_type();
+        auto const shared = opts.strings == string_policy::shared && simplify_type(type) == detail::type::string;
+        if (shared) {
+          auto const it = strings.find(field.second.strv());
+          if (it != strings.end()) {
+            new(entry++) dictionary_entry(type, it->second, id);
+            continue;
+          }
+        }
+
+        auto* unaligned = DART_FROM_THIS_MUT + offset;
+        auto* aligned = zero_align_pointer<RefCount>(unaligned, type);
+        offset += aligned - unaligned;
+        new(entry++) dictionary_entry(type, offset, id);
+        if (shared) strings.emplace(field.second.strv(), offset);
+        offset += field.second.layout(aligned, opts, plan);
+      }
+      for (auto const& field : *fields) {
+        if (dict.find(field.first.strv()) != dictionary_entry::inline_id) continue;
+
+        // Anything else is stored inline, exactly as it would be in the standard encoding.
+        auto* unaligned = DART_FROM_THIS_MUT + offset;
+        auto* aligned = zero_align_pointer<RefCount>(unaligned, detail::raw_type::string);
+        offset += aligned - unaligned;
+        new(entry++) dictionary_entry(field.second.get_raw_type(), offset, dictionary_entry::inline_id);
+        offset += field.first.layout(aligned, opts);
+
+        unaligned = DART_FROM_THIS_MUT + offset;
+        aligned = zero_align_pointer<RefCount>(unaligned, field.second.get_raw_type());
+        offset += aligned - unaligned;
+        offset += field.second.layout(aligned, opts, plan);
+      }
+
+      // This is necessary to ensure packets can be naively stored in
+      // contiguous buffers without ruining their alignment.
+      offset = zero_pad_bytes<RefCount>(DART_FROM_THIS_MUT, offset, detail::raw_type::object);
+      set_sizeof(offset);
     }
 
     template <template <class> class RefCount>
     object<RefCount>::object(object const* base, object const* incoming) noexcept : elems(0) {
-      // This is unfortunate.
-      // We need to merge together two objects that may contain duplicate keys,
-      // but before we can start laying out the object we have to know how many
+      // Before we can start laying out the object we have to know how many
       // keys will be present so we can calculate the address of the end of the vtable.
-      // Unfortunately we can't know how many keys there will be until we've already
-      // walked across the objects and de-duped things, which is expensive, and so
-      // for now we'll just assume that all keys are unique (conservative option, maximum
-      // memory usage by the vtable), and memmove things after the fact if that assumption
-      // turns out to be inaccurate.
-      // Note that, of course this whole problem could be solved by creating a
-      // temporary std::unordered_set to dedupe the keys for us, but the cost of doing so
-      // would completely defeat the point of this whole pathway.
-      auto guess = base->size() + incoming->size();
+      // Both vtables are sorted, so a quick walk across them (which only touches the keys
+      // themselves when their prefixes collide) tells us exactly how many keys survive de-duping.
+      auto const total = count_unique_keys(base, incoming);
 
       // Iterate across both object simultaneously, uniquely visiting each key-value pair,
       // giving precedence to the incoming packet for collisions.
       // Write each pair into our buffer.
       object_entry* entry = vtable();
-      size_t offset = reinterpret_cast<gsl::byte*>(&vtable()[guess]) - DART_FROM_THIS_MUT;
+      size_t offset = reinterpret_cast<gsl::byte*>(&vtable()[total]) - DART_FROM_THIS_MUT;
       buffer_builder<RefCount>::each_unique_pair(base, incoming, [&] (auto raw_key, auto raw_val) {
-        // Using the current offset, align a pointer for the key (string type).
-        auto* unaligned = DART_FROM_THIS_MUT + offset;
-        auto* aligned = align_pointer<RefCount>(unaligned, detail::raw_type::string);
-        offset += aligned - unaligned;
+        offset = layout_pair(entry++, offset, raw_key, raw_val);
+        ++elems;
+      });
 
-        // Add an entry to the vtable.
-        auto* key = get_string(raw_key);
-        new(entry++) object_entry(raw_val.type,
-            static_cast<uint32_t>(offset), key->get_strv().data());
+      assert(elems == total);
 
-        // Copy in our key.
-        auto key_len = find_sizeof<RefCount>(raw_key);
-        std::copy_n(raw_key.buffer, key_len, aligned);
-        offset += key_len;
+      // This is necessary to ensure packets can be naively stored in
+      // contiguous buffers without ruining their alignment.
+      offset = zero_pad_bytes<RefCount>(DART_FROM_THIS_MUT, offset, detail::raw_type::object);
 
-        // Realign our pointer for our value type.
-        unaligned = DART_FROM_THIS_MUT + offset;
-        aligned = align_pointer<RefCount>(unaligned, raw_val.type);
-        offset += aligned - unaligned;
+      // object is laid out, write in our final size.
+      bytes = static_cast<uint32_t>(offset);
+    }
+
+    template <template <class> class RefCount>
+    object<RefCount>::object(object const* base, object const* incoming, deep_merge_tag) noexcept : elems(0) {
+      // Recursing into nested objects doesn't change which keys survive at this level,
+      // so the vtable is sized exactly as it would be for a shallow merge.
+      auto const total = count_unique_keys(base, incoming);
 
-        // Copy in our value
-        auto val_len = find_sizeof<RefCount>(raw_val);
-        std::copy_n(raw_val.buffer, val_len, aligned);
-        offset += val_len;
+      // Same walk as the shallow merge, except that collisions between two objects
+      // are merged, in place, directly into our buffer instead of being overwritten.
+      object_entry* entry = vtable();
+      size_t offset = reinterpret_cast<gsl::byte*>(&vtable()[total]) - DART_FROM_THIS_MUT;
+      each_merged_pair(base, incoming, [&] (auto* obj, auto idx, auto* shadowed, auto shadowed_idx) {
+        auto raw_key = load_key(reinterpret_cast<gsl::byte const*>(obj), idx);
+        auto raw_val = load_value(reinterpret_cast<gsl::byte const*>(obj), idx);
+        if (shadowed && raw_val.type == raw_type::object) {
+          auto shadowed_val = load_value(reinterpret_cast<gsl::byte const*>(shadowed), shadowed_idx);
+          if (shadowed_val.type == raw_type::object) {
+            offset = layout_key(entry++, offset, raw_key, raw_type::object);
+            auto* nested = new(DART_FROM_THIS_MUT + offset)
+              object(get_object<RefCount>(shadowed_val), get_object<RefCount>(raw_val), deep_merge_tag {});
+            offset += nested->get_sizeof();
+            ++elems;
+            return;
+          }
+        }
+        offset = layout_pair(entry++, offset, raw_key, raw_val);
         ++elems;
       });
-
-      // Alright, since we guessed at the total size of the object, we now have to handle
-      // the case where we were wrong.
-      if (elems != guess) offset = realign(guess, offset);
+      assert(elems == total);
 
       // This is necessary to ensure packets can be naively stored in
       // contiguous buffers without ruining their alignment.
-      offset = pad_bytes<RefCount>(offset, detail::raw_type::object);
+      offset = zero_pad_bytes<RefCount>(DART_FROM_THIS_MUT, offset, detail::raw_type::object);
 
       // object is laid out, write in our final size.
       bytes = static_cast<uint32_t>(offset);
@@ -444,47 +556,44 @@ namespace dart {
     template <template <class> class RefCount>
     template <class Key>
     object<RefCount>::object(object const* base, gsl::span<Key const*> key_ptrs) noexcept : elems(0) {
-      // Need to guess again. To see the reasoning for this, check the object merge constructor.
-      auto guess = key_ptrs.size();
+      // Need to count again. To see the reasoning for this, check the object merge constructor.
+      auto const total = count_projected_keys(base, key_ptrs);
 
       // Iterate over our elements and write each one into the buffer.
       object_entry* entry = vtable();
-      size_t offset = reinterpret_cast<gsl::byte*>(&vtable()[guess]) - DART_FROM_THIS_MUT;
+      size_t offset = reinterpret_cast<gsl::byte*>(&vtable()[total]) - DART_FROM_THIS_MUT;
       buffer_builder<RefCount>::project_each_pair(base, key_ptrs, [&] (auto raw_key, auto raw_val) {
-        // Using the current offset, align a pointer for the key (string type).
-        auto* unaligned = DART_FROM_THIS_MUT + offset;
-        auto* aligned = align_pointer<RefCount>(unaligned, detail::raw_type::string);
-        offset += aligned - unaligned;
+        offset = layout_pair(entry++, offset, raw_key, raw_val);
+        ++elems;
+      });
 
-        // Add an entry to the vtable.
-        auto* key = get_string(raw_key);
-        new(entry++) object_entry(raw_val.type,
-            static_cast<uint32_t>(offset), key->get_strv().data());
+      assert(elems == total);
 
-        // Copy in our key.
-        auto key_len = find_sizeof<RefCount>(raw_key);
-        std::copy_n(raw_key.buffer, key_len, aligned);
-        offset += key_len;
+      // This is necessary to ensure packets can be naively stored in
+      // contiguous buffers without ruining their alignment.
+      offset = zero_pad_bytes<RefCount>(DART_FROM_THIS_MUT, offset, detail::raw_type::object);
 
-        // Realign our pointer for our value type.
-        unaligned = DART_FROM_THIS_MUT + offset;
-        aligned = align_pointer<RefCount>(unaligned, raw_val.type);
-        offset += aligned - unaligned;
+      // object is laid out, write in our final size.
+      bytes = static_cast<uint32_t>(offset);
+    }
 
-        // Copy in our value
-        auto val_len = find_sizeof<RefCount>(raw_val);
-        std::copy_n(raw_val.buffer, val_len, aligned);
-        offset += val_len;
+    template <template <class> class RefCount>
+    object<RefCount>::object(gsl::span<merge_source> sources, size_t total) noexcept : elems(0) {
+      // Same problem as the two-way merge constructor, we need to know how many keys
+      // will survive before we know where the vtable ends, but merged_sizeof already counted them.
+      // Walk across every object, writing each winning pair into our buffer.
+      object_entry* entry = vtable();
+      size_t offset = reinterpret_cast<gsl::byte*>(&vtable()[total]) - DART_FROM_THIS_MUT;
+      each_merged_entry(sources, [&] (auto* obj, auto idx) {
+        auto* base = reinterpret_cast<gsl::byte const*>(obj);
+        offset = layout_pair(entry++, offset, load_key(base, idx), load_value(base, idx));
         ++elems;
       });
-
-      // Alright, since we guessed at the total size of the object, we now have to handle
-      // the case where we were wrong.
-      if (elems != guess) offset = realign(guess, offset);
+      assert(elems == total);
 
       // This is necessary to ensure packets can be naively stored in
       // contiguous buffers without ruining their alignment.
-      offset = pad_bytes<RefCount>(offset, detail::raw_type::object);
+      offset = zero_pad_bytes<RefCount>(DART_FROM_THIS_MUT, offset, detail::raw_type::object);
 
       // object is laid out, write in our final size.
       bytes = static_cast<uint32_t>(offset);
@@ -503,13 +612,23 @@ namespace dart {
 
     template <template <class> class RefCount>
     template <bool silent>
-    bool object<RefCount>::is_valid(size_t bytes) const noexcept(silent) {
+    bool object<RefCount>::is_valid(size_t bytes, dictionary_storage const* dict) const noexcept(silent) {
       // Check if we even have enough space left for the object header.
       if (bytes < header_len) {
         if (silent) return false;
         else throw validation_error("Serialized object is truncated");
       }
 
+      // Alternative encodings can carry more header than the standard one (including a wider length),
+      // so make sure we understand the encoding, and that its header fits, before reading any further.
+      if (format() > layout_format::wide_keyed && format() != layout_format::dictionary) {
+        if (silent) return false;
+        else throw validation_error("Serialized object uses an unknown encoding");
+      } else if (header_sizeof() > bytes) {
+        if (silent) return false;
+        else throw validation_error("Serialized object header is truncated");
+      }
+
       // We now know it's safe to access the object length, but it still could be garbage,
       // so check if the object claims to be larger than our total buffer.
       // After this check, all other length checks will use the length reported by the object
@@ -519,28 +638,47 @@ namespace dart {
       if (total_size > static_cast<ssize_t>(bytes)) {
         if (silent) return false;
         else throw validation_error("Serialized object length is out of bounds");
+      } else if (static_cast<std::ptrdiff_t>(header_sizeof()) > total_size) {
+        if (silent) return false;
+        else throw validation_error("Serialized object header is truncated");
       }
 
-      // The object reports a reasonable total length,
-      // so now check if the vtable is within bounds.
-      auto* vtable_end = raw_vtable() + (size() * sizeof(object_entry));
+      // The object reports a reasonable total length, but wide objects carry a full 64-bit count,
+      // so make sure the count can't overflow the vtable length before checking its bounds.
+      auto const max_entries = (static_cast<size_t>(total_size) - header_sizeof()) / entry_sizeof();
+      if (size() > max_entries) {
+        if (silent) return false;
+        else throw validation_error("Serialized object vtable length is out of bounds");
+      }
+      auto* vtable_end = raw_vtable() + (size() * entry_sizeof());
       if (vtable_end - DART_FROM_THIS > total_size) {
         if (silent) return false;
         else throw validation_error("Serialized object vtable length is out of bounds");
       }
 
+      // Objects keyed against a dictionary lay out their vtables differently enough
+      // to be checked separately.
+      if (format() == layout_format::dictionary) return is_valid_keyed<silent>(total_size, dict);
+
       // We now know that the vtable is fully within bounds, but it could still be full of crap
       // Check that every element in the vtable has a valid type
-      for (size_t i = 0; i < size(); ++i) {
-        if (!valid_type(vtable()[i].get_type())) {
-          if (silent) return false;
-          else throw validation_error("Serialized object value is of no known type");
+      auto const types_valid = visit_vtable([&] (auto const* entries) {
+        for (size_t i = 0; i < size(); ++i) {
+          if (!valid_type(entries[i].get_type())) return false;
         }
+        return true;
+      });
+      if (!types_valid) {
+        if (silent) return false;
+        else throw validation_error("Serialized object value is of no known type");
       }
 
       // We now know the entire vtable is within bounds,
       // so iterate over it and check all contained children.
+      size_t idx = 0;
       void const* prev = this;
+      shim::string_view prev_key;
+      auto const skip = key_skip();
       auto key_it = key_begin(), val_it = begin();
       while (val_it != end()) {
         // We know the whole vtable is within bounds, but it could still specify offsets that aren't,
@@ -568,28 +706,159 @@ namespace dart {
         auto valid_key = valid_buffer<silent, RefCount>(raw_key, total_size - key_offset);
         if (!valid_key) return false;
 
+        // Values are found using the key length cached in the vtable, so make sure the entry
+        // actually describes the key it points to before trusting it.
+        auto const key_strv = get_string(raw_key)->get_strv();
+        auto const entry_matches = visit_vtable([&] (auto const* entries) {
+          using entry_type = std::decay_t<decltype(*entries)>;
+          auto const& entry = entries[idx];
+          auto const key_skip = skip.for_length(key_strv.size());
+          return !entry.entry_compare(entry_type {entry.get_type(), entry.get_offset(), key_strv, key_skip});
+        });
+        if (!entry_matches) {
+          if (silent) return false;
+          else throw validation_error("Serialized object vtable entry does not match its key");
+        }
+
+        // Lookup can only skip over the leading bytes of keys if every key it might
+        // have to tell apart (those of the same length) actually shares them.
+        auto const shared = skip.for_length(key_strv.size());
+        if (shared && idx && prev_key.size() == key_strv.size()) {
+          if (prev_key.substr(0, shared) != key_strv.substr(0, shared)) {
+            if (silent) return false;
+            else throw validation_error("Serialized object keys do not share the prefix skipped by its vtable");
+          }
+        }
+        prev_key = key_strv;
+
+        // Shared values are found through an offset stored after their key (see string_policy::shared),
+        // so make sure it's within bounds before loading it. Only strings can be shared, as they can't
+        // point anywhere themselves, and only with copies laid out earlier, past the vtable.
+        auto const* slot = visit_vtable([&] (auto const* entries) -> gsl::byte const* {
+          using offset_type = typename std::decay_t<decltype(*entries)>::offset_type;
+          auto const& entry = entries[idx];
+          if (!entry.is_shared()) return nullptr;
+          else if (simplify_type(entry.get_type()) != detail::type::string) return raw_key.buffer;
+          auto const* aligned = align_pointer_for<offset_type>(raw_key.buffer + get_string(raw_key)->get_sizeof());
+          return (aligned + sizeof(offset_type) - DART_FROM_THIS <= static_cast<ptrdiff_t>(total_size)) ? aligned : raw_key.buffer;
+        });
+        if (slot == raw_key.buffer) {
+          if (silent) return false;
+          else throw validation_error("Serialized object shared value is not a string, or its offset is out of bounds");
+        }
+
         // Now we can dereference the value iterator since we know the key appears reasonable.
         // Load the base address of the value and verify that it's within bounds.
         auto raw_val = *val_it;
         auto val_offset = raw_val.buffer - DART_FROM_THIS;
+        auto const shared_earlier = slot && raw_val.buffer < raw_key.buffer && raw_val.buffer >= vtable_end;
         if (val_offset > total_size) {
           if (silent) return false;
           else throw validation_error("Serialized object value offset is out of bounds");
-        } else if (raw_val.buffer <= prev) {
+        } else if ((slot && !shared_earlier) || (!slot && raw_val.buffer <= prev)) {
           if (silent) return false;
           else throw validation_error("Serialized object value contained a negative or cyclic offset");
         } else if (align_pointer<RefCount>(raw_val.buffer, raw_val.type) != raw_val.buffer) {
           if (silent) return false;
           else throw validation_error("Serialized object value offset does not meet alignment requirements");
         }
-        prev = raw_val.buffer;
+        prev = slot ? slot : raw_val.buffer;
 
         // We now know that at least up to the base of the value is within bounds, so recurse on the value.
         auto valid_val = valid_buffer<silent, RefCount>(raw_val, total_size - val_offset);
         if (!valid_val) return false;
 
         // Check the next pair.
-        ++key_it, ++val_it;
+        ++key_it, ++val_it, ++idx;
+      }
+      return true;
+    }
+
+    template <template <class> class RefCount>
+    template <bool silent>
+    bool object<RefCount>::is_valid_keyed(size_t total_size, dictionary_storage const* dict) const noexcept(silent) {
+      // Ids mean nothing without the dictionary that handed them out.
+      if (!dict) {
+        if (silent) return false;
+        else throw validation_error("Serialized object is keyed against a dictionary that was not provided");
+      } else if (dictionary_version() != dict->version) {
+        if (silent) return false;
+        else throw validation_error("Serialized object is keyed against a different dictionary");
+      }
+
+      // We already know the vtable is within bounds, so walk it, checking that ids are in bounds and
+      // increasing, that inline keys follow them in order, and that everything else lies past the vtable.
+      // Values don't follow keys the dictionary contains, so null values can legitimately share an offset
+      // with whatever comes next, and strings can be shared (see string_policy::shared).
+      auto const* entries = vtable<dictionary_entry>();
+      auto const* vtable_end = raw_vtable() + (size() * sizeof(dictionary_entry));
+      void const* prev = vtable_end;
+      size_t next_id = 0;
+      shim::string_view prev_key;
+      for (size_t idx = 0; idx < size(); ++idx) {
+        auto const& entry = entries[idx];
+        if (!valid_type(entry.get_type())) {
+          if (silent) return false;
+          else throw validation_error("Serialized object value is of no known type");
+        }
+
+        if (!entry.is_inline()) {
+          if (entry.get_id() < next_id || entry.get_id() >= dict->size()) {
+            if (silent) return false;
+            else throw validation_error("Serialized object vtable ids are out of bounds or out of order");
+          }
+          next_id = entry.get_id() + 1;
+        } else {
+          // Inline keys are checked exactly as they are in any other object.
+          raw_element const raw_key {raw_type::string, DART_FROM_THIS + entry.get_offset()};
+          if (entry.get_offset() > total_size) {
+            if (silent) return false;
+            else throw validation_error("Serialized object key offset is out of bounds");
+          } else if (raw_key.buffer < prev) {
+            if (silent) return false;
+            else throw validation_error("Serialized object key contained a negative or cyclic offset");
+          } else if (align_pointer<RefCount>(raw_key.buffer, raw_key.type) != raw_key.buffer) {
+            if (silent) return false;
+            else throw validation_error("Serialized object key offset does not meet alignment requirements");
+          }
+          prev = raw_key.buffer;
+
+          auto valid_key = valid_buffer<silent, RefCount>(raw_key, total_size - entry.get_offset());
+          if (!valid_key) return false;
+
+          // Lookup only searches for keys the dictionary doesn't contain amongst the inline keys,
+          // so make sure that's the only place they could be.
+          auto const key_strv = get_string(raw_key)->get_strv();
+          if (next_id == dictionary_entry::inline_id && !dart_comparator<RefCount> {}(prev_key, key_strv)) {
+            if (silent) return false;
+            else throw validation_error("Serialized object keys are out of order");
+          } else if (dict->find(key_strv) != dictionary_entry::inline_id) {
+            if (silent) return false;
+            else throw validation_error("Serialized object stores a key inline that its dictionary contains");
+          }
+          prev_key = key_strv;
+          next_id = dictionary_entry::inline_id;
+        }
+
+        // Now it's safe to find the value, and check it too.
+        raw_element const raw_val {entry.get_type(), value_address(DART_FROM_THIS, entry)};
+        auto const val_offset = static_cast<size_t>(raw_val.buffer - DART_FROM_THIS);
+        auto const shared = raw_val.buffer < prev && !entry.is_inline()
+          && simplify_type(raw_val.type) == detail::type::string && raw_val.buffer >= vtable_end;
+        if (val_offset > total_size) {
+          if (silent) return false;
+          else throw validation_error("Serialized object value offset is out of bounds");
+        } else if (raw_val.buffer < prev && !shared) {
+          if (silent) return false;
+          else throw validation_error("Serialized object value contained a negative or cyclic offset");
+        } else if (align_pointer<RefCount>(raw_val.buffer, raw_val.type) != raw_val.buffer) {
+          if (silent) return false;
+          else throw validation_error("Serialized object value offset does not meet alignment requirements");
+        }
+        if (!shared) prev = raw_val.buffer;
+
+        auto valid_val = valid_buffer<silent, RefCount>(raw_val, total_size - val_offset, dict);
+        if (!valid_val) return false;
       }
       return true;
     }
@@ -602,12 +871,32 @@ namespace dart {
 
     template <template <class> class RefCount>
     size_t object<RefCount>::size() const noexcept {
-      return elems;
+      if (is_wide(format())) return get_wide_header()->elems;
+      else return elems & size_mask;
     }
 
     template <template <class> class RefCount>
     size_t object<RefCount>::get_sizeof() const noexcept {
-      return bytes;
+      if (is_wide(format())) return get_wide_header()->bytes & wide_header::size_mask;
+      else return bytes;
+    }
+
+    template <template <class> class RefCount>
+    layout_format object<RefCount>::format() const noexcept {
+      return layout_format(elems >> format_shift);
+    }
+
+    template <template <class> class RefCount>
+    bool object<RefCount>::shares_strings() const noexcept {
+      // Objects keyed against a dictionary share values without flagging them,
+      // but are only ever copied out through the heap.
+      if (format() == layout_format::dictionary) return false;
+      return visit_vtable([&] (auto const* entries) {
+        for (size_t idx = 0; idx < size(); ++idx) {
+          if (entries[idx].is_shared()) return true;
+        }
+        return false;
+      });
     }
 
     template <template <class> class RefCount>
@@ -621,18 +910,29 @@ namespace dart {
     }
 
     template <template <class> class RefCount>
-    auto object<RefCount>::key_begin() const noexcept -> ll_iterator<RefCount> {
-      return ll_iterator<RefCount>(0, DART_FROM_THIS, load_key);
+    auto object<RefCount>::key_begin(dictionary_storage const* dict) const noexcept -> ll_iterator<RefCount> {
+      return ll_iterator<RefCount>(0, DART_FROM_THIS, load_key, dict);
+    }
+
+    template <template <class> class RefCount>
+    auto object<RefCount>::key_end(dictionary_storage const* dict) const noexcept -> ll_iterator<RefCount> {
+      return ll_iterator<RefCount>(size(), DART_FROM_THIS, load_key, dict);
     }
 
     template <template <class> class RefCount>
-    auto object<RefCount>::key_end() const noexcept -> ll_iterator<RefCount> {
-      return ll_iterator<RefCount>(size(), DART_FROM_THIS, load_key);
+    template <class Callback>
+    auto object<RefCount>::get_key(shim::string_view const key,
+        Callback&& cb, dictionary_ref dict) const noexcept -> raw_element {
+      // Keys the dictionary contains are only ever stored by id.
+      if (DART_UNLIKELY(format() == layout_format::dictionary)) {
+        return get_dictionary_key(key, std::forward<Callback>(cb), dict);
+      }
+      return get_standard_key(key, std::forward<Callback>(cb));
     }
 
     template <template <class> class RefCount>
     template <class Callback>
-    auto object<RefCount>::get_key(shim::string_view const key, Callback&& cb) const noexcept -> raw_element {
+    auto object<RefCount>::get_standard_key(shim::string_view const key, Callback&& cb) const noexcept -> raw_element {
       // Get the size of the vtable.
       size_t const num_keys = size();
 
@@ -641,118 +941,472 @@ namespace dart {
       auto type = detail::raw_type::null;
       ssize_t const key_size = key.size();
       gsl::byte const* const base = DART_FROM_THIS;
-      int32_t low = 0, high = static_cast<int32_t>(num_keys) - 1;
-      while (high >= low) {
-        // Calculate the location of the next guess.
-        auto const mid = (low + high) / 2;
+      auto const skip = key_skip().for_length(key.size());
+      visit_vtable([&] (auto const* entries) {
+        int32_t low = 0, high = static_cast<int32_t>(num_keys) - 1;
+        while (high >= low) {
+          // Calculate the location of the next guess.
+          auto const mid = (low + high) / 2;
+
+          // Run the comparison.
+          auto const& entry = entries[mid];
+          ssize_t comparison = -entry.prefix_compare(key, skip);
+          if (!comparison && (skip || entry.is_capped() || entry.get_length() > sizeof(object_entry::prefix_type))) {
+            // Keys short enough to fit entirely in a leading prefix have already been compared in full,
+            // otherwise we have to consult the key itself.
+            auto const* curr_str = detail::get_string({detail::raw_type::string, base + entry.get_offset()});
+            auto const curr_view = curr_str->get_strv();
+            ssize_t const curr_size = curr_view.size();
+            comparison = (curr_size == key_size) ? key.compare(curr_view) : key_size - curr_size;
+          }
+
+          // Update.
+          if (comparison == 0) {
+            // We've found it!
+            // The lambda is passed through here specifically so that get_it and get_key_it can return
+            // iterators without having to duplicate the logic in this function.
+            // I originally had a more straightforward approach where we always returned an integer along
+            // with the raw_element, but it caused like a 15% performance regression, so now we're
+            // taking this approach.
+            cb(mid);
+            type = entry.get_type();
+            target = base + entry.get_offset();
+            break;
+          } else if (comparison > 0) {
+            low = mid + 1;
+          } else {
+            high = mid - 1;
+          }
+        }
+      });
+      return {type, target};
+    }
+
+    template <template <class> class RefCount>
+    template <class Callback>
+    auto object<RefCount>::get_key(key_dictionary::key const& key,
+        Callback&& cb, dictionary_ref dict) const noexcept -> raw_element {
+      if (format() != layout_format::dictionary) return get_key(key.strv(), std::forward<Callback>(cb));
+
+      // Keys resolved against the same dictionary we were keyed against already know their id,
+      // and don't need their string at all.
+      if (key.version() == dictionary_version()) {
+        return get_keyed(shim::string_view {}, key.id(), std::forward<Callback>(cb));
+      }
+      return get_key(key.strv(), std::forward<Callback>(cb), dict);
+    }
 
-        // Run the comparison.
-        auto const& entry = vtable()[mid];
-        ssize_t comparison = -entry.prefix_compare(key);
-        if (!comparison) {
-          auto const* curr_str = detail::get_string({detail::raw_type::string, base + entry.get_offset()});
-          auto const curr_view = curr_str->get_strv();
-          ssize_t const curr_size = curr_view.size();
-          comparison = (curr_size == key_size) ? key.compare(curr_view) : key_size - curr_size;
+    template <template <class> class RefCount>
+    template <class Callback>
+    auto object<RefCount>::get_keyed(shim::string_view const key, size_t id, Callback&& cb) const noexcept -> raw_element {
+      // Entries are sorted by id, and every inline key shares the largest one,
+      // so keys the dictionary contains can be found by comparing integers alone.
+      gsl::byte const* const base = DART_FROM_THIS;
+      auto const* entries = vtable<dictionary_entry>();
+      int32_t low = 0, high = static_cast<int32_t>(size()) - 1;
+      if (id != dictionary_entry::inline_id) {
+        while (high >= low) {
+          auto const mid = (low + high) / 2;
+          auto const& entry = entries[mid];
+          auto const curr = entry.get_id();
+          if (curr == id) {
+            cb(mid);
+            return {entry.get_type(), base + entry.get_offset()};
+          } else if (curr < id) {
+            low = mid + 1;
+          } else {
+            high = mid - 1;
+          }
         }
+        return {detail::raw_type::null, nullptr};
+      }
 
-        // Update.
+      // Anything else can only be stored inline, at the end of the vtable, in the usual order.
+      while (high >= low) {
+        auto const mid = (low + high) / 2;
+        if (entries[mid].is_inline()) high = mid - 1;
+        else low = mid + 1;
+      }
+      high = static_cast<int32_t>(size()) - 1;
+      ssize_t const key_size = key.size();
+      while (high >= low) {
+        auto const mid = (low + high) / 2;
+        auto const& entry = entries[mid];
+        auto const curr_view = detail::get_string({detail::raw_type::string, base + entry.get_offset()})->get_strv();
+        ssize_t const curr_size = curr_view.size();
+        ssize_t const comparison = (curr_size == key_size) ? key.compare(curr_view) : key_size - curr_size;
         if (comparison == 0) {
-          // We've found it!
-          // The lambda is passed through here specifically so that get_it and get_key_it can return
-          // iterators without having to duplicate the logic in this function.
-          // I originally had a more straightforward approach where we always returned an integer along
-          // with the raw_element, but it caused like a 15% performance regression, so now we're
-          // taking this approach.
           cb(mid);
-          type = entry.get_type();
-          target = base + entry.get_offset();
-          break;
+          return {entry.get_type(), base + entry.get_offset()};
         } else if (comparison > 0) {
           low = mid + 1;
         } else {
           high = mid - 1;
         }
       }
-      return {type, target};
+      return {detail::raw_type::null, nullptr};
     }
 
     template <template <class> class RefCount>
-    auto object<RefCount>::get_it(shim::string_view const key) const noexcept -> ll_iterator<RefCount> {
+    auto object<RefCount>::get_it(shim::string_view const key, dictionary_ref dict) const noexcept -> ll_iterator<RefCount> {
       size_t idx;
-      get_key(key, [&] (auto target) { idx = target; });
-      return ll_iterator<RefCount>(idx, DART_FROM_THIS, load_value);
+      get_key(key, [&] (auto target) { idx = target; }, dict);
+      auto const* storage = format() == layout_format::dictionary ? dict.get() : nullptr;
+      return ll_iterator<RefCount>(idx, DART_FROM_THIS, load_value, storage);
     }
 
     template <template <class> class RefCount>
-    auto object<RefCount>::get_key_it(shim::string_view const key) const noexcept -> ll_iterator<RefCount> {
+    auto object<RefCount>::get_key_it(shim::string_view const key, dictionary_ref dict) const noexcept -> ll_iterator<RefCount> {
       size_t idx;
-      get_key(key, [&] (auto target) { idx = target; });
-      return ll_iterator<RefCount>(idx, DART_FROM_THIS, load_key);
+      get_key(key, [&] (auto target) { idx = target; }, dict);
+      auto const* storage = format() == layout_format::dictionary ? dict.get() : nullptr;
+      return ll_iterator<RefCount>(idx, DART_FROM_THIS, load_key, storage);
     }
 
     template <template <class> class RefCount>
-    auto object<RefCount>::get_value(shim::string_view const key) const noexcept -> raw_element {
-      return get_value_impl(key, [] (auto) {});
+    auto object<RefCount>::get_value(shim::string_view const key, dictionary_ref dict) const noexcept -> raw_element {
+      return get_value_impl(key, [] (auto) {}, dict);
     }
 
     template <template <class> class RefCount>
-    auto object<RefCount>::at_value(shim::string_view const key) const -> raw_element {
+    auto object<RefCount>::get_value(key_dictionary::key const& key, dictionary_ref dict) const noexcept -> raw_element {
+      if (format() != layout_format::dictionary) return get_value(key.strv());
+
+      // Keys resolved against the same dictionary we were keyed against already know their id,
+      // and don't need their string at all.
+      if (key.version() == dictionary_version()) {
+        return get_keyed_value(shim::string_view {}, key.id(), [] (auto) {});
+      }
+      return get_value(key.strv(), dict);
+    }
+
+    template <template <class> class RefCount>
+    auto object<RefCount>::at_value(shim::string_view const key, dictionary_ref dict) const -> raw_element {
       auto& ex_msg = "dart::buffer does not contain the requested mapping";
-      return get_value_impl(key, [&] (auto& elem) { if (!elem.buffer) throw std::out_of_range(ex_msg); });
+      return get_value_impl(key, [&] (auto& elem) { if (!elem.buffer) throw std::out_of_range(ex_msg); }, dict);
     }
 
     template <template <class> class RefCount>
-    auto object<RefCount>::load_key(gsl::byte const* base, size_t idx) noexcept
+    template <class Callback>
+    void object<RefCount>::for_each_pair(Callback&& cb, dictionary_storage const* dict) const {
+      // Unlike load_key/load_value, which re-derive the object header on every call,
+      // walk the vtable linearly and find each value from the entry already in hand.
+      gsl::byte const* const base = DART_FROM_THIS;
+      if (format() == layout_format::dictionary) {
+        auto const* entries = vtable<dictionary_entry>();
+        for (size_t idx = 0, len = size(); idx < len; ++idx) {
+          auto const& entry = entries[idx];
+          auto const key = entry.is_inline() ? raw_element {raw_type::string, base + entry.get_offset()} : dict->key_at(entry.get_id());
+          cb(key, raw_element {entry.get_type(), value_address(base, entry)});
+        }
+        return;
+      }
+      visit_vtable([&] (auto const* entries) {
+        for (size_t idx = 0, len = size(); idx < len; ++idx) {
+          auto const& entry = entries[idx];
+          cb(raw_element {raw_type::string, base + entry.get_offset()}, raw_element {entry.get_type(), value_address(base, entry)});
+        }
+      });
+    }
+
+    template <template <class> class RefCount>
+    template <class Callback>
+    bool object<RefCount>::for_each_pair_with(object const& other, Callback&& cb) const {
+      // Both objects share a format, so one visit covers both vtables.
+      DART_ASSERT(format() == other.format() && format() != layout_format::dictionary);
+      DART_ASSERT(size() == other.size());
+      gsl::byte const* const base = DART_FROM_THIS;
+      auto const* other_base = reinterpret_cast<gsl::byte const*>(&other);
+      return visit_vtable([&] (auto const* entries) {
+        using entry_type = std::decay_t<decltype(*entries)>;
+        auto const* other_entries = other.template vtable<entry_type>();
+        for (size_t idx = 0, len = size(); idx < len; ++idx) {
+          auto const& entry = entries[idx];
+          auto const& other_entry = other_entries[idx];
+          auto const keep_going = cb(raw_element {raw_type::string, base + entry.get_offset()},
+              raw_element {entry.get_type(), value_address(base, entry)},
+              raw_element {raw_type::string, other_base + other_entry.get_offset()},
+              raw_element {other_entry.get_type(), value_address(other_base, other_entry)});
+          if (!keep_going) return false;
+        }
+        return true;
+      });
+    }
+
+    template <template <class> class RefCount>
+    auto object<RefCount>::load_key(gsl::byte const* base, size_t idx, dictionary_storage const* dict) noexcept
       -> typename ll_iterator<RefCount>::value_type
     {
       // Get our vtable entry.
-      auto const& entry = detail::get_object<RefCount>({raw_type::object, base})->vtable()[idx];
-      return {detail::raw_type::string, base + entry.get_offset()};
+      // Keys stored by id live in the dictionary instead of the object.
+      auto* obj = detail::get_object<RefCount>({raw_type::object, base});
+      if (obj->format() == layout_format::dictionary) {
+        auto const& entry = obj->template vtable<dictionary_entry>()[idx];
+        if (entry.is_inline()) return {detail::raw_type::string, base + entry.get_offset()};
+        DART_ASSERT(dict);
+        return dict->key_at(entry.get_id());
+      }
+      return obj->visit_vtable([&] (auto const* entries) -> typename ll_iterator<RefCount>::value_type {
+        return {detail::raw_type::string, base + entries[idx].get_offset()};
+      });
     }
 
     template <template <class> class RefCount>
-    auto object<RefCount>::load_value(gsl::byte const* base, size_t idx) noexcept
+    auto object<RefCount>::load_value(gsl::byte const* base, size_t idx, dictionary_storage const*) noexcept
       -> typename ll_iterator<RefCount>::value_type
     {
       // Get our vtable entry.
-      auto const& entry = detail::get_object<RefCount>({raw_type::object, base})->vtable()[idx];
+      auto* obj = detail::get_object<RefCount>({raw_type::object, base});
+      if (obj->format() == layout_format::dictionary) {
+        auto const& entry = obj->template vtable<dictionary_entry>()[idx];
+        return {entry.get_type(), value_address(base, entry)};
+      }
+      return obj->visit_vtable([&] (auto const* entries) -> typename ll_iterator<RefCount>::value_type {
+        auto const& entry = entries[idx];
+        return {entry.get_type(), value_address(base, entry)};
+      });
+    }
 
-      // Jump over the key and align to the given type.
-      auto const* val_ptr = base + entry.get_offset();
-      auto const* key_ptr = detail::get_string({raw_type::string, val_ptr});
-      return {entry.get_type(), align_pointer<RefCount>(val_ptr + key_ptr->get_sizeof(), entry.get_type())};
+    template <template <class> class RefCount>
+    template <class Entry>
+    gsl::byte const* object<RefCount>::value_address(gsl::byte const* base, Entry const& entry) noexcept {
+      // Values immediately follow their keys, so as long as the vtable knows the exact length
+      // of the key we can jump straight to the value without a dependent load through the key.
+      auto const* key_ptr = base + entry.get_offset();
+      size_t key_bytes;
+      if (!entry.is_capped()) key_bytes = string::static_sizeof(static_cast<string::size_type>(entry.get_length()));
+      else key_bytes = detail::get_string({raw_type::string, key_ptr})->get_sizeof();
+
+      // Shared values are found through the offset of their earlier copy instead.
+      if (DART_UNLIKELY(entry.is_shared())) {
+        using offset_type = typename Entry::offset_type;
+        auto const* slot = align_pointer_for<offset_type>(key_ptr + key_bytes);
+        return base + shim::launder(reinterpret_cast<little_order<offset_type> const*>(slot))->get();
+      }
+      return align_pointer<RefCount>(key_ptr + key_bytes, entry.get_type());
     }
 
     template <template <class> class RefCount>
-    size_t object<RefCount>::realign(size_t guess, size_t offset) noexcept {
-      // Get a pointer to where the packet data we wrote starts
-      assert(elems < guess);
-      auto* src = reinterpret_cast<gsl::byte const*>(&vtable()[guess]);
+    gsl::byte const* object<RefCount>::value_address(gsl::byte const* base, dictionary_entry const& entry) noexcept {
+      // Entries for keys stored by id point straight at their values,
+      // while inline keys are followed by their values as usual.
+      auto const* ptr = base + entry.get_offset();
+      if (!entry.is_inline()) return ptr;
+      auto const key_bytes = detail::get_string({raw_type::string, ptr})->get_sizeof();
+      return align_pointer<RefCount>(ptr + key_bytes, entry.get_type());
+    }
 
-      // Get a pointer to the next alignment boundary after where the vtable ACTUALLY ends.
-      auto* unaligned = reinterpret_cast<gsl::byte*>(&vtable()[elems]);
-      auto* dst = align_pointer<RefCount>(unaligned, vtable()[0].get_type());
+    template <template <class> class RefCount>
+    size_t object<RefCount>::merged_sizeof(gsl::span<merge_source> sources) noexcept {
+      size_t count;
+      return merged_sizeof(sources, count);
+    }
+
+    template <template <class> class RefCount>
+    size_t object<RefCount>::merged_sizeof(gsl::span<merge_source> sources, size_t& count) noexcept {
+      // The vtable always ends on an alignment boundary, so we can tally up the data
+      // section without knowing where it will start.
+      size_t data = 0;
+      count = 0;
+      each_merged_entry(sources, [&] (auto* obj, auto idx) {
+        auto* base = reinterpret_cast<gsl::byte const*>(obj);
+        auto raw_key = load_key(base, idx), raw_val = load_value(base, idx);
+        data = pad_bytes<RefCount>(data, raw_type::string) + find_sizeof<RefCount>(raw_key);
+        data = pad_bytes<RefCount>(data, raw_val.type) + find_sizeof<RefCount>(raw_val);
+        ++count;
+      });
+      auto total = header_len + (count * sizeof(object_entry)) + data;
+      return pad_bytes<RefCount>(total, raw_type::object);
+    }
+
+    template <template <class> class RefCount>
+    size_t object<RefCount>::deep_merged_sizeof(object const* base, object const* incoming) noexcept {
+      // Same idea as merged_sizeof, but colliding objects contribute the size of their merge.
+      size_t count = 0, data = 0;
+      each_merged_pair(base, incoming, [&] (auto* obj, auto idx, auto* shadowed, auto shadowed_idx) {
+        auto raw_key = load_key(reinterpret_cast<gsl::byte const*>(obj), idx);
+        auto raw_val = load_value(reinterpret_cast<gsl::byte const*>(obj), idx);
+        data = pad_bytes<RefCount>(data, raw_type::string) + find_sizeof<RefCount>(raw_key);
+        data = pad_bytes<RefCount>(data, raw_val.type);
+        ++count;
+
+        if (shadowed && raw_val.type == raw_type::object) {
+          auto shadowed_val = load_value(reinterpret_cast<gsl::byte const*>(shadowed), shadowed_idx);
+          if (shadowed_val.type == raw_type::object) {
+            data += deep_merged_sizeof(get_object<RefCount>(shadowed_val), get_object<RefCount>(raw_val));
+            return;
+          }
+        }
+        data += find_sizeof<RefCount>(raw_val);
+      });
+      auto total = header_len + (count * sizeof(object_entry)) + data;
+      return pad_bytes<RefCount>(total, raw_type::object);
+    }
+
+    template <template <class> class RefCount>
+    template <class Key>
+    size_t object<RefCount>::projected_sizeof(object const* base, gsl::span<Key const*> key_ptrs) noexcept {
+      // Same idea as merged_sizeof, but only for the pairs that survive the projection.
+      size_t count = 0, data = 0;
+      buffer_builder<RefCount>::project_each_pair(base, key_ptrs, [&] (auto raw_key, auto raw_val) {
+        data = pad_bytes<RefCount>(data, raw_type::string) + find_sizeof<RefCount>(raw_key);
+        data = pad_bytes<RefCount>(data, raw_val.type) + find_sizeof<RefCount>(raw_val);
+        ++count;
+      });
+      auto total = header_len + (count * sizeof(object_entry)) + data;
+      return pad_bytes<RefCount>(total, raw_type::object);
+    }
+
+    template <template <class> class RefCount>
+    size_t object<RefCount>::layout_key(object_entry* entry,
+        size_t offset, raw_element raw_key, raw_type val_type) noexcept {
+      // Using the current offset, align a pointer for the key (string type).
+      auto* unaligned = DART_FROM_THIS_MUT + offset;
+      auto* aligned = zero_align_pointer<RefCount>(unaligned, detail::raw_type::string);
+      offset += aligned - unaligned;
+
+      // Add an entry to the vtable.
+      auto* key = get_string(raw_key);
+      new(entry) object_entry(val_type, static_cast<uint32_t>(offset), key->get_strv());
+
+      // Copy in our key.
+      auto key_len = find_sizeof<RefCount>(raw_key);
+      std::copy_n(raw_key.buffer, key_len, aligned);
+      offset += key_len;
+
+      // Realign for our value type, and return where the value should be written.
+      unaligned = DART_FROM_THIS_MUT + offset;
+      aligned = zero_align_pointer<RefCount>(unaligned, val_type);
+      return offset + (aligned - unaligned);
+    }
+
+    template <template <class> class RefCount>
+    size_t object<RefCount>::layout_pair(object_entry* entry,
+        size_t offset, raw_element raw_key, raw_element raw_val) noexcept {
+      // Lay out our key.
+      offset = layout_key(entry, offset, raw_key, raw_val.type);
+
+      // Copy in our value
+      auto val_len = find_sizeof<RefCount>(raw_val);
+      std::copy_n(raw_val.buffer, val_len, DART_FROM_THIS_MUT + offset);
+      return offset + val_len;
+    }
+
+    template <template <class> class RefCount>
+    int object<RefCount>::compare_keys(object const* lhs,
+        size_t lhs_idx, object const* rhs, size_t rhs_idx) noexcept {
+      // Try to order the keys using only their vtable entries.
+      // Prefixes cached after skipping over bytes shared within one object say nothing
+      // about keys from another, so those always have to consult the keys.
+      if (!lhs->key_skip().skip && !rhs->key_skip().skip) {
+        auto diff = lhs->visit_vtable([&] (auto const* lhs_entries) {
+          return rhs->visit_vtable([&] (auto const* rhs_entries) {
+            return lhs_entries[lhs_idx].entry_compare(rhs_entries[rhs_idx]);
+          });
+        });
+        if (diff) return diff;
+      }
+
+      // Lengths and prefixes collided, fall back on the keys themselves.
+      dart_comparator<RefCount> comp;
+      auto lhs_key = get_string(load_key(reinterpret_cast<gsl::byte const*>(lhs), lhs_idx))->get_strv();
+      auto rhs_key = get_string(load_key(reinterpret_cast<gsl::byte const*>(rhs), rhs_idx))->get_strv();
+      if (comp(lhs_key, rhs_key)) return -1;
+      else if (comp(rhs_key, lhs_key)) return 1;
+      else return 0;
+    }
+
+    template <template <class> class RefCount>
+    template <class Callback>
+    void object<RefCount>::each_merged_pair(object const* base, object const* incoming, Callback&& cb) noexcept {
+      // Standard sorted merge walk, giving precedence to the incoming object.
+      // Callback receives the winning entry, along with the base entry it shadows (if any).
+      object const* none = nullptr;
+      size_t base_idx = 0, in_idx = 0;
+      auto const base_size = base->size(), in_size = incoming->size();
+      while (base_idx < base_size && in_idx < in_size) {
+        auto diff = compare_keys(base, base_idx, incoming, in_idx);
+        if (diff < 0) cb(base, base_idx++, none, 0);
+        else if (diff > 0) cb(incoming, in_idx++, none, 0);
+        else cb(incoming, in_idx++, base, base_idx++);
+      }
+
+      // Whatever remains can't collide.
+      while (base_idx < base_size) cb(base, base_idx++, none, 0);
+      while (in_idx < in_size) cb(incoming, in_idx++, none, 0);
+    }
+
+    template <template <class> class RefCount>
+    template <class Callback>
+    void object<RefCount>::each_merged_entry(gsl::span<merge_source> sources, Callback&& cb) noexcept {
+      // K-way merge walk across all of the sorted vtables.
+      // K is expected to be small (a handful of layered configs), so a linear scan
+      // for the minimum key beats maintaining a heap.
+      for (auto& src : sources) src.idx = 0;
+      while (true) {
+        // Find the smallest current key, preferring later sources on ties.
+        merge_source* winner = nullptr;
+        for (auto& src : sources) {
+          if (src.idx == src.obj->size()) continue;
+          else if (!winner) winner = &src;
+          else if (compare_keys(src.obj, src.idx, winner->obj, winner->idx) <= 0) winner = &src;
+        }
+        if (!winner) return;
+        cb(winner->obj, winner->idx);
 
-      // Re-align things.
-      auto diff = src - dst;
-      std::copy(src, DART_FROM_THIS + offset, dst);
-      offset -= diff;
+        // Skip over the winning key in every source that contained it.
+        for (auto& src : sources) {
+          if (&src == winner || src.idx == src.obj->size()) continue;
+          else if (!compare_keys(src.obj, src.idx, winner->obj, winner->idx)) ++src.idx;
+        }
+        ++winner->idx;
+      }
+    }
 
-      // We just realigned things, which means all of our vtable offsets are now wrong.
-      for (auto idx = 0U; idx < elems; ++idx) vtable()[idx].adjust_offset(-diff);
+    template <template <class> class RefCount>
+    size_t object<RefCount>::count_unique_keys(object const* base, object const* incoming) noexcept {
+      size_t count = 0;
+      each_merged_pair(base, incoming, [&] (auto*, auto, auto*, auto) { ++count; });
+      return count;
+    }
 
-      // Lastly, we need to zero the trailing bytes to ensure buffers
-      // can still be compared via memcmp.
-      std::fill_n(DART_FROM_THIS_MUT + offset, diff, gsl::byte {});
-      return offset;
+    template <template <class> class RefCount>
+    template <class Key>
+    size_t object<RefCount>::count_projected_keys(object const* base, gsl::span<Key const*> key_ptrs) noexcept {
+      // Requested keys are arbitrary user types, so there's no vtable for them,
+      // but the walk is otherwise identical to project_each_pair.
+      dart_comparator<RefCount> comp;
+      size_t base_idx = 0, count = 0;
+      auto const base_size = base->size();
+      for (auto in_keys = std::begin(key_ptrs); in_keys != std::end(key_ptrs); ++in_keys) {
+        auto& in_key = **in_keys;
+        while (base_idx < base_size) {
+          auto base_key = get_string(load_key(reinterpret_cast<gsl::byte const*>(base), base_idx))->get_strv();
+          if (comp(base_key, in_key)) {
+            ++base_idx;
+          } else if (!comp(in_key, base_key)) {
+            ++base_idx, ++count;
+          } else {
+            break;
+          }
+        }
+      }
+      return count;
     }
 
     template <template <class> class RefCount>
     template <class Callback>
-    auto object<RefCount>::get_value_impl(shim::string_view const key, Callback&& cb) const -> raw_element {
+    auto object<RefCount>::get_value_impl(shim::string_view const key,
+        Callback&& cb, dictionary_ref dict) const -> raw_element {
+      // Objects keyed against a dictionary are searched out of line, and only they go looking
+      // for it, which keeps the standard search exactly as tight as it was.
+      if (DART_UNLIKELY(format() == layout_format::dictionary)) {
+        return get_dictionary_value(key, std::forward<Callback>(cb), dict);
+      }
+
       // Propagate through to get_key to grab the pointer to our key and the type of our value.
-      auto const field = get_key(key, [] (auto) {});
+      size_t idx = 0;
+      auto const field = get_standard_key(key, [&] (auto target) { idx = target; });
 
       // If the pointer is null, the key didn't exist, and we're done.
       // Callback function is passed through here specifically so that at_value can throw without having
@@ -769,30 +1423,213 @@ namespace dart {
       if (field.type == detail::raw_type::null) return {field.type, nullptr};
 
       // Otherwise, jump over the key and align to the given type.
-      auto const* key_ptr = detail::get_string({detail::raw_type::string, field.buffer});
-      return {field.type, align_pointer<RefCount>(field.buffer + key_ptr->get_sizeof(), field.type)};
+      return visit_vtable([&] (auto const* entries) -> raw_element {
+        return {field.type, value_address(DART_FROM_THIS, entries[idx])};
+      });
+    }
+
+    template <template <class> class RefCount>
+    template <class Callback>
+    DART_NOINLINE auto object<RefCount>::get_dictionary_key(shim::string_view const key,
+        Callback&& cb, dictionary_ref dict) const noexcept -> raw_element {
+      // Keys our dictionary doesn't contain, or any key if we can't find it, are stored inline.
+      auto const* storage = dict.get();
+      auto const id = storage ? storage->find(key) : dictionary_entry::inline_id;
+      return get_keyed(key, id, std::forward<Callback>(cb));
+    }
+
+    template <template <class> class RefCount>
+    template <class Callback>
+    DART_NOINLINE auto object<RefCount>::get_dictionary_value(shim::string_view const key,
+        Callback&& cb, dictionary_ref dict) const -> raw_element {
+      auto const* storage = dict.get();
+      auto const id = storage ? storage->find(key) : dictionary_entry::inline_id;
+      return get_keyed_value(key, id, std::forward<Callback>(cb));
+    }
+
+    template <template <class> class RefCount>
+    template <class Callback>
+    DART_NOINLINE auto object<RefCount>::get_keyed_value(shim::string_view const key, size_t id, Callback&& cb) const -> raw_element {
+      // Same as get_value_impl, except that values stored by id don't follow their keys.
+      size_t idx = 0;
+      auto const field = get_keyed(key, id, [&] (auto target) { idx = target; });
+      cb(field);
+      if (!field.buffer) return field;
+      else if (field.type == detail::raw_type::null) return {field.type, nullptr};
+      return {field.type, value_address(DART_FROM_THIS, vtable<dictionary_entry>()[idx])};
+    }
+
+    template <template <class> class RefCount>
+    size_t object<RefCount>::extension_sizeof(finalize_options const& opts) noexcept {
+      // Worst case amount of header an object might need beyond the standard encoding.
+      if (!opts.dictionary.empty()) return sizeof(dictionary_extension);
+      else if (opts.prefix == prefix_policy::discriminating) return sizeof(key_extension);
+      else return 0;
+    }
+
+    template <template <class> class RefCount>
+    uint64_t object<RefCount>::dictionary_version() const noexcept {
+      if (format() != layout_format::dictionary) return 0;
+      auto* ext = shim::launder(reinterpret_cast<dictionary_extension const*>(raw_vtable() - sizeof(dictionary_extension)));
+      return ext->version;
+    }
+
+    template <template <class> class RefCount>
+    template <class Fields>
+    prefix_skip object<RefCount>::discriminating_skip(Fields const& fields) noexcept {
+      // Keys are sorted by length first, so the only keys lookup ever has to tell apart
+      // using their prefixes are those of the same length, which are adjacent, and sorted,
+      // so the leading bytes a run of them shares are whatever its first and last share.
+      struct key_run {
+        size_t len;
+        size_t count;
+        size_t shared;
+      };
+      auto each_run = [&] (auto&& cb) {
+        key_run run {0, 0, 0};
+        shim::string_view first;
+        for (auto const& field : fields) {
+          auto const curr = field.first.strv();
+          if (run.count && curr.size() == run.len) {
+            size_t shared = 0;
+            while (shared < curr.size() && curr[shared] == first[shared]) ++shared;
+            run.shared = shared;
+            run.count++;
+            continue;
+          }
+          if (run.count) cb(run);
+          run = {curr.size(), 1, curr.size()};
+          first = curr;
+        }
+        if (run.count) cb(run);
+      };
+
+      // Skip whatever the largest run of keys that actually shares a prefix has in common.
+      // Unrelated keys shouldn't be able to defeat it, so measure it over that run alone.
+      constexpr size_t max_len = std::numeric_limits<uint16_t>::max();
+      key_run best {0, 0, 0};
+      each_run([&] (key_run const& run) {
+        if (run.count < 2 || !run.shared || run.len > max_len) return;
+        else if (run.count > best.count || (run.count == best.count && run.shared > best.shared)) best = run;
+      });
+      if (!best.count) return {};
+
+      // Then stretch the range of lengths it applies to over any neighboring runs that share it too.
+      bool done = false;
+      prefix_skip skip {best.shared, 0, 0};
+      each_run([&] (key_run const& run) {
+        if (done) return;
+        else if (run.shared < skip.skip || run.len > max_len) {
+          if (run.len > best.len) done = true;
+          else skip.min_len = 0;
+        } else {
+          if (!skip.min_len) skip.min_len = run.len;
+          skip.max_len = run.len;
+        }
+      });
+      return skip;
+    }
+
+    template <template <class> class RefCount>
+    prefix_skip object<RefCount>::key_skip() const noexcept {
+      if (!is_keyed(format())) return {};
+      auto* ext = shim::launder(reinterpret_cast<key_extension const*>(raw_vtable() - sizeof(key_extension)));
+      return {ext->skip, ext->min_len, ext->max_len};
+    }
+
+    template <template <class> class RefCount>
+    void object<RefCount>::set_key_skip(prefix_skip skip) noexcept {
+      set_format(layout_format(static_cast<uint8_t>(format()) | static_cast<uint8_t>(layout_format::keyed)));
+      auto* ext = new(raw_vtable() - sizeof(key_extension)) key_extension;
+      ext->skip = static_cast<uint32_t>(skip.skip);
+      ext->min_len = static_cast<uint16_t>(skip.min_len);
+      ext->max_len = static_cast<uint16_t>(skip.max_len);
+    }
+
+    template <template <class> class RefCount>
+    void object<RefCount>::set_format(layout_format fmt) noexcept {
+      set_format(fmt, size());
+    }
+
+    template <template <class> class RefCount>
+    void object<RefCount>::set_format(layout_format fmt, size_t count) noexcept {
+      if (is_wide(fmt)) {
+        // The wide header overlaps the standard one, and our caller already read out our size,
+        // so only our length, if we're already wide, needs reading before we write into it.
+        auto const len = is_wide(format()) ? get_sizeof() : 0;
+        auto* header = get_wide_header();
+        header->bytes = len | (static_cast<uint64_t>(fmt) << wide_header::format_shift);
+        header->elems = count;
+      } else {
+        elems = (static_cast<uint32_t>(count) & size_mask) | (static_cast<uint32_t>(fmt) << format_shift);
+      }
+    }
+
+    template <template <class> class RefCount>
+    void object<RefCount>::set_sizeof(size_t len) noexcept {
+      if (is_wide(format())) {
+        auto* header = get_wide_header();
+        header->bytes = len | (static_cast<uint64_t>(format()) << wide_header::format_shift);
+      } else {
+        bytes = static_cast<uint32_t>(len);
+      }
+    }
+
+    template <template <class> class RefCount>
+    size_t object<RefCount>::header_sizeof() const noexcept {
+      auto const fmt = format();
+      auto const base = is_wide(fmt) ? sizeof(wide_header) : header_len;
+      if (is_keyed(fmt)) return base + sizeof(key_extension);
+      else if (fmt == layout_format::dictionary) return base + sizeof(dictionary_extension);
+      else return base;
+    }
+
+    template <template <class> class RefCount>
+    size_t object<RefCount>::entry_sizeof() const noexcept {
+      if (format() == layout_format::dictionary) return sizeof(dictionary_entry);
+      return visit_vtable([] (auto const* entries) { return sizeof(*entries); });
+    }
+
+    template <template <class> class RefCount>
+    template <class Callback>
+    decltype(auto) object<RefCount>::visit_vtable(Callback&& cb) const {
+      // Vtables keyed against a dictionary have to be handled separately.
+      DART_ASSERT(format() != layout_format::dictionary);
+      if (is_compact(format())) return cb(vtable<compact_object_entry>());
+      else if (is_wide(format())) return cb(vtable<wide_object_entry>());
+      else return cb(vtable<object_entry>());
+    }
+
+    template <template <class> class RefCount>
+    wide_header* object<RefCount>::get_wide_header() noexcept {
+      return shim::launder(reinterpret_cast<wide_header*>(DART_FROM_THIS_MUT));
+    }
+
+    template <template <class> class RefCount>
+    wide_header const* object<RefCount>::get_wide_header() const noexcept {
+      return shim::launder(reinterpret_cast<wide_header const*>(DART_FROM_THIS));
     }
 
     template <template <class> class RefCount>
-    object_entry* object<RefCount>::vtable() noexcept {
-      auto* base = DART_FROM_THIS_MUT + sizeof(bytes) + sizeof(elems);
-      return shim::launder(reinterpret_cast<object_entry*>(base));
+    template <class Entry>
+    Entry* object<RefCount>::vtable() noexcept {
+      return shim::launder(reinterpret_cast<Entry*>(raw_vtable()));
     }
 
     template <template <class> class RefCount>
-    object_entry const* object<RefCount>::vtable() const noexcept {
-      auto* base = DART_FROM_THIS + sizeof(bytes) + sizeof(elems);
-      return shim::launder(reinterpret_cast<object_entry const*>(base));
+    template <class Entry>
+    Entry const* object<RefCount>::vtable() const noexcept {
+      return shim::launder(reinterpret_cast<Entry const*>(raw_vtable()));
     }
 
     template <template <class> class RefCount>
     gsl::byte* object<RefCount>::raw_vtable() noexcept {
-      return DART_FROM_THIS_MUT + sizeof(bytes) + sizeof(elems);
+      return DART_FROM_THIS_MUT + header_sizeof();
     }
 
     template <template <class> class RefCount>
     gsl::byte const* object<RefCount>::raw_vtable() const noexcept {
-      return DART_FROM_THIS + sizeof(bytes) + sizeof(elems);
+      return DART_FROM_THIS + header_sizeof();
     }
 
   }
@@ -220,6 +220,20 @@ namespace dart {
     return std::move(*this);
   }
 
+  template <template <class> class RefCount>
+  template <bool enabled, class EnableIf>
+  basic_packet<RefCount>& basic_packet<RefCount>::finalize(finalize_options const& opts) & {
+    if (!is_finalized()) impl = shim::get<basic_heap<RefCount>>(impl).finalize(opts);
+    return *this;
+  }
+
+  template <template <class> class RefCount>
+  template <bool enabled, class EnableIf>
+  basic_packet<RefCount>&& basic_packet<RefCount>::finalize(finalize_options const& opts) && {
+    finalize(opts);
+    return std::move(*this);
+  }
+
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount>& basic_packet<RefCount>::lower() & {
@@ -244,13 +258,13 @@ namespace dart {
   template <template <class> class RefCount>
   template <class KeyType, class EnableIf>
   basic_packet<RefCount> basic_packet<RefCount>::get(KeyType const& identifier) const& {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.get(identifier); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.get(identifier); });
   }
 
   template <template <class> class RefCount>
   template <class KeyType, class EnableIf>
   basic_packet<RefCount>&& basic_packet<RefCount>::get(KeyType const& identifier) && {
-    shim::visit([&] (auto& v) { v = std::move(v).get(identifier); }, impl);
+    visit_impl([&] (auto& v) { v = std::move(v).get(identifier); });
     return std::move(*this);
   }
 
@@ -269,13 +283,13 @@ namespace dart {
   template <template <class> class RefCount>
   template <class KeyType, class EnableIf>
   basic_packet<RefCount> basic_packet<RefCount>::at(KeyType const& identifier) const& {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.at(identifier); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.at(identifier); });
   }
 
   template <template <class> class RefCount>
   template <class KeyType, class EnableIf>
   basic_packet<RefCount>&& basic_packet<RefCount>::at(KeyType const& identifier) && {
-    shim::visit([&] (auto& v) { v = std::move(v).at(identifier); }, impl);
+    visit_impl([&] (auto& v) { v = std::move(v).at(identifier); });
     return std::move(*this);
   }
 
@@ -312,7 +326,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   auto basic_packet<RefCount>::size() const -> size_type {
-    return shim::visit([] (auto& v) { return v.size(); }, impl);
+    return visit_impl([] (auto& v) { return v.size(); });
   }
 
   template <template <class> class RefCount>
@@ -320,14 +334,19 @@ namespace dart {
     return size() == 0ULL;
   }
 
+  template <template <class> class RefCount>
+  size_t basic_packet<RefCount>::hash() const noexcept {
+    return visit_impl([] (auto& v) { return v.hash(); });
+  }
+
   template <template <class> class RefCount>
   bool basic_packet<RefCount>::is_object() const noexcept {
-    return shim::visit([] (auto& v) { return v.is_object(); }, impl);
+    return visit_impl([] (auto& v) { return v.is_object(); });
   }
 
   template <template <class> class RefCount>
   bool basic_packet<RefCount>::is_array() const noexcept {
-    return shim::visit([] (auto& v) { return v.is_array(); }, impl);
+    return visit_impl([] (auto& v) { return v.is_array(); });
   }
 
   template <template <class> class RefCount>
@@ -337,17 +356,17 @@ namespace dart {
 
   template <template <class> class RefCount>
   bool basic_packet<RefCount>::is_str() const noexcept {
-    return shim::visit([] (auto& v) { return v.is_str(); }, impl);
+    return visit_impl([] (auto& v) { return v.is_str(); });
   }
 
   template <template <class> class RefCount>
   bool basic_packet<RefCount>::is_integer() const noexcept {
-    return shim::visit([] (auto& v) { return v.is_integer(); }, impl);
+    return visit_impl([] (auto& v) { return v.is_integer(); });
   }
 
   template <template <class> class RefCount>
   bool basic_packet<RefCount>::is_decimal() const noexcept {
-    return shim::visit([] (auto& v) { return v.is_decimal(); }, impl);
+    return visit_impl([] (auto& v) { return v.is_decimal(); });
   }
 
   template <template <class> class RefCount>
@@ -357,12 +376,12 @@ namespace dart {
 
   template <template <class> class RefCount>
   bool basic_packet<RefCount>::is_boolean() const noexcept {
-    return shim::visit([] (auto& v) { return v.is_boolean(); }, impl);
+    return visit_impl([] (auto& v) { return v.is_boolean(); });
   }
 
   template <template <class> class RefCount>
   bool basic_packet<RefCount>::is_null() const noexcept {
-    return shim::visit([] (auto& v) { return v.is_null(); }, impl);
+    return visit_impl([] (auto& v) { return v.is_null(); });
   }
 
   template <template <class> class RefCount>
@@ -372,7 +391,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   auto basic_packet<RefCount>::get_type() const noexcept -> type {
-    return shim::visit([] (auto& v) { return v.get_type(); }, impl);
+    return visit_impl([] (auto& v) { return v.get_type(); });
   }
 
   template <template <class> class RefCount>
@@ -382,12 +401,26 @@ namespace dart {
 
   template <template <class> class RefCount>
   auto basic_packet<RefCount>::refcount() const noexcept -> size_type {
-    return shim::visit([] (auto& v) { return v.refcount(); }, impl);
+    return visit_impl([] (auto& v) { return v.refcount(); });
+  }
+
+  template <template <class> class RefCount>
+  template <class Callback>
+  decltype(auto) basic_packet<RefCount>::visit_finalized(Callback&& cb) const {
+    return visit_impl(std::forward<Callback>(cb));
+  }
+
+  template <template <class> class RefCount>
+  template <class Callback>
+  bool basic_packet<RefCount>::with_buffer(Callback&& cb) const {
+    auto* buf = try_get_buffer();
+    if (buf) std::forward<Callback>(cb)(*buf);
+    return buf != nullptr;
   }
 
   template <template <class> class RefCount>
   auto basic_packet<RefCount>::begin() const -> iterator {
-    return shim::visit([] (auto& v) -> iterator { return v.begin(); }, impl);
+    return visit_impl([] (auto& v) -> iterator { return v.begin(); });
   }
 
   template <template <class> class RefCount>
@@ -397,7 +430,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   auto basic_packet<RefCount>::end() const -> iterator {
-    return shim::visit([] (auto& v) -> iterator { return v.end(); }, impl);
+    return visit_impl([] (auto& v) -> iterator { return v.end(); });
   }
 
   template <template <class> class RefCount>
@@ -417,7 +450,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   auto basic_packet<RefCount>::key_begin() const -> iterator {
-    return shim::visit([] (auto& v) -> iterator { return v.key_begin(); }, impl);
+    return visit_impl([] (auto& v) -> iterator { return v.key_begin(); });
   }
 
   template <template <class> class RefCount>
@@ -427,7 +460,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   auto basic_packet<RefCount>::key_end() const -> iterator {
-    return shim::visit([] (auto& v) -> iterator { return v.key_end(); }, impl);
+    return visit_impl([] (auto& v) -> iterator { return v.key_end(); });
   }
 
   template <template <class> class RefCount>
@@ -150,13 +150,13 @@ namespace dart {
 
   template <template <class> class RefCount>
   basic_packet<RefCount> basic_packet<RefCount>::get(size_type index) const& {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.get(index); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.get(index); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount>&& basic_packet<RefCount>::get(size_type index) && {
-    shim::visit([&] (auto& v) { v = std::move(v).get(index); }, impl);
+    visit_impl([&] (auto& v) { v = std::move(v).get(index); });
     return std::move(*this);
   }
   
@@ -187,49 +187,49 @@ namespace dart {
 
   template <template <class> class RefCount>
   basic_packet<RefCount> basic_packet<RefCount>::at(size_type index) const& {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.at(index); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.at(index); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount>&& basic_packet<RefCount>::at(size_type index) && {
-    shim::visit([&] (auto& v) { v = std::move(v).at(index); }, impl);
+    visit_impl([&] (auto& v) { v = std::move(v).at(index); });
     return std::move(*this);
   }
 
   template <template <class> class RefCount>
   basic_packet<RefCount> basic_packet<RefCount>::at_front() const& {
-    return shim::visit([] (auto& v) -> basic_packet { return v.at_front(); }, impl);
+    return visit_impl([] (auto& v) -> basic_packet { return v.at_front(); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount>&& basic_packet<RefCount>::at_front() && {
-    shim::visit([] (auto& v) -> basic_packet { v = std::move(v).at_front(); }, impl);
+    visit_impl([] (auto& v) -> basic_packet { v = std::move(v).at_front(); });
     return std::move(*this);
   }
 
   template <template <class> class RefCount>
   basic_packet<RefCount> basic_packet<RefCount>::at_back() const& {
-    return shim::visit([] (auto& v) -> basic_packet { return v.at_back(); }, impl);
+    return visit_impl([] (auto& v) -> basic_packet { return v.at_back(); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount>&& basic_packet<RefCount>::at_back() && {
-    shim::visit([] (auto& v) -> basic_packet { v = std::move(v).at_back(); }, impl);
+    visit_impl([] (auto& v) -> basic_packet { v = std::move(v).at_back(); });
     return std::move(*this);
   }
 
   template <template <class> class RefCount>
   basic_packet<RefCount> basic_packet<RefCount>::front() const& {
-    return shim::visit([] (auto& v) -> basic_packet { return v.front(); }, impl);
+    return visit_impl([] (auto& v) -> basic_packet { return v.front(); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount>&& basic_packet<RefCount>::front() && {
-    shim::visit([] (auto& v) { v = std::move(v).front(); }, impl);
+    visit_impl([] (auto& v) { v = std::move(v).front(); });
     return std::move(*this);
   }
   
@@ -241,13 +241,13 @@ namespace dart {
 
   template <template <class> class RefCount>
   basic_packet<RefCount> basic_packet<RefCount>::back() const& {
-    return shim::visit([] (auto& v) -> basic_packet { return v.back(); }, impl);
+    return visit_impl([] (auto& v) -> basic_packet { return v.back(); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount>&& basic_packet<RefCount>::back() && {
-    shim::visit([] (auto& v) { v = std::move(v).back(); }, impl);
+    visit_impl([] (auto& v) { v = std::move(v).back(); });
     return std::move(*this);
   }
 
@@ -257,9 +257,22 @@ namespace dart {
     return get_heap().back_or(std::forward<T>(opt));
   }
 
+  template <template <class> class RefCount>
+  template <class T>
+  bool basic_packet<RefCount>::is_packed() const noexcept {
+    auto* buf = try_get_buffer();
+    return buf && buf->template is_packed<T>();
+  }
+
+  template <template <class> class RefCount>
+  template <class T>
+  gsl::span<T const> basic_packet<RefCount>::as_span() const {
+    return get_buffer().template as_span<T>();
+  }
+
   template <template <class> class RefCount>
   auto basic_packet<RefCount>::capacity() const -> size_type {
-    return shim::visit([] (auto& v) { return v.capacity(); }, impl);
+    return visit_impl([] (auto& v) { return v.capacity(); });
   }
 
 }
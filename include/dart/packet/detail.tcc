@@ -30,6 +30,8 @@ namespace dart {
           return bytes;
         },
         [=] (basic_heap<RefCount> const& impl) {
+          // Packets are only laid out directly inside of objects built from pairs, which are
+          // always in the standard encoding, so nothing inside of them needs a plan.
           return impl.layout(buffer);
         }
       ),
@@ -52,6 +54,23 @@ namespace dart {
     );
   }
 
+  template <template <class> class RefCount>
+  template <class Callback>
+  decltype(auto) basic_packet<RefCount>::visit_impl(Callback&& cb) {
+    // Finalized packets are checked first, as they're the ones on the hot path for reads.
+    // A single branch here lets the compiler inline the callback against each
+    // representation, where shim::visit would go through a jump table.
+    if (auto* buf = try_get_buffer()) return std::forward<Callback>(cb)(*buf);
+    else return std::forward<Callback>(cb)(*try_get_heap());
+  }
+
+  template <template <class> class RefCount>
+  template <class Callback>
+  decltype(auto) basic_packet<RefCount>::visit_impl(Callback&& cb) const {
+    if (auto* buf = try_get_buffer()) return std::forward<Callback>(cb)(*buf);
+    else return std::forward<Callback>(cb)(*try_get_heap());
+  }
+
   template <template <class> class RefCount>
   basic_heap<RefCount>& basic_packet<RefCount>::get_heap() {
     if (!is_finalized()) return shim::get<basic_heap<RefCount>>(impl);
@@ -90,43 +90,56 @@ namespace dart {
   template <template <class> class RefCount>
   template <class... Args, class EnableIf>
   basic_packet<RefCount> basic_packet<RefCount>::inject(Args&&... pairs) const {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.inject(std::forward<Args>(pairs)...); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.inject(std::forward<Args>(pairs)...); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount> basic_packet<RefCount>::inject(gsl::span<basic_heap<RefCount> const> pairs) const {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.inject(pairs); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.inject(pairs); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount> basic_packet<RefCount>::inject(gsl::span<basic_buffer<RefCount> const> pairs) const {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.inject(pairs); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.inject(pairs); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount> basic_packet<RefCount>::inject(gsl::span<basic_packet const> pairs) const {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.inject(pairs); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.inject(pairs); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount> basic_packet<RefCount>::project(std::initializer_list<shim::string_view> keys) const {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.project(keys); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.project(keys); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount> basic_packet<RefCount>::project(gsl::span<std::string const> keys) const {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.project(keys); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.project(keys); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount> basic_packet<RefCount>::project(gsl::span<shim::string_view const> keys) const {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.project(keys); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.project(keys); });
+  }
+
+  template <template <class> class RefCount>
+  template <bool enabled, class EnableIf>
+  basic_packet<RefCount> basic_packet<RefCount>::deep_merge(basic_packet const& incoming) const {
+    // Merge in whichever representation we're currently using.
+    if (is_finalized()) {
+      if (incoming.is_finalized()) return get_buffer().deep_merge(incoming.get_buffer());
+      else return get_buffer().deep_merge(basic_buffer<RefCount> {incoming.get_heap()});
+    } else {
+      if (incoming.is_finalized()) return get_heap().deep_merge(basic_heap<RefCount> {incoming.get_buffer()});
+      else return get_heap().deep_merge(incoming.get_heap());
+    }
   }
 
   template <template <class> class RefCount>
@@ -146,6 +159,11 @@ namespace dart {
     return get(key);
   }
 
+  template <template <class> class RefCount>
+  basic_packet<RefCount> basic_packet<RefCount>::operator [](key_dictionary::key const& key) const& {
+    return get(key);
+  }
+
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount>&& basic_packet<RefCount>::operator [](shim::string_view key) && {
@@ -166,13 +184,21 @@ namespace dart {
 
   template <template <class> class RefCount>
   basic_packet<RefCount> basic_packet<RefCount>::get(shim::string_view key) const& {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.get(key); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.get(key); });
+  }
+
+  template <template <class> class RefCount>
+  basic_packet<RefCount> basic_packet<RefCount>::get(key_dictionary::key const& key) const& {
+    // Only finalized packets can be keyed against a dictionary.
+    auto* buf = shim::get_if<basic_buffer<RefCount>>(&impl);
+    if (buf) return buf->get(key);
+    else return get(key.strv());
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount>&& basic_packet<RefCount>::get(shim::string_view key) && {
-    shim::visit([&] (auto& v) { v = std::move(v).get(key); }, impl);
+    visit_impl([&] (auto& v) { v = std::move(v).get(key); });
     return std::move(*this);
   }
 
@@ -191,7 +217,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   basic_packet<RefCount> basic_packet<RefCount>::get_nested(shim::string_view path, char separator) const {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.get_nested(path, separator); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.get_nested(path, separator); });
   }
 
   template <template <class> class RefCount>
@@ -208,13 +234,13 @@ namespace dart {
 
   template <template <class> class RefCount>
   basic_packet<RefCount> basic_packet<RefCount>::at(shim::string_view key) const& {
-    return shim::visit([&] (auto& v) -> basic_packet { return v.at(key); }, impl);
+    return visit_impl([&] (auto& v) -> basic_packet { return v.at(key); });
   }
 
   template <template <class> class RefCount>
   template <bool enabled, class EnableIf>
   basic_packet<RefCount>&& basic_packet<RefCount>::at(shim::string_view key) && {
-    shim::visit([&] (auto& v) { v = std::move(v).at(key); }, impl);
+    visit_impl([&] (auto& v) { v = std::move(v).at(key); });
     return std::move(*this);
   }
 
@@ -226,7 +252,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   auto basic_packet<RefCount>::find(shim::string_view key) const -> iterator {
-    return shim::visit([&] (auto& v) -> iterator { return v.find(key); }, impl);
+    return visit_impl([&] (auto& v) -> iterator { return v.find(key); });
   }
 
   template <template <class> class RefCount>
@@ -237,7 +263,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   auto basic_packet<RefCount>::find_key(shim::string_view key) const -> iterator {
-    return shim::visit([&] (auto& v) -> iterator { return v.find_key(key); }, impl);
+    return visit_impl([&] (auto& v) -> iterator { return v.find_key(key); });
   }
 
   template <template <class> class RefCount>
@@ -258,7 +284,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   bool basic_packet<RefCount>::has_key(shim::string_view key) const {
-    return shim::visit([&] (auto& v) { return v.has_key(key); }, impl);
+    return visit_impl([&] (auto& v) { return v.has_key(key); });
   }
 
   template <template <class> class RefCount>
@@ -29,7 +29,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   int64_t basic_packet<RefCount>::integer() const {
-    return shim::visit([] (auto& v) { return v.integer(); }, impl);
+    return visit_impl([] (auto& v) { return v.integer(); });
   }
 
   template <template <class> class RefCount>
@@ -39,7 +39,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   double basic_packet<RefCount>::decimal() const {
-    return shim::visit([] (auto& v) { return v.decimal(); }, impl);
+    return visit_impl([] (auto& v) { return v.decimal(); });
   }
 
   template <template <class> class RefCount>
@@ -49,7 +49,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   double basic_packet<RefCount>::numeric() const {
-    return shim::visit([] (auto& v) { return v.numeric(); }, impl);
+    return visit_impl([] (auto& v) { return v.numeric(); });
   }
 
   template <template <class> class RefCount>
@@ -59,7 +59,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   bool basic_packet<RefCount>::boolean() const {
-    return shim::visit([] (auto& v) { return v.boolean(); }, impl);
+    return visit_impl([] (auto& v) { return v.boolean(); });
   }
 
   template <template <class> class RefCount>
@@ -27,7 +27,7 @@ namespace dart {
 
   template <template <class> class RefCount>
   shim::string_view basic_packet<RefCount>::strv() const {
-    return shim::visit([] (auto& v) { return v.strv(); }, impl);
+    return visit_impl([] (auto& v) { return v.strv(); });
   }
 
   template <template <class> class RefCount>
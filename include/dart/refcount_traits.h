@@ -3,6 +3,10 @@
 
 /*----- System Includes -----*/
 
+#include <new>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 /*----- Local Includes -----*/
@@ -67,6 +71,105 @@ namespace dart {
 
     };
 
+    namespace detail {
+
+      // Allocator over-allocates every request by a fixed number of trailing bytes,
+      // which allows std::allocate_shared to lay out a dynamically sized payload
+      // in the same block as its control block.
+      // The allocator is stateless beyond the sizes it was given (a copy of it lives
+      // on in the control block), so the payload is found from the address of the
+      // shared object rather than handed back through the allocator.
+      template <class T>
+      struct tail_allocator {
+
+        using value_type = T;
+
+        tail_allocator(size_t bytes, size_t alignment) noexcept :
+          bytes(bytes),
+          alignment(alignment < alignof(std::max_align_t) ? alignof(std::max_align_t) : alignment)
+        {}
+        template <class U>
+        tail_allocator(tail_allocator<U> const& other) noexcept :
+          bytes(other.bytes),
+          alignment(other.alignment)
+        {}
+
+        T* allocate(size_t count) {
+          // Leave enough slack behind the control block that the payload can always
+          // be aligned up from the end of the shared object.
+          gsl::byte* block;
+          auto total = count * sizeof(T) + (alignment - 1) + bytes;
+          if (shim::aligned_alloc(reinterpret_cast<void**>(&block), alignment, total)) {
+            throw std::bad_alloc();
+          }
+          return reinterpret_cast<T*>(block);
+        }
+
+        void deallocate(T* ptr, size_t) noexcept {
+          shim::aligned_free(ptr);
+        }
+
+        // Returns the payload trailing the shared object at the given address.
+        gsl::byte* tail_of(gsl::byte* object) const noexcept {
+          auto end = reinterpret_cast<uintptr_t>(object + 1);
+          return reinterpret_cast<gsl::byte*>((end + (alignment - 1)) & ~uintptr_t(alignment - 1));
+        }
+
+        template <class U>
+        bool operator ==(tail_allocator<U> const& other) const noexcept {
+          return bytes == other.bytes && alignment == other.alignment;
+        }
+        template <class U>
+        bool operator !=(tail_allocator<U> const& other) const noexcept {
+          return !(*this == other);
+        }
+
+        size_t bytes;
+        size_t alignment;
+
+      };
+
+    }
+
+    // Allocates an uninitialized, aligned, block of bytes owned by a newly
+    // constructed reference counter.
+    // Default implementation makes the allocation separately and hands it off through take.
+    template <class T>
+    struct allocate_bytes {
+
+      static gsl::byte* perform(T* that, size_t bytes, size_t alignment) {
+        gsl::byte* owned;
+        if (shim::aligned_alloc(reinterpret_cast<void**>(&owned), alignment, bytes)) {
+          throw std::bad_alloc();
+        }
+
+        try {
+          take<T>::perform(that, owned, +[] (gsl::byte const* ptr) {
+            shim::aligned_free(const_cast<gsl::byte*>(ptr));
+          });
+        } catch (...) {
+          shim::aligned_free(owned);
+          throw;
+        }
+        return owned;
+      }
+
+    };
+    template <class T>
+    struct allocate_bytes<std::shared_ptr<T>> {
+
+      static gsl::byte* perform(std::shared_ptr<T>* that, size_t bytes, size_t alignment) {
+        // Allocate the control block with the bytes trailing behind it, and then
+        // alias into the tail.
+        detail::tail_allocator<gsl::byte> alloc {bytes, alignment};
+        auto block = std::allocate_shared<gsl::byte>(alloc);
+        auto owned = alloc.tail_of(block.get());
+        new(that) std::shared_ptr<T>(block, owned);
+        return owned;
+      }
+
+    };
+
     template <class T>
     struct copy {
 
@@ -543,6 +646,26 @@ namespace dart {
       return refcount::take<T>::perform(that, ptr, std::forward<Del>(del));
     }
 
+    /**
+     *  @brief
+     *  Function defers allocation of a block of bytes, owned by a newly
+     *  constructed reference counter, to a potentially user defined source.
+     *
+     *  @param[out] that
+     *  Pointer to unconstructed memory!
+     *  Placement new must be used to construct your reference counter.
+     *  @param[in] bytes
+     *  The number of bytes to allocate.
+     *  @param[in] alignment
+     *  The required alignment of the allocated bytes.
+     *
+     *  @return
+     *  Pointer to the uninitialized bytes.
+     */
+    static gsl::byte* allocate_bytes(T* that, size_t bytes, size_t alignment) {
+      return refcount::allocate_bytes<T>::perform(that, bytes, alignment);
+    }
+
     /**
      *  @brief
      *  Function defers copying of a reference counter to a
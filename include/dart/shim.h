@@ -53,8 +53,10 @@ using ssize_t = SSIZE_T;
 
 #if DART_USING_MSVC
 #define DART_UNLIKELY(x) !!(x)
+#define DART_NOINLINE __declspec(noinline)
 #else
 #define DART_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define DART_NOINLINE __attribute__((noinline))
 #endif
 
 #ifndef NDEBUG
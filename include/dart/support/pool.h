@@ -0,0 +1,133 @@
+#ifndef DART_POOL_H
+#define DART_POOL_H
+
+/*----- System Includes -----*/
+
+#include <array>
+#include <cstddef>
+#include <gsl/gsl>
+#include <stdint.h>
+
+/*----- Local Includes -----*/
+
+#include "../shim.h"
+
+/*----- Type Declarations -----*/
+
+namespace dart {
+
+  namespace detail {
+
+    /**
+     *  @brief
+     *  Thread-caching, size-classed allocator for finalized packet memory.
+     *
+     *  @details
+     *  Steady-state traffic tends to finalize packets of similar sizes over and over,
+     *  and each of those finalizations otherwise pays for an aligned allocation and a free.
+     *  The pool rounds requests up to a power of two size class, and caches freed blocks
+     *  per thread (bounded per class) so that the next request of a similar size can
+     *  skip the trip to the system allocator.
+     *  Every block is prefixed with a small header recording its size class, which allows
+     *  the deleter to be a plain, stateless, function pointer (required by buffer_refcount_type).
+     *
+     *  @remarks
+     *  Blocks may be freed on a different thread than they were allocated on, in which case
+     *  they simply migrate into the freeing thread's cache.
+     *  Blocks released after the calling thread has torn down its cache go straight back
+     *  to the system.
+     */
+    class buffer_pool {
+
+      public:
+
+        /*----- Public Types -----*/
+
+        using size_type = size_t;
+
+        /*----- Public Members -----*/
+
+        // Smallest size class is 64 bytes, largest is 1MB.
+        // Anything larger is allocated directly and never cached.
+        static constexpr size_type min_class_shift = 6;
+        static constexpr size_type num_classes = 15;
+
+        // Cap on the number of bytes each size class will hold onto per thread.
+        static constexpr size_type max_cached_bytes = 1 << 20;
+        static constexpr size_type max_cached_blocks = 64;
+
+        // Bytes reserved in front of each block. Must be a multiple of every alignment
+        // we hand out.
+        static constexpr size_type header_bytes = 16;
+
+        /*----- Lifecycle Functions -----*/
+
+        buffer_pool() noexcept;
+        buffer_pool(buffer_pool const&) = delete;
+        ~buffer_pool() noexcept;
+
+        /*----- Operators -----*/
+
+        buffer_pool& operator =(buffer_pool const&) = delete;
+
+        /*----- Public API -----*/
+
+        // Function returns an uninitialized block of at least bytes bytes,
+        // or nullptr if the system is out of memory.
+        static gsl::byte* allocate(size_type bytes, size_type alignment) noexcept;
+
+        // Function returns a block previously allocated through allocate.
+        static void deallocate(gsl::byte const* ptr) noexcept;
+
+        // Function releases every cached block held by the calling thread.
+        static void trim() noexcept;
+
+        // Function returns the number of bytes currently cached by the calling thread.
+        static size_type cached_bytes() noexcept;
+
+      private:
+
+        /*----- Private Types -----*/
+
+        struct block_header {
+          uint32_t size_class;
+        };
+
+        struct free_block {
+          free_block* next;
+        };
+
+        struct free_list {
+          free_block* head;
+          size_type count;
+        };
+
+        /*----- Private Helpers -----*/
+
+        static buffer_pool* local() noexcept;
+        static bool& retired() noexcept;
+
+        static constexpr size_type class_size(size_type size_class) noexcept;
+        static size_type class_for(size_type bytes) noexcept;
+        static size_type class_capacity(size_type size_class) noexcept;
+
+        static gsl::byte* system_allocate(size_type size_class, size_type bytes) noexcept;
+        static void system_deallocate(gsl::byte* ptr) noexcept;
+
+        void release_all() noexcept;
+
+        /*----- Private Members -----*/
+
+        std::array<free_list, num_classes> lists;
+
+    };
+
+  }
+
+}
+
+/*----- Template Implementations -----*/
+
+#include "pool.tcc"
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef DART_POOL_IMPL_H
+#define DART_POOL_IMPL_H
+
+/*----- System Includes -----*/
+
+#include <new>
+
+/*----- Local Includes -----*/
+
+#include "pool.h"
+
+/*----- Function Implementations -----*/
+
+namespace dart {
+
+  namespace detail {
+
+    inline buffer_pool::buffer_pool() noexcept : lists() {}
+
+    inline buffer_pool::~buffer_pool() noexcept {
+      // Anything freed on this thread from here on out goes straight back to the system.
+      retired() = true;
+      release_all();
+    }
+
+    inline gsl::byte* buffer_pool::allocate(size_type bytes, size_type alignment) noexcept {
+      // Every block is aligned to the header size, so that's the best we can do.
+      if (alignment > header_bytes) return nullptr;
+
+      // Check if we've got something cached for this size class.
+      gsl::byte* block = nullptr;
+      auto size_class = class_for(bytes);
+      auto* pool = (size_class < num_classes) ? local() : nullptr;
+      if (pool) {
+        auto& list = pool->lists[size_class];
+        if (list.head) {
+          block = reinterpret_cast<gsl::byte*>(list.head);
+          list.head = list.head->next;
+          --list.count;
+        }
+      }
+
+      // Fall back on the system if not.
+      // Recycled blocks are handed out dirty, finalized layout code zeroes its own padding.
+      if (!block) block = system_allocate(size_class, bytes);
+      return block;
+    }
+
+    inline void buffer_pool::deallocate(gsl::byte const* ptr) noexcept {
+      if (!ptr) return;
+
+      // Figure out what we're dealing with.
+      auto* block = const_cast<gsl::byte*>(ptr);
+      auto size_class = reinterpret_cast<block_header const*>(block - header_bytes)->size_class;
+
+      // Cache it if we have room, otherwise give it back.
+      auto* pool = (size_class < num_classes) ? local() : nullptr;
+      if (pool && pool->lists[size_class].count < class_capacity(size_class)) {
+        auto& list = pool->lists[size_class];
+        auto* node = new(block) free_block;
+        node->next = list.head;
+        list.head = node;
+        ++list.count;
+      } else {
+        system_deallocate(block);
+      }
+    }
+
+    inline void buffer_pool::trim() noexcept {
+      auto* pool = local();
+      if (pool) pool->release_all();
+    }
+
+    inline auto buffer_pool::cached_bytes() noexcept -> size_type {
+      auto* pool = local();
+      if (!pool) return 0;
+
+      size_type total = 0;
+      for (size_type size_class = 0; size_class < num_classes; ++size_class) {
+        total += pool->lists[size_class].count * class_size(size_class);
+      }
+      return total;
+    }
+
+    inline buffer_pool* buffer_pool::local() noexcept {
+      // Thread local destruction order isn't something we get to control,
+      // so once our cache is gone we stop handing it out.
+      if (retired()) return nullptr;
+      static thread_local buffer_pool pool;
+      return &pool;
+    }
+
+    inline bool& buffer_pool::retired() noexcept {
+      // Trivially destructible, so it outlives the pool itself.
+      static thread_local bool flag = false;
+      return flag;
+    }
+
+    constexpr auto buffer_pool::class_size(size_type size_class) noexcept -> size_type {
+      return size_type {1} << (size_class + min_class_shift);
+    }
+
+    inline auto buffer_pool::class_for(size_type bytes) noexcept -> size_type {
+      size_type size_class = 0;
+      while (size_class < num_classes && class_size(size_class) < bytes) ++size_class;
+      return size_class;
+    }
+
+    inline auto buffer_pool::class_capacity(size_type size_class) noexcept -> size_type {
+      auto blocks = max_cached_bytes / class_size(size_class);
+      if (!blocks) return 1;
+      return (blocks < max_cached_blocks) ? blocks : max_cached_blocks;
+    }
+
+    inline gsl::byte* buffer_pool::system_allocate(size_type size_class, size_type bytes) noexcept {
+      // Oversized requests are allocated exactly, everything else is rounded to its class.
+      auto total = ((size_class < num_classes) ? class_size(size_class) : bytes) + header_bytes;
+
+      gsl::byte* raw;
+      if (shim::aligned_alloc(reinterpret_cast<void**>(&raw), header_bytes, total)) return nullptr;
+      new(raw) block_header {static_cast<uint32_t>(size_class)};
+      return raw + header_bytes;
+    }
+
+    inline void buffer_pool::system_deallocate(gsl::byte* ptr) noexcept {
+      shim::aligned_free(ptr - header_bytes);
+    }
+
+    inline void buffer_pool::release_all() noexcept {
+      for (auto& list : lists) {
+        while (list.head) {
+          auto* next = list.head->next;
+          system_deallocate(reinterpret_cast<gsl::byte*>(list.head));
+          list.head = next;
+        }
+        list.count = 0;
+      }
+    }
+
+  }
+
+}
+
+#endif
@@ -3,6 +3,8 @@
 
 /*----- System Includes -----*/
 
+#include <array>
+#include <thread>
 #include <atomic>
 #include <memory>
 #include <gsl/gsl>
@@ -30,32 +32,218 @@ namespace dart {
       void operator ()(std::remove_extent_t<T>* ptr);
     };
 
-    // Type-erasure mechanism for counted_ptr_base.
+    // Control block for counted_ptr_base.
+    // Blocks either own a separately allocated pointer through a type-erased deleter
+    // (see managed_ptr_eraser), or sit directly in front of their payload in a single
+    // aligned allocation (see make_counted and allocate_counted).
+    // Teardown goes through a plain function pointer, which is left null for co-located,
+    // trivially destructible, payloads so that releasing a finalized buffer is just a free.
     template <class Counter>
     struct managed_ptr {
-      managed_ptr(void* ptr, int64_t use_count) : ptr(ptr), use_count(use_count) {}
-      virtual ~managed_ptr() = default;
-      virtual void destroy() = 0;
+      using destroy_type = void (*) (managed_ptr*);
+
+      managed_ptr(void* ptr, int64_t use_count, destroy_type destroy) noexcept :
+        ptr(ptr),
+        use_count(use_count),
+        destroy(destroy)
+      {}
+
+      // Function releases the block, and whatever it owns.
+      static void dispose(managed_ptr* block) noexcept;
 
       void* ptr;
       Counter use_count;
+      destroy_type destroy;
+    };
+
+    /**
+     *  @brief
+     *  Reference counter that is biased towards the thread that created it.
+     *
+     *  @details
+     *  Most packets are created, copied, and destroyed on a single thread, and
+     *  for those packets the cost of an atomic read-modify-write on every copy is
+     *  pure overhead.
+     *  biased_counter splits the count in two: the owning thread counts the copies it
+     *  makes on a counter that only it ever writes (plain loads and stores, no
+     *  read-modify-write), and every release, along with every copy made anywhere else,
+     *  is counted on a shared atomic counter.
+     *  The owner's half only ever grows, so a releasing thread that reads it (while it
+     *  still holds its own reference) and then updates the shared half can tell exactly
+     *  when the two sum to zero, and frees the object immediately, whichever thread it's on.
+     */
+    struct biased_counter {
+
+      /*----- Lifecycle Functions -----*/
+
+      biased_counter(int64_t count) noexcept;
+      biased_counter(biased_counter const&) = delete;
+      ~biased_counter() = default;
+
+      /*----- Operators -----*/
+
+      biased_counter& operator =(biased_counter const&) = delete;
+
+      /*----- Members -----*/
+
+      uint64_t owner;
+      std::atomic<int64_t> biased;
+      std::atomic<int64_t> shared;
+
+    };
+
+    // Per-thread bookkeeping for biased_counter.
+    struct biased_thread {
+      // Function returns the identifier of the calling thread.
+      // Identifiers are never reused, so a stale owner can't be mistaken for a live one.
+      static uint64_t current() noexcept;
+    };
+
+    /**
+     *  @brief
+     *  Reference counter that splits its count across per-thread slots while
+     *  it's published.
+     *
+     *  @details
+     *  A packet that's published to, and read by, many threads at once turns its
+     *  reference count into the hottest cache line in the process, as every reader
+     *  copy bounces it between cores.
+     *  split_counter behaves like a plain atomic counter until it's published (see
+     *  dart::publisher), at which point every thread starts counting in one of a fixed
+     *  number of slots, each on its own cache line, and the shared count is pinned
+     *  with a large bias so that nobody can observe it reaching zero.
+     *  Once retracted, the slots are folded back into the shared count one by one,
+     *  and only then is the bias released, so transient imbalances between slots
+     *  (a reference copied on one thread and released on another) are never mistaken
+     *  for the last reference going away.
+     *
+     *  @remarks
+     *  Each counter carries num_slots cache lines, which makes it a poor fit for
+     *  small, short lived, objects; it's intended for finalized buffers.
+     */
+    struct split_counter {
+
+      /*----- Types -----*/
+
+      using block_type = managed_ptr<split_counter>;
+
+      // Aligned so that every slot's count lands on its own cache line.
+      struct alignas(64) slot {
+        std::atomic<int64_t> count;
+      };
+
+      // Holds the switch lock for its lifetime.
+      // Retraction runs from destructors, and switches are rare and short, so the
+      // lock spins rather than risk the exceptions a mutex can throw.
+      struct switch_guard {
+        switch_guard() noexcept;
+        switch_guard(switch_guard const&) = delete;
+        ~switch_guard() noexcept;
+        switch_guard& operator =(switch_guard const&) = delete;
+      };
+
+      /*----- Constants -----*/
+
+      static constexpr size_t num_slots = 16;
+
+      // Slot is not in use, and operations must fall back on the shared count.
+      static constexpr int64_t folded = INT64_MIN;
+
+      // Bias held on the shared count while published.
+      static constexpr int64_t publish_bias = int64_t {1} << 48;
+
+      /*----- Lifecycle Functions -----*/
+
+      split_counter(int64_t count) noexcept;
+      split_counter(split_counter const&) = delete;
+      ~split_counter() = default;
+
+      /*----- Operators -----*/
+
+      split_counter& operator =(split_counter const&) = delete;
+
+      /*----- Helpers -----*/
+
+      // Function returns the slot the calling thread counts in.
+      static size_t slot_index() noexcept;
+
+      // Functions switch an object in and out of per-slot counting.
+      // Publications nest, and the caller must hold a reference throughout.
+      static void publish(block_type* block) noexcept;
+      static void retract(block_type* block) noexcept;
+      static std::atomic_flag& switch_lock() noexcept;
+
+      /*----- Members -----*/
+
+      std::atomic<int64_t> shared;
+      int64_t publications;
+      std::array<slot, num_slots> slots;
+
     };
+
+    // Customization point for the counting operations performed by counted_ptr_base.
+    template <class Counter>
+    struct counter_ops {
+      static void retain(managed_ptr<Counter>* block) noexcept;
+
+      // Returns true if the caller released the final reference.
+      static bool release(managed_ptr<Counter>* block) noexcept;
+      static int64_t count(managed_ptr<Counter> const* block) noexcept;
+    };
+    template <>
+    struct counter_ops<biased_counter> {
+      static void retain(managed_ptr<biased_counter>* block) noexcept;
+      static bool release(managed_ptr<biased_counter>* block) noexcept;
+      static int64_t count(managed_ptr<biased_counter> const* block) noexcept;
+    };
+
+    template <>
+    struct counter_ops<split_counter> {
+      static void retain(managed_ptr<split_counter>* block) noexcept;
+      static bool release(managed_ptr<split_counter>* block) noexcept;
+      static int64_t count(managed_ptr<split_counter> const* block) noexcept;
+    };
+
     template <class Counter, class PtrType, class Deleter>
     struct managed_ptr_eraser : managed_ptr<Counter> {
-      managed_ptr_eraser(void const* ptr, int64_t use_count) : managed_ptr<Counter>(const_cast<void*>(ptr), use_count) {}
+      managed_ptr_eraser(void const* ptr, int64_t use_count) :
+        managed_ptr<Counter>(const_cast<void*>(ptr), use_count, &erase)
+      {}
       managed_ptr_eraser(void const* ptr, int64_t use_count, Deleter const& deleter) :
-        managed_ptr<Counter>(const_cast<void*>(ptr), use_count),
+        managed_ptr<Counter>(const_cast<void*>(ptr), use_count, &erase),
         deleter(deleter)
       {}
       managed_ptr_eraser(void const* ptr, int64_t use_count, Deleter&& deleter) :
-        managed_ptr<Counter>(const_cast<void*>(ptr), use_count),
+        managed_ptr<Counter>(const_cast<void*>(ptr), use_count, &erase),
         deleter(std::move(deleter))
       {}
-      virtual void destroy() override;
+
+      static void erase(managed_ptr<Counter>* block);
+
+      // Counters may be over-aligned, which plain new doesn't honor before C++17.
+      static void* operator new(size_t bytes);
+      static void operator delete(void* ptr) noexcept;
 
       Deleter deleter;
     };
 
+    // Function makes a single aligned allocation holding a control block, with an
+    // initial count of one, followed by bytes bytes of uninitialized payload.
+    template <class Counter>
+    managed_ptr<Counter>* allocate_managed(size_t bytes, size_t alignment,
+        typename managed_ptr<Counter>::destroy_type destroy);
+
+    // Teardown for co-located payloads with non-trivial destructors.
+    template <class Counter, class T>
+    void destroy_managed(managed_ptr<Counter>* block);
+
+    // Functions construct counted pointers whose control block and payload share
+    // an allocation, akin to std::make_shared.
+    template <class Ptr, class... Args>
+    Ptr make_counted(Args&&... the_args);
+    template <class Ptr>
+    Ptr allocate_counted(size_t bytes, size_t alignment, gsl::byte** out);
+
     template <class T, class Counter>
     class counted_ptr_base {
 
@@ -171,6 +359,12 @@ namespace dart {
 
         template <class U, class C>
         friend class counted_ptr_base;
+        template <class Ptr, class... Args>
+        friend Ptr make_counted(Args&&...);
+        template <class Ptr>
+        friend Ptr allocate_counted(size_t, size_t, gsl::byte**);
+        template <class Ptr>
+        friend struct publication;
 
     };
 
@@ -230,6 +424,48 @@ namespace dart {
 
     };
 
+    // Hooks that let dart::publisher tell a reference counter when one of its
+    // objects is about to be read by many threads, and when that's over.
+    // Most reference counters have no use for this.
+    template <class Ptr>
+    struct publication {
+      static void publish(Ptr const&) noexcept {}
+      static void retract(Ptr const&) noexcept {}
+    };
+    template <class T>
+    struct publication<counted_ptr_impl<T, split_counter>> {
+      static void publish(counted_ptr_impl<T, split_counter> const& ptr) noexcept;
+      static void retract(counted_ptr_impl<T, split_counter> const& ptr) noexcept;
+    };
+
+  }
+
+  namespace refcount {
+
+    // Counted pointers lay their control block out in front of whatever they own.
+    template <class T, class Counter>
+    struct construct<dart::detail::counted_ptr_impl<T, Counter>> {
+
+      template <class... Args>
+      static void perform(dart::detail::counted_ptr_impl<T, Counter>* that, Args&&... the_args) {
+        using ptr_type = dart::detail::counted_ptr_impl<T, Counter>;
+        new(that) ptr_type(dart::detail::make_counted<ptr_type>(std::forward<Args>(the_args)...));
+      }
+
+    };
+
+    template <class T, class Counter>
+    struct allocate_bytes<dart::detail::counted_ptr_impl<T, Counter>> {
+
+      static gsl::byte* perform(dart::detail::counted_ptr_impl<T, Counter>* that, size_t bytes, size_t alignment) {
+        using ptr_type = dart::detail::counted_ptr_impl<T, Counter>;
+        gsl::byte* owned;
+        new(that) ptr_type(dart::detail::allocate_counted<ptr_type>(bytes, alignment, &owned));
+        return owned;
+      }
+
+    };
+
   }
 
   template <class T>
@@ -377,9 +613,21 @@ namespace dart {
 
       template <class U, class... Args>
       friend shareable_ptr<U> make_shareable(Args&&...);
+      template <class U>
+      friend shareable_ptr<U> allocate_shareable(size_t, size_t, gsl::byte**);
 
   };
 
+  template <class T, class... Args>
+  shareable_ptr<T> make_shareable(Args&&... the_args);
+
+  // Function allocates an uninitialized, aligned, block of bytes owned by
+  // a new reference counter, and returns the block through out.
+  // Reference counters can co-locate the block with their own bookkeeping
+  // by specializing dart::refcount::allocate_bytes.
+  template <class T>
+  shareable_ptr<T> allocate_shareable(size_t bytes, size_t alignment, gsl::byte** out);
+
   template <template <class> class RefCount>
   struct view_ptr_context {
 
@@ -498,6 +746,46 @@ namespace dart {
   template <class T, class... Args>
   std::enable_if_t<!std::is_array<T>::value, skinny_ptr<T>> make_skinny(Args&&... the_args);
 
+  template <class T>
+  using biased_ptr = std::conditional_t<
+    std::is_same<
+      std::remove_extent_t<T>,
+      T
+    >::value,
+    detail::counted_ptr_impl<T, detail::biased_counter>,
+    detail::counted_array_ptr_impl<T, detail::biased_counter>
+  >;
+
+  template <class T, class EnableIf =
+    std::enable_if_t<
+      std::is_array<T>::value
+    >
+  >
+  biased_ptr<T> make_biased(size_t idx);
+
+  template <class T, class... Args>
+  std::enable_if_t<!std::is_array<T>::value, biased_ptr<T>> make_biased(Args&&... the_args);
+
+  template <class T>
+  using split_ptr = std::conditional_t<
+    std::is_same<
+      std::remove_extent_t<T>,
+      T
+    >::value,
+    detail::counted_ptr_impl<T, detail::split_counter>,
+    detail::counted_array_ptr_impl<T, detail::split_counter>
+  >;
+
+  template <class T, class EnableIf =
+    std::enable_if_t<
+      std::is_array<T>::value
+    >
+  >
+  split_ptr<T> make_split(size_t idx);
+
+  template <class T, class... Args>
+  std::enable_if_t<!std::is_array<T>::value, split_ptr<T>> make_split(Args&&... the_args);
+
 }
 
 /*----- Template Implementations -----*/
@@ -21,9 +21,232 @@ namespace dart {
       delete[] ptr;
     }
 
+    template <class Counter>
+    void managed_ptr<Counter>::dispose(managed_ptr* block) noexcept {
+      // Anything that needs more than a free knows how to tear itself down.
+      if (block->destroy) return block->destroy(block);
+      block->~managed_ptr();
+      shim::aligned_free(block);
+    }
+
+    template <class Counter, class PtrType, class Deleter>
+    void managed_ptr_eraser<Counter, PtrType, Deleter>::erase(managed_ptr<Counter>* block) {
+      auto* that = static_cast<managed_ptr_eraser*>(block);
+      that->deleter(reinterpret_cast<std::decay_t<PtrType>>(that->ptr));
+      delete that;
+    }
+
     template <class Counter, class PtrType, class Deleter>
-    void managed_ptr_eraser<Counter, PtrType, Deleter>::destroy() {
-      deleter(reinterpret_cast<std::decay_t<PtrType>>(this->ptr));
+    void* managed_ptr_eraser<Counter, PtrType, Deleter>::operator new(size_t bytes) {
+      void* raw;
+      auto alignment = alignof(managed_ptr_eraser) < alignof(void*) ? alignof(void*) : alignof(managed_ptr_eraser);
+      if (shim::aligned_alloc(&raw, alignment, bytes)) throw std::bad_alloc();
+      return raw;
+    }
+
+    template <class Counter, class PtrType, class Deleter>
+    void managed_ptr_eraser<Counter, PtrType, Deleter>::operator delete(void* ptr) noexcept {
+      shim::aligned_free(ptr);
+    }
+
+    template <class Counter>
+    managed_ptr<Counter>* allocate_managed(size_t bytes, size_t alignment,
+        typename managed_ptr<Counter>::destroy_type destroy) {
+      // Pad the control block out so that the payload lands on the requested boundary.
+      if (alignment < alignof(managed_ptr<Counter>)) alignment = alignof(managed_ptr<Counter>);
+      auto header = (sizeof(managed_ptr<Counter>) + (alignment - 1)) & ~(alignment - 1);
+
+      gsl::byte* raw;
+      if (shim::aligned_alloc(reinterpret_cast<void**>(&raw), alignment, header + bytes)) {
+        throw std::bad_alloc();
+      }
+      return new(raw) managed_ptr<Counter>(raw + header, 1, destroy);
+    }
+
+    template <class Counter, class T>
+    void destroy_managed(managed_ptr<Counter>* block) {
+      static_cast<T*>(block->ptr)->~T();
+      block->~managed_ptr();
+      shim::aligned_free(block);
+    }
+
+    template <class Ptr, class... Args>
+    Ptr make_counted(Args&&... the_args) {
+      using counter_type = typename Ptr::counter_type;
+      using value_type = std::remove_cv_t<typename Ptr::element_type>;
+
+      // Trivially destructible payloads don't need any teardown beyond the free.
+      auto* block = allocate_managed<counter_type>(sizeof(value_type), alignof(value_type),
+          std::is_trivially_destructible<value_type>::value ? nullptr : &destroy_managed<counter_type, value_type>);
+      try {
+        new(block->ptr) value_type(std::forward<Args>(the_args)...);
+      } catch (...) {
+        block->destroy = nullptr;
+        managed_ptr<counter_type>::dispose(block);
+        throw;
+      }
+
+      Ptr ptr;
+      ptr.value = block;
+      return ptr;
+    }
+
+    template <class Ptr>
+    Ptr allocate_counted(size_t bytes, size_t alignment, gsl::byte** out) {
+      auto* block = allocate_managed<typename Ptr::counter_type>(bytes, alignment, nullptr);
+      *out = static_cast<gsl::byte*>(block->ptr);
+
+      Ptr ptr;
+      ptr.value = block;
+      return ptr;
+    }
+
+    inline biased_counter::biased_counter(int64_t count) noexcept :
+      owner(biased_thread::current()),
+      biased(count),
+      shared(0)
+    {}
+
+    inline uint64_t biased_thread::current() noexcept {
+      static std::atomic<uint64_t> counter {0};
+      static thread_local uint64_t id = counter.fetch_add(1, std::memory_order_relaxed) + 1;
+      return id;
+    }
+
+    template <class Counter>
+    void counter_ops<Counter>::retain(managed_ptr<Counter>* block) noexcept {
+      ++block->use_count;
+    }
+
+    template <class Counter>
+    bool counter_ops<Counter>::release(managed_ptr<Counter>* block) noexcept {
+      return --block->use_count == 0;
+    }
+
+    template <class Counter>
+    int64_t counter_ops<Counter>::count(managed_ptr<Counter> const* block) noexcept {
+      return block->use_count;
+    }
+
+    inline void counter_ops<biased_counter>::retain(managed_ptr<biased_counter>* block) noexcept {
+      auto& counter = block->use_count;
+      if (counter.owner == biased_thread::current()) {
+        // Only the owner ever writes the biased half, so no read-modify-write is necessary.
+        counter.biased.store(counter.biased.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      } else {
+        counter.shared.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    inline bool counter_ops<biased_counter>::release(managed_ptr<biased_counter>* block) noexcept {
+      // The owner always knows its own half exactly, so a single decrement tells it whether it's done.
+      auto& counter = block->use_count;
+      if (counter.owner == biased_thread::current()) {
+        auto biased = counter.biased.load(std::memory_order_relaxed);
+        return counter.shared.fetch_sub(1, std::memory_order_acq_rel) - 1 + biased == 0;
+      }
+
+      // Anyone else has to read the owner's half, and has to do it before letting go of their reference.
+      // Every copy the owner made of a reference that has already been released is visible once we've
+      // seen that release on the shared half, so as long as the shared half hasn't moved by the time
+      // we swap it, whoever takes the total to zero knows it, and nobody touches the object afterwards.
+      auto shared = counter.shared.load(std::memory_order_acquire);
+      while (true) {
+        auto last = shared - 1 + counter.biased.load(std::memory_order_acquire) == 0;
+        if (counter.shared.compare_exchange_weak(shared, shared - 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+          return last;
+        }
+      }
+    }
+
+    inline int64_t counter_ops<biased_counter>::count(managed_ptr<biased_counter> const* block) noexcept {
+      auto& counter = block->use_count;
+      return counter.biased.load(std::memory_order_relaxed) + counter.shared.load(std::memory_order_relaxed);
+    }
+
+    inline split_counter::split_counter(int64_t count) noexcept : shared(count), publications(0) {
+      for (auto& slot : slots) slot.count.store(folded, std::memory_order_relaxed);
+    }
+
+    inline size_t split_counter::slot_index() noexcept {
+      // Threads are dealt out to slots round robin, which spreads them out
+      // more evenly than hashing their identifiers would.
+      static std::atomic<size_t> next {0};
+      static thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed) % num_slots;
+      return index;
+    }
+
+    inline void split_counter::publish(block_type* block) noexcept {
+      auto& counter = block->use_count;
+      switch_guard guard;
+      if (counter.publications++) return;
+
+      // Pin the shared count before anyone starts counting in the slots,
+      // as slots are free to go negative.
+      counter.shared.fetch_add(publish_bias, std::memory_order_relaxed);
+      for (auto& slot : counter.slots) slot.count.store(0, std::memory_order_release);
+    }
+
+    inline void split_counter::retract(block_type* block) noexcept {
+      auto& counter = block->use_count;
+      switch_guard guard;
+      if (--counter.publications) return;
+
+      // Fold the slots back in one at a time.
+      // Anyone who finds their slot folded falls back on the shared count, which
+      // can't reach zero until we release the bias.
+      int64_t total = 0;
+      for (auto& slot : counter.slots) total += slot.count.exchange(folded, std::memory_order_acq_rel);
+
+      // Our caller holds a reference, so this can't be the last one.
+      counter.shared.fetch_sub(publish_bias - total, std::memory_order_acq_rel);
+    }
+
+    inline std::atomic_flag& split_counter::switch_lock() noexcept {
+      static std::atomic_flag lock = ATOMIC_FLAG_INIT;
+      return lock;
+    }
+
+    inline split_counter::switch_guard::switch_guard() noexcept {
+      while (switch_lock().test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+    }
+
+    inline split_counter::switch_guard::~switch_guard() noexcept {
+      switch_lock().clear(std::memory_order_release);
+    }
+
+    inline void counter_ops<split_counter>::retain(managed_ptr<split_counter>* block) noexcept {
+      auto& counter = block->use_count;
+      auto& slot = counter.slots[split_counter::slot_index()];
+      auto curr = slot.count.load(std::memory_order_relaxed);
+      while (curr != split_counter::folded) {
+        if (slot.count.compare_exchange_weak(curr, curr + 1, std::memory_order_relaxed)) return;
+      }
+      counter.shared.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline bool counter_ops<split_counter>::release(managed_ptr<split_counter>* block) noexcept {
+      // Slots are never folded while published, so a slot release can't be the last.
+      auto& counter = block->use_count;
+      auto& slot = counter.slots[split_counter::slot_index()];
+      auto curr = slot.count.load(std::memory_order_relaxed);
+      while (curr != split_counter::folded) {
+        if (slot.count.compare_exchange_weak(curr, curr - 1, std::memory_order_release, std::memory_order_relaxed)) {
+          return false;
+        }
+      }
+      return counter.shared.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    inline int64_t counter_ops<split_counter>::count(managed_ptr<split_counter> const* block) noexcept {
+      // Only a snapshot while published.
+      auto& counter = block->use_count;
+      auto total = counter.shared.load(std::memory_order_relaxed);
+      for (auto& slot : counter.slots) {
+        auto curr = slot.count.load(std::memory_order_relaxed);
+        if (curr != split_counter::folded) total += curr;
+      }
+      return (total > split_counter::publish_bias / 2) ? total - split_counter::publish_bias : total;
     }
 
     template <class T, class Counter>
@@ -31,7 +254,7 @@ namespace dart {
     counted_ptr_base<T, Counter>::counted_ptr_base(counted_ptr_base<U, Counter> const& other) noexcept :
       value(other.value)
     {
-      if (value) ++value->use_count;
+      if (value) counter_ops<Counter>::retain(value);
     }
 
     template <class T, class Counter>
@@ -58,7 +281,7 @@ namespace dart {
 
     template <class T, class Counter>
     counted_ptr_base<T, Counter>::counted_ptr_base(counted_ptr_base const& other) noexcept : value(other.value) {
-      if (value) ++value->use_count;
+      if (value) counter_ops<Counter>::retain(value);
     }
 
     template <class T, class Counter>
@@ -68,9 +291,8 @@ namespace dart {
 
     template <class T, class Counter>
     counted_ptr_base<T, Counter>::~counted_ptr_base() noexcept {
-      if (value && --value->use_count == 0) {
-        value->destroy();
-        delete value;
+      if (value && counter_ops<Counter>::release(value)) {
+        managed_ptr<Counter>::dispose(value);
       }
     }
 
@@ -190,7 +412,7 @@ namespace dart {
 
     template <class T, class Counter>
     int64_t counted_ptr_base<T, Counter>::use_count() const noexcept {
-      if (value) return value->use_count;
+      if (value) return counter_ops<Counter>::count(value);
       else return 0;
     }
 
@@ -220,6 +442,16 @@ namespace dart {
       return reinterpret_cast<element_type*>(this->value->ptr)[idx];
     }
 
+    template <class T>
+    void publication<counted_ptr_impl<T, split_counter>>::publish(counted_ptr_impl<T, split_counter> const& ptr) noexcept {
+      if (ptr.value) split_counter::publish(ptr.value);
+    }
+
+    template <class T>
+    void publication<counted_ptr_impl<T, split_counter>>::retract(counted_ptr_impl<T, split_counter> const& ptr) noexcept {
+      if (ptr.value) split_counter::retract(ptr.value);
+    }
+
   }
 
   template <class T>
@@ -439,6 +671,20 @@ namespace dart {
     return ptr;
   }
 
+  template <class T>
+  shareable_ptr<T> allocate_shareable(size_t bytes, size_t alignment, gsl::byte** out) {
+    shareable_ptr<T> ptr(typename shareable_ptr<T>::partial_construction_tag {});
+    try {
+      *out = refcount_traits<T>::allocate_bytes(&ptr.impl, bytes, alignment);
+    } catch (...) {
+      // Leave behind something our destructor can cope with.
+      using element_type = typename shareable_ptr<T>::element_type;
+      refcount_traits<T>::take(&ptr.impl, nullptr, std::default_delete<element_type> {});
+      throw;
+    }
+    return ptr;
+  }
+
   template <template <class> class RefCount>
   template <class T>
   view_ptr_context<RefCount>::view_ptr<T>::view_ptr(T*) {
@@ -602,7 +848,7 @@ namespace dart {
 
   template <class T, class... Args>
   std::enable_if_t<!std::is_array<T>::value, unsafe_ptr<T>> make_unsafe(Args&&... the_args) {
-    return unsafe_ptr<T>(new T(std::forward<Args>(the_args)...));
+    return detail::make_counted<unsafe_ptr<T>>(std::forward<Args>(the_args)...);
   }
 
   template <class T, class EnableIf>
@@ -612,7 +858,27 @@ namespace dart {
 
   template <class T, class... Args>
   std::enable_if_t<!std::is_array<T>::value, skinny_ptr<T>> make_skinny(Args&&... the_args) {
-    return skinny_ptr<T>(new T(std::forward<Args>(the_args)...));
+    return detail::make_counted<skinny_ptr<T>>(std::forward<Args>(the_args)...);
+  }
+
+  template <class T, class EnableIf>
+  biased_ptr<T> make_biased(size_t idx) {
+    return biased_ptr<T>(new std::remove_extent_t<T>[idx]);
+  }
+
+  template <class T, class... Args>
+  std::enable_if_t<!std::is_array<T>::value, biased_ptr<T>> make_biased(Args&&... the_args) {
+    return detail::make_counted<biased_ptr<T>>(std::forward<Args>(the_args)...);
+  }
+
+  template <class T, class EnableIf>
+  split_ptr<T> make_split(size_t idx) {
+    return split_ptr<T>(new std::remove_extent_t<T>[idx]);
+  }
+
+  template <class T, class... Args>
+  std::enable_if_t<!std::is_array<T>::value, split_ptr<T>> make_split(Args&&... the_args) {
+    return detail::make_counted<split_ptr<T>>(std::forward<Args>(the_args)...);
   }
 
 }
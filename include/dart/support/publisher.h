@@ -0,0 +1,189 @@
+#ifndef DART_PUBLISHER_H
+#define DART_PUBLISHER_H
+
+/*----- System Includes -----*/
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <gsl/gsl>
+#include <stdint.h>
+
+/*----- Local Includes -----*/
+
+#include "ptrs.h"
+
+/*----- Type Declarations -----*/
+
+namespace dart {
+
+  namespace detail {
+
+    /**
+     *  @brief
+     *  Per-thread bookkeeping for the read side of dart::publisher.
+     *
+     *  @details
+     *  Every reading thread announces the global epoch it observed for the duration
+     *  of a read, and clears it afterwards.
+     *  Writers bump the epoch after swapping a version out, and wait for any thread
+     *  still announcing an older epoch before releasing the old version (a minimal,
+     *  memory-barrier based, RCU).
+     *  Threads can also pin a single version, past the end of a read, which writers
+     *  check for before releasing anything they swapped out.
+     *  Reads never block, and never write to anything but their own cache line.
+     */
+    class epoch_thread {
+
+      public:
+
+        /*----- Lifecycle Functions -----*/
+
+        epoch_thread() noexcept;
+        epoch_thread(epoch_thread const&) = delete;
+        ~epoch_thread() noexcept;
+
+        /*----- Operators -----*/
+
+        epoch_thread& operator =(epoch_thread const&) = delete;
+
+        /*----- Public API -----*/
+
+        // Function calls the given callback inside of a read-side critical section.
+        template <class Callback>
+        static decltype(auto) read(Callback&& cb);
+
+        // Function waits until every read-side critical section that was already
+        // underway when it was called has finished.
+        static void synchronize() noexcept;
+
+        // Function calls the given callback inside of a read-side critical section,
+        // and pins whatever it returns for the calling thread, replacing anything
+        // pinned before. Returns null without calling it if the thread has exited.
+        template <class Callback>
+        static auto pin(Callback&& cb) noexcept -> decltype(cb());
+        static void unpin() noexcept;
+
+        // Function checks whether any thread has the given pointer pinned.
+        // Anything swapped out before the last call to synchronize() can't be pinned
+        // again, so a false result is final.
+        static bool is_pinned(void const* ptr) noexcept;
+
+      private:
+
+        /*----- Private Helpers -----*/
+
+        static epoch_thread* local() noexcept;
+        static bool& retired() noexcept;
+        static std::mutex& registry_lock() noexcept;
+        static epoch_thread*& registry() noexcept;
+        static std::atomic<uint64_t>& global_epoch() noexcept;
+
+        /*----- Private Members -----*/
+
+        // Zero when the thread is outside of a read.
+        std::atomic<uint64_t> epoch;
+        std::atomic<void const*> pinned;
+        epoch_thread* prev;
+        epoch_thread* next;
+
+    };
+
+    template <class Packet>
+    struct publisher_bytes;
+    template <template <template <class> class> class Packet, template <class> class RefCount>
+    struct publisher_bytes<Packet<RefCount>> {
+      using type = shareable_ptr<RefCount<gsl::byte const>>;
+    };
+
+  }
+
+  /**
+   *  @brief
+   *  Class holds the current version of a finalized packet, and allows it to be
+   *  hot-swapped by writers while any number of threads read it.
+   *
+   *  @details
+   *  Readers call load() to get a copy of the current version, and are never blocked
+   *  by writers, each other, or a mutex.
+   *  Writers call store() to swap in a new version, and wait for any readers that
+   *  might still be copying the old version before letting go of it.
+   *  Works with any reference counter, but is intended to be paired with
+   *  dart::split_ptr, in which case the current version is switched into per-thread
+   *  counting for as long as it's published, and readers never touch a shared
+   *  counter at all.
+   *  Readers can also pin() the current version instead of copying it, in which case
+   *  writers hold on to it until the reader pins something else, calls unpin(), or
+   *  exits, so each thread keeps at most one version alive past its replacement.
+   *
+   *  @remarks
+   *  Packet must be a dart::basic_buffer or dart::basic_packet, and stored packets
+   *  are finalized.
+   */
+  template <class Packet>
+  class publisher {
+
+    public:
+
+      /*----- Public Types -----*/
+
+      using value_type = Packet;
+
+      /*----- Lifecycle Functions -----*/
+
+      publisher() : publisher(Packet {}) {}
+      explicit publisher(Packet pkt);
+      publisher(publisher const&) = delete;
+      ~publisher() noexcept;
+
+      /*----- Operators -----*/
+
+      publisher& operator =(publisher const&) = delete;
+
+      /*----- Public API -----*/
+
+      // Function returns a copy of the current version.
+      Packet load() const;
+
+      // Function pins the current version for the calling thread, across every publisher,
+      // and returns it without copying it, or null if the thread has already exited.
+      // Remains valid until the thread pins something else, calls unpin(), or exits,
+      // or the publisher is destroyed.
+      Packet const* pin() const noexcept;
+      static void unpin() noexcept;
+
+      // Function publishes a new version, and returns the one it replaced.
+      Packet exchange(Packet pkt);
+      void store(Packet pkt);
+
+    private:
+
+      /*----- Private Types -----*/
+
+      struct version {
+        explicit version(Packet pkt);
+        version(version const&) = delete;
+        ~version() noexcept;
+
+        Packet pkt;
+        typename detail::publisher_bytes<Packet>::type bytes;
+      };
+
+      /*----- Private Members -----*/
+
+      std::atomic<version*> current;
+
+      // Versions that were swapped out while pinned, released by later writers.
+      std::mutex retire_lock;
+      std::vector<std::unique_ptr<version>> retired;
+
+  };
+
+}
+
+/*----- Template Implementations -----*/
+
+#include "publisher.tcc"
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef DART_PUBLISHER_IMPL_H
+#define DART_PUBLISHER_IMPL_H
+
+/*----- System Includes -----*/
+
+#include <thread>
+#include <algorithm>
+
+/*----- Local Includes -----*/
+
+#include "publisher.h"
+
+/*----- Function Implementations -----*/
+
+namespace dart {
+
+  namespace detail {
+
+    inline epoch_thread::epoch_thread() noexcept : epoch(0), pinned(nullptr), prev(nullptr), next(nullptr) {
+      std::lock_guard<std::mutex> guard(registry_lock());
+      next = registry();
+      if (next) next->prev = this;
+      registry() = this;
+    }
+
+    inline epoch_thread::~epoch_thread() noexcept {
+      // Anything read on this thread from here on out falls back on the registry lock.
+      retired() = true;
+
+      std::lock_guard<std::mutex> guard(registry_lock());
+      if (prev) prev->next = next;
+      else registry() = next;
+      if (next) next->prev = prev;
+    }
+
+    template <class Callback>
+    decltype(auto) epoch_thread::read(Callback&& cb) {
+      struct guard {
+        ~guard() noexcept {
+          thread->epoch.store(0, std::memory_order_release);
+        }
+        epoch_thread* thread;
+      };
+
+      // Our bookkeeping is gone, so hold writers off the old fashioned way.
+      auto* thread = local();
+      if (!thread) {
+        std::lock_guard<std::mutex> lock(registry_lock());
+        return cb();
+      }
+
+      // Announce ourselves before looking at anything a writer might release.
+      // Both the load and the store must be sequentially consistent, so that announcing
+      // an epoch at least as new as a writer's target guarantees we see its swap.
+      thread->epoch.store(global_epoch().load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+      guard clear {thread};
+      return cb();
+    }
+
+    inline void epoch_thread::synchronize() noexcept {
+      // Holding the registry lock keeps threads from exiting out from under us.
+      std::lock_guard<std::mutex> guard(registry_lock());
+      auto target = global_epoch().fetch_add(1, std::memory_order_seq_cst) + 1;
+      for (auto* thread = registry(); thread; thread = thread->next) {
+        while (true) {
+          auto observed = thread->epoch.load(std::memory_order_seq_cst);
+          if (!observed || observed >= target) break;
+          std::this_thread::yield();
+        }
+      }
+    }
+
+    template <class Callback>
+    auto epoch_thread::pin(Callback&& cb) noexcept -> decltype(cb()) {
+      // Without our bookkeeping there's nowhere for writers to look for the pin.
+      auto* thread = local();
+      if (!thread) return nullptr;
+
+      // Pinned inside of a read, so a writer that swaps the pointer out will wait
+      // for the pin to land before checking for it.
+      return read([&] {
+        auto ptr = cb();
+        thread->pinned.store(ptr, std::memory_order_release);
+        return ptr;
+      });
+    }
+
+    inline void epoch_thread::unpin() noexcept {
+      if (auto* thread = local()) thread->pinned.store(nullptr, std::memory_order_release);
+    }
+
+    inline bool epoch_thread::is_pinned(void const* ptr) noexcept {
+      // Holding the registry lock keeps threads from exiting out from under us.
+      std::lock_guard<std::mutex> guard(registry_lock());
+      for (auto* thread = registry(); thread; thread = thread->next) {
+        if (thread->pinned.load(std::memory_order_acquire) == ptr) return true;
+      }
+      return false;
+    }
+
+    inline epoch_thread* epoch_thread::local() noexcept {
+      // Thread local destruction order isn't something we get to control,
+      // so once our record is gone we stop handing it out.
+      if (retired()) return nullptr;
+      static thread_local epoch_thread thread;
+      return &thread;
+    }
+
+    inline bool& epoch_thread::retired() noexcept {
+      // Trivially destructible, so it outlives the record itself.
+      static thread_local bool flag = false;
+      return flag;
+    }
+
+    inline std::mutex& epoch_thread::registry_lock() noexcept {
+      static std::mutex lock;
+      return lock;
+    }
+
+    inline epoch_thread*& epoch_thread::registry() noexcept {
+      static epoch_thread* head = nullptr;
+      return head;
+    }
+
+    inline std::atomic<uint64_t>& epoch_thread::global_epoch() noexcept {
+      // Starts at one, as zero means a thread isn't reading.
+      static std::atomic<uint64_t> epoch {1};
+      return epoch;
+    }
+
+  }
+
+  template <class Packet>
+  publisher<Packet>::version::version(Packet pkt) : pkt(std::move(pkt)), bytes(nullptr) {
+    if (this->pkt.is_null()) return;
+
+    // Grab our own reference to the network buffer so we can tell its
+    // reference counter that it's being published.
+    this->pkt.finalize();
+    this->pkt.share_bytes(bytes.raw());
+    detail::publication<std::decay_t<decltype(bytes.raw())>>::publish(bytes.raw());
+  }
+
+  template <class Packet>
+  publisher<Packet>::version::~version() noexcept {
+    detail::publication<std::decay_t<decltype(bytes.raw())>>::retract(bytes.raw());
+  }
+
+  template <class Packet>
+  publisher<Packet>::publisher(Packet pkt) : current(new version(std::move(pkt))) {}
+
+  template <class Packet>
+  publisher<Packet>::~publisher() noexcept {
+    delete current.load(std::memory_order_acquire);
+  }
+
+  template <class Packet>
+  Packet publisher<Packet>::load() const {
+    return detail::epoch_thread::read([this] {
+      return current.load(std::memory_order_seq_cst)->pkt;
+    });
+  }
+
+  template <class Packet>
+  auto publisher<Packet>::pin() const noexcept -> Packet const* {
+    auto const* curr = detail::epoch_thread::pin([this] () -> version const* {
+      return current.load(std::memory_order_seq_cst);
+    });
+    return curr ? &curr->pkt : nullptr;
+  }
+
+  template <class Packet>
+  void publisher<Packet>::unpin() noexcept {
+    detail::epoch_thread::unpin();
+  }
+
+  template <class Packet>
+  Packet publisher<Packet>::exchange(Packet pkt) {
+    // Make room to retire the old version before anything is swapped,
+    // so nothing can fail once it has been.
+    std::unique_ptr<version> next {new version(std::move(pkt))};
+    std::lock_guard<std::mutex> guard(retire_lock);
+    retired.reserve(retired.size() + 1);
+
+    // Swap the new version in, and then wait out anyone who might still be
+    // copying, or pinning, the old one.
+    std::unique_ptr<version> prev {current.exchange(next.release(), std::memory_order_seq_cst)};
+    detail::epoch_thread::synchronize();
+
+    // Anything retired earlier that's no longer pinned can finally go,
+    // while the old version has to wait its turn if it's pinned.
+    auto unpinned = [] (auto const& ver) { return !detail::epoch_thread::is_pinned(ver.get()); };
+    retired.erase(std::remove_if(retired.begin(), retired.end(), unpinned), retired.end());
+    if (!detail::epoch_thread::is_pinned(prev.get())) return std::move(prev->pkt);
+    retired.push_back(std::move(prev));
+    return retired.back()->pkt;
+  }
+
+  template <class Packet>
+  void publisher<Packet>::store(Packet pkt) {
+    exchange(std::move(pkt));
+  }
+
+}
+
+#endif
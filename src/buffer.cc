@@ -34,7 +34,8 @@ namespace {
     auto err = buffer_access(
       compose(
         [get_str] (dart::buffer const& src) { get_str(src); },
-        [get_str] (dart::unsafe_buffer const& src) { get_str(src); }
+        [get_str] (dart::unsafe_buffer const& src) { get_str(src); },
+        [get_str] (dart::biased_buffer const& src) { get_str(src); }
       ),
       src
     );
@@ -47,7 +48,8 @@ namespace {
     return buffer_access(
       compose(
         [get_int] (dart::buffer const& src) { get_int(src); },
-        [get_int] (dart::unsafe_buffer const& src) { get_int(src); }
+        [get_int] (dart::unsafe_buffer const& src) { get_int(src); },
+        [get_int] (dart::biased_buffer const& src) { get_int(src); }
       ),
       src
     );
@@ -58,7 +60,8 @@ namespace {
     return buffer_access(
       compose(
         [get_dcm] (dart::buffer const& src) { get_dcm(src); },
-        [get_dcm] (dart::unsafe_buffer const& src) { get_dcm(src); }
+        [get_dcm] (dart::unsafe_buffer const& src) { get_dcm(src); },
+        [get_dcm] (dart::biased_buffer const& src) { get_dcm(src); }
       ),
       src
     );
@@ -69,12 +72,195 @@ namespace {
     return buffer_access(
       compose(
         [get_bool] (dart::buffer const& src) { get_bool(src); },
-        [get_bool] (dart::unsafe_buffer const& src) { get_bool(src); }
+        [get_bool] (dart::unsafe_buffer const& src) { get_bool(src); },
+        [get_bool] (dart::biased_buffer const& src) { get_bool(src); }
       ),
       src
     );
   }
 
+  // Function constructs n buffers in place from the given lookup,
+  // and cleans up after itself if any of them throw.
+  template <class Buffer, class Lookup>
+  void batch_construct(dart_buffer_t* dst, dart_type_id_t rtti, size_t n, Lookup&& lookup) {
+    size_t built = 0;
+    try {
+      for (; built < n; ++built) {
+        dst[built].rtti = rtti;
+        new(DART_RAW_BYTES(&dst[built])) Buffer(lookup(built));
+      }
+    } catch (...) {
+      while (built) reinterpret_cast<Buffer*>(DART_RAW_BYTES(&dst[--built]))->~Buffer();
+      throw;
+    }
+  }
+
+  dart_err_t dart_buffer_obj_get_many_impl(dart_buffer_t* dst,
+      dart_buffer_t const* src, char const* const* keys, size_t const* lens, size_t n) {
+    auto rtti = src->rtti;
+    return buffer_access(
+      [=] (auto& src) {
+        using buffer_type = std::decay_t<decltype(src)>;
+        if (!src.is_object()) throw dart::type_error("dart_buffer_obj_get_many called on non-object");
+        batch_construct<buffer_type>(dst, rtti, n, [&] (size_t idx) {
+          return src[{keys[idx], lens ? lens[idx] : strlen(keys[idx])}];
+        });
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_buffer_arr_get_range_impl(dart_buffer_t* dst, dart_buffer_t const* src, size_t start, size_t n) {
+    auto rtti = src->rtti;
+    return buffer_access(
+      [=] (auto& src) {
+        using buffer_type = std::decay_t<decltype(src)>;
+        if (!src.is_array()) throw dart::type_error("dart_buffer_arr_get_range called on non-array");
+        batch_construct<buffer_type>(dst, rtti, n, [&] (size_t idx) { return src[start + idx]; });
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_buffer_extract_typed_impl(dart_buffer_t const* src, dart_field_t const* fields, size_t n, void* out) {
+    auto* bytes = reinterpret_cast<char*>(out);
+    return buffer_access(
+      [=] (auto& src) {
+        // Work against a view so that none of the lookups touch the reference count.
+        typename std::decay_t<decltype(src)>::view obj = src;
+        if (!obj.is_object()) throw dart::type_error("dart_buffer_extract_typed called on non-object");
+
+        for (size_t i = 0; i < n; ++i) {
+          auto& field = fields[i];
+          auto val = obj[{field.key, field.len}];
+          if (val.is_null()) continue;
+          else if (abi_type(val.get_type()) != field.type) {
+            throw dart::type_error("dart_buffer_extract_typed encountered a field of unexpected type");
+          }
+
+          // Destinations may not be aligned, so copy everything in bytewise.
+          auto* dst = bytes + field.offset;
+          switch (field.type) {
+            case DART_STRING:
+              {
+                auto strv = val.strv();
+                dart_string_view_t view {strv.data(), strv.size()};
+                memcpy(dst, &view, sizeof(view));
+                break;
+              }
+            case DART_INTEGER:
+              {
+                int64_t num = val.integer();
+                memcpy(dst, &num, sizeof(num));
+                break;
+              }
+            case DART_DECIMAL:
+              {
+                double num = val.decimal();
+                memcpy(dst, &num, sizeof(num));
+                break;
+              }
+            case DART_BOOLEAN:
+              {
+                int flag = val.boolean();
+                memcpy(dst, &flag, sizeof(flag));
+                break;
+              }
+            default:
+              throw abi_error("dart_buffer_extract_typed can only extract strings, integers, decimals, and booleans");
+          }
+        }
+      },
+      src
+    );
+  }
+
+  // Function copies up to cap elements of the given array out through the given
+  // conversion, working against a view so nothing touches the reference count.
+  template <class Value, class Convert>
+  dart_err_t buffer_arr_unpack(dart_buffer_t const* src, Value* out, size_t cap, size_t* count, Convert&& conv) {
+    return buffer_access(
+      [&] (auto& src) {
+        typename std::decay_t<decltype(src)>::view arr = src;
+        if (!arr.is_array()) throw dart::type_error("dart_buffer_arr_get functions called on non-array");
+
+        size_t idx = 0;
+        for (auto it = arr.begin(); idx < cap && it != arr.end(); ++it) out[idx++] = conv(*it);
+        if (count) *count = arr.size();
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_buffer_arr_get_strs_impl(dart_buffer_t const* src, dart_string_view_t* out, size_t cap, size_t* count) {
+    return buffer_arr_unpack(src, out, cap, count, [] (auto const& val) {
+      auto strv = val.strv();
+      return dart_string_view_t {strv.data(), strv.size()};
+    });
+  }
+
+  dart_err_t dart_buffer_arr_get_ints_impl(dart_buffer_t const* src, int64_t* out, size_t cap, size_t* count) {
+    return buffer_arr_unpack(src, out, cap, count, [] (auto const& val) { return val.integer(); });
+  }
+
+  dart_err_t dart_buffer_arr_get_dcms_impl(dart_buffer_t const* src, double* out, size_t cap, size_t* count) {
+    return buffer_arr_unpack(src, out, cap, count, [] (auto const& val) { return val.decimal(); });
+  }
+
+  dart_err_t dart_buffer_obj_get_all_impl(dart_buffer_t const* src,
+      dart_string_view_t* keys, dart_buffer_view_t* vals, size_t cap, size_t* count) {
+    dart_type_id_t rtti {DART_BUFFER_VIEW, src->rtti.rc_id};
+    return buffer_access(
+      [=] (auto& src) {
+        using view_type = typename std::decay_t<decltype(src)>::view;
+        view_type obj = src;
+        if (!obj.is_object()) throw dart::type_error("dart_buffer_obj_get_all called on non-object");
+
+        // Walk the keyspace and valuespace in lockstep.
+        size_t idx = 0;
+        auto key_it = obj.key_begin(), val_it = obj.begin();
+        for (; idx < cap && key_it != obj.key_end(); ++key_it, ++val_it, ++idx) {
+          if (keys) {
+            auto key = (*key_it).strv();
+            keys[idx] = {key.data(), key.size()};
+          }
+          if (vals) {
+            vals[idx].rtti = rtti;
+            new(DART_RAW_BYTES(&vals[idx])) view_type(*val_it);
+          }
+        }
+        if (count) *count = obj.size();
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_buffer_obj_try_get_len_impl(dart_buffer_t* dst, dart_buffer_t const* src, char const* key, size_t len) {
+    // Initialize.
+    dst->rtti = src->rtti;
+    return quiet_buffer_access(
+      [=] (auto& src) {
+        using buffer_type = std::decay_t<decltype(src)>;
+        if (!src.is_object()) return DART_TYPE_ERROR;
+        return buffer_construct([&] (buffer_type* dst) { new(dst) buffer_type(src[{key, len}]); }, dst);
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_buffer_arr_try_get_impl(dart_buffer_t* dst, dart_buffer_t const* src, size_t idx) {
+    // Initialize.
+    dst->rtti = src->rtti;
+    return quiet_buffer_access(
+      [=] (auto& src) {
+        using buffer_type = std::decay_t<decltype(src)>;
+        if (!src.is_array()) return DART_TYPE_ERROR;
+        return buffer_construct([&] (buffer_type* dst) { new(dst) buffer_type(src[idx]); }, dst);
+      },
+      src
+    );
+  }
+
   size_t dart_buffer_size_impl(dart_buffer_t const* src) {
     size_t val = 0;
     auto err = buffer_access([&val] (auto& src) { val = src.size(); }, src);
@@ -82,6 +268,13 @@ namespace {
     else return val;
   }
 
+  size_t dart_buffer_hash_impl(dart_buffer_t const* src) {
+    size_t val = 0;
+    auto err = buffer_access([&val] (auto& src) { val = src.hash(); }, src);
+    if (err) return DART_FAILURE;
+    else return val;
+  }
+
   int dart_buffer_equal_impl(dart_buffer_t const* lhs, dart_buffer_t const* rhs) {
     bool equal = false;
     auto check = [&] (auto& lhs, auto& rhs) { equal = (lhs == rhs); };
@@ -92,6 +285,9 @@ namespace {
         },
         [check, rhs] (dart::unsafe_buffer const& lhs) {
           buffer_access([check, lhs] (dart::unsafe_buffer const& rhs) { check(lhs, rhs); }, rhs);
+        },
+        [check, rhs] (dart::biased_buffer const& lhs) {
+          buffer_access([check, lhs] (dart::biased_buffer const& rhs) { check(lhs, rhs); }, rhs);
         }
       ),
       lhs
@@ -106,7 +302,8 @@ namespace {
     auto err = buffer_access(
       compose(
         [=] (dart::buffer const& pkt) { get_type(pkt); },
-        [=] (dart::unsafe_buffer const& pkt) { get_type(pkt); }
+        [=] (dart::unsafe_buffer const& pkt) { get_type(pkt); },
+        [=] (dart::biased_buffer const& pkt) { get_type(pkt); }
       ),
       src
     );
@@ -128,7 +325,8 @@ namespace {
     auto ret = buffer_access(
       compose(
         [=] (dart::buffer const& pkt) { print(pkt); },
-        [=] (dart::unsafe_buffer const& pkt) { print(pkt); }
+        [=] (dart::unsafe_buffer const& pkt) { print(pkt); },
+        [=] (dart::biased_buffer const& pkt) { print(pkt); }
       ),
       pkt
     );
@@ -177,6 +375,178 @@ namespace {
     else return ptr;
   }
 
+
+  // Functions initialize a view of some part of the given buffer or view
+  // without touching its reference count.
+  template <class Lookup>
+  dart_err_t buffer_view_derive(dart_buffer_view_t* dst, dart_buffer_t const* src, Lookup&& lookup) {
+    // Initialize.
+    dst->rtti = {DART_BUFFER_VIEW, src->rtti.rc_id};
+    return buffer_access(
+      [&] (auto& src) {
+        using view_type = typename std::decay_t<decltype(src)>::view;
+        return buffer_view_construct([&] (view_type* dst) { new(dst) view_type(lookup(view_type {src})); }, dst);
+      },
+      src
+    );
+  }
+
+  template <class Lookup>
+  dart_err_t buffer_view_derive(dart_buffer_view_t* dst, dart_buffer_view_t const* src, Lookup&& lookup) {
+    // Initialize.
+    dst->rtti = src->rtti;
+    return buffer_view_access(
+      [&] (auto& src) {
+        using view_type = std::decay_t<decltype(src)>;
+        return buffer_view_construct([&] (view_type* dst) { new(dst) view_type(lookup(src)); }, dst);
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_buffer_view_init_err_impl(dart_buffer_view_t* dst, dart_buffer_t const* src) {
+    return buffer_view_derive(dst, src, [] (auto const& src) { return src; });
+  }
+
+  dart_err_t dart_buffer_view_to_buffer_err_impl(dart_buffer_t* dst, dart_buffer_view_t const* src) {
+    // Initialize.
+    dst->rtti = {DART_BUFFER, src->rtti.rc_id};
+    return buffer_view_access(
+      [dst] (auto& src) {
+        using buffer_type = std::decay_t<decltype(src.as_owner())>;
+        return buffer_construct([&src] (buffer_type* dst) { new(dst) buffer_type(src.as_owner()); }, dst);
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_buffer_view_destroy_impl(dart_buffer_view_t* dst) {
+    return buffer_view_access([] (auto& dst) {
+      using view_type = std::decay_t<decltype(dst)>;
+      dst.~view_type();
+    }, dst);
+  }
+
+  dart_err_t dart_buffer_obj_get_view_len_impl(dart_buffer_view_t* dst,
+      dart_buffer_t const* src, char const* key, size_t len) {
+    return buffer_view_derive(dst, src, [=] (auto const& src) { return src[{key, len}]; });
+  }
+
+  dart_err_t dart_buffer_arr_get_view_impl(dart_buffer_view_t* dst, dart_buffer_t const* src, size_t idx) {
+    return buffer_view_derive(dst, src, [=] (auto const& src) { return src[idx]; });
+  }
+
+  dart_err_t dart_buffer_view_obj_get_len_impl(dart_buffer_view_t* dst,
+      dart_buffer_view_t const* src, char const* key, size_t len) {
+    return buffer_view_derive(dst, src, [=] (auto const& src) { return src[{key, len}]; });
+  }
+
+  dart_err_t dart_buffer_view_arr_get_impl(dart_buffer_view_t* dst, dart_buffer_view_t const* src, size_t idx) {
+    return buffer_view_derive(dst, src, [=] (auto const& src) { return src[idx]; });
+  }
+
+  char const* dart_buffer_view_str_get_len_impl(dart_buffer_view_t const* src, size_t* len) {
+    char const* str;
+    auto err = buffer_view_access(
+      [&] (auto& src) {
+        auto view = src.strv();
+        str = view.data();
+        *len = view.size();
+      },
+      src
+    );
+    if (err) return nullptr;
+    else return str;
+  }
+
+  dart_err_t dart_buffer_view_int_get_err_impl(dart_buffer_view_t const* src, int64_t* val) {
+    return buffer_view_access([=] (auto& src) { *val = src.integer(); }, src);
+  }
+
+  dart_err_t dart_buffer_view_dcm_get_err_impl(dart_buffer_view_t const* src, double* val) {
+    return buffer_view_access([=] (auto& src) { *val = src.decimal(); }, src);
+  }
+
+  dart_err_t dart_buffer_view_bool_get_err_impl(dart_buffer_view_t const* src, int* val) {
+    return buffer_view_access([=] (auto& src) { *val = src.boolean(); }, src);
+  }
+
+  size_t dart_buffer_view_size_impl(dart_buffer_view_t const* src) {
+    size_t val = 0;
+    auto err = buffer_view_access([&val] (auto& src) { val = src.size(); }, src);
+    if (err) return DART_FAILURE;
+    else return val;
+  }
+
+  dart_type_t dart_buffer_view_get_type_impl(dart_buffer_view_t const* src) {
+    dart_type_t type;
+    auto err = buffer_view_access([&type] (auto& src) { type = abi_type(src.get_type()); }, src);
+    if (err) return DART_INVALID;
+    else return type;
+  }
+
+  dart_err_t dart_buffer_view_iterator_init_err_impl(dart_buffer_view_iterator_t* dst, dart_buffer_view_t const* src) {
+    // Initialize.
+    dst->rtti = src->rtti;
+    return buffer_view_access(
+      [dst] (auto& src) {
+        using iterator = typename std::decay_t<decltype(src)>::iterator;
+        return view_iterator_construct([&src] (iterator* begin, iterator* end) {
+          new(begin) iterator(src.begin());
+          new(end) iterator(src.end());
+        }, dst);
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_buffer_view_iterator_init_key_err_impl(dart_buffer_view_iterator_t* dst, dart_buffer_view_t const* src) {
+    // Initialize.
+    dst->rtti = src->rtti;
+    return buffer_view_access(
+      [dst] (auto& src) {
+        using iterator = typename std::decay_t<decltype(src)>::iterator;
+        return view_iterator_construct([&src] (iterator* begin, iterator* end) {
+          new(begin) iterator(src.key_begin());
+          new(end) iterator(src.key_end());
+        }, dst);
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_buffer_view_iterator_get_err_impl(dart_buffer_view_t* dst, dart_buffer_view_iterator_t const* src) {
+    // Initialize.
+    dst->rtti = src->rtti;
+    return view_iterator_access(
+      [dst] (auto& src_curr, auto& src_end) {
+        using view_type = typename std::decay_t<decltype(src_curr)>::value_type;
+        if (src_curr == src_end) throw std::runtime_error("dart_buffer_view_iterator has been exhausted");
+        return buffer_view_construct([&src_curr] (view_type* dst) { new(dst) view_type(*src_curr); }, dst);
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_buffer_view_iterator_next_impl(dart_buffer_view_iterator_t* dst) {
+    return view_iterator_access([] (auto& curr, auto& end) { if (curr != end) curr++; }, dst);
+  }
+
+  int dart_buffer_view_iterator_done_impl(dart_buffer_view_iterator_t const* src) {
+    bool ended = false;
+    auto err = view_iterator_access([&] (auto& curr, auto& end) { ended = (curr == end); }, src);
+    if (err) return true;
+    else return ended;
+  }
+
+  dart_err_t dart_buffer_view_iterator_destroy_impl(dart_buffer_view_iterator_t* dst) {
+    return view_iterator_access([] (auto& start, auto& end) {
+      using type = std::decay_t<decltype(start)>;
+      start.~type();
+      end.~type();
+    }, dst);
+  }
+
 }
 
 /*----- Function Implementations -----*/
@@ -207,7 +577,8 @@ extern "C" {
     return buffer_constructor_access(
       compose(
         [] (dart::buffer* ptr) { new(ptr) dart::buffer(); },
-        [] (dart::unsafe_buffer* ptr) { new(ptr) dart::unsafe_buffer(); }
+        [] (dart::unsafe_buffer* ptr) { new(ptr) dart::unsafe_buffer(); },
+        [] (dart::biased_buffer* ptr) { new(ptr) dart::biased_buffer(); }
       ),
       dst
     );
@@ -230,6 +601,9 @@ extern "C" {
         },
         [dst] (dart::unsafe_buffer const& src) {
           return buffer_construct([&src] (dart::unsafe_buffer* dst) { new(dst) dart::unsafe_buffer(src); }, dst);
+        },
+        [dst] (dart::biased_buffer const& src) {
+          return buffer_construct([&src] (dart::biased_buffer* dst) { new(dst) dart::biased_buffer(src); }, dst);
         }
       ),
       src
@@ -253,6 +627,9 @@ extern "C" {
         },
         [dst] (dart::unsafe_buffer& src) {
           return buffer_construct([&src] (dart::unsafe_buffer* dst) { new(dst) dart::unsafe_buffer(std::move(src)); }, dst);
+        },
+        [dst] (dart::biased_buffer& src) {
+          return buffer_construct([&src] (dart::biased_buffer* dst) { new(dst) dart::biased_buffer(std::move(src)); }, dst);
         }
       ),
       src
@@ -264,7 +641,8 @@ extern "C" {
     return buffer_access(
       compose(
         [] (dart::buffer& dst) { dst.~basic_buffer(); },
-        [] (dart::unsafe_buffer& dst) { dst.~basic_buffer(); }
+        [] (dart::unsafe_buffer& dst) { dst.~basic_buffer(); },
+        [] (dart::biased_buffer& dst) { dst.~basic_buffer(); }
       ),
       dst
     );
@@ -310,6 +688,11 @@ extern "C" {
           return buffer_construct([&] (dart::unsafe_buffer* dst) {
             new(dst) dart::unsafe_buffer(src[{key, len}]);
           }, dst);
+        },
+        [=] (dart::biased_buffer const& src) {
+          return buffer_construct([&] (dart::biased_buffer* dst) {
+            new(dst) dart::biased_buffer(src[{key, len}]);
+          }, dst);
         }
       ),
       src
@@ -337,12 +720,29 @@ extern "C" {
           return buffer_construct([&] (dart::unsafe_buffer* dst) {
             new(dst) dart::unsafe_buffer(src[idx]);
           }, dst);
+        },
+        [=] (dart::biased_buffer const& src) {
+          return buffer_construct([&] (dart::biased_buffer* dst) {
+            new(dst) dart::biased_buffer(src[idx]);
+          }, dst);
         }
       ),
       src
     );
   }
 
+  dart_err_t dart_buffer_obj_try_get(dart_buffer_t* dst, dart_buffer_t const* src, char const* key) {
+    return dart_buffer_obj_try_get_len(dst, src, key, strlen(key));
+  }
+
+  dart_err_t dart_buffer_obj_try_get_len(dart_buffer_t* dst, dart_buffer_t const* src, char const* key, size_t len) {
+    return dart_buffer_obj_try_get_len_impl(dst, src, key, len);
+  }
+
+  dart_err_t dart_buffer_arr_try_get(dart_buffer_t* dst, dart_buffer_t const* src, size_t idx) {
+    return dart_buffer_arr_try_get_impl(dst, src, idx);
+  }
+
   char const* dart_buffer_str_get(dart_buffer_t const* src) {
     size_t dummy;
     return dart_buffer_str_get_len(src, &dummy);
@@ -394,6 +794,10 @@ extern "C" {
     return dart_buffer_equal_impl(lhs, rhs);
   }
 
+  size_t dart_buffer_hash(dart_buffer_t const* src) {
+    return dart_buffer_hash_impl(src);
+  }
+
   int dart_buffer_is_obj(dart_buffer_t const* src) {
     return dart_buffer_get_type(src) == DART_OBJECT;
   }
@@ -426,6 +830,36 @@ extern "C" {
     return dart_buffer_get_type_impl(src);
   }
 
+  dart_err_t dart_buffer_obj_get_many(dart_buffer_t* dst,
+      dart_buffer_t const* src, char const* const* keys, size_t const* lens, size_t n) {
+    return dart_buffer_obj_get_many_impl(dst, src, keys, lens, n);
+  }
+
+  dart_err_t dart_buffer_arr_get_range(dart_buffer_t* dst, dart_buffer_t const* src, size_t start, size_t n) {
+    return dart_buffer_arr_get_range_impl(dst, src, start, n);
+  }
+
+  dart_err_t dart_buffer_extract_typed(dart_buffer_t const* src, dart_field_t const* fields, size_t n, void* out) {
+    return dart_buffer_extract_typed_impl(src, fields, n, out);
+  }
+
+  dart_err_t dart_buffer_arr_get_strs(dart_buffer_t const* src, dart_string_view_t* out, size_t cap, size_t* count) {
+    return dart_buffer_arr_get_strs_impl(src, out, cap, count);
+  }
+
+  dart_err_t dart_buffer_arr_get_ints(dart_buffer_t const* src, int64_t* out, size_t cap, size_t* count) {
+    return dart_buffer_arr_get_ints_impl(src, out, cap, count);
+  }
+
+  dart_err_t dart_buffer_arr_get_dcms(dart_buffer_t const* src, double* out, size_t cap, size_t* count) {
+    return dart_buffer_arr_get_dcms_impl(src, out, cap, count);
+  }
+
+  dart_err_t dart_buffer_obj_get_all(dart_buffer_t const* src,
+      dart_string_view_t* keys, dart_buffer_view_t* vals, size_t cap, size_t* count) {
+    return dart_buffer_obj_get_all_impl(src, keys, vals, cap, count);
+  }
+
   dart_buffer_t dart_buffer_from_json(char const* str) {
     dart_buffer_t dst;
     auto err = dart_buffer_from_json_err(&dst, str);
@@ -475,7 +909,8 @@ extern "C" {
       return buffer_unwrap(
         compose(
           [=] (dart::buffer& dst) { dst = dart::buffer::from_json({str, len}); },
-          [=] (dart::unsafe_buffer& dst) { dst = dart::unsafe_buffer::from_json({str, len}); }
+          [=] (dart::unsafe_buffer& dst) { dst = dart::unsafe_buffer::from_json({str, len}); },
+          [=] (dart::biased_buffer& dst) { dst = dart::biased_buffer::from_json({str, len}); }
         ),
         dst
       );
@@ -503,6 +938,9 @@ extern "C" {
         },
         [dst] (dart::unsafe_buffer const& src) {
           heap_construct([&src] (dart::unsafe_heap* dst) { new(dst) dart::unsafe_heap(src.lift()); }, dst);
+        },
+        [dst] (dart::biased_buffer const& src) {
+          heap_construct([&src] (dart::biased_heap* dst) { new(dst) dart::biased_heap(src.lift()); }, dst);
         }
       ),
       src
@@ -524,6 +962,10 @@ extern "C" {
     return dart_buffer_get_bytes_impl(src, len);
   }
 
+  uint32_t dart_buffer_layout_version() {
+    return dart::detail::buffer_layout_version;
+  }
+
   void* dart_buffer_dup_bytes(dart_buffer_t const* src, size_t* len) {
     return dart_buffer_dup_bytes_impl(src, len);
   }
@@ -556,7 +998,8 @@ extern "C" {
       return buffer_unwrap(
         compose(
           [punned, len] (dart::buffer& dst) { dst = dart::buffer {gsl::make_span(punned, len)}; },
-          [punned, len] (dart::unsafe_buffer& dst) { dst = dart::unsafe_buffer {gsl::make_span(punned, len)}; }
+          [punned, len] (dart::unsafe_buffer& dst) { dst = dart::unsafe_buffer {gsl::make_span(punned, len)}; },
+          [punned, len] (dart::biased_buffer& dst) { dst = dart::biased_buffer {gsl::make_span(punned, len)}; }
         ),
         dst
       );
@@ -596,11 +1039,109 @@ extern "C" {
       return buffer_unwrap(
         compose(
           [&] (dart::buffer& dst) { dst = dart::buffer {std::move(owner)}; },
-          [&] (dart::unsafe_buffer& dst) { dst = dart::unsafe_buffer {std::move(owner)}; }
+          [&] (dart::unsafe_buffer& dst) { dst = dart::unsafe_buffer {std::move(owner)}; },
+          [&] (dart::biased_buffer& dst) { dst = dart::biased_buffer {std::move(owner)}; }
         ),
         dst
       );
     });
   }
-  
+
+  dart_buffer_view_t dart_buffer_view_init(dart_buffer_t const* src) {
+    dart_buffer_view_t dst;
+    auto err = dart_buffer_view_init_err(&dst, src);
+    if (err) {
+      // A view of a default constructed buffer is always null.
+      static dart_buffer_t const null_buffer = dart_buffer_init();
+      dart_buffer_view_init_err(&dst, &null_buffer);
+    }
+    return dst;
+  }
+
+  dart_err_t dart_buffer_view_init_err(dart_buffer_view_t* dst, dart_buffer_t const* src) {
+    return dart_buffer_view_init_err_impl(dst, src);
+  }
+
+  dart_err_t dart_buffer_view_to_buffer_err(dart_buffer_t* dst, dart_buffer_view_t const* src) {
+    return dart_buffer_view_to_buffer_err_impl(dst, src);
+  }
+
+  dart_err_t dart_buffer_view_destroy(dart_buffer_view_t* dst) {
+    return dart_buffer_view_destroy_impl(dst);
+  }
+
+  dart_err_t dart_buffer_obj_get_view(dart_buffer_view_t* dst, dart_buffer_t const* src, char const* key) {
+    return dart_buffer_obj_get_view_len(dst, src, key, strlen(key));
+  }
+
+  dart_err_t dart_buffer_obj_get_view_len(dart_buffer_view_t* dst,
+      dart_buffer_t const* src, char const* key, size_t len) {
+    return dart_buffer_obj_get_view_len_impl(dst, src, key, len);
+  }
+
+  dart_err_t dart_buffer_arr_get_view(dart_buffer_view_t* dst, dart_buffer_t const* src, size_t idx) {
+    return dart_buffer_arr_get_view_impl(dst, src, idx);
+  }
+
+  dart_err_t dart_buffer_view_obj_get(dart_buffer_view_t* dst, dart_buffer_view_t const* src, char const* key) {
+    return dart_buffer_view_obj_get_len(dst, src, key, strlen(key));
+  }
+
+  dart_err_t dart_buffer_view_obj_get_len(dart_buffer_view_t* dst,
+      dart_buffer_view_t const* src, char const* key, size_t len) {
+    return dart_buffer_view_obj_get_len_impl(dst, src, key, len);
+  }
+
+  dart_err_t dart_buffer_view_arr_get(dart_buffer_view_t* dst, dart_buffer_view_t const* src, size_t idx) {
+    return dart_buffer_view_arr_get_impl(dst, src, idx);
+  }
+
+  char const* dart_buffer_view_str_get_len(dart_buffer_view_t const* src, size_t* len) {
+    return dart_buffer_view_str_get_len_impl(src, len);
+  }
+
+  dart_err_t dart_buffer_view_int_get_err(dart_buffer_view_t const* src, int64_t* val) {
+    return dart_buffer_view_int_get_err_impl(src, val);
+  }
+
+  dart_err_t dart_buffer_view_dcm_get_err(dart_buffer_view_t const* src, double* val) {
+    return dart_buffer_view_dcm_get_err_impl(src, val);
+  }
+
+  dart_err_t dart_buffer_view_bool_get_err(dart_buffer_view_t const* src, int* val) {
+    return dart_buffer_view_bool_get_err_impl(src, val);
+  }
+
+  size_t dart_buffer_view_size(dart_buffer_view_t const* src) {
+    return dart_buffer_view_size_impl(src);
+  }
+
+  dart_type_t dart_buffer_view_get_type(dart_buffer_view_t const* src) {
+    return dart_buffer_view_get_type_impl(src);
+  }
+
+  dart_err_t dart_buffer_view_iterator_init_err(dart_buffer_view_iterator_t* dst, dart_buffer_view_t const* src) {
+    return dart_buffer_view_iterator_init_err_impl(dst, src);
+  }
+
+  dart_err_t dart_buffer_view_iterator_init_key_err(dart_buffer_view_iterator_t* dst, dart_buffer_view_t const* src) {
+    return dart_buffer_view_iterator_init_key_err_impl(dst, src);
+  }
+
+  dart_err_t dart_buffer_view_iterator_get_err(dart_buffer_view_t* dst, dart_buffer_view_iterator_t const* src) {
+    return dart_buffer_view_iterator_get_err_impl(dst, src);
+  }
+
+  dart_err_t dart_buffer_view_iterator_next(dart_buffer_view_iterator_t* dst) {
+    return dart_buffer_view_iterator_next_impl(dst);
+  }
+
+  int dart_buffer_view_iterator_done(dart_buffer_view_iterator_t const* src) {
+    return dart_buffer_view_iterator_done_impl(src);
+  }
+
+  dart_err_t dart_buffer_view_iterator_destroy(dart_buffer_view_iterator_t* dst) {
+    return dart_buffer_view_iterator_destroy_impl(dst);
+  }
+
 }
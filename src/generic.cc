@@ -386,6 +386,92 @@ namespace {
     return generic_access([=] (auto& src) { *val = src.boolean(); }, src);
   }
 
+  dart_err_t dart_obj_try_get_len_impl(dart_packet_t* dst, void const* src, char const* key, size_t len) {
+    // Initialize.
+    dart_rc_propagate(dst, src);
+    dst->rtti.p_id = DART_PACKET;
+    return quiet_generic_access(
+      [=] (auto& src) {
+        if (!src.is_object()) return DART_TYPE_ERROR;
+        return packet_construct([=, &src] (auto* dst) {
+          safe_construct(dst, src.get({key, len}));
+        }, dst);
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_arr_try_get_impl(dart_packet_t* dst, void const* src, size_t idx) {
+    // Initialize.
+    dart_rc_propagate(dst, src);
+    dst->rtti.p_id = DART_PACKET;
+    return quiet_generic_access(
+      [=] (auto& src) {
+        if (!src.is_array()) return DART_TYPE_ERROR;
+        return packet_construct([=, &src] (auto* dst) {
+          safe_construct(dst, src.get(idx));
+        }, dst);
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_str_try_get_impl(void const* src, char const** str, size_t* len) {
+    return quiet_generic_access(
+      [=] (auto& src) {
+        if (!src.is_str()) return DART_TYPE_ERROR;
+        auto strv = src.strv();
+        *str = strv.data();
+        if (len) *len = strv.size();
+        return DART_NO_ERROR;
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_int_try_get_impl(void const* src, int64_t* val) {
+    return quiet_generic_access(
+      [=] (auto& src) {
+        if (!src.is_integer()) return DART_TYPE_ERROR;
+        *val = src.integer();
+        return DART_NO_ERROR;
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_dcm_try_get_impl(void const* src, double* val) {
+    return quiet_generic_access(
+      [=] (auto& src) {
+        if (!src.is_decimal()) return DART_TYPE_ERROR;
+        *val = src.decimal();
+        return DART_NO_ERROR;
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_bool_try_get_impl(void const* src, int* val) {
+    return quiet_generic_access(
+      [=] (auto& src) {
+        if (!src.is_boolean()) return DART_TYPE_ERROR;
+        *val = src.boolean();
+        return DART_NO_ERROR;
+      },
+      src
+    );
+  }
+
+  dart_err_t dart_try_get_type_impl(void const* src, dart_type_t* type) {
+    return quiet_generic_access(
+      [=] (auto& src) {
+        *type = abi_type(src.get_type());
+        return DART_NO_ERROR;
+      },
+      src
+    );
+  }
+
   size_t dart_size_impl(void const* src) {
     size_t val = 0;
     auto err = generic_access([&val] (auto& src) { val = src.size(); }, src);
@@ -393,6 +479,13 @@ namespace {
     else return val;
   }
 
+  size_t dart_hash_impl(void const* src) {
+    size_t val = 0;
+    auto err = generic_access([&val] (auto& src) { val = src.hash(); }, src);
+    if (err) return DART_FAILURE;
+    else return val;
+  }
+
   int dart_equal_impl(void const* lhs, void const* rhs) {
     bool equal = false;
     dart::detail::typeless_comparator comp {};
@@ -698,7 +791,8 @@ extern "C" {
     return packet_constructor_access(
       compose(
         [] (dart::packet* ptr) { new(ptr) dart::packet(); },
-        [] (dart::unsafe_packet* ptr) { new(ptr) dart::unsafe_packet(); }
+        [] (dart::unsafe_packet* ptr) { new(ptr) dart::unsafe_packet(); },
+        [] (dart::biased_packet* ptr) { new(ptr) dart::biased_packet(); }
       ),
       dst
     );
@@ -733,10 +827,13 @@ extern "C" {
       compose(
         [] (dart::heap& pkt) { pkt.~basic_heap(); },
         [] (dart::unsafe_heap& pkt) { pkt.~basic_heap(); },
+        [] (dart::biased_heap& pkt) { pkt.~basic_heap(); },
         [] (dart::buffer& pkt) { pkt.~basic_buffer(); },
         [] (dart::unsafe_buffer& pkt) { pkt.~basic_buffer(); },
+        [] (dart::biased_buffer& pkt) { pkt.~basic_buffer(); },
         [] (dart::packet& pkt) { pkt.~basic_packet(); },
-        [] (dart::unsafe_packet& pkt) { pkt.~basic_packet(); }
+        [] (dart::unsafe_packet& pkt) { pkt.~basic_packet(); },
+        [] (dart::biased_packet& pkt) { pkt.~basic_packet(); }
       ),
       pkt
     );
@@ -765,7 +862,8 @@ extern "C" {
     return packet_typed_constructor_access(
       compose(
         [] (dart::packet& dst) { dst = dart::packet::make_object(); },
-        [] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_object(); }
+        [] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_object(); },
+        [] (dart::biased_packet& dst) { dst = dart::biased_packet::make_object(); }
       ),
       dst,
       rc
@@ -782,6 +880,10 @@ extern "C" {
         [format, args] (dart::unsafe_packet& dst) mutable {
           dst = dart::unsafe_packet::make_object();
           parse_pairs(dst, format, args);
+        },
+        [format, args] (dart::biased_packet& dst) mutable {
+          dst = dart::biased_packet::make_object();
+          parse_pairs(dst, format, args);
         }
       ),
       dst,
@@ -848,7 +950,8 @@ extern "C" {
     return packet_typed_constructor_access(
       compose(
         [] (dart::packet& dst) { dst = dart::packet::make_array(); },
-        [] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_array(); }
+        [] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_array(); },
+        [] (dart::biased_packet& dst) { dst = dart::biased_packet::make_array(); }
       ),
       dst,
       rc
@@ -865,6 +968,10 @@ extern "C" {
         [format, args] (dart::unsafe_packet& dst) mutable {
           dst = dart::unsafe_packet::make_array();
           parse_vals(dst, format, args);
+        },
+        [format, args] (dart::biased_packet& dst) mutable {
+          dst = dart::biased_packet::make_array();
+          parse_vals(dst, format, args);
         }
       ),
       dst,
@@ -951,7 +1058,8 @@ extern "C" {
     return packet_typed_constructor_access(
       compose(
         [str, len] (dart::packet& dst) { dst = dart::packet::make_string({str, len}); },
-        [str, len] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_string({str, len}); }
+        [str, len] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_string({str, len}); },
+        [str, len] (dart::biased_packet& dst) { dst = dart::biased_packet::make_string({str, len}); }
       ),
       dst,
       rc
@@ -981,7 +1089,8 @@ extern "C" {
     return packet_typed_constructor_access(
       compose(
         [val] (dart::packet& dst) { dst = dart::packet::make_integer(val); },
-        [val] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_integer(val); }
+        [val] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_integer(val); },
+        [val] (dart::biased_packet& dst) { dst = dart::biased_packet::make_integer(val); }
       ),
       dst,
       rc
@@ -1011,7 +1120,8 @@ extern "C" {
     return packet_typed_constructor_access(
       compose(
         [val] (dart::packet& dst) { dst = dart::packet::make_decimal(val); },
-        [val] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_decimal(val); }
+        [val] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_decimal(val); },
+        [val] (dart::biased_packet& dst) { dst = dart::biased_packet::make_decimal(val); }
       ),
       dst,
       rc
@@ -1041,7 +1151,8 @@ extern "C" {
     return packet_typed_constructor_access(
       compose(
         [val] (dart::packet& dst) { dst = dart::packet::make_boolean(val); },
-        [val] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_boolean(val); }
+        [val] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_boolean(val); },
+        [val] (dart::biased_packet& dst) { dst = dart::biased_packet::make_boolean(val); }
       ),
       dst,
       rc
@@ -1072,7 +1183,8 @@ extern "C" {
     return packet_typed_constructor_access(
       compose(
         [] (dart::packet& dst) { dst = dart::packet::make_null(); },
-        [] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_null(); }
+        [] (dart::unsafe_packet& dst) { dst = dart::unsafe_packet::make_null(); },
+        [] (dart::biased_packet& dst) { dst = dart::biased_packet::make_null(); }
       ),
       dst,
       rc
@@ -1367,6 +1479,38 @@ extern "C" {
     return dart_bool_get_err_impl(src, val);
   }
 
+  dart_err_t dart_obj_try_get(dart_packet_t* dst, void const* src, char const* key) {
+    return dart_obj_try_get_len(dst, src, key, strlen(key));
+  }
+
+  dart_err_t dart_obj_try_get_len(dart_packet_t* dst, void const* src, char const* key, size_t len) {
+    return dart_obj_try_get_len_impl(dst, src, key, len);
+  }
+
+  dart_err_t dart_arr_try_get(dart_packet_t* dst, void const* src, size_t idx) {
+    return dart_arr_try_get_impl(dst, src, idx);
+  }
+
+  dart_err_t dart_str_try_get(void const* src, char const** str, size_t* len) {
+    return dart_str_try_get_impl(src, str, len);
+  }
+
+  dart_err_t dart_int_try_get(void const* src, int64_t* val) {
+    return dart_int_try_get_impl(src, val);
+  }
+
+  dart_err_t dart_dcm_try_get(void const* src, double* val) {
+    return dart_dcm_try_get_impl(src, val);
+  }
+
+  dart_err_t dart_bool_try_get(void const* src, int* val) {
+    return dart_bool_try_get_impl(src, val);
+  }
+
+  dart_err_t dart_try_get_type(void const* src, dart_type_t* type) {
+    return dart_try_get_type_impl(src, type);
+  }
+
   size_t dart_size(void const* src) {
     return dart_size_impl(src);
   }
@@ -1375,6 +1519,10 @@ extern "C" {
     return dart_equal_impl(lhs, rhs);
   }
 
+  size_t dart_hash(void const* src) {
+    return dart_hash_impl(src);
+  }
+
   int dart_is_obj(void const* src) {
     return dart_get_type(src) == DART_OBJECT;
   }
@@ -1463,6 +1611,9 @@ extern "C" {
         },
         [=] (dart::unsafe_packet& dst) {
           dst = dart::unsafe_packet::from_json({str, len});
+        },
+        [=] (dart::biased_packet& dst) {
+          dst = dart::biased_packet::from_json({str, len});
         }
       ),
       dst,
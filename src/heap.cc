@@ -24,6 +24,9 @@ namespace {
         },
         [=] (dart::unsafe_heap& dst) {
           return heap_access([=, &dst] (dart::unsafe_heap const& val) { insert(dst, val); }, val);
+        },
+        [=] (dart::biased_heap& dst) {
+          return heap_access([=, &dst] (dart::biased_heap const& val) { insert(dst, val); }, val);
         }
       ),
       dst
@@ -39,6 +42,9 @@ namespace {
         },
         [=] (dart::unsafe_heap& dst) {
           return heap_access([=, &dst] (dart::unsafe_heap& val) { insert(dst, val); }, val);
+        },
+        [=] (dart::biased_heap& dst) {
+          return heap_access([=, &dst] (dart::biased_heap& val) { insert(dst, val); }, val);
         }
       ),
       dst
@@ -50,7 +56,8 @@ namespace {
     return heap_access(
       compose(
         [insert] (dart::heap& dst) { insert(dst); },
-        [insert] (dart::unsafe_heap& dst) { insert(dst); }
+        [insert] (dart::unsafe_heap& dst) { insert(dst); },
+        [insert] (dart::biased_heap& dst) { insert(dst); }
       ),
       dst
     );
@@ -61,7 +68,8 @@ namespace {
     return heap_access(
       compose(
         [insert] (dart::heap& dst) { insert(dst); },
-        [insert] (dart::unsafe_heap& dst) { insert(dst); }
+        [insert] (dart::unsafe_heap& dst) { insert(dst); },
+        [insert] (dart::biased_heap& dst) { insert(dst); }
       ),
       dst
     );
@@ -72,7 +80,8 @@ namespace {
     return heap_access(
       compose(
         [insert] (dart::heap& dst) { insert(dst); },
-        [insert] (dart::unsafe_heap& dst) { insert(dst); }
+        [insert] (dart::unsafe_heap& dst) { insert(dst); },
+        [insert] (dart::biased_heap& dst) { insert(dst); }
       ),
       dst
     );
@@ -83,7 +92,8 @@ namespace {
     return heap_access(
       compose(
         [insert] (dart::heap& dst) { insert(dst); },
-        [insert] (dart::unsafe_heap& dst) { insert(dst); }
+        [insert] (dart::unsafe_heap& dst) { insert(dst); },
+        [insert] (dart::biased_heap& dst) { insert(dst); }
       ),
       dst
     );
@@ -94,7 +104,8 @@ namespace {
     return heap_access(
       compose(
         [insert] (dart::heap& dst) { insert(dst); },
-        [insert] (dart::unsafe_heap& dst) { insert(dst); }
+        [insert] (dart::unsafe_heap& dst) { insert(dst); },
+        [insert] (dart::biased_heap& dst) { insert(dst); }
       ),
       dst
     );
@@ -109,6 +120,9 @@ namespace {
         },
         [=] (dart::unsafe_heap& dst) {
           return heap_access([=, &dst] (dart::unsafe_heap const& val) { set(dst, val); }, val);
+        },
+        [=] (dart::biased_heap& dst) {
+          return heap_access([=, &dst] (dart::biased_heap const& val) { set(dst, val); }, val);
         }
       ),
       dst
@@ -124,6 +138,9 @@ namespace {
         },
         [=] (dart::unsafe_heap& dst) {
           return heap_access([=, &dst] (dart::unsafe_heap& val) { set(dst, val); }, val);
+        },
+        [=] (dart::biased_heap& dst) {
+          return heap_access([=, &dst] (dart::biased_heap& val) { set(dst, val); }, val);
         }
       ),
       dst
@@ -135,7 +152,8 @@ namespace {
     return heap_access(
       compose(
         [set] (dart::heap& dst) { set(dst); },
-        [set] (dart::unsafe_heap& dst) { set(dst); }
+        [set] (dart::unsafe_heap& dst) { set(dst); },
+        [set] (dart::biased_heap& dst) { set(dst); }
       ),
       dst
     );
@@ -146,7 +164,8 @@ namespace {
     return heap_access(
       compose(
         [set] (dart::heap& dst) { set(dst); },
-        [set] (dart::unsafe_heap& dst) { set(dst); }
+        [set] (dart::unsafe_heap& dst) { set(dst); },
+        [set] (dart::biased_heap& dst) { set(dst); }
       ),
       dst
     );
@@ -157,7 +176,8 @@ namespace {
     return heap_access(
       compose(
         [set] (dart::heap& dst) { set(dst); },
-        [set] (dart::unsafe_heap& dst) { set(dst); }
+        [set] (dart::unsafe_heap& dst) { set(dst); },
+        [set] (dart::biased_heap& dst) { set(dst); }
       ),
       dst
     );
@@ -168,7 +188,8 @@ namespace {
     return heap_access(
       compose(
         [set] (dart::heap& dst) { set(dst); },
-        [set] (dart::unsafe_heap& dst) { set(dst); }
+        [set] (dart::unsafe_heap& dst) { set(dst); },
+        [set] (dart::biased_heap& dst) { set(dst); }
       ),
       dst
     );
@@ -179,7 +200,8 @@ namespace {
     return heap_access(
       compose(
         [set] (dart::heap& dst) { set(dst); },
-        [set] (dart::unsafe_heap& dst) { set(dst); }
+        [set] (dart::unsafe_heap& dst) { set(dst); },
+        [set] (dart::biased_heap& dst) { set(dst); }
       ),
       dst
     );
@@ -194,7 +216,8 @@ namespace {
     return heap_access(
       compose(
         [erase] (dart::heap& dst) { erase(dst); },
-        [erase] (dart::unsafe_heap& dst) { erase(dst); }
+        [erase] (dart::unsafe_heap& dst) { erase(dst); },
+        [erase] (dart::biased_heap& dst) { erase(dst); }
       ),
       dst
     );
@@ -209,6 +232,9 @@ namespace {
         },
         [=] (dart::unsafe_heap& dst) {
           return heap_access([=, &dst] (dart::unsafe_heap const& val) { insert(dst, val); }, val);
+        },
+        [=] (dart::biased_heap& dst) {
+          return heap_access([=, &dst] (dart::biased_heap const& val) { insert(dst, val); }, val);
         }
       ),
       dst
@@ -224,6 +250,9 @@ namespace {
         },
         [=] (dart::unsafe_heap& dst) {
           return heap_access([=, &dst] (dart::unsafe_heap& val) { insert(dst, val); }, val);
+        },
+        [=] (dart::biased_heap& dst) {
+          return heap_access([=, &dst] (dart::biased_heap& val) { insert(dst, val); }, val);
         }
       ),
       dst
@@ -235,7 +264,8 @@ namespace {
     return heap_access(
       compose(
         [insert] (dart::heap& dst) { insert(dst); },
-        [insert] (dart::unsafe_heap& dst) { insert(dst); }
+        [insert] (dart::unsafe_heap& dst) { insert(dst); },
+        [insert] (dart::biased_heap& dst) { insert(dst); }
       ),
       dst
     );
@@ -246,7 +276,8 @@ namespace {
     return heap_access(
       compose(
         [insert] (dart::heap& dst) { insert(dst); },
-        [insert] (dart::unsafe_heap& dst) { insert(dst); }
+        [insert] (dart::unsafe_heap& dst) { insert(dst); },
+        [insert] (dart::biased_heap& dst) { insert(dst); }
       ),
       dst
     );
@@ -257,7 +288,8 @@ namespace {
     return heap_access(
       compose(
         [insert] (dart::heap& dst) { insert(dst); },
-        [insert] (dart::unsafe_heap& dst) { insert(dst); }
+        [insert] (dart::unsafe_heap& dst) { insert(dst); },
+        [insert] (dart::biased_heap& dst) { insert(dst); }
       ),
       dst
     );
@@ -268,7 +300,8 @@ namespace {
     return heap_access(
       compose(
         [insert] (dart::heap& dst) { insert(dst); },
-        [insert] (dart::unsafe_heap& dst) { insert(dst); }
+        [insert] (dart::unsafe_heap& dst) { insert(dst); },
+        [insert] (dart::biased_heap& dst) { insert(dst); }
       ),
       dst
     );
@@ -279,7 +312,8 @@ namespace {
     return heap_access(
       compose(
         [=] (dart::heap& dst) { insert(dst); },
-        [=] (dart::unsafe_heap& dst) { insert(dst); }
+        [=] (dart::unsafe_heap& dst) { insert(dst); },
+        [=] (dart::biased_heap& dst) { insert(dst); }
       ),
       dst
     );
@@ -294,6 +328,9 @@ namespace {
         },
         [=] (dart::unsafe_heap& dst) {
           return heap_access([=, &dst] (dart::unsafe_heap const& val) { set(dst, val); }, val);
+        },
+        [=] (dart::biased_heap& dst) {
+          return heap_access([=, &dst] (dart::biased_heap const& val) { set(dst, val); }, val);
         }
       ),
       dst
@@ -309,6 +346,9 @@ namespace {
         },
         [=] (dart::unsafe_heap& dst) {
           return heap_access([=, &dst] (dart::unsafe_heap& val) { set(dst, val); }, val);
+        },
+        [=] (dart::biased_heap& dst) {
+          return heap_access([=, &dst] (dart::biased_heap& val) { set(dst, val); }, val);
         }
       ),
       dst
@@ -320,7 +360,8 @@ namespace {
     return heap_access(
       compose(
         [set] (dart::heap& dst) { set(dst); },
-        [set] (dart::unsafe_heap& dst) { set(dst); }
+        [set] (dart::unsafe_heap& dst) { set(dst); },
+        [set] (dart::biased_heap& dst) { set(dst); }
       ),
       dst
     );
@@ -331,7 +372,8 @@ namespace {
     return heap_access(
       compose(
         [set] (dart::heap& dst) { set(dst); },
-        [set] (dart::unsafe_heap& dst) { set(dst); }
+        [set] (dart::unsafe_heap& dst) { set(dst); },
+        [set] (dart::biased_heap& dst) { set(dst); }
       ),
       dst
     );
@@ -342,7 +384,8 @@ namespace {
     return heap_access(
       compose(
         [set] (dart::heap& dst) { set(dst); },
-        [set] (dart::unsafe_heap& dst) { set(dst); }
+        [set] (dart::unsafe_heap& dst) { set(dst); },
+        [set] (dart::biased_heap& dst) { set(dst); }
       ),
       dst
     );
@@ -353,7 +396,8 @@ namespace {
     return heap_access(
       compose(
         [set] (dart::heap& dst) { set(dst); },
-        [set] (dart::unsafe_heap& dst) { set(dst); }
+        [set] (dart::unsafe_heap& dst) { set(dst); },
+        [set] (dart::biased_heap& dst) { set(dst); }
       ),
       dst
     );
@@ -364,7 +408,8 @@ namespace {
     return heap_access(
       compose(
         [=] (dart::heap& dst) { set(dst); },
-        [=] (dart::unsafe_heap& dst) { set(dst); }
+        [=] (dart::unsafe_heap& dst) { set(dst); },
+        [=] (dart::biased_heap& dst) { set(dst); }
       ),
       dst
     );
@@ -379,7 +424,8 @@ namespace {
     return heap_access(
       compose(
         [erase] (dart::heap& dst) { erase(dst); },
-        [erase] (dart::unsafe_heap& dst) { erase(dst); }
+        [erase] (dart::unsafe_heap& dst) { erase(dst); },
+        [erase] (dart::biased_heap& dst) { erase(dst); }
       ),
       dst
     );
@@ -390,7 +436,8 @@ namespace {
     return heap_access(
       compose(
         [resize] (dart::heap& dst) { resize(dst); },
-        [resize] (dart::unsafe_heap& dst) { resize(dst); }
+        [resize] (dart::unsafe_heap& dst) { resize(dst); },
+        [resize] (dart::biased_heap& dst) { resize(dst); }
       ),
       dst
     );
@@ -401,7 +448,8 @@ namespace {
     return heap_access(
       compose(
         [reserve] (dart::heap& dst) { reserve(dst); },
-        [reserve] (dart::unsafe_heap& dst) { reserve(dst); }
+        [reserve] (dart::unsafe_heap& dst) { reserve(dst); },
+        [reserve] (dart::biased_heap& dst) { reserve(dst); }
       ),
       dst
     );
@@ -427,7 +475,8 @@ namespace {
     auto err = heap_access(
       compose(
         [get_str] (dart::heap const& src) { get_str(src); },
-        [get_str] (dart::unsafe_heap const& src) { get_str(src); }
+        [get_str] (dart::unsafe_heap const& src) { get_str(src); },
+        [get_str] (dart::biased_heap const& src) { get_str(src); }
       ),
       src
     );
@@ -440,7 +489,8 @@ namespace {
     return heap_access(
       compose(
         [get_int] (dart::heap const& src) { get_int(src); },
-        [get_int] (dart::unsafe_heap const& src) { get_int(src); }
+        [get_int] (dart::unsafe_heap const& src) { get_int(src); },
+        [get_int] (dart::biased_heap const& src) { get_int(src); }
       ),
       src
     );
@@ -451,7 +501,8 @@ namespace {
     return heap_access(
       compose(
         [get_dcm] (dart::heap const& src) { get_dcm(src); },
-        [get_dcm] (dart::unsafe_heap const& src) { get_dcm(src); }
+        [get_dcm] (dart::unsafe_heap const& src) { get_dcm(src); },
+        [get_dcm] (dart::biased_heap const& src) { get_dcm(src); }
       ),
       src
     );
@@ -462,7 +513,8 @@ namespace {
     return heap_access(
       compose(
         [get_bool] (dart::heap const& src) { get_bool(src); },
-        [get_bool] (dart::unsafe_heap const& src) { get_bool(src); }
+        [get_bool] (dart::unsafe_heap const& src) { get_bool(src); },
+        [get_bool] (dart::biased_heap const& src) { get_bool(src); }
       ),
       src
     );
@@ -475,6 +527,13 @@ namespace {
     else return val;
   }
 
+  size_t dart_heap_hash_impl(dart_heap_t const* src) {
+    size_t val = 0;
+    auto err = heap_access([&val] (auto& src) { val = src.hash(); }, src);
+    if (err) return DART_FAILURE;
+    else return val;
+  }
+
   int dart_heap_equal_impl(dart_heap_t const* lhs, dart_heap_t const* rhs) {
     bool equal = false;
     auto check = [&] (auto& lhs, auto& rhs) { equal = (lhs == rhs); };
@@ -485,6 +544,9 @@ namespace {
         },
         [check, rhs] (dart::unsafe_heap const& lhs) {
           heap_access([check, lhs] (dart::unsafe_heap const& rhs) { check(lhs, rhs); }, rhs);
+        },
+        [check, rhs] (dart::biased_heap const& lhs) {
+          heap_access([check, lhs] (dart::biased_heap const& rhs) { check(lhs, rhs); }, rhs);
         }
       ),
       lhs
@@ -499,7 +561,8 @@ namespace {
     auto err = heap_access(
       compose(
         [=] (dart::heap const& pkt) { get_type(pkt); },
-        [=] (dart::unsafe_heap const& pkt) { get_type(pkt); }
+        [=] (dart::unsafe_heap const& pkt) { get_type(pkt); },
+        [=] (dart::biased_heap const& pkt) { get_type(pkt); }
       ),
       src
     );
@@ -521,7 +584,8 @@ namespace {
     auto ret = heap_access(
       compose(
         [=] (dart::heap const& pkt) { print(pkt); },
-        [=] (dart::unsafe_heap const& pkt) { print(pkt); }
+        [=] (dart::unsafe_heap const& pkt) { print(pkt); },
+        [=] (dart::biased_heap const& pkt) { print(pkt); }
       ),
       pkt
     );
@@ -559,7 +623,8 @@ extern "C" {
     return heap_constructor_access(
       compose(
         [] (dart::heap* ptr) { new(ptr) dart::heap(); },
-        [] (dart::unsafe_heap* ptr) { new(ptr) dart::unsafe_heap(); }
+        [] (dart::unsafe_heap* ptr) { new(ptr) dart::unsafe_heap(); },
+        [] (dart::biased_heap* ptr) { new(ptr) dart::biased_heap(); }
       ),
       dst
     );
@@ -582,6 +647,9 @@ extern "C" {
         },
         [dst] (dart::unsafe_heap const& src) {
           return heap_construct([&src] (dart::unsafe_heap* dst) { new(dst) dart::unsafe_heap(src); }, dst);
+        },
+        [dst] (dart::biased_heap const& src) {
+          return heap_construct([&src] (dart::biased_heap* dst) { new(dst) dart::biased_heap(src); }, dst);
         }
       ),
       src
@@ -605,6 +673,9 @@ extern "C" {
         },
         [dst] (dart::unsafe_heap& src) {
           return heap_construct([&src] (dart::unsafe_heap* dst) { new(dst) dart::unsafe_heap(std::move(src)); }, dst);
+        },
+        [dst] (dart::biased_heap& src) {
+          return heap_construct([&src] (dart::biased_heap* dst) { new(dst) dart::biased_heap(std::move(src)); }, dst);
         }
       ),
       src
@@ -616,7 +687,8 @@ extern "C" {
     return heap_access(
       compose(
         [] (dart::heap& dst) { dst.~basic_heap(); },
-        [] (dart::unsafe_heap& dst) { dst.~basic_heap(); }
+        [] (dart::unsafe_heap& dst) { dst.~basic_heap(); },
+        [] (dart::biased_heap& dst) { dst.~basic_heap(); }
       ),
       dst
     );
@@ -645,7 +717,8 @@ extern "C" {
     return heap_typed_constructor_access(
       compose(
         [] (dart::heap& dst) { dst = dart::heap::make_object(); },
-        [] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_object(); }
+        [] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_object(); },
+        [] (dart::biased_heap& dst) { dst = dart::biased_heap::make_object(); }
       ),
       dst,
       rc
@@ -662,6 +735,10 @@ extern "C" {
         [format, args] (dart::unsafe_heap& dst) mutable {
           dst = dart::unsafe_heap::make_object();
           parse_pairs(dst, format, args);
+        },
+        [format, args] (dart::biased_heap& dst) mutable {
+          dst = dart::biased_heap::make_object();
+          parse_pairs(dst, format, args);
         }
       ),
       dst,
@@ -728,7 +805,8 @@ extern "C" {
     return heap_typed_constructor_access(
       compose(
         [] (dart::heap& dst) { dst = dart::heap::make_array(); },
-        [] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_array(); }
+        [] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_array(); },
+        [] (dart::biased_heap& dst) { dst = dart::biased_heap::make_array(); }
       ),
       dst,
       rc
@@ -745,6 +823,10 @@ extern "C" {
         [format, args] (dart::unsafe_heap& dst) mutable {
           dst = dart::unsafe_heap::make_array();
           parse_vals(dst, format, args);
+        },
+        [format, args] (dart::biased_heap& dst) mutable {
+          dst = dart::biased_heap::make_array();
+          parse_vals(dst, format, args);
         }
       ),
       dst,
@@ -831,7 +913,8 @@ extern "C" {
     return heap_typed_constructor_access(
       compose(
         [str, len] (dart::heap& dst) { dst = dart::heap::make_string({str, len}); },
-        [str, len] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_string({str, len}); }
+        [str, len] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_string({str, len}); },
+        [str, len] (dart::biased_heap& dst) { dst = dart::biased_heap::make_string({str, len}); }
       ),
       dst,
       rc
@@ -861,7 +944,8 @@ extern "C" {
     return heap_typed_constructor_access(
       compose(
         [val] (dart::heap& dst) { dst = dart::heap::make_integer(val); },
-        [val] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_integer(val); }
+        [val] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_integer(val); },
+        [val] (dart::biased_heap& dst) { dst = dart::biased_heap::make_integer(val); }
       ),
       dst,
       rc
@@ -891,7 +975,8 @@ extern "C" {
     return heap_typed_constructor_access(
       compose(
         [val] (dart::heap& dst) { dst = dart::heap::make_decimal(val); },
-        [val] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_decimal(val); }
+        [val] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_decimal(val); },
+        [val] (dart::biased_heap& dst) { dst = dart::biased_heap::make_decimal(val); }
       ),
       dst,
       rc
@@ -921,7 +1006,8 @@ extern "C" {
     return heap_typed_constructor_access(
       compose(
         [val] (dart::heap& dst) { dst = dart::heap::make_boolean(val); },
-        [val] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_boolean(val); }
+        [val] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_boolean(val); },
+        [val] (dart::biased_heap& dst) { dst = dart::biased_heap::make_boolean(val); }
       ),
       dst,
       rc
@@ -952,7 +1038,8 @@ extern "C" {
     return heap_typed_constructor_access(
       compose(
         [] (dart::heap& dst) { dst = dart::heap::make_null(); },
-        [] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_null(); }
+        [] (dart::unsafe_heap& dst) { dst = dart::unsafe_heap::make_null(); },
+        [] (dart::biased_heap& dst) { dst = dart::biased_heap::make_null(); }
       ),
       dst,
       rc
@@ -1203,6 +1290,11 @@ extern "C" {
           return heap_construct([&] (dart::unsafe_heap* dst) {
             new(dst) dart::unsafe_heap(src[string_view {key, len}]);
           }, dst);
+        },
+        [=] (dart::biased_heap const& src) {
+          return heap_construct([&] (dart::biased_heap* dst) {
+            new(dst) dart::biased_heap(src[string_view {key, len}]);
+          }, dst);
         }
       ),
       src
@@ -1230,6 +1322,11 @@ extern "C" {
           return heap_construct([&] (dart::unsafe_heap* dst) {
             new(dst) dart::unsafe_heap(src[idx]);
           }, dst);
+        },
+        [=] (dart::biased_heap const& src) {
+          return heap_construct([&] (dart::biased_heap* dst) {
+            new(dst) dart::biased_heap(src[idx]);
+          }, dst);
         }
       ),
       src
@@ -1287,6 +1384,10 @@ extern "C" {
     return dart_heap_equal_impl(lhs, rhs);
   }
 
+  size_t dart_heap_hash(dart_heap_t const* src) {
+    return dart_heap_hash_impl(src);
+  }
+
   int dart_heap_is_obj(dart_heap_t const* src) {
     return dart_heap_get_type(src) == DART_OBJECT;
   }
@@ -1367,6 +1468,9 @@ extern "C" {
         },
         [=] (dart::unsafe_heap& dst) {
           dst = dart::unsafe_heap::from_json({str, len});
+        },
+        [=] (dart::biased_heap& dst) {
+          dst = dart::biased_heap::from_json({str, len});
         }
       ),
       dst,
@@ -1402,6 +1506,9 @@ extern "C" {
         },
         [dst] (dart::unsafe_heap const& src) {
           buffer_construct([&src] (dart::unsafe_buffer* dst) { new(dst) dart::unsafe_buffer(src.lower()); }, dst);
+        },
+        [dst] (dart::biased_heap const& src) {
+          buffer_construct([&src] (dart::biased_buffer* dst) { new(dst) dart::biased_buffer(src.lower()); }, dst);
         }
       ),
       src
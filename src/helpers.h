@@ -9,6 +9,7 @@
 
 #include "../include/dart.h"
 #include "../include/dart/abi.h"
+#include "../include/dart/abi_fast.h"
 
 /*----- Build Sanity Checks -----*/
 
@@ -31,6 +32,23 @@ static_assert(sizeof(dart::packet) <= DART_PACKET_MAX_SIZE, "Dart ABI is misconf
 static_assert(sizeof(dart::heap::iterator) * 2 <= DART_ITERATOR_MAX_SIZE, "Dart ABI is misconfigured");
 static_assert(sizeof(dart::buffer::iterator) * 2 <= DART_ITERATOR_MAX_SIZE, "Dart ABI is misconfigured");
 static_assert(sizeof(dart::packet::iterator) * 2 <= DART_ITERATOR_MAX_SIZE, "Dart ABI is misconfigured");
+static_assert(sizeof(dart::buffer::view) <= DART_BUFFER_MAX_SIZE, "Dart ABI is misconfigured");
+static_assert(sizeof(dart::buffer::view::iterator) * 2 <= DART_ITERATOR_MAX_SIZE, "Dart ABI is misconfigured");
+
+// abi_fast.h decodes finalized buffers without calling into the library,
+// so it must agree with the library on what those buffers look like.
+static_assert(DART_FAST_LAYOUT_VERSION == dart::detail::buffer_layout_version, "Dart ABI is misconfigured");
+static_assert(DART_FAST_RAW_OBJECT == static_cast<int>(dart::detail::raw_type::object), "Dart ABI is misconfigured");
+static_assert(DART_FAST_RAW_BIG_STRING == static_cast<int>(dart::detail::raw_type::big_string), "Dart ABI is misconfigured");
+static_assert(DART_FAST_RAW_LONG_DECIMAL == static_cast<int>(dart::detail::raw_type::long_decimal), "Dart ABI is misconfigured");
+static_assert(DART_FAST_RAW_NULL == static_cast<int>(dart::detail::raw_type::null), "Dart ABI is misconfigured");
+static_assert(sizeof(dart::detail::object_entry) == DART_FAST_ENTRY_LEN, "Dart ABI is misconfigured");
+static_assert(sizeof(dart::detail::array_entry) == DART_FAST_ENTRY_LEN, "Dart ABI is misconfigured");
+static_assert(sizeof(dart::detail::compact_object_entry) == DART_FAST_COMPACT_OBJ_LEN, "Dart ABI is misconfigured");
+static_assert(sizeof(dart::detail::compact_array_entry) == DART_FAST_COMPACT_ARR_LEN, "Dart ABI is misconfigured");
+static_assert(sizeof(dart::detail::wide_object_entry) == DART_FAST_WIDE_ENTRY_LEN, "Dart ABI is misconfigured");
+static_assert(sizeof(dart::detail::wide_array_entry) == DART_FAST_WIDE_ENTRY_LEN, "Dart ABI is misconfigured");
+static_assert(sizeof(dart::detail::wide_header) == DART_FAST_WIDE_HEADER_LEN, "Dart ABI is misconfigured");
 
 /*----- Macros -----*/
 
@@ -51,11 +69,14 @@ namespace dart {
 /*----- Private Types -----*/
 
 namespace dart {
-  // Dart ABI statically exports two reference counter
-  // implementations: thread safe and thread unsafe.
+  // Dart ABI statically exports three reference counter
+  // implementations: thread safe, thread unsafe, and biased.
   using unsafe_heap = dart::basic_heap<dart::unsafe_ptr>;
   using unsafe_buffer = dart::basic_buffer<dart::unsafe_ptr>;
   using unsafe_packet = dart::basic_packet<dart::unsafe_ptr>;
+  using biased_heap = dart::basic_heap<dart::biased_ptr>;
+  using biased_buffer = dart::basic_buffer<dart::biased_ptr>;
+  using biased_packet = dart::basic_packet<dart::biased_ptr>;
 }
 
 template <class Func, class... Args>
@@ -261,8 +282,10 @@ namespace {
     return compose(
       [=] (dart::heap& pkt) { return cb(pkt); },
       [=] (dart::unsafe_heap& pkt) { return cb(pkt); },
+      [=] (dart::biased_heap& pkt) { return cb(pkt); },
       [=] (dart::packet& pkt) { return cb(pkt); },
-      [=] (dart::unsafe_packet& pkt) { return cb(pkt); }
+      [=] (dart::unsafe_packet& pkt) { return cb(pkt); },
+      [=] (dart::biased_packet& pkt) { return cb(pkt); }
     );
   }
 
@@ -277,8 +300,10 @@ namespace {
     return compose(
       [=] (dart::buffer const& pkt) { return cb(pkt); },
       [=] (dart::unsafe_buffer const& pkt) { return cb(pkt); },
+      [=] (dart::biased_buffer const& pkt) { return cb(pkt); },
       [=] (dart::packet const& pkt) { return cb(pkt); },
-      [=] (dart::unsafe_packet const& pkt) { return cb(pkt); }
+      [=] (dart::unsafe_packet const& pkt) { return cb(pkt); },
+      [=] (dart::biased_packet const& pkt) { return cb(pkt); }
     );
   }
 
@@ -334,6 +359,12 @@ namespace {
           return safe_call(std::forward<Func>(cb),
               const_cast<maybe_const_t<dart::unsafe_heap, is_const>&>(*rt_ptr));
         }
+      case DART_RC_BIASED:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::biased_heap*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb),
+              const_cast<maybe_const_t<dart::biased_heap, is_const>&>(*rt_ptr));
+        }
       default:
         dart::detail::errmsg = "Unknown reference counter passed for dart_heap";
         return DART_CLIENT_ERROR;
@@ -355,6 +386,12 @@ namespace {
           return safe_call(std::forward<Func>(cb),
               const_cast<maybe_const_t<dart::unsafe_buffer, is_const>&>(*rt_ptr));
         }
+      case DART_RC_BIASED:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::biased_buffer*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb),
+              const_cast<maybe_const_t<dart::biased_buffer, is_const>&>(*rt_ptr));
+        }
       default:
         dart::detail::errmsg = "Unknown reference counter passed for dart_buffer";
         return DART_CLIENT_ERROR;
@@ -376,6 +413,12 @@ namespace {
           return safe_call(std::forward<Func>(cb),
               const_cast<maybe_const_t<dart::unsafe_packet, is_const>&>(*rt_ptr));
         }
+      case DART_RC_BIASED:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::biased_packet*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb),
+              const_cast<maybe_const_t<dart::biased_packet, is_const>&>(*rt_ptr));
+        }
       default:
         dart::detail::errmsg = "Unknown reference counter passed for dart_packet";
         return DART_CLIENT_ERROR;
@@ -410,6 +453,11 @@ namespace {
           auto* rt_ptr = reinterpret_cast<dart::unsafe_heap*>(DART_RAW_BYTES(pkt));
           return safe_call(std::forward<Func>(cb), rt_ptr);
         }
+      case DART_RC_BIASED:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::biased_heap*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb), rt_ptr);
+        }
       default:
         dart::detail::errmsg = "Unknown reference counter passed for dart_heap";
         return DART_CLIENT_ERROR;
@@ -444,12 +492,83 @@ namespace {
           auto* rt_ptr = reinterpret_cast<dart::unsafe_buffer*>(DART_RAW_BYTES(pkt));
           return safe_call(std::forward<Func>(cb), rt_ptr);
         }
+      case DART_RC_BIASED:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::biased_buffer*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb), rt_ptr);
+        }
       default:
         dart::detail::errmsg = "Unknown reference counter passed for dart_buffer";
         return DART_CLIENT_ERROR;
     }
   }
 
+  template <bool is_const, class Func>
+  dart_err_t buffer_view_unwrap_impl(Func&& cb, dart_buffer_view_t* pkt) {
+    switch (pkt->rtti.rc_id) {
+      case DART_RC_SAFE:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::buffer::view*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb),
+              const_cast<maybe_const_t<dart::buffer::view, is_const>&>(*rt_ptr));
+        }
+      case DART_RC_UNSAFE:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::unsafe_buffer::view*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb),
+              const_cast<maybe_const_t<dart::unsafe_buffer::view, is_const>&>(*rt_ptr));
+        }
+      case DART_RC_BIASED:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::biased_buffer::view*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb),
+              const_cast<maybe_const_t<dart::biased_buffer::view, is_const>&>(*rt_ptr));
+        }
+      default:
+        dart::detail::errmsg = "Unknown reference counter passed for dart_buffer_view";
+        return DART_CLIENT_ERROR;
+    }
+  }
+
+  // Functions take a generic lambda and a pointer to a C type,
+  // and call the generic lambda with the underlying C++ object.
+  // Functions assume the C++ object has already been constructed.
+  template <class Func>
+  dart_err_t buffer_view_unwrap(Func&& cb, dart_buffer_view_t* pkt) {
+    return buffer_view_unwrap_impl<false>(std::forward<Func>(cb), pkt);
+  }
+  template <class Func>
+  dart_err_t buffer_view_unwrap(Func&& cb, dart_buffer_view_t const* pkt) {
+    return buffer_view_unwrap_impl<true>(std::forward<Func>(cb), const_cast<dart_buffer_view_t*>(pkt));
+  }
+
+  // Function takes a generic lambda and a pointer to a C type,
+  // and performs the pointer arithmetic and casting necessary
+  // to return a pointer to the nested C++ object for construction.
+  template <class Func>
+  dart_err_t buffer_view_construct(Func&& cb, dart_buffer_view_t* pkt) {
+    switch (pkt->rtti.rc_id) {
+      case DART_RC_SAFE:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::buffer::view*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb), rt_ptr);
+        }
+      case DART_RC_UNSAFE:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::unsafe_buffer::view*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb), rt_ptr);
+        }
+      case DART_RC_BIASED:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::biased_buffer::view*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb), rt_ptr);
+        }
+      default:
+        dart::detail::errmsg = "Unknown reference counter passed for dart_buffer_view";
+        return DART_CLIENT_ERROR;
+    }
+  }
+
   // Functions take a generic lambda and a pointer to a C type,
   // and call the generic lambda with the underlying C++ object.
   // Functions assume the C++ object has already been constructed.
@@ -478,6 +597,11 @@ namespace {
           auto* rt_ptr = reinterpret_cast<dart::unsafe_packet*>(DART_RAW_BYTES(pkt));
           return safe_call(std::forward<Func>(cb), rt_ptr);
         }
+      case DART_RC_BIASED:
+        {
+          auto* rt_ptr = reinterpret_cast<dart::biased_packet*>(DART_RAW_BYTES(pkt));
+          return safe_call(std::forward<Func>(cb), rt_ptr);
+        }
       default:
         dart::detail::errmsg = "Unknown reference counter passed for dart_packet";
         return DART_CLIENT_ERROR;
@@ -541,6 +665,7 @@ namespace {
       constexpr auto is_const = std::is_const<Ptr>::value;
       using safe_iterator = maybe_const_t<typename packet_t<decltype(id), std::shared_ptr>::iterator, is_const>;
       using unsafe_iterator = maybe_const_t<typename packet_t<decltype(id), dart::unsafe_ptr>::iterator, is_const>;
+      using biased_iterator = maybe_const_t<typename packet_t<decltype(id), dart::biased_ptr>::iterator, is_const>;
 
       switch (it->rtti.rc_id) {
         case DART_RC_SAFE:
@@ -553,6 +678,11 @@ namespace {
             auto* rt_ptr = reinterpret_cast<unsafe_iterator*>(DART_RAW_BYTES(it));
             return safe_call(std::forward<Func>(cb), rt_ptr, rt_ptr + 1);
           }
+        case DART_RC_BIASED:
+          {
+            auto* rt_ptr = reinterpret_cast<biased_iterator*>(DART_RAW_BYTES(it));
+            return safe_call(std::forward<Func>(cb), rt_ptr, rt_ptr + 1);
+          }
         default:
           dart::detail::errmsg = "Unknown reference counter passed for dart_iterator";
           return DART_CLIENT_ERROR;
@@ -581,6 +711,46 @@ namespace {
     return iterator_construct([&] (auto* begin, auto* end) { std::forward<Func>(cb)(*begin, *end); }, it);
   }
 
+  // Function takes a generic lambda and a pointer to a C type,
+  // and performs the pointer arithmetic and casting necessary
+  // to return a pointer to the nested C++ object for construction.
+  template <class Func, class Ptr>
+  dart_err_t view_iterator_construct(Func&& cb, Ptr* it) {
+    constexpr auto is_const = std::is_const<Ptr>::value;
+    using safe_iterator = maybe_const_t<dart::buffer::view::iterator, is_const>;
+    using unsafe_iterator = maybe_const_t<dart::unsafe_buffer::view::iterator, is_const>;
+    using biased_iterator = maybe_const_t<dart::biased_buffer::view::iterator, is_const>;
+
+    switch (it->rtti.rc_id) {
+      case DART_RC_SAFE:
+        {
+          auto* rt_ptr = reinterpret_cast<safe_iterator*>(DART_RAW_BYTES(it));
+          return safe_call(std::forward<Func>(cb), rt_ptr, rt_ptr + 1);
+        }
+      case DART_RC_UNSAFE:
+        {
+          auto* rt_ptr = reinterpret_cast<unsafe_iterator*>(DART_RAW_BYTES(it));
+          return safe_call(std::forward<Func>(cb), rt_ptr, rt_ptr + 1);
+        }
+      case DART_RC_BIASED:
+        {
+          auto* rt_ptr = reinterpret_cast<biased_iterator*>(DART_RAW_BYTES(it));
+          return safe_call(std::forward<Func>(cb), rt_ptr, rt_ptr + 1);
+        }
+      default:
+        dart::detail::errmsg = "Unknown reference counter passed for dart_buffer_view_iterator";
+        return DART_CLIENT_ERROR;
+    }
+  }
+
+  // Functions take a generic lambda and a pointer to a C type,
+  // and call the generic lambda with the underlying C++ object.
+  // Functions assume the C++ object has already been constructed.
+  template <class Func, class Ptr>
+  dart_err_t view_iterator_unwrap(Func&& cb, Ptr* it) {
+    return view_iterator_construct([&] (auto* begin, auto* end) { std::forward<Func>(cb)(*begin, *end); }, it);
+  }
+
   // Function is a top level error handler for all code in the ABI
   // Catches all exceptions, turns them into corresponding error codes
   // and updates the global error string.
@@ -659,6 +829,13 @@ namespace {
     return err_handler([&cb, pkt] { return buffer_construct(std::forward<Func>(cb), pkt); });
   }
 
+  // Converts from a C pointer to the underlying strongly typed C++ object
+  // expects to take a generic lambda which supports all possible types.
+  template <class Func, class Ptr>
+  dart_err_t buffer_view_access(Func&& cb, Ptr* pkt) noexcept {
+    return err_handler([&cb, pkt] { return buffer_view_unwrap(std::forward<Func>(cb), pkt); });
+  }
+
   // Converts from a C pointer to the underlying strongly typed C++ object
   // expects to take a generic lambda which supports all possible types.
   template <class Func, class Ptr>
@@ -701,6 +878,55 @@ namespace {
     return err_handler([&cb, it] { return iterator_construct(std::forward<Func>(cb), it); });
   }
 
+  // Converts from a C pointer to the underlying strongly typed C++ object
+  // expects to take a generic lambda which supports all possible types.
+  template <class Func, class Ptr>
+  dart_err_t view_iterator_access(Func&& cb, Ptr* it) noexcept {
+    return err_handler([&cb, it] { return view_iterator_unwrap(std::forward<Func>(cb), it); });
+  }
+
+  // Function checks whether a given C type carries RTTI that can be dispatched on,
+  // without reporting anything.
+  inline bool quiet_rtti_check(dart_type_id_t const& rtti) noexcept {
+    switch (rtti.p_id) {
+      case DART_HEAP:
+      case DART_BUFFER:
+      case DART_PACKET:
+        break;
+      default:
+        return false;
+    }
+    switch (rtti.rc_id) {
+      case DART_RC_SAFE:
+      case DART_RC_UNSAFE:
+      case DART_RC_BIASED:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // Functions are the counterparts of generic_access/buffer_access for the
+  // status-only ABI functions.
+  // Callbacks are expected to check for anything that could go wrong up front
+  // and report it by return code, so the only way to reach the catch block is a bug,
+  // and the thread-local error string is never touched either way.
+  template <class Func>
+  dart_err_t quiet_generic_access(Func&& cb, void const* pkt) noexcept try {
+    if (!quiet_rtti_check(*reinterpret_cast<dart_type_id_t const*>(pkt))) return DART_CLIENT_ERROR;
+    return generic_unwrap(std::forward<Func>(cb), pkt);
+  } catch (...) {
+    return DART_UNKNOWN_ERROR;
+  }
+
+  template <class Func>
+  dart_err_t quiet_buffer_access(Func&& cb, dart_buffer_t const* pkt) noexcept try {
+    if (pkt->rtti.p_id != DART_BUFFER || !quiet_rtti_check(pkt->rtti)) return DART_CLIENT_ERROR;
+    return buffer_unwrap(std::forward<Func>(cb), pkt);
+  } catch (...) {
+    return DART_UNKNOWN_ERROR;
+  }
+
   // Forgive me
   // Function drives the parsing logic for the variadic initializers
   inline parse_type identify_vararg(char const*& c) {
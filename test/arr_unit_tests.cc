@@ -1,5 +1,6 @@
 /*----- System Includes -----*/
 
+#include <array>
 #include <vector>
 #include <string>
 #include <unordered_set>
@@ -477,6 +478,424 @@ SCENARIO("arrays can be compared for equality", "[array unit]") {
   }
 }
 
+SCENARIO("finalized arrays can use compact offsets", "[array unit]") {
+  GIVEN("an array small enough to address with 16-bit offsets") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto elems = dart::heap::make_array("one", 2, 3.5, false, dart::heap::null());
+      for (auto i = 0; i < 30; ++i) elems.push_back(i);
+      auto dyn = dart::heap::make_object("arr", elems);
+
+      auto opts = dart::finalize_options {};
+      opts.offsets = dart::offset_policy::automatic;
+      auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+      auto std_obj = dart::conversion_helper<pkt>(dyn.finalize());
+      auto arr = obj["arr"], std_arr = std_obj["arr"];
+
+      DYNAMIC_WHEN("each element is accessed", idx) {
+        DYNAMIC_THEN("every value is found", idx) {
+          REQUIRE(arr.size() == std_arr.size());
+          REQUIRE(arr[0] == "one");
+          REQUIRE(arr[1].integer() == 2);
+          REQUIRE(arr[2].decimal() == 3.5);
+          REQUIRE(!arr[3].boolean());
+          REQUIRE(arr[4].is_null());
+          for (auto i = 0; i < 30; ++i) REQUIRE(arr[i + 5].integer() == i);
+          REQUIRE(arr.back().integer() == 29);
+          REQUIRE_THROWS_AS(arr.at(35), std::out_of_range);
+        }
+      }
+
+      DYNAMIC_WHEN("it is compared against the standard encoding", idx) {
+        DYNAMIC_THEN("it takes less space, but holds the same values", idx) {
+          REQUIRE(obj.get_bytes().size() < std_obj.get_bytes().size());
+          REQUIRE(arr == std_arr);
+          REQUIRE(std_arr == arr);
+          REQUIRE(arr == elems);
+        }
+      }
+
+      DYNAMIC_WHEN("it is iterated over", idx) {
+        auto it = arr.begin();
+        auto std_it = std_arr.begin();
+        DYNAMIC_THEN("it visits the same values in the same order", idx) {
+          while (it != arr.end()) REQUIRE(*it++ == *std_it++);
+          REQUIRE(std_it == std_arr.end());
+        }
+      }
+
+      DYNAMIC_WHEN("its encoding tag is changed to any other", idx) {
+        // The first string is laid out directly after the vtable, which directly follows the header.
+        auto bytes = obj.get_bytes();
+        auto* first = reinterpret_cast<gsl::byte const*>(arr[0].str()) - sizeof(uint16_t);
+        auto header = first - bytes.data() - arr.size() * sizeof(dart::detail::compact_array_entry) - 8;
+        DYNAMIC_THEN("it fails to validate", idx) {
+          auto const fmt = static_cast<unsigned char>(dart::detail::layout_format::compact);
+          REQUIRE(static_cast<unsigned char>(bytes[header + 7]) >> 5 == fmt);
+          dart::each_foreign_encoding(bytes, [] (auto const* bytes, auto len) {
+            REQUIRE(!dart::is_valid(bytes, len));
+            REQUIRE_THROWS_AS(dart::validate(bytes, len), dart::validation_error);
+          }, header);
+        }
+      }
+    });
+  }
+}
+
+SCENARIO("finalized arrays can use wide offsets", "[array unit]") {
+  GIVEN("an array finalized with 64-bit offsets") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto elems = dart::heap::make_array("one", 2, 3.5, false, dart::heap::null());
+      for (auto i = 0; i < 30; ++i) elems.push_back(i);
+      auto dyn = dart::heap::make_object("arr", elems);
+
+      auto opts = dart::finalize_options {};
+      opts.offsets = dart::offset_policy::wide;
+      auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+      auto std_obj = dart::conversion_helper<pkt>(dyn.finalize());
+      auto arr = obj["arr"], std_arr = std_obj["arr"];
+
+      DYNAMIC_WHEN("each element is accessed", idx) {
+        DYNAMIC_THEN("every value is found", idx) {
+          REQUIRE(arr.size() == std_arr.size());
+          REQUIRE(arr[0] == "one");
+          REQUIRE(arr[2].decimal() == 3.5);
+          REQUIRE(arr[4].is_null());
+          for (auto i = 0; i < 30; ++i) REQUIRE(arr[i + 5].integer() == i);
+          REQUIRE_THROWS_AS(arr.at(35), std::out_of_range);
+        }
+      }
+
+      DYNAMIC_WHEN("it is compared against the standard encoding", idx) {
+        DYNAMIC_THEN("it takes more space, but holds the same values", idx) {
+          REQUIRE(obj.get_bytes().size() > std_obj.get_bytes().size());
+          REQUIRE(arr == std_arr);
+          REQUIRE(std_arr == arr);
+          REQUIRE(arr == elems);
+        }
+      }
+
+      DYNAMIC_WHEN("its encoding tag is changed to any other", idx) {
+        // The first string is laid out directly after the vtable, which directly follows the header.
+        auto bytes = obj.get_bytes();
+        auto* first = reinterpret_cast<gsl::byte const*>(arr[0].str()) - sizeof(uint16_t);
+        auto header = first - bytes.data() - arr.size() * sizeof(dart::detail::wide_array_entry);
+        header -= sizeof(dart::detail::wide_header);
+        DYNAMIC_THEN("it fails to validate", idx) {
+          auto const fmt = static_cast<unsigned char>(dart::detail::layout_format::wide);
+          REQUIRE(static_cast<unsigned char>(bytes[header + 7]) >> 5 == fmt);
+          dart::each_foreign_encoding(bytes, [] (auto const* bytes, auto len) {
+            REQUIRE(!dart::is_valid(bytes, len));
+            REQUIRE_THROWS_AS(dart::validate(bytes, len), dart::validation_error);
+          }, header);
+        }
+      }
+    });
+  }
+
+  GIVEN("an array header with more elements than the standard header can count") {
+    // No test can afford half a billion elements, but the header can be written without them.
+    alignas(dart::detail::array<std::shared_ptr>::alignment) gsl::byte storage[sizeof(dart::detail::wide_header)] {};
+    auto* arr = reinterpret_cast<dart::detail::array<std::shared_ptr>*>(storage);
+    auto const count = (size_t {1} << 29U) + 42;
+
+    WHEN("it is switched to the wide encoding") {
+      arr->set_format(dart::detail::layout_format::wide, count);
+      THEN("it keeps the whole count") {
+        REQUIRE(arr->format() == dart::detail::layout_format::wide);
+        REQUIRE(arr->size() == count);
+      }
+    }
+  }
+
+  GIVEN("a wide array header with a count large enough to overflow the length of its vtable") {
+    // 2^60 16-byte entries wrap the vtable length around to zero, and every entry that
+    // actually fits has a valid type, so nothing stops the type check from running off the end.
+    alignas(dart::detail::array<std::shared_ptr>::alignment) gsl::byte storage[64] {};
+    auto* header = reinterpret_cast<dart::detail::wide_header*>(storage);
+    auto const fmt = static_cast<uint64_t>(dart::detail::layout_format::wide);
+    header->bytes = (fmt << dart::detail::wide_header::format_shift) | sizeof(storage);
+    header->elems = uint64_t {1} << 60U;
+    for (auto* entry = storage + sizeof(*header); entry != std::end(storage); entry += sizeof(dart::detail::wide_array_entry)) {
+      new(entry) dart::detail::wide_array_entry(dart::detail::raw_type::null, 0);
+    }
+    auto* arr = reinterpret_cast<dart::detail::array<std::shared_ptr>*>(storage);
+
+    WHEN("it is validated") {
+      THEN("it fails to validate without reading past the buffer") {
+        REQUIRE(!arr->is_valid<true>(sizeof(storage)));
+        REQUIRE_THROWS_AS(arr->is_valid<false>(sizeof(storage)), dart::validation_error);
+      }
+    }
+  }
+}
+
+SCENARIO("finalized arrays can be packed", "[array unit]") {
+  GIVEN("arrays of scalars finalized with the packed array policy") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto ints = dart::heap::make_array(), decs = dart::heap::make_array(), flags = dart::heap::make_array();
+      for (auto i = 0; i < 64; ++i) {
+        ints.push_back(i % 2 ? i : i * 100000);
+        decs.push_back(i + 0.5);
+        flags.push_back(i % 3 == 0);
+      }
+      auto mixed = dart::heap::make_array(1, 2.5, "three");
+      auto dyn = dart::heap::make_object("ints", ints, "decs", decs,
+          "flags", flags, "mixed", mixed, "empty", dart::heap::make_array());
+
+      auto opts = dart::finalize_options {};
+      opts.arrays = dart::array_policy::packed;
+      auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+      auto std_obj = dart::conversion_helper<pkt>(dyn.finalize());
+
+      DYNAMIC_WHEN("each element is accessed", idx) {
+        DYNAMIC_THEN("every value is found", idx) {
+          auto arr = obj["ints"];
+          REQUIRE(arr.size() == 64U);
+          for (auto i = 0; i < 64; ++i) {
+            REQUIRE(arr[i].integer() == (i % 2 ? i : i * 100000));
+            REQUIRE(obj["decs"][i].decimal() == i + 0.5);
+            REQUIRE(obj["flags"][i].boolean() == (i % 3 == 0));
+          }
+          REQUIRE(arr[64].is_null());
+          REQUIRE_THROWS_AS(arr.at(64), std::out_of_range);
+
+          auto count = 0;
+          for (auto val : obj["decs"]) REQUIRE(val.decimal() == count++ + 0.5);
+          REQUIRE(count == 64);
+        }
+      }
+
+      DYNAMIC_WHEN("the elements are viewed as spans", idx) {
+        auto ints_view = obj["ints"].template as_span<int64_t>();
+        auto decs_view = obj["decs"].template as_span<double>();
+        auto flags_view = obj["flags"].template as_span<bool>();
+        DYNAMIC_THEN("the spans hold every element", idx) {
+          REQUIRE(ints_view.size() == 64);
+          REQUIRE(decs_view.size() == 64);
+          REQUIRE(flags_view.size() == 64);
+          for (auto i = 0; i < 64; ++i) {
+            REQUIRE(ints_view[i] == (i % 2 ? i : i * 100000));
+            REQUIRE(decs_view[i] == i + 0.5);
+            REQUIRE(flags_view[i] == (i % 3 == 0));
+          }
+        }
+
+        DYNAMIC_THEN("arrays of anything else can't be viewed", idx) {
+          REQUIRE(obj["empty"].template as_span<double>().empty());
+          REQUIRE_THROWS_AS(obj["ints"].template as_span<double>(), dart::type_error);
+          REQUIRE_THROWS_AS(obj["ints"].template as_span<int32_t>(), dart::type_error);
+          REQUIRE_THROWS_AS(obj["mixed"].template as_span<int64_t>(), dart::type_error);
+          REQUIRE_THROWS_AS(std_obj["ints"].template as_span<int64_t>(), dart::type_error);
+          REQUIRE_THROWS_AS(obj.template as_span<int64_t>(), dart::type_error);
+        }
+      }
+
+      DYNAMIC_WHEN("it is compared against the standard encoding", idx) {
+        DYNAMIC_THEN("it takes less space, but holds the same values", idx) {
+          REQUIRE(obj.get_bytes().size() < std_obj.get_bytes().size());
+          REQUIRE(obj == std_obj);
+          REQUIRE(std_obj == obj);
+          REQUIRE(obj == dyn);
+          REQUIRE(obj["ints"] == ints);
+          REQUIRE(obj["decs"] == std_obj["decs"]);
+          REQUIRE(obj["mixed"] == mixed);
+          REQUIRE(obj["ints"] != obj["decs"]);
+        }
+      }
+
+      DYNAMIC_WHEN("it is merged", idx) {
+        auto merged = obj.inject("extra", 1);
+        auto projected = obj.project({"decs"});
+        DYNAMIC_THEN("packed arrays are carried along", idx) {
+          REQUIRE(dart::is_valid(merged.get_bytes()));
+          REQUIRE(merged["ints"].template as_span<int64_t>().size() == 64);
+          REQUIRE(projected["decs"].template as_span<double>()[63] == 63.5);
+        }
+      }
+
+      DYNAMIC_WHEN("the type of its elements is corrupted", idx) {
+        auto bytes = obj.get_bytes();
+        std::vector<gsl::byte> copy(bytes.begin(), bytes.end());
+        // The type of the elements is stored in the word preceding them.
+        auto* elems = reinterpret_cast<gsl::byte const*>(obj["ints"].template as_span<int64_t>().data());
+        auto offset = elems - bytes.data() - sizeof(int64_t);
+        DYNAMIC_THEN("it fails validation", idx) {
+          REQUIRE(dart::is_valid(gsl::make_span(copy)));
+          copy[offset] = static_cast<gsl::byte>(dart::detail::raw_type::string);
+          REQUIRE_FALSE(dart::is_valid(gsl::make_span(copy)));
+        }
+      }
+
+      DYNAMIC_WHEN("its encoding tag is changed to any other", idx) {
+        // The type of the elements sits between the header and the elements.
+        auto bytes = obj.get_bytes();
+        auto* elems = reinterpret_cast<gsl::byte const*>(obj["decs"].template as_span<double>().data());
+        auto header = elems - bytes.data() - sizeof(int64_t) - 8;
+        DYNAMIC_THEN("it fails to validate", idx) {
+          auto const fmt = static_cast<unsigned char>(dart::detail::layout_format::packed);
+          REQUIRE(static_cast<unsigned char>(bytes[header + 7]) >> 5 == fmt);
+          dart::each_foreign_encoding(bytes, [] (auto const* bytes, auto len) {
+            REQUIRE(!dart::is_valid(bytes, len));
+            REQUIRE_THROWS_AS(dart::validate(bytes, len), dart::validation_error);
+          }, header);
+        }
+      }
+    });
+  }
+}
+
+SCENARIO("finalized arrays can share repeated strings", "[array unit]") {
+  GIVEN("an array of repeated strings finalized with the shared string policy") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto statuses = dart::heap::make_array();
+      for (auto i = 0; i < 64; ++i) statuses.push_back(i % 3 ? "healthy" : "degraded since the last deploy");
+      statuses.push_back(1).push_back(dart::heap::null()).push_back("healthy");
+      auto dyn = dart::heap::make_object("statuses", statuses, "other", dart::heap::make_array("healthy"));
+
+      auto opts = dart::finalize_options {};
+      opts.strings = dart::string_policy::shared;
+      auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+      auto std_obj = dart::conversion_helper<pkt>(dyn.finalize());
+      auto arr = obj["statuses"];
+
+      DYNAMIC_WHEN("each element is accessed", idx) {
+        DYNAMIC_THEN("every value is found", idx) {
+          REQUIRE(arr.size() == 67U);
+          for (auto i = 0; i < 64; ++i) {
+            REQUIRE(arr[i] == (i % 3 ? "healthy" : "degraded since the last deploy"));
+          }
+          REQUIRE(arr[64].integer() == 1);
+          REQUIRE(arr[65].is_null());
+          REQUIRE(arr[66] == "healthy");
+          REQUIRE(obj["other"][0] == "healthy");
+        }
+      }
+
+      DYNAMIC_WHEN("it is compared against the standard encoding", idx) {
+        DYNAMIC_THEN("it takes less space, but holds the same values", idx) {
+          REQUIRE(obj.get_bytes().size() < std_obj.get_bytes().size());
+          REQUIRE(obj == std_obj);
+          REQUIRE(std_obj == obj);
+          REQUIRE(obj == dyn);
+          REQUIRE(arr == statuses);
+          REQUIRE(obj["other"] == std_obj["other"]);
+        }
+      }
+
+      DYNAMIC_WHEN("it is validated, or copied out piece by piece", idx) {
+        auto arr_buf = dart::buffer::make_object("arr", arr);
+        DYNAMIC_THEN("shared strings are accepted, and carried along", idx) {
+          REQUIRE(dart::is_valid(obj.get_bytes()));
+          REQUIRE(dart::is_valid(arr_buf.get_bytes()));
+          REQUIRE(arr_buf["arr"] == statuses);
+          REQUIRE(obj.inject("extra", 1)["statuses"] == statuses);
+        }
+      }
+
+      DYNAMIC_WHEN("an element is pointed back at something other than a string", idx) {
+        auto bytes = obj.get_bytes();
+        std::vector<gsl::byte> copy(bytes.begin(), bytes.end());
+        // The first string is laid out directly after the vtable, and each entry starts with its offset.
+        auto* first = reinterpret_cast<gsl::byte const*>(arr[0].str()) - sizeof(uint16_t);
+        auto vtable = first - bytes.data() - arr.size() * sizeof(dart::detail::array_entry);
+        auto entry = vtable + 64 * sizeof(dart::detail::array_entry);
+        DYNAMIC_THEN("it fails validation", idx) {
+          REQUIRE(dart::is_valid(gsl::make_span(copy)));
+          std::copy_n(copy.begin() + vtable, sizeof(uint32_t), copy.begin() + entry);
+          REQUIRE_FALSE(dart::is_valid(gsl::make_span(copy)));
+        }
+      }
+
+      DYNAMIC_WHEN("its encoding tag is changed to any other", idx) {
+        // The vtable directly follows the header.
+        auto bytes = obj.get_bytes();
+        auto* first = reinterpret_cast<gsl::byte const*>(arr[0].str()) - sizeof(uint16_t);
+        auto header = first - bytes.data() - arr.size() * sizeof(dart::detail::array_entry) - 8;
+        DYNAMIC_THEN("it fails to validate", idx) {
+          auto const fmt = static_cast<unsigned char>(dart::detail::layout_format::standard);
+          REQUIRE(static_cast<unsigned char>(bytes[header + 7]) >> 5 == fmt);
+          dart::each_foreign_encoding(bytes, [] (auto const* bytes, auto len) {
+            REQUIRE(!dart::is_valid(bytes, len));
+            REQUIRE_THROWS_AS(dart::validate(bytes, len), dart::validation_error);
+          }, header);
+        }
+      }
+    });
+  }
+}
+
+SCENARIO("arrays can be converted to and from contiguous ranges in bulk", "[array unit]") {
+  GIVEN("contiguous ranges of scalars") {
+    std::vector<double> decs;
+    std::vector<int32_t> ints;
+    for (auto i = 0; i < 64; ++i) {
+      decs.push_back(i + 0.5);
+      ints.push_back(i * 100000);
+    }
+    std::array<bool, 3> flags {{true, false, true}};
+
+    WHEN("they are cast into buffers") {
+      auto decs_buf = dart::convert::cast<dart::buffer>(decs);
+      auto ints_buf = dart::convert::cast<dart::buffer>(gsl::make_span(ints));
+      auto flags_buf = dart::convert::cast<dart::buffer>(flags);
+      THEN("the arrays are packed with elements of the same type") {
+        REQUIRE(decs_buf.is_packed<double>());
+        REQUIRE_FALSE(decs_buf.is_packed<int64_t>());
+        REQUIRE(ints_buf.is_packed<int32_t>());
+        REQUIRE(flags_buf.is_packed<bool>());
+        REQUIRE(decs_buf.as_span<double>()[63] == 63.5);
+        REQUIRE(ints_buf[63].integer() == 6300000);
+        REQUIRE_FALSE(flags_buf[1].boolean());
+      }
+
+      THEN("they compare equal to the same arrays built element by element") {
+        auto dyn = dart::heap::make_object("decs", decs, "ints", ints);
+        auto fin = dyn.finalize();
+        REQUIRE(decs_buf == decs);
+        REQUIRE(decs_buf == fin["decs"]);
+        REQUIRE(ints_buf == fin["ints"]);
+        REQUIRE(decs_buf == dyn["decs"]);
+      }
+    }
+
+    WHEN("a packed array is cast back out") {
+      auto buf = dart::convert::cast<dart::buffer>(decs);
+      std::vector<double> storage(decs.size()), small(3);
+      auto count = dart::convert::cast_into(buf, gsl::make_span(storage));
+      THEN("every element is copied") {
+        REQUIRE(count == decs.size());
+        REQUIRE(storage == decs);
+        REQUIRE(dart::convert::cast<std::vector<double>>(buf) == decs);
+      }
+
+      THEN("storage that is too small is rejected") {
+        REQUIRE_THROWS_AS(dart::convert::cast_into(buf, gsl::make_span(small)), std::out_of_range);
+        REQUIRE_THROWS_AS(dart::convert::cast_into(dart::buffer {}, gsl::make_span(small)), dart::type_error);
+      }
+    }
+
+    WHEN("an unpacked array is cast back out") {
+      auto buf = dart::heap::make_object("decs", decs).finalize()["decs"];
+      std::vector<double> storage(decs.size());
+      auto count = dart::convert::cast_into(buf, gsl::make_span(storage));
+      THEN("every element is converted individually") {
+        REQUIRE_FALSE(buf.is_packed<double>());
+        REQUIRE(count == decs.size());
+        REQUIRE(storage == decs);
+        REQUIRE(dart::convert::cast<std::vector<double>>(buf) == decs);
+      }
+    }
+  }
+}
+
 SCENARIO("arrays protect scope of shared resources", "[array unit]") {
   GIVEN("some arrays at an initial scope") {
     dart::packet_api_test([] (auto tag, auto idx) {
@@ -6,9 +6,11 @@
 
 /*----- Local Includes -----*/
 
+#include <cstddef>
 #include <cstring>
 #include <iostream>
 #include "../include/dart/abi.h"
+#include "../include/dart/abi_fast.h"
 #include "../include/extern/catch.h"
 
 /*----- Types -----*/
@@ -356,6 +358,41 @@ SCENARIO("dart buffers with unsafe refcounting are regular types", "[buffer abi
   }
 }
 
+SCENARIO("dart buffers with biased refcounting are regular types", "[buffer abi unit]") {
+  GIVEN("an object with some contents") {
+    // Get an object, make sure it's cleaned up.
+    auto mut = dart_obj_init_rc(DART_RC_BIASED);
+    auto guard = make_scope_guard([&] { dart_destroy(&mut); });
+    dart_obj_insert_str(&mut, "hello", "world");
+    dart_obj_insert_int(&mut, "int", 5);
+
+    WHEN("the object is finalized") {
+      auto fin = dart_to_buffer(&mut);
+      auto guard = make_scope_guard([&] { dart_buffer_destroy(&fin); });
+      THEN("its basic properties make sense") {
+        REQUIRE(dart_buffer_size(&fin) == 2U);
+        REQUIRE(fin.rtti.p_id == DART_BUFFER);
+        REQUIRE(fin.rtti.rc_id == DART_RC_BIASED);
+        REQUIRE(dart_buffer_get_type(&fin) == DART_OBJECT);
+      }
+
+      WHEN("the buffer is copied") {
+        auto copy = dart_buffer_copy(&fin);
+        auto key = dart_buffer_obj_get(&copy, "hello");
+        auto guard = make_scope_guard([&] {
+          dart_buffer_destroy(&key);
+          dart_buffer_destroy(&copy);
+        });
+        THEN("it is indistinguishable from the original") {
+          REQUIRE(copy.rtti.rc_id == DART_RC_BIASED);
+          REQUIRE(dart_equal(&copy, &fin));
+          REQUIRE(dart_buffer_str_get(&key) == "world"s);
+        }
+      }
+    }
+  }
+}
+
 SCENARIO("buffer objects can be constructed with many values", "[buffer abi unit]") {
   GIVEN("many test cases to run") {
     WHEN("an object is constructed with many values") {
@@ -510,6 +547,471 @@ SCENARIO("buffer objects with unsafe refcounting can be constructed with many va
   }
 }
 
+SCENARIO("buffer objects can be queried in batches", "[buffer abi unit]") {
+  GIVEN("an object with many values") {
+    auto mut = dart_obj_init_va("sidbaii", "name", "dart", "id", 7,
+        "price", 2.5, "live", true, "arr", 1, 2);
+    auto fin = dart_to_buffer(&mut);
+    auto guard = make_scope_guard([&] {
+      dart_buffer_destroy(&fin);
+      dart_destroy(&mut);
+    });
+
+    WHEN("many keys are looked up at once") {
+      char const* keys[] = {"name", "missing", "id"};
+      dart_buffer_t vals[3];
+      auto err = dart_buffer_obj_get_many(vals, &fin, keys, nullptr, 3);
+      REQUIRE(err == DART_NO_ERROR);
+      auto guard = make_scope_guard([&] { for (auto& val : vals) dart_buffer_destroy(&val); });
+
+      THEN("every key resolves just as it would individually") {
+        REQUIRE(dart_buffer_str_get(&vals[0]) == "dart"s);
+        REQUIRE(dart_is_null(&vals[1]));
+        REQUIRE(dart_buffer_int_get(&vals[2]) == 7);
+      }
+    }
+
+    WHEN("a range of an array is looked up at once") {
+      auto arr = dart_buffer_obj_get(&fin, "arr");
+      dart_buffer_t vals[3];
+      auto err = dart_buffer_arr_get_range(vals, &arr, 0, 3);
+      REQUIRE(err == DART_NO_ERROR);
+      auto guard = make_scope_guard([&] {
+        for (auto& val : vals) dart_buffer_destroy(&val);
+        dart_buffer_destroy(&arr);
+      });
+
+      THEN("out of bounds indices come back null") {
+        REQUIRE(dart_buffer_int_get(&vals[0]) == 1);
+        REQUIRE(dart_buffer_int_get(&vals[1]) == 2);
+        REQUIRE(dart_is_null(&vals[2]));
+      }
+    }
+
+    WHEN("fields are extracted into a struct") {
+      struct message {
+        dart_string_view_t name;
+        int64_t id;
+        double price;
+        int live;
+        int64_t missing;
+      };
+      dart_field_t fields[] = {
+        {"name", strlen("name"), DART_STRING, offsetof(message, name)},
+        {"id", strlen("id"), DART_INTEGER, offsetof(message, id)},
+        {"price", strlen("price"), DART_DECIMAL, offsetof(message, price)},
+        {"live", strlen("live"), DART_BOOLEAN, offsetof(message, live)},
+        {"missing", strlen("missing"), DART_INTEGER, offsetof(message, missing)}
+      };
+      message msg {};
+      msg.missing = 42;
+      auto err = dart_buffer_extract_typed(&fin, fields, 5, &msg);
+
+      THEN("each field is converted in place") {
+        REQUIRE(err == DART_NO_ERROR);
+        REQUIRE(std::string(msg.name.ptr, msg.name.len) == "dart");
+        REQUIRE(msg.id == 7);
+        REQUIRE(msg.price == Approx(2.5));
+        REQUIRE(msg.live == 1);
+        REQUIRE(msg.missing == 42);
+      }
+    }
+
+    WHEN("a batch is requested with the wrong types") {
+      char const* keys[] = {"name"};
+      dart_buffer_t vals[1];
+      dart_field_t field {"id", strlen("id"), DART_STRING, 0};
+      dart_string_view_t view;
+
+      THEN("the calls fail without constructing anything") {
+        REQUIRE(dart_buffer_arr_get_range(vals, &fin, 0, 1) == DART_TYPE_ERROR);
+        REQUIRE(dart_buffer_extract_typed(&fin, &field, 1, &view) == DART_TYPE_ERROR);
+        auto arr = dart_buffer_obj_get(&fin, "arr");
+        auto guard = make_scope_guard([&] { dart_buffer_destroy(&arr); });
+        REQUIRE(dart_buffer_obj_get_many(vals, &arr, keys, nullptr, 1) == DART_TYPE_ERROR);
+      }
+    }
+  }
+}
+
+SCENARIO("buffer aggregates can be unwrapped in bulk", "[buffer abi unit]") {
+  GIVEN("an object of homogeneous arrays") {
+    auto mut = dart_obj_init();
+    auto strs = dart_arr_init_va("sss", "one", "two", "three");
+    auto ints = dart_arr_init_va("iii", 1, 2, 3);
+    auto dcms = dart_arr_init_va("dd", 1.5, 2.5);
+    dart_obj_insert_dart(&mut, "strs", &strs);
+    dart_obj_insert_dart(&mut, "ints", &ints);
+    dart_obj_insert_dart(&mut, "dcms", &dcms);
+    auto fin = dart_to_buffer(&mut);
+    auto guard = make_scope_guard([&] {
+      dart_buffer_destroy(&fin);
+      dart_destroy(&dcms);
+      dart_destroy(&ints);
+      dart_destroy(&strs);
+      dart_destroy(&mut);
+    });
+
+    WHEN("each array is unwrapped") {
+      auto fin_strs = dart_buffer_obj_get(&fin, "strs");
+      auto fin_ints = dart_buffer_obj_get(&fin, "ints");
+      auto fin_dcms = dart_buffer_obj_get(&fin, "dcms");
+      auto guard = make_scope_guard([&] {
+        dart_buffer_destroy(&fin_dcms);
+        dart_buffer_destroy(&fin_ints);
+        dart_buffer_destroy(&fin_strs);
+      });
+
+      THEN("every element comes out in a single call") {
+        size_t count;
+        dart_string_view_t str_vals[3];
+        REQUIRE(dart_buffer_arr_get_strs(&fin_strs, str_vals, 3, &count) == DART_NO_ERROR);
+        REQUIRE(count == 3U);
+        REQUIRE(std::string(str_vals[0].ptr, str_vals[0].len) == "one");
+        REQUIRE(std::string(str_vals[2].ptr, str_vals[2].len) == "three");
+
+        int64_t int_vals[2];
+        REQUIRE(dart_buffer_arr_get_ints(&fin_ints, int_vals, 2, &count) == DART_NO_ERROR);
+        REQUIRE(count == 3U);
+        REQUIRE(int_vals[0] == 1);
+        REQUIRE(int_vals[1] == 2);
+
+        double dcm_vals[2];
+        REQUIRE(dart_buffer_arr_get_dcms(&fin_dcms, dcm_vals, 2, nullptr) == DART_NO_ERROR);
+        REQUIRE(dcm_vals[0] == Approx(1.5));
+        REQUIRE(dcm_vals[1] == Approx(2.5));
+
+        REQUIRE(dart_buffer_arr_get_ints(&fin_strs, int_vals, 2, &count) == DART_TYPE_ERROR);
+        REQUIRE(dart_buffer_arr_get_strs(&fin, str_vals, 3, &count) == DART_TYPE_ERROR);
+      }
+    }
+
+    WHEN("the object is unwrapped") {
+      size_t count;
+      dart_string_view_t keys[3];
+      dart_buffer_view_t vals[3];
+      auto err = dart_buffer_obj_get_all(&fin, keys, vals, 3, &count);
+      REQUIRE(err == DART_NO_ERROR);
+      auto guard = make_scope_guard([&] { for (auto& val : vals) dart_buffer_view_destroy(&val); });
+
+      THEN("every key lines up with its value") {
+        REQUIRE(count == 3U);
+        for (size_t i = 0; i < count; ++i) {
+          auto check = dart_buffer_obj_get_len(&fin, keys[i].ptr, keys[i].len);
+          auto guard = make_scope_guard([&] { dart_buffer_destroy(&check); });
+          REQUIRE(dart_buffer_view_size(&vals[i]) == dart_buffer_size(&check));
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("buffer lookups can fail without touching the error string", "[buffer abi unit]") {
+  GIVEN("a finalized object and a recorded error") {
+    auto mut = dart_obj_init_va("sib", "str", "hello", "int", 5, "bool", true);
+    auto fin = dart_to_buffer(&mut);
+    auto guard = make_scope_guard([&] {
+      dart_buffer_destroy(&fin);
+      dart_destroy(&mut);
+    });
+
+    int64_t dummy;
+    REQUIRE(dart_int_get_err(&fin, &dummy) == DART_TYPE_ERROR);
+    std::string before = dart_get_error();
+    REQUIRE_FALSE(before.empty());
+
+    WHEN("quiet lookups are performed") {
+      dart_buffer_t str, missing, bad;
+      REQUIRE(dart_buffer_obj_try_get(&str, &fin, "str") == DART_NO_ERROR);
+      REQUIRE(dart_buffer_obj_try_get_len(&missing, &fin, "nope", 4) == DART_NO_ERROR);
+      REQUIRE(dart_buffer_arr_try_get(&bad, &fin, 0) == DART_TYPE_ERROR);
+      auto guard = make_scope_guard([&] {
+        dart_buffer_destroy(&missing);
+        dart_buffer_destroy(&str);
+      });
+
+      THEN("they report through their return values alone") {
+        REQUIRE(dart_buffer_get_type(&str) == DART_STRING);
+        REQUIRE(dart_buffer_is_null(&missing));
+        REQUIRE(dart_get_error() == before);
+      }
+    }
+
+    WHEN("quiet unwraps are performed") {
+      char const* chars;
+      size_t len;
+      int64_t ival;
+      double dval;
+      int bval;
+      dart_type_t type;
+      auto str = dart_buffer_obj_get(&fin, "str");
+      auto num = dart_buffer_obj_get(&fin, "int");
+      auto flag = dart_buffer_obj_get(&fin, "bool");
+      auto guard = make_scope_guard([&] {
+        dart_buffer_destroy(&flag);
+        dart_buffer_destroy(&num);
+        dart_buffer_destroy(&str);
+      });
+
+      THEN("matching types succeed and mismatches stay quiet") {
+        REQUIRE(dart_str_try_get(&str, &chars, &len) == DART_NO_ERROR);
+        REQUIRE(std::string(chars, len) == "hello");
+        REQUIRE(dart_str_try_get(&num, &chars, nullptr) == DART_TYPE_ERROR);
+        REQUIRE(dart_int_try_get(&num, &ival) == DART_NO_ERROR);
+        REQUIRE(ival == 5);
+        REQUIRE(dart_int_try_get(&str, &ival) == DART_TYPE_ERROR);
+        REQUIRE(dart_dcm_try_get(&num, &dval) == DART_TYPE_ERROR);
+        REQUIRE(dart_bool_try_get(&flag, &bval) == DART_NO_ERROR);
+        REQUIRE(bval);
+        REQUIRE(dart_try_get_type(&fin, &type) == DART_NO_ERROR);
+        REQUIRE(type == DART_OBJECT);
+
+        dart_packet_t pkt;
+        REQUIRE(dart_obj_try_get(&pkt, &fin, "int") == DART_NO_ERROR);
+        REQUIRE(dart_int_get(&pkt) == 5);
+        dart_destroy(&pkt);
+        REQUIRE(dart_arr_try_get(&pkt, &fin, 0) == DART_TYPE_ERROR);
+        REQUIRE(dart_get_error() == before);
+      }
+    }
+  }
+}
+
+SCENARIO("finalized buffers can be read through the inline fast path", "[buffer abi unit]") {
+  GIVEN("an object covering every finalized representation") {
+    std::string long_key(300, 'k'), big_str(70000, 'b');
+    auto mut = dart_obj_init();
+    auto nested = dart_obj_init_va("s", "inner", "value");
+    auto arr = dart_arr_init_va("ids", 1, 2.5, "three");
+    dart_obj_insert_int(&mut, "short", -3);
+    dart_obj_insert_int(&mut, "medium", 70000);
+    dart_obj_insert_int(&mut, "long", 1LL << 40);
+    dart_obj_insert_dcm(&mut, "dcm", 3.14159);
+    dart_obj_insert_bool(&mut, "ab", true);
+    dart_obj_insert_str(&mut, "ac", "hello");
+    dart_obj_insert_str(&mut, "abc", "");
+    dart_obj_insert_null(&mut, "abd");
+    dart_obj_insert_str_len(&mut, long_key.data(), long_key.size(), big_str.data(), big_str.size());
+    dart_obj_insert_dart(&mut, "nested", &nested);
+    dart_obj_insert_dart(&mut, "arr", &arr);
+    auto fin = dart_to_buffer(&mut);
+    auto guard = make_scope_guard([&] {
+      dart_buffer_destroy(&fin);
+      dart_destroy(&arr);
+      dart_destroy(&nested);
+      dart_destroy(&mut);
+    });
+
+    WHEN("the buffer is decoded inline") {
+      REQUIRE(dart_fast_compatible());
+      auto root = dart_fast_from_buffer(&fin);
+
+      THEN("types, sizes, and lookups agree with the library") {
+        REQUIRE(dart_fast_is_obj(root));
+        REQUIRE(dart_fast_size(root) == dart_buffer_size(&fin));
+
+        size_t count;
+        dart_string_view_t keys[16];
+        REQUIRE(dart_buffer_obj_get_all(&fin, keys, nullptr, 16, &count) == DART_NO_ERROR);
+        for (size_t idx = 0; idx < count; ++idx) {
+          auto slow = dart_buffer_obj_get_len(&fin, keys[idx].ptr, keys[idx].len);
+          auto fast = dart_fast_obj_get_len(root, keys[idx].ptr, keys[idx].len);
+          REQUIRE(dart_fast_get_type(fast) == dart_buffer_get_type(&slow));
+          REQUIRE(dart_fast_size(fast) == dart_buffer_size(&slow));
+          dart_buffer_destroy(&slow);
+        }
+
+        REQUIRE(dart_fast_is_null(dart_fast_obj_get(root, "missing")));
+        REQUIRE(dart_fast_is_null(dart_fast_obj_get(root, "ad")));
+        REQUIRE(dart_fast_is_null(dart_fast_obj_get_len(root, long_key.data(), long_key.size() - 1)));
+        REQUIRE(dart_fast_is_null(dart_fast_obj_get(root, "")));
+      }
+
+      THEN("scalars and strings unwrap to the same values") {
+        int64_t ival;
+        REQUIRE(dart_fast_int_get(dart_fast_obj_get(root, "short"), &ival) == DART_NO_ERROR);
+        REQUIRE(ival == -3);
+        REQUIRE(dart_fast_int_get(dart_fast_obj_get(root, "medium"), &ival) == DART_NO_ERROR);
+        REQUIRE(ival == 70000);
+        REQUIRE(dart_fast_int_get(dart_fast_obj_get(root, "long"), &ival) == DART_NO_ERROR);
+        REQUIRE(ival == 1LL << 40);
+        REQUIRE(dart_fast_int_get(dart_fast_obj_get(root, "ac"), &ival) == DART_TYPE_ERROR);
+
+        double dval;
+        REQUIRE(dart_fast_dcm_get(dart_fast_obj_get(root, "dcm"), &dval) == DART_NO_ERROR);
+        REQUIRE(dval == Approx(3.14159));
+
+        int bval;
+        REQUIRE(dart_fast_bool_get(dart_fast_obj_get(root, "ab"), &bval) == DART_NO_ERROR);
+        REQUIRE(bval);
+
+        dart_string_view_t str;
+        REQUIRE(dart_fast_str_get(dart_fast_obj_get(root, "ac"), &str) == DART_NO_ERROR);
+        REQUIRE(std::string(str.ptr, str.len) == "hello");
+        REQUIRE(dart_fast_str_get(dart_fast_obj_get(root, "abc"), &str) == DART_NO_ERROR);
+        REQUIRE(str.len == 0U);
+        auto big = dart_fast_obj_get_len(root, long_key.data(), long_key.size());
+        REQUIRE(dart_fast_str_get(big, &str) == DART_NO_ERROR);
+        REQUIRE(std::string(str.ptr, str.len) == big_str);
+        REQUIRE(dart_fast_size(big) == big_str.size());
+        REQUIRE(dart_fast_is_null(dart_fast_obj_get(root, "abd")));
+        REQUIRE(dart_fast_str_get(dart_fast_obj_get(root, "abd"), &str) == DART_TYPE_ERROR);
+      }
+
+      THEN("nested aggregates can be traversed") {
+        dart_string_view_t str;
+        auto inner = dart_fast_obj_get(dart_fast_obj_get(root, "nested"), "inner");
+        REQUIRE(dart_fast_str_get(inner, &str) == DART_NO_ERROR);
+        REQUIRE(std::string(str.ptr, str.len) == "value");
+
+        int64_t ival;
+        double dval;
+        auto elems = dart_fast_obj_get(root, "arr");
+        REQUIRE(dart_fast_size(elems) == 3U);
+        REQUIRE(dart_fast_int_get(dart_fast_arr_get(elems, 0), &ival) == DART_NO_ERROR);
+        REQUIRE(ival == 1);
+        REQUIRE(dart_fast_dcm_get(dart_fast_arr_get(elems, 1), &dval) == DART_NO_ERROR);
+        REQUIRE(dval == 2.5);
+        REQUIRE(dart_fast_str_get(dart_fast_arr_get(elems, 2), &str) == DART_NO_ERROR);
+        REQUIRE(std::string(str.ptr, str.len) == "three");
+        REQUIRE(dart_fast_is_null(dart_fast_arr_get(elems, 3)));
+        REQUIRE(dart_fast_is_null(dart_fast_arr_get(root, 0)));
+        REQUIRE(!dart_fast_is_unsupported(elems));
+        REQUIRE(!dart_fast_is_unsupported(dart_fast_obj_get(root, "missing")));
+      }
+    }
+  }
+
+  GIVEN("an object keyed against a dictionary") {
+    // The ABI can't key objects against a dictionary, so the object is written out by hand:
+    // "id" is stored by id (0), and "ab" inline, each with a short integer value.
+    alignas(8) unsigned char bytes[48] {};
+    auto store = [&] (size_t offset, uint64_t val, size_t len) {
+      for (size_t i = 0; i < len; ++i) bytes[offset + i] = static_cast<unsigned char>(val >> (i * 8));
+    };
+    store(0, sizeof(bytes), 4);
+    store(4, 2 | (DART_FAST_DICTIONARY << DART_FAST_FORMAT_SHIFT), 4);
+    store(16, 32, 4);
+    store(20, DART_FAST_RAW_SHORT_INTEGER, 1);
+    store(22, 0, 2);
+    store(24, 34, 4);
+    store(28, DART_FAST_RAW_SHORT_INTEGER, 1);
+    store(30, DART_FAST_INLINE_ID, 2);
+    store(32, 7, 2);
+    store(34, 2, 2);
+    std::memcpy(bytes + 36, "ab", 3);
+    store(40, 9, 2);
+    auto root = dart_fast_root(bytes);
+
+    WHEN("keys are looked up inline") {
+      THEN("keys stored inline are found") {
+        int64_t ival;
+        REQUIRE(dart_fast_size(root) == 2U);
+        REQUIRE(dart_fast_int_get(dart_fast_obj_get(root, "ab"), &ival) == DART_NO_ERROR);
+        REQUIRE(ival == 9);
+      }
+
+      THEN("any other key is reported as unsupported instead of absent") {
+        auto id = dart_fast_obj_get(root, "id");
+        REQUIRE(dart_fast_is_unsupported(id));
+        REQUIRE(!dart_fast_is_null(id));
+        REQUIRE(dart_fast_get_type(id) == DART_INVALID);
+        REQUIRE(dart_fast_is_unsupported(dart_fast_obj_get(root, "missing")));
+        REQUIRE(dart_fast_is_unsupported(dart_fast_obj_get(root, "ac")));
+      }
+
+      THEN("lookups through an unsupported handle stay unsupported") {
+        auto id = dart_fast_obj_get(root, "id");
+        REQUIRE(dart_fast_is_unsupported(dart_fast_obj_get(id, "nested")));
+        REQUIRE(dart_fast_is_unsupported(dart_fast_arr_get(id, 0)));
+      }
+
+      THEN("arrays in encodings the fast path doesn't understand are reported as unsupported") {
+        dart_fast_elem_t arr {bytes, DART_FAST_RAW_ARRAY};
+        REQUIRE(dart_fast_is_unsupported(dart_fast_arr_get(arr, 0)));
+        REQUIRE(dart_fast_is_null(dart_fast_arr_get(arr, 2)));
+      }
+    }
+  }
+}
+
+SCENARIO("buffer objects can be walked through views", "[buffer abi unit]") {
+  GIVEN("an object with nested values") {
+    auto mut = dart_obj_init_va("sisai", "name", "dart", "id", 7, "str", "value", "arr", 1);
+    auto fin = dart_to_buffer(&mut);
+    auto guard = make_scope_guard([&] {
+      dart_buffer_destroy(&fin);
+      dart_destroy(&mut);
+    });
+
+    WHEN("values are viewed") {
+      auto root = dart_buffer_view_init(&fin);
+      dart_buffer_view_t name, id, arr, elem, missing;
+      REQUIRE(dart_buffer_obj_get_view(&name, &fin, "name") == DART_NO_ERROR);
+      REQUIRE(dart_buffer_view_obj_get(&id, &root, "id") == DART_NO_ERROR);
+      REQUIRE(dart_buffer_view_obj_get_len(&arr, &root, "arr", strlen("arr")) == DART_NO_ERROR);
+      REQUIRE(dart_buffer_view_arr_get(&elem, &arr, 0) == DART_NO_ERROR);
+      REQUIRE(dart_buffer_view_obj_get(&missing, &root, "missing") == DART_NO_ERROR);
+      auto guard = make_scope_guard([&] {
+        dart_buffer_view_destroy(&missing);
+        dart_buffer_view_destroy(&elem);
+        dart_buffer_view_destroy(&arr);
+        dart_buffer_view_destroy(&id);
+        dart_buffer_view_destroy(&name);
+        dart_buffer_view_destroy(&root);
+      });
+
+      THEN("they resolve just as buffers would") {
+        size_t len;
+        int64_t val;
+        REQUIRE(root.rtti.p_id == DART_BUFFER_VIEW);
+        REQUIRE(dart_buffer_view_size(&root) == 4U);
+        REQUIRE(dart_buffer_view_str_get_len(&name, &len) == "dart"s);
+        REQUIRE(len == strlen("dart"));
+        REQUIRE(dart_buffer_view_int_get_err(&id, &val) == DART_NO_ERROR);
+        REQUIRE(val == 7);
+        REQUIRE(dart_buffer_view_get_type(&arr) == DART_ARRAY);
+        REQUIRE(dart_buffer_view_int_get_err(&elem, &val) == DART_NO_ERROR);
+        REQUIRE(val == 1);
+        REQUIRE(dart_buffer_view_get_type(&missing) == DART_NULL);
+        REQUIRE(dart_buffer_view_int_get_err(&name, &val) == DART_TYPE_ERROR);
+      }
+
+      THEN("they can be promoted back into buffers") {
+        dart_buffer_t owned;
+        REQUIRE(dart_buffer_view_to_buffer_err(&owned, &arr) == DART_NO_ERROR);
+        auto guard = make_scope_guard([&] { dart_buffer_destroy(&owned); });
+        REQUIRE(owned.rtti.p_id == DART_BUFFER);
+        REQUIRE(dart_buffer_size(&owned) == 1U);
+      }
+    }
+
+    WHEN("a view is iterated over") {
+      auto root = dart_buffer_view_init(&fin);
+      dart_buffer_view_iterator_t it;
+      REQUIRE(dart_buffer_view_iterator_init_key_err(&it, &root) == DART_NO_ERROR);
+      auto guard = make_scope_guard([&] {
+        dart_buffer_view_iterator_destroy(&it);
+        dart_buffer_view_destroy(&root);
+      });
+
+      THEN("it visits every key") {
+        size_t count = 0;
+        for (; !dart_buffer_view_iterator_done(&it); dart_buffer_view_iterator_next(&it)) {
+          dart_buffer_view_t key;
+          REQUIRE(dart_buffer_view_iterator_get_err(&key, &it) == DART_NO_ERROR);
+          REQUIRE(dart_buffer_view_get_type(&key) == DART_STRING);
+          dart_buffer_view_destroy(&key);
+          ++count;
+        }
+        dart_buffer_view_t key;
+        REQUIRE(count == 4U);
+        REQUIRE(dart_buffer_view_iterator_get_err(&key, &it) == DART_RUNTIME_ERROR);
+      }
+    }
+  }
+}
+
 SCENARIO("buffer objects can be iterated over", "[buffer abi unit]") {
   GIVEN("an object with contents") {
     auto* dyn = "dynamic";
@@ -953,6 +953,28 @@ namespace dart {
     return retval;
   }
 
+  // Calls the given callback with a copy of the given buffer in which the aggregate whose header
+  // starts at the given offset is re-tagged with every encoding other than its own.
+  // The top three bits of the eighth byte select the encoding, whether the header is standard or wide.
+  // A wide header re-tagged with a standard encoding reads as an empty aggregate, which is perfectly
+  // valid, as the standard count overlaps the top of the wide length, so those tags are skipped.
+  template <class Callback>
+  void each_foreign_encoding(gsl::span<gsl::byte const> bytes, Callback&& cb, size_t header = 0) {
+    auto len = bytes.size();
+    std::shared_ptr<gsl::byte> dup(new gsl::byte[len], [] (auto* ptr) { delete[] ptr; });
+    auto* raw = reinterpret_cast<unsigned char*>(dup.get()) + header;
+    auto const own = static_cast<unsigned char>(bytes[header + 7]) >> 5;
+    auto const wide = detail::is_wide(static_cast<detail::layout_format>(own));
+    for (unsigned char tag = 0; tag < 8; ++tag) {
+      auto const fmt = static_cast<detail::layout_format>(tag);
+      if (tag == own) continue;
+      else if (wide && !detail::is_wide(fmt) && fmt < detail::layout_format::packed) continue;
+      std::copy(bytes.begin(), bytes.end(), dup.get());
+      raw[7] = (raw[7] & 0x1F) | (tag << 5);
+      cb(static_cast<gsl::byte const*>(dup.get()), len);
+    }
+  }
+
   template <class Callback>
   void n_times(int n, Callback&& cb) {
     for (auto i = 0; i < n; ++i) cb();
@@ -2060,6 +2060,11 @@ SCENARIO("objects can switch between finalized and non-finalized representations
         REQUIRE(dart_equal(&low, &obj));
       }
 
+      THEN("it hashes equal with its original representation") {
+        REQUIRE(dart_hash(&fin) == dart_hash(&obj));
+        REQUIRE(dart_hash(&low) == dart_hash(&obj));
+      }
+
       WHEN("the object is de-finalized again") {
         auto liftd = dart_lift(&low);
         auto nofin = dart_definalize(&fin);
@@ -2111,6 +2116,11 @@ SCENARIO("objects with unsafe refcounting can switch between finalized and non-f
         REQUIRE(dart_equal(&low, &obj));
       }
 
+      THEN("it hashes equal with its original representation") {
+        REQUIRE(dart_hash(&fin) == dart_hash(&obj));
+        REQUIRE(dart_hash(&low) == dart_hash(&obj));
+      }
+
       WHEN("the object is de-finalized again") {
         auto liftd = dart_lift(&low);
         auto nofin = dart_definalize(&fin);
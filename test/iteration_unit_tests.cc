@@ -285,3 +285,50 @@ SCENARIO("iterators can iterate over array elements", "[iteration unit]") {
     }
   }
 }
+
+SCENARIO("finalized aggregates can be visited without iterators", "[iteration unit]") {
+  GIVEN("a finalized object with mixed values") {
+    auto nested = dart::buffer::make_object("nested", dart::packet::make_array(1, 2.5, "three", true, nullptr));
+    auto obj = dart::buffer::make_object("a", 1, "bb", "str", "ccc", 3.5, "arr", nested["nested"], "obj", nested);
+
+    WHEN("the object is visited pair by pair") {
+      std::vector<std::string> keys;
+      std::vector<dart::buffer> vals;
+      obj.for_each_pair([&] (auto key, auto val) {
+        keys.emplace_back(key.str());
+        vals.push_back(val.as_owner());
+      });
+
+      THEN("it visits the same pairs, in the same order, as the iterators") {
+        auto k_it = obj.key_begin();
+        auto v_it = obj.begin();
+        REQUIRE(keys.size() == obj.size());
+        for (size_t idx = 0; idx < keys.size(); ++idx, ++k_it, ++v_it) {
+          REQUIRE(keys[idx] == *k_it);
+          REQUIRE(vals[idx] == *v_it);
+        }
+      }
+    }
+
+    WHEN("an array is visited element by element") {
+      auto arr = obj["arr"];
+      std::vector<dart::buffer> elems;
+      arr.for_each_elem([&] (auto elem) { elems.push_back(elem.as_owner()); });
+
+      THEN("it visits every element in order") {
+        REQUIRE(elems.size() == arr.size());
+        for (size_t idx = 0; idx < elems.size(); ++idx) REQUIRE(elems[idx] == arr[idx]);
+        REQUIRE(elems[1].decimal() == 2.5);
+        REQUIRE(elems[4].is_null());
+      }
+    }
+
+    WHEN("the wrong aggregate is visited") {
+      THEN("it throws") {
+        REQUIRE_THROWS_AS(obj.for_each_elem([] (auto) {}), dart::type_error);
+        REQUIRE_THROWS_AS(obj["arr"].for_each_pair([] (auto, auto) {}), dart::type_error);
+        REQUIRE_THROWS_AS(obj["a"].for_each_elem([] (auto) {}), dart::type_error);
+      }
+    }
+  }
+}
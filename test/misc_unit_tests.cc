@@ -54,3 +54,104 @@ SCENARIO("packets can be compared directly to native types", "[misc unit]") {
     }
   }
 }
+
+SCENARIO("packets can dispatch directly to their underlying representation", "[misc unit]") {
+  GIVEN("a dynamic and a finalized object") {
+    auto dyn = dart::packet::make_object("hello", "world", "int", 5);
+    auto fin = dyn;
+    fin.finalize();
+    auto is_buffer = [] (auto& v) {
+      return std::is_same<std::decay_t<decltype(v)>, dart::buffer>::value;
+    };
+
+    WHEN("the objects are visited") {
+      THEN("finalized packets are visited as buffers, everything else as heaps") {
+        REQUIRE(fin.visit_finalized(is_buffer));
+        REQUIRE_FALSE(dyn.visit_finalized(is_buffer));
+        REQUIRE(fin.visit_finalized([] (auto& v) { return v["int"].integer(); }) == 5);
+        REQUIRE(dyn.visit_finalized([] (auto& v) { return v["hello"] == "world"; }));
+      }
+    }
+
+    WHEN("the objects are asked for their buffers") {
+      int64_t val = 0;
+      bool dyn_called = false;
+      auto fin_found = fin.with_buffer([&] (dart::buffer const& buf) { val = buf["int"].integer(); });
+      auto dyn_found = dyn.with_buffer([&] (dart::buffer const&) { dyn_called = true; });
+
+      THEN("only the finalized packet invokes the callback") {
+        REQUIRE(fin_found);
+        REQUIRE(val == 5);
+        REQUIRE_FALSE(dyn_found);
+        REQUIRE_FALSE(dyn_called);
+      }
+    }
+  }
+}
+
+SCENARIO("packets hash consistently with equality", "[misc unit]") {
+  GIVEN("an object with nested aggregates, repeated strings, and every primitive type") {
+    auto samples = dart::packet::make_array(1, 2, 3);
+    auto obj = dart::packet::make_object("host", "db1", "status", "ok",
+        "metrics", dart::packet::make_object("cpu", 0.5, "mem", 12, "up", true),
+        "samples", samples, "tags", dart::packet::make_array("x", "x", "y", nullptr));
+
+    WHEN("it is finalized under every option") {
+      dart::key_dictionary dict {"host", "metrics", "cpu"};
+      std::vector<dart::finalize_options> options(6);
+      options[1].offsets = dart::offset_policy::automatic;
+      options[2].offsets = dart::offset_policy::wide;
+      options[3].arrays = dart::array_policy::packed;
+      options[4].strings = dart::string_policy::shared;
+      options[5].dictionary = dict;
+      options[5].strings = dart::string_policy::shared;
+
+      THEN("every representation hashes the same") {
+        dart::heap heap {obj};
+        for (auto& opts : options) {
+          auto fin = obj;
+          fin.finalize(opts);
+          dart::buffer buf {fin};
+          REQUIRE(fin.hash() == obj.hash());
+          REQUIRE(buf.hash() == heap.hash());
+          REQUIRE(buf["metrics"].hash() == heap["metrics"].hash());
+          REQUIRE(buf["samples"].hash() == samples.hash());
+          REQUIRE(buf["tags"][0].hash() == heap["tags"][1].hash());
+        }
+      }
+    }
+
+    WHEN("it is stored in a hash set alongside its finalized form") {
+      std::unordered_set<dart::packet> set;
+      auto other = obj;
+      other.add_field("host", "db2");
+      set.insert(obj);
+      set.insert(dart::packet {obj}.finalize());
+      set.insert(other);
+
+      THEN("equal packets collapse into one entry") {
+        REQUIRE(set.size() == 2U);
+        REQUIRE(set.count(obj.finalize()) == 1U);
+        REQUIRE(set.count(other) == 1U);
+      }
+    }
+  }
+
+  GIVEN("values that compare unequal") {
+    THEN("they hash differently") {
+      REQUIRE(dart::packet::make_integer(1).hash() != dart::packet::make_string("1").hash());
+      REQUIRE(dart::packet::make_integer(1).hash() != dart::packet::make_decimal(1.0).hash());
+      REQUIRE(dart::packet::make_array(1, 2).hash() != dart::packet::make_array(2, 1).hash());
+      REQUIRE(dart::packet::make_object("a", 1).hash() != dart::packet::make_object("a", 2).hash());
+    }
+  }
+
+  GIVEN("positive and negative zero") {
+    THEN("they compare, and hash, equal") {
+      auto pos = dart::packet::make_decimal(0.0);
+      auto neg = dart::packet::make_decimal(-0.0);
+      REQUIRE(pos == neg);
+      REQUIRE(pos.hash() == neg.hash());
+    }
+  }
+}
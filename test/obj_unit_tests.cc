@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <string>
+#include <thread>
+#include <cstring>
 #include <iostream>
 #include <algorithm>
 #include <unordered_set>
@@ -233,6 +235,17 @@ SCENARIO("finalized objects can be validated", "[object unit]") {
           }
         }
 
+        DYNAMIC_WHEN("we corrupt the key length cached in the vtable", idx) {
+          // Object header is 8 bytes, and the cached length is the sixth byte of the entry.
+          auto replacement = static_cast<unsigned char>(std::strlen("hello") - 1);
+          const_cast<gsl::byte&>(dup[8 + 5]) = *reinterpret_cast<gsl::byte*>(&replacement);
+
+          DYNAMIC_THEN("it fails to validate", idx) {
+            REQUIRE(!dart::is_valid(dup.get(), len));
+            REQUIRE_THROWS_AS(dart::validate(dup.get(), len), dart::validation_error);
+          }
+        }
+
         DYNAMIC_WHEN("we truncate the buffer", idx) {
           auto curr = len;
           while (--curr != 0) {
@@ -939,6 +952,752 @@ SCENARIO("objects have limits on key sizes", "[object unit]") {
   }
 }
 
+SCENARIO("finalized objects find values behind keys of any length", "[object unit]") {
+  GIVEN("a finalized object with keys on either side of the vtable length cap") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      // Key lengths are cached in the vtable up to 254 characters, which lets
+      // lookups skip the key entirely, after that the key itself is consulted.
+      std::vector<size_t> lengths {0, 1, 2, 3, 7, 254, 255, 256, 1024};
+      auto dyn = dart::heap::make_object();
+      for (auto len : lengths) {
+        std::string key(len, 'k');
+        if (len % 2) dyn.add_field(key, static_cast<int64_t>(len));
+        else dyn.add_field(key, std::string(len % 7 + 1, 'v'));
+      }
+      auto obj = dart::conversion_helper<pkt>(dyn.finalize());
+
+      DYNAMIC_WHEN("each key is looked up", idx) {
+        DYNAMIC_THEN("every value is found where it was written", idx) {
+          REQUIRE(dart::is_valid(obj.get_bytes()));
+          for (auto len : lengths) {
+            auto val = obj[std::string(len, 'k')];
+            if (len % 2) REQUIRE(val.integer() == static_cast<int64_t>(len));
+            else REQUIRE(val.strv() == std::string(len % 7 + 1, 'v'));
+          }
+        }
+      }
+
+      DYNAMIC_WHEN("the object is iterated over", idx) {
+        DYNAMIC_THEN("keys and values line up", idx) {
+          auto k_it = obj.key_begin();
+          for (auto v_it = obj.begin(); v_it != obj.end(); ++v_it, ++k_it) {
+            auto len = k_it->size();
+            if (len % 2) REQUIRE(v_it->integer() == static_cast<int64_t>(len));
+            else REQUIRE(v_it->strv() == std::string(len % 7 + 1, 'v'));
+          }
+        }
+      }
+    });
+  }
+}
+
+SCENARIO("finalized objects trust only exact cached key lengths", "[object unit]") {
+  GIVEN("a finalized object whose key contains an embedded null") {
+    auto dyn = dart::heap::make_object();
+    dyn.add_field(std::string("a\0bcd", 5), 7);
+    dart::buffer obj {dyn.finalize()};
+
+    WHEN("the key is looked up") {
+      THEN("the value is found behind the whole key") {
+        REQUIRE(obj[std::string("a\0bcd", 5)] == 7);
+        REQUIRE(obj.values().front() == 7);
+      }
+    }
+
+    WHEN("the vtable caches the length up to the null, as layouts before version 7 did") {
+      // Standard objects lay out {offset, type, len, prefix} entries after an 8 byte header.
+      auto bytes = obj.get_bytes();
+      std::vector<gsl::byte> patched(bytes.begin(), bytes.end());
+      REQUIRE(patched[13] == static_cast<gsl::byte>(5));
+      patched[13] = static_cast<gsl::byte>(1);
+      THEN("validation rejects the buffer instead of misreading its values") {
+        REQUIRE(dart::is_valid(bytes));
+        REQUIRE_FALSE(dart::is_valid(gsl::make_span(patched)));
+      }
+    }
+  }
+}
+
+SCENARIO("finalized objects can cache discriminating key prefixes", "[object unit]") {
+  GIVEN("an object whose keys share a long leading prefix") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      // Every key of the same length starts with "metric.cpu.", so the leading
+      // two characters cached by the standard encoding can't tell any of them apart.
+      auto dyn = dart::heap::make_object("a", 1, "metric.x", 2);
+      for (auto i = 0; i < 40; ++i) dyn.add_field("metric.cpu." + std::to_string(1000 + i), i);
+
+      auto opts = dart::finalize_options {};
+      opts.prefix = dart::prefix_policy::discriminating;
+      auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+      auto std_obj = dart::conversion_helper<pkt>(dyn.finalize());
+
+      DYNAMIC_WHEN("each key is looked up", idx) {
+        DYNAMIC_THEN("every value is found, and absent keys are not", idx) {
+          REQUIRE(dart::is_valid(obj.get_bytes()));
+          REQUIRE(obj.size() == std_obj.size());
+          REQUIRE(obj["a"].integer() == 1);
+          REQUIRE(obj["metric.x"].integer() == 2);
+          for (auto i = 0; i < 40; ++i) {
+            REQUIRE(obj["metric.cpu." + std::to_string(1000 + i)].integer() == i);
+          }
+          REQUIRE(obj["metric.cpu.2000"].is_null());
+          REQUIRE(obj["metric.gpu.1000"].is_null());
+          REQUIRE(obj["metric.y"].is_null());
+          REQUIRE(obj["b"].is_null());
+        }
+      }
+
+      DYNAMIC_WHEN("it is compared against the standard encoding", idx) {
+        DYNAMIC_THEN("it takes more space, but holds the same values", idx) {
+          REQUIRE(obj.get_bytes().size() > std_obj.get_bytes().size());
+          REQUIRE(obj == std_obj);
+          REQUIRE(std_obj == obj);
+          REQUIRE(obj == dyn);
+        }
+      }
+
+      DYNAMIC_WHEN("it is merged into another object", idx) {
+        auto base = dart::conversion_helper<pkt>(dart::heap::make_object("z", 3).finalize());
+        auto merged = base.deep_merge(obj);
+        DYNAMIC_THEN("the keys survive", idx) {
+          REQUIRE(dart::is_valid(merged.get_bytes()));
+          REQUIRE(merged.size() == obj.size() + 1);
+          REQUIRE(merged["z"].integer() == 3);
+          REQUIRE(merged["metric.cpu.1017"].integer() == 17);
+        }
+      }
+
+      DYNAMIC_WHEN("its encoding tag is changed to any other", idx) {
+        DYNAMIC_THEN("it fails to validate", idx) {
+          dart::each_foreign_encoding(obj.get_bytes(), [] (auto const* bytes, auto len) {
+            REQUIRE(!dart::is_valid(bytes, len));
+            REQUIRE_THROWS_AS(dart::validate(bytes, len), dart::validation_error);
+          });
+        }
+      }
+
+      DYNAMIC_WHEN("its keys stop sharing the prefix the vtable skips", idx) {
+        auto bytes = obj.get_bytes();
+        auto len = bytes.size();
+        std::shared_ptr<gsl::byte> dup(new gsl::byte[len], [] (auto* ptr) { delete[] ptr; });
+        std::copy(bytes.begin(), bytes.end(), dup.get());
+
+        // Rename one of the long keys so that it no longer starts with the shared prefix.
+        auto* raw = reinterpret_cast<char*>(dup.get());
+        auto* key = std::search(raw, raw + len, "metric.cpu.1039", "metric.cpu.1039" + 15);
+        REQUIRE(key != raw + len);
+        key[0] = 'n';
+
+        DYNAMIC_THEN("it fails to validate", idx) {
+          REQUIRE(!dart::is_valid(dup.get(), len));
+          REQUIRE_THROWS_AS(dart::validate(dup.get(), len), dart::validation_error);
+        }
+      }
+    });
+  }
+
+  GIVEN("an object whose namespaced keys sit alongside unrelated keys of the same length") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      // "ints" and "strs" share nothing, which mustn't stop the namespaced keys from being skipped over.
+      auto dyn = dart::heap::make_object("ints", 1, "strs", "two", "metric.x", 3);
+      for (auto i = 0; i < 40; ++i) dyn.add_field("metric.cpu." + std::to_string(1000 + i), i);
+      for (auto i = 0; i < 4; ++i) dyn.add_field("metric.cpu.idle" + std::to_string(i), -i);
+
+      auto opts = dart::finalize_options {};
+      opts.prefix = dart::prefix_policy::discriminating;
+      auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+      auto std_obj = dart::conversion_helper<pkt>(dyn.finalize());
+
+      DYNAMIC_WHEN("its size is compared against the standard encoding", idx) {
+        DYNAMIC_THEN("it still records a skip", idx) {
+          REQUIRE(obj.get_bytes().size() > std_obj.get_bytes().size());
+        }
+      }
+
+      DYNAMIC_WHEN("its keys are looked up", idx) {
+        DYNAMIC_THEN("every one of them is found", idx) {
+          REQUIRE(obj["ints"] == 1);
+          REQUIRE(obj["strs"] == "two");
+          REQUIRE(obj["metric.x"] == 3);
+          for (auto i = 0; i < 40; ++i) REQUIRE(obj["metric.cpu." + std::to_string(1000 + i)] == i);
+          for (auto i = 0; i < 4; ++i) REQUIRE(obj["metric.cpu.idle" + std::to_string(i)] == -i);
+          REQUIRE(obj == std_obj);
+        }
+      }
+
+      DYNAMIC_WHEN("absent keys of every length are looked up", idx) {
+        DYNAMIC_THEN("they are not found", idx) {
+          REQUIRE(obj["intz"].is_null());
+          REQUIRE(obj["atrs"].is_null());
+          REQUIRE(obj["metric.cpu.2000"].is_null());
+          REQUIRE(obj["metric.gpu.1000"].is_null());
+          REQUIRE(obj["metric.cpu.idle4"].is_null());
+          REQUIRE(obj["metric.gpu.idle0"].is_null());
+        }
+      }
+
+      DYNAMIC_WHEN("it is validated", idx) {
+        auto bytes = obj.get_bytes();
+        DYNAMIC_THEN("it is accepted", idx) {
+          REQUIRE(dart::is_valid(bytes));
+        }
+      }
+    });
+  }
+}
+
+SCENARIO("finalized objects can use compact offsets", "[object unit]") {
+  GIVEN("an object small enough to address with 16-bit offsets") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto dyn = dart::heap::make_object("id", 42, "name", "gadget", "price", 9.99, "ok", true);
+      dyn.add_field("nested", dart::heap::make_object("a", 1, "b", "two"));
+      dyn.add_field("list", dart::heap::make_array(1, "two", 3.0, dart::heap::null()));
+      for (auto i = 0; i < 20; ++i) dyn.add_field("field" + std::to_string(i), i);
+
+      auto opts = dart::finalize_options {};
+      opts.offsets = dart::offset_policy::automatic;
+      auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+      auto std_obj = dart::conversion_helper<pkt>(dyn.finalize());
+
+      DYNAMIC_WHEN("each key is looked up", idx) {
+        DYNAMIC_THEN("every value is found, and absent keys are not", idx) {
+          REQUIRE(dart::is_valid(obj.get_bytes()));
+          REQUIRE(obj.size() == std_obj.size());
+          REQUIRE(obj["id"].integer() == 42);
+          REQUIRE(obj["name"] == "gadget");
+          REQUIRE(obj["price"].decimal() == 9.99);
+          REQUIRE(obj["ok"].boolean());
+          REQUIRE(obj["nested"]["b"] == "two");
+          REQUIRE(obj["list"].size() == 4);
+          REQUIRE(obj["list"][1] == "two");
+          REQUIRE(obj["list"][3].is_null());
+          for (auto i = 0; i < 20; ++i) REQUIRE(obj["field" + std::to_string(i)].integer() == i);
+          REQUIRE(obj["field20"].is_null());
+          REQUIRE(obj["missing"].is_null());
+        }
+      }
+
+      DYNAMIC_WHEN("it is compared against the standard encoding", idx) {
+        DYNAMIC_THEN("it takes less space, but holds the same values", idx) {
+          REQUIRE(obj.get_bytes().size() < std_obj.get_bytes().size());
+          REQUIRE(obj == std_obj);
+          REQUIRE(std_obj == obj);
+          REQUIRE(obj == dyn);
+          REQUIRE(obj != dart::conversion_helper<pkt>(dart::heap::make_object("id", 42).finalize(opts)));
+        }
+      }
+
+      DYNAMIC_WHEN("it is iterated over", idx) {
+        auto keys = obj.keys();
+        auto std_keys = std_obj.keys();
+        DYNAMIC_THEN("it visits the same keys in the same order", idx) {
+          REQUIRE(keys.size() == std_keys.size());
+          for (auto i = 0U; i < keys.size(); ++i) REQUIRE(keys[i] == std_keys[i]);
+        }
+      }
+
+      DYNAMIC_WHEN("it is merged into another object", idx) {
+        auto base = dart::conversion_helper<pkt>(dart::heap::make_object("z", 3).finalize());
+        auto merged = base.deep_merge(obj);
+        DYNAMIC_THEN("the values survive", idx) {
+          REQUIRE(dart::is_valid(merged.get_bytes()));
+          REQUIRE(merged.size() == obj.size() + 1);
+          REQUIRE(merged["z"].integer() == 3);
+          REQUIRE(merged["nested"]["a"].integer() == 1);
+          REQUIRE(merged["field7"].integer() == 7);
+        }
+      }
+
+      DYNAMIC_WHEN("it has pairs injected into it", idx) {
+        // Injection lays out the standard encoding, which needs more space than either input.
+        auto injected = obj.inject("zz", 3, "id", 7);
+        DYNAMIC_THEN("the values survive", idx) {
+          REQUIRE(dart::is_valid(injected.get_bytes()));
+          REQUIRE(injected.size() == obj.size() + 1);
+          REQUIRE(injected["zz"].integer() == 3);
+          REQUIRE(injected["id"].integer() == 7);
+          REQUIRE(injected["field19"].integer() == 19);
+        }
+      }
+
+      DYNAMIC_WHEN("it is projected", idx) {
+        std::vector<std::string> keys;
+        for (auto i = 0; i < 20; ++i) keys.push_back("field" + std::to_string(i));
+        keys.push_back("nested");
+        auto projected = obj.project(keys);
+        DYNAMIC_THEN("the requested values survive", idx) {
+          REQUIRE(dart::is_valid(projected.get_bytes()));
+          REQUIRE(projected.size() == 21);
+          REQUIRE(projected["nested"]["a"].integer() == 1);
+          REQUIRE(projected["field0"].integer() == 0);
+          REQUIRE(projected["id"].is_null());
+        }
+      }
+
+      DYNAMIC_WHEN("its encoding tag is changed to any other", idx) {
+        DYNAMIC_THEN("it fails to validate", idx) {
+          dart::each_foreign_encoding(obj.get_bytes(), [] (auto const* bytes, auto len) {
+            REQUIRE(!dart::is_valid(bytes, len));
+            REQUIRE_THROWS_AS(dart::validate(bytes, len), dart::validation_error);
+          });
+        }
+      }
+    });
+  }
+
+  GIVEN("an object too large to address with 16-bit offsets") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto dyn = dart::heap::make_object("small", dart::heap::make_object("a", 1));
+      dyn.add_field("big", std::string(1 << 17, 'x'));
+
+      auto opts = dart::finalize_options {};
+      opts.offsets = dart::offset_policy::automatic;
+      auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+      auto std_obj = dart::conversion_helper<pkt>(dyn.finalize());
+
+      DYNAMIC_WHEN("it is finalized", idx) {
+        DYNAMIC_THEN("the outer object keeps the standard encoding", idx) {
+          REQUIRE(dart::is_valid(obj.get_bytes()));
+          REQUIRE(obj["big"].size() == (1U << 17));
+          REQUIRE(obj["small"]["a"].integer() == 1);
+          REQUIRE(obj == std_obj);
+        }
+      }
+    });
+  }
+}
+
+SCENARIO("finalized objects can use wide offsets", "[object unit]") {
+  GIVEN("an object finalized with 64-bit offsets") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      // Objects only need 64-bit offsets past 4GB, but the encoding can be forced for any object.
+      auto dyn = dart::heap::make_object("id", 42, "name", "gadget", "price", 9.99, "ok", true);
+      dyn.add_field("nested", dart::heap::make_object("a", 1, "b", "two"));
+      dyn.add_field("list", dart::heap::make_array(1, "two", 3.0, dart::heap::null()));
+      for (auto i = 0; i < 20; ++i) dyn.add_field("metric.cpu." + std::to_string(1000 + i), i);
+
+      auto opts = dart::finalize_options {};
+      opts.offsets = dart::offset_policy::wide;
+      auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+      auto std_obj = dart::conversion_helper<pkt>(dyn.finalize());
+      auto keyed_opts = opts;
+      keyed_opts.prefix = dart::prefix_policy::discriminating;
+      auto keyed_obj = dart::conversion_helper<pkt>(dyn.finalize(keyed_opts));
+
+      DYNAMIC_WHEN("each key is looked up", idx) {
+        DYNAMIC_THEN("every value is found, and absent keys are not", idx) {
+          for (auto const& curr : {obj, keyed_obj}) {
+            REQUIRE(dart::is_valid(curr.get_bytes()));
+            REQUIRE(curr.size() == std_obj.size());
+            REQUIRE(curr["id"].integer() == 42);
+            REQUIRE(curr["name"] == "gadget");
+            REQUIRE(curr["price"].decimal() == 9.99);
+            REQUIRE(curr["ok"].boolean());
+            REQUIRE(curr["nested"]["b"] == "two");
+            REQUIRE(curr["list"].size() == 4);
+            REQUIRE(curr["list"][1] == "two");
+            REQUIRE(curr["list"][3].is_null());
+            for (auto i = 0; i < 20; ++i) REQUIRE(curr["metric.cpu." + std::to_string(1000 + i)].integer() == i);
+            REQUIRE(curr["metric.cpu.2000"].is_null());
+            REQUIRE(curr["missing"].is_null());
+          }
+        }
+      }
+
+      DYNAMIC_WHEN("it is compared against the standard encoding", idx) {
+        DYNAMIC_THEN("it takes more space, but holds the same values", idx) {
+          REQUIRE(obj.get_bytes().size() > std_obj.get_bytes().size());
+          REQUIRE(keyed_obj.get_bytes().size() > obj.get_bytes().size());
+          REQUIRE(obj == std_obj);
+          REQUIRE(std_obj == obj);
+          REQUIRE(keyed_obj == obj);
+          REQUIRE(obj == keyed_obj);
+          REQUIRE(obj == dyn);
+          REQUIRE(obj != dart::conversion_helper<pkt>(dart::heap::make_object("id", 42).finalize(opts)));
+        }
+      }
+
+      DYNAMIC_WHEN("it is merged with other objects", idx) {
+        auto base = dart::conversion_helper<pkt>(dart::heap::make_object("z", 3).finalize());
+        auto merged = base.deep_merge(obj);
+        auto keyed_merged = base.deep_merge(keyed_obj);
+        auto injected = obj.inject("zz", 3, "id", 7);
+        DYNAMIC_THEN("the values survive", idx) {
+          REQUIRE(dart::is_valid(merged.get_bytes()));
+          REQUIRE(merged.size() == obj.size() + 1);
+          REQUIRE(merged["z"].integer() == 3);
+          REQUIRE(merged["nested"]["a"].integer() == 1);
+          REQUIRE(merged["metric.cpu.1007"].integer() == 7);
+          REQUIRE(dart::is_valid(keyed_merged.get_bytes()));
+          REQUIRE(keyed_merged == merged);
+          REQUIRE(dart::is_valid(injected.get_bytes()));
+          REQUIRE(injected["id"].integer() == 7);
+          REQUIRE(injected["metric.cpu.1019"].integer() == 19);
+        }
+      }
+
+      DYNAMIC_WHEN("its header is truncated", idx) {
+        // The wide header is 16 bytes, twice what every other encoding needs.
+        auto bytes = obj.get_bytes();
+        std::shared_ptr<gsl::byte> dup(new gsl::byte[bytes.size()], [] (auto* ptr) { delete[] ptr; });
+        std::copy(bytes.begin(), bytes.end(), dup.get());
+
+        DYNAMIC_THEN("it fails to validate", idx) {
+          REQUIRE(!dart::is_valid(dup.get(), 12));
+          REQUIRE_THROWS_AS(dart::validate(dup.get(), 12), dart::validation_error);
+          REQUIRE(!dart::is_valid(dup.get(), bytes.size() - 8));
+        }
+      }
+
+      DYNAMIC_WHEN("its encoding tag is changed to any other", idx) {
+        DYNAMIC_THEN("it fails to validate", idx) {
+          for (auto const& curr : {obj, keyed_obj}) {
+            dart::each_foreign_encoding(curr.get_bytes(), [] (auto const* bytes, auto len) {
+              REQUIRE(!dart::is_valid(bytes, len));
+              REQUIRE_THROWS_AS(dart::validate(bytes, len), dart::validation_error);
+            });
+          }
+        }
+      }
+
+      DYNAMIC_WHEN("its count is large enough to overflow the length of its vtable", idx) {
+        // 2^60 16-byte entries wrap the vtable length around to zero,
+        // and an empty object leaves no entries to fail the type check on before running off the end.
+        auto empty = dart::conversion_helper<pkt>(dart::heap::make_object().finalize(opts));
+        auto bytes = empty.get_bytes();
+        std::shared_ptr<gsl::byte> dup(new gsl::byte[bytes.size()], [] (auto* ptr) { delete[] ptr; });
+        std::copy(bytes.begin(), bytes.end(), dup.get());
+        auto const count = uint64_t {1} << 60U;
+        for (auto i = 0U; i < sizeof(count); ++i) dup.get()[8 + i] = static_cast<gsl::byte>(count >> (i * 8));
+
+        DYNAMIC_THEN("it fails to validate without reading past the buffer", idx) {
+          REQUIRE(!dart::is_valid(dup.get(), bytes.size()));
+          REQUIRE_THROWS_AS(dart::validate(dup.get(), bytes.size()), dart::validation_error);
+        }
+      }
+    });
+  }
+
+  GIVEN("an object header with more fields than the standard header can count") {
+    // No test can afford half a billion fields, but the header can be written without them.
+    alignas(dart::detail::object<std::shared_ptr>::alignment) gsl::byte storage[sizeof(dart::detail::wide_header)] {};
+    auto* obj = reinterpret_cast<dart::detail::object<std::shared_ptr>*>(storage);
+    auto const count = (size_t {1} << 29U) + 42;
+
+    WHEN("it is switched to the wide encoding") {
+      obj->set_format(dart::detail::layout_format::wide, count);
+      THEN("it keeps the whole count") {
+        REQUIRE(obj->format() == dart::detail::layout_format::wide);
+        REQUIRE(obj->size() == count);
+      }
+    }
+  }
+}
+
+SCENARIO("finalized objects can be keyed against a shared dictionary", "[object unit]") {
+  GIVEN("an object finalized against a dictionary of most of its keys") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      dart::key_dictionary dict {"host", "region", "cpu.user", "cpu.sys", "mem", "ts", "tags", "a"};
+      auto dyn = dart::heap::make_object("host", "web-12", "region", "us-east", "cpu.user", 0.25);
+      dyn.add_field("cpu.sys", 0.125).add_field("mem", 4096).add_field("ts", 1234567890);
+      dyn.add_field("tags", dart::heap::make_array("prod", dart::heap::make_object("a", 1, "b", 2)));
+      dyn.add_field("nested", dart::heap::make_object("a", true, "unlisted", dart::heap::null()));
+      dyn.add_field("extra", "inline");
+
+      auto opts = dart::finalize_options {};
+      opts.dictionary = dict;
+      auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+      auto std_obj = dart::conversion_helper<pkt>(dyn.finalize());
+
+      DYNAMIC_WHEN("each key is looked up", idx) {
+        DYNAMIC_THEN("keys the dictionary contains, and keys it doesn't, are all found", idx) {
+          REQUIRE(obj.size() == std_obj.size());
+          REQUIRE(obj["host"] == "web-12");
+          REQUIRE(obj["region"] == "us-east");
+          REQUIRE(obj["cpu.user"].decimal() == 0.25);
+          REQUIRE(obj["cpu.sys"].decimal() == 0.125);
+          REQUIRE(obj["mem"].integer() == 4096);
+          REQUIRE(obj["ts"].integer() == 1234567890);
+          REQUIRE(obj["tags"][0] == "prod");
+          REQUIRE(obj["tags"][1]["b"].integer() == 2);
+          REQUIRE(obj["nested"]["a"].boolean());
+          REQUIRE(obj["nested"].has_key("unlisted"));
+          REQUIRE(obj["extra"] == "inline");
+          REQUIRE(obj["missing"].is_null());
+          REQUIRE(!obj.has_key("cpu"));
+        }
+      }
+
+      DYNAMIC_WHEN("keys are resolved against the dictionary ahead of time", idx) {
+        auto mem = dict.lookup("mem");
+        auto region = dict.lookup("region");
+        DYNAMIC_THEN("they find the same values, in any object", idx) {
+          REQUIRE(mem.strv() == "mem");
+          REQUIRE(obj[mem].integer() == 4096);
+          REQUIRE(obj[region] == "us-east");
+          REQUIRE(std_obj[mem].integer() == 4096);
+          REQUIRE(obj["nested"][dict.lookup("a")].boolean());
+          REQUIRE(obj["tags"][1][dict.lookup("a")].integer() == 1);
+          REQUIRE(obj[dart::key_dictionary {"mem"}.lookup("mem")].integer() == 4096);
+          REQUIRE_THROWS_AS(dict.lookup("extra"), std::out_of_range);
+        }
+      }
+
+      DYNAMIC_WHEN("it is iterated over", idx) {
+        std::vector<std::string> keys;
+        for (auto it = obj.key_begin(); it != obj.key_end(); ++it) keys.emplace_back((*it).str());
+        DYNAMIC_THEN("it visits every key, dictionary keys first", idx) {
+          REQUIRE(keys.size() == obj.size());
+          REQUIRE(keys.back() == "nested");
+          REQUIRE(std::find(keys.begin(), keys.end(), "cpu.user") != keys.end());
+          for (auto const& key : keys) REQUIRE(obj[key] == std_obj[key]);
+        }
+      }
+
+      DYNAMIC_WHEN("it is compared against the standard encoding", idx) {
+        DYNAMIC_THEN("it takes less space, but holds the same values", idx) {
+          REQUIRE(obj.get_bytes().size() < std_obj.get_bytes().size());
+          REQUIRE(obj == std_obj);
+          REQUIRE(std_obj == obj);
+          REQUIRE(obj == dyn);
+          REQUIRE(obj != dart::conversion_helper<pkt>(dart::heap::make_object("host", "web-12").finalize(opts)));
+        }
+      }
+
+      DYNAMIC_WHEN("it is validated", idx) {
+        DYNAMIC_THEN("it is only valid alongside the same dictionary", idx) {
+          REQUIRE(dart::is_valid(obj.get_bytes(), dict));
+          REQUIRE(!dart::is_valid(obj.get_bytes()));
+          REQUIRE_THROWS_AS(dart::validate(obj.get_bytes()), dart::validation_error);
+          REQUIRE(!dart::is_valid(obj.get_bytes(), dart::key_dictionary {"host", "region"}));
+          REQUIRE(dart::is_valid(std_obj.get_bytes(), dict));
+        }
+      }
+
+      DYNAMIC_WHEN("it is reconstituted from its bytes", idx) {
+        auto bytes = obj.get_bytes();
+        dart::buffer copy(bytes, dict);
+        DYNAMIC_THEN("it needs its dictionary to do so", idx) {
+          REQUIRE(copy == obj);
+          REQUIRE(copy.dictionary() == dict);
+          REQUIRE(copy["extra"] == "inline");
+          REQUIRE_THROWS_AS(dart::buffer(bytes), std::invalid_argument);
+          REQUIRE_THROWS_AS(dart::buffer(bytes, dart::key_dictionary {"host"}), std::invalid_argument);
+          REQUIRE(dart::buffer::transmogrify<dart::unsafe_ptr>(copy) == obj);
+        }
+      }
+
+      DYNAMIC_WHEN("it is merged, injected into, projected, or embedded in another object", idx) {
+        auto base = dart::conversion_helper<pkt>(dart::heap::make_object("z", 3).finalize());
+        auto merged = base.deep_merge(obj);
+        auto injected = obj.inject("zz", 3, "mem", 7);
+        auto projected = obj.project({"host", "extra"});
+        auto embedded = dart::buffer::make_object("inner", obj);
+        DYNAMIC_THEN("the values survive", idx) {
+          REQUIRE(dart::is_valid(merged.get_bytes(), dict));
+          REQUIRE(merged.size() == obj.size() + 1);
+          REQUIRE(merged["z"].integer() == 3);
+          REQUIRE(merged["host"] == "web-12");
+          REQUIRE(merged["nested"]["a"].boolean());
+          REQUIRE(dart::is_valid(injected.get_bytes(), dict));
+          REQUIRE(injected["mem"].integer() == 7);
+          REQUIRE(injected["zz"].integer() == 3);
+          REQUIRE(projected.size() == 2);
+          REQUIRE(projected["extra"] == "inline");
+          REQUIRE(dart::is_valid(embedded.get_bytes()));
+          REQUIRE(embedded["inner"] == obj);
+        }
+      }
+
+      DYNAMIC_WHEN("its encoding tag is changed to any other", idx) {
+        DYNAMIC_THEN("it fails to validate, even alongside its dictionary", idx) {
+          dart::each_foreign_encoding(obj.get_bytes(), [&] (auto const* bytes, auto len) {
+            REQUIRE(!dart::is_valid(gsl::make_span(bytes, len), dict));
+            REQUIRE_THROWS_AS(dart::validate(gsl::make_span(bytes, len), dict), dart::validation_error);
+          });
+        }
+      }
+    });
+  }
+
+  GIVEN("a dictionary") {
+    WHEN("it is constructed from duplicate keys") {
+      dart::key_dictionary dict {"b", "a", "b"};
+      THEN("each key is only stored once") {
+        REQUIRE(dict.size() == 2);
+        REQUIRE(dict.contains("a"));
+        REQUIRE(!dict.contains("c"));
+        REQUIRE(dict == dart::key_dictionary {"a", "b"});
+        REQUIRE(dict != dart::key_dictionary {"a", "c"});
+      }
+    }
+
+    WHEN("an object has no keys in common with it") {
+      auto opts = dart::finalize_options {};
+      opts.dictionary = dart::key_dictionary {"unused"};
+      auto obj = dart::heap::make_object("a", 1, "b", dart::heap::make_object()).finalize(opts);
+      THEN("every key is stored inline") {
+        REQUIRE(obj["a"].integer() == 1);
+        REQUIRE(obj["b"].size() == 0);
+        REQUIRE(dart::is_valid(obj.get_bytes(), opts.dictionary));
+      }
+    }
+
+    WHEN("an object with repeated values is finalized against it, sharing strings") {
+      dart::key_dictionary dict {"a", "b", "c"};
+      auto dyn = dart::heap::make_object("a", "a repeated value", "b", "a repeated value", "c", 1);
+      dyn.add_field("d", "a repeated value");
+      auto opts = dart::finalize_options {};
+      opts.dictionary = dict;
+      auto plain = dyn.finalize(opts);
+      opts.strings = dart::string_policy::shared;
+      auto shared = dyn.finalize(opts);
+      THEN("keys the dictionary contains share their values") {
+        REQUIRE(shared.get_bytes().size() < plain.get_bytes().size());
+        REQUIRE(shared == plain);
+        REQUIRE(shared[dict.lookup("b")] == "a repeated value");
+        REQUIRE(shared["d"] == "a repeated value");
+        REQUIRE(dart::is_valid(shared.get_bytes(), dict));
+      }
+    }
+  }
+}
+
+SCENARIO("finalized objects can share repeated strings", "[object unit]") {
+  GIVEN("an object of repeated strings finalized with the shared string policy") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto const degraded = "degraded since the last deploy";
+      auto const healthy = "healthy and serving traffic";
+      auto dyn = dart::heap::make_object("short", "ok", "unit", "ok", "count", 1);
+      dyn.add_field("nested", dart::heap::make_object("status", degraded));
+      for (auto i = 0; i < 32; ++i) dyn.add_field("host.status." + std::to_string(i), i % 3 ? healthy : degraded);
+
+      std::vector<dart::finalize_options> options(4);
+      options[1].offsets = dart::offset_policy::automatic;
+      options[2].offsets = dart::offset_policy::wide;
+      options[3].prefix = dart::prefix_policy::discriminating;
+
+      DYNAMIC_WHEN("it is finalized in every encoding", idx) {
+        DYNAMIC_THEN("it takes less space, but holds the same values", idx) {
+          for (auto opts : options) {
+            auto plain = dart::conversion_helper<pkt>(dyn.finalize(opts));
+            opts.strings = dart::string_policy::shared;
+            auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+            REQUIRE(obj.get_bytes().size() < plain.get_bytes().size());
+            REQUIRE(dart::is_valid(obj.get_bytes()));
+            REQUIRE(obj == plain);
+            REQUIRE(plain == obj);
+            REQUIRE(obj == dyn);
+            for (auto i = 0; i < 32; ++i) {
+              REQUIRE(obj["host.status." + std::to_string(i)] == (i % 3 ? healthy : degraded));
+            }
+            REQUIRE(obj["short"] == "ok");
+            REQUIRE(obj["unit"] == "ok");
+            REQUIRE(obj["count"].integer() == 1);
+            REQUIRE(obj["nested"]["status"] == degraded);
+            REQUIRE(!obj["host.status.32"]);
+
+            // Repeats point at the same bytes, but strings too short to be worth it,
+            // and strings in other aggregates, are laid out again.
+            REQUIRE(obj["host.status.3"].str() == obj["host.status.0"].str());
+            REQUIRE(obj["host.status.31"].str() == obj["host.status.1"].str());
+            REQUIRE(obj["unit"].str() != obj["short"].str());
+            REQUIRE(obj["nested"]["status"].str() != obj["host.status.0"].str());
+          }
+        }
+      }
+
+      DYNAMIC_WHEN("it is merged, injected into, projected, or embedded in another object", idx) {
+        auto opts = dart::finalize_options {};
+        opts.strings = dart::string_policy::shared;
+        auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+        auto base = dart::conversion_helper<pkt>(dart::heap::make_object("z", 3).finalize());
+        auto merged = base.deep_merge(obj);
+        auto injected = obj.inject("zz", 3);
+        auto projected = obj.project({"host.status.0", "host.status.3"});
+        auto embedded = dart::buffer::make_object("inner", obj);
+        DYNAMIC_THEN("the values survive", idx) {
+          REQUIRE(dart::is_valid(merged.get_bytes()));
+          REQUIRE(merged.size() == obj.size() + 1);
+          REQUIRE(merged["host.status.3"] == degraded);
+          REQUIRE(dart::is_valid(injected.get_bytes()));
+          REQUIRE(injected["host.status.4"] == healthy);
+          REQUIRE(injected["zz"].integer() == 3);
+          REQUIRE(dart::is_valid(projected.get_bytes()));
+          REQUIRE(projected.size() == 2);
+          REQUIRE(projected["host.status.3"] == degraded);
+          REQUIRE(dart::is_valid(embedded.get_bytes()));
+          REQUIRE(embedded["inner"] == obj);
+          REQUIRE(embedded["inner"]["host.status.3"] == degraded);
+        }
+      }
+
+      DYNAMIC_WHEN("a shared value is pointed somewhere other than an earlier string", idx) {
+        auto opts = dart::finalize_options {};
+        opts.strings = dart::string_policy::shared;
+        auto obj = dart::conversion_helper<pkt>(dyn.finalize(opts));
+        auto bytes = obj.get_bytes();
+        std::vector<gsl::byte> copy(bytes.begin(), bytes.end());
+
+        // The offset of the earlier copy follows the key, aligned like the offsets of the vtable,
+        // which directly follows the header, and starts each entry with the offset of its key.
+        std::string const raw(reinterpret_cast<char const*>(bytes.data()), bytes.size());
+        auto const key = raw.find(std::string("host.status.3", 14)) - sizeof(uint16_t);
+        auto const slot = (key + sizeof(uint16_t) + 14 + 3) & ~size_t(3);
+        size_t entry = 8;
+        auto const vtable_end = entry + obj.size() * sizeof(dart::detail::object_entry);
+        for (; entry < vtable_end; entry += sizeof(dart::detail::object_entry)) {
+          uint32_t offset;
+          std::memcpy(&offset, bytes.data() + entry, sizeof(offset));
+          if (offset == key) break;
+        }
+        auto const set_slot = [&] (uint32_t offset) {
+          auto tmp = copy;
+          std::memcpy(tmp.data() + slot, &offset, sizeof(offset));
+          return tmp;
+        };
+
+        DYNAMIC_THEN("it fails validation", idx) {
+          uint32_t earlier;
+          std::memcpy(&earlier, bytes.data() + slot, sizeof(earlier));
+          auto const* first = reinterpret_cast<gsl::byte const*>(obj["host.status.0"].str()) - sizeof(uint16_t);
+          REQUIRE(entry < vtable_end);
+          REQUIRE(earlier == static_cast<uint32_t>(first - bytes.data()));
+          REQUIRE(static_cast<unsigned char>(bytes[entry + 4]) & 0x80);
+          REQUIRE(dart::is_valid(gsl::make_span(copy)));
+
+          // Forwards, at itself, or out of bounds.
+          REQUIRE_FALSE(dart::is_valid(gsl::make_span(set_slot(static_cast<uint32_t>(slot)))));
+          REQUIRE_FALSE(dart::is_valid(gsl::make_span(set_slot(static_cast<uint32_t>(bytes.size())))));
+          REQUIRE_FALSE(dart::is_valid(gsl::make_span(set_slot(0))));
+
+          // At something that isn't a string.
+          auto retyped = copy;
+          retyped[entry + 4] = static_cast<gsl::byte>(0x80 | static_cast<unsigned char>(dart::detail::raw_type::integer));
+          REQUIRE_FALSE(dart::is_valid(gsl::make_span(retyped)));
+          REQUIRE_THROWS_AS(dart::validate(gsl::make_span(retyped)), dart::validation_error);
+        }
+      }
+    });
+  }
+}
+
 SCENARIO("object keys are unique", "[object unit]") {
   GIVEN("a desire to test finalized objects") {
     dart::buffer_api_test([] (auto tag, auto idx) {
@@ -1181,6 +1940,187 @@ SCENARIO("objects can inject additional keys", "[object unit]") {
       }
     });
   }
+
+  GIVEN("a finalized object whose keys share lengths and prefixes") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      std::string long_a(300, 'a'), long_b(300, 'a');
+      long_b.back() = 'b';
+      std::string high_a = "k\xC3\xA9", high_b = "k\x7F\x01";
+      auto obj = pkt::make_object("ab", 1, "ac", 2, long_a, 3, high_b, 4).finalize();
+
+      DYNAMIC_WHEN("overlapping pairs are injected", idx) {
+        auto injected = obj.inject("ac", "two", long_a, "three", long_b, 5, high_a, 6, "ad", 7);
+        auto expected = pkt::make_object("ab", 1, "ac", "two", "ad", 7,
+            long_a, "three", long_b, 5, high_a, 6, high_b, 4).finalize();
+
+        DYNAMIC_THEN("duplicates are collapsed and the layout matches a fresh build", idx) {
+          REQUIRE(injected.size() == 7U);
+          REQUIRE(injected == expected);
+          auto bytes = injected.get_bytes(), expected_bytes = expected.get_bytes();
+          REQUIRE(bytes.size() == expected_bytes.size());
+          REQUIRE(std::memcmp(bytes.data(), expected_bytes.data(), bytes.size()) == 0);
+        }
+      }
+    });
+  }
+}
+
+SCENARIO("finalized objects can be merged in bulk", "[object unit]") {
+  GIVEN("several layered objects") {
+    dart::buffer_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto defaults = pkt::make_object("region", "us", "timeout", 30, "retries", 3, "debug", false).finalize();
+      auto region = pkt::make_object("region", "eu", "endpoint", "eu.example.com").finalize();
+      auto tenant = pkt::make_object("timeout", 60, "tenant", "acme", "a", nullptr).finalize();
+      auto request = pkt::make_object("debug", true, "timeout", 5, "zzzzzzzzzzzzzzzzzzz", 2.5).finalize();
+
+      DYNAMIC_WHEN("they are merged together", idx) {
+        auto merged = pkt::merge({defaults, region, tenant, request});
+        auto chained = defaults.inject("region", "eu", "endpoint", "eu.example.com")
+          .inject("timeout", 60, "tenant", "acme", "a", nullptr)
+          .inject("debug", true, "timeout", 5, "zzzzzzzzzzzzzzzzzzz", 2.5);
+
+        DYNAMIC_THEN("later objects take precedence", idx) {
+          REQUIRE(merged.size() == 8U);
+          REQUIRE(merged["region"] == "eu");
+          REQUIRE(merged["timeout"] == 5);
+          REQUIRE(merged["retries"] == 3);
+          REQUIRE(merged["debug"] == true);
+          REQUIRE(merged["endpoint"] == "eu.example.com");
+          REQUIRE(merged["tenant"] == "acme");
+          REQUIRE(merged["a"] == nullptr);
+          REQUIRE(merged["zzzzzzzzzzzzzzzzzzz"].decimal() == Approx(2.5));
+        }
+
+        DYNAMIC_THEN("the result is identical to chaining injections", idx) {
+          REQUIRE(merged == chained);
+          auto bytes = merged.get_bytes(), chained_bytes = chained.get_bytes();
+          REQUIRE(bytes.size() == chained_bytes.size());
+          REQUIRE(std::memcmp(bytes.data(), chained_bytes.data(), bytes.size()) == 0);
+        }
+      }
+
+      DYNAMIC_WHEN("a single object is merged", idx) {
+        auto merged = pkt::merge({region});
+        DYNAMIC_THEN("it results in the original object", idx) {
+          REQUIRE(merged == region);
+        }
+      }
+
+      DYNAMIC_WHEN("nothing is merged", idx) {
+        auto merged = pkt::merge(gsl::span<pkt const> {});
+        DYNAMIC_THEN("it results in an empty object", idx) {
+          REQUIRE(merged.is_object());
+          REQUIRE(merged.size() == 0U);
+          REQUIRE(merged == pkt::make_object().finalize());
+        }
+      }
+
+      DYNAMIC_WHEN("a non-object is merged", idx) {
+        auto retries = defaults["retries"];
+        DYNAMIC_THEN("it refuses", idx) {
+          REQUIRE_THROWS_AS(pkt::merge({defaults, retries}), dart::type_error);
+        }
+      }
+    });
+  }
+}
+
+SCENARIO("objects can be merged recursively", "[object unit]") {
+  GIVEN("an object with nested objects") {
+    dart::api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto base = pkt::make_object(
+        "name", "server",
+        "limits", pkt::make_object("cpu", 2, "memory", 512, "disk", pkt::make_object("size", 10, "kind", "ssd")),
+        "tags", pkt::make_object("env", "prod"),
+        "replicas", 3
+      );
+
+      DYNAMIC_WHEN("an overlay with overlapping nested objects is merged", idx) {
+        auto overlay = pkt::make_object(
+          "limits", pkt::make_object("memory", 1024, "disk", pkt::make_object("kind", "nvme"), "gpu", 1),
+          "tags", "none",
+          "replicas", pkt::make_object("min", 1, "max", 5),
+          "owner", "ops"
+        );
+        auto merged = base.deep_merge(overlay);
+
+        DYNAMIC_THEN("nested objects are combined key by key", idx) {
+          REQUIRE(merged.size() == 5U);
+          REQUIRE(merged["name"] == "server");
+          REQUIRE(merged["owner"] == "ops");
+          REQUIRE(merged["limits"].size() == 4U);
+          REQUIRE(merged["limits"]["cpu"] == 2);
+          REQUIRE(merged["limits"]["memory"] == 1024);
+          REQUIRE(merged["limits"]["gpu"] == 1);
+          REQUIRE(merged["limits"]["disk"]["size"] == 10);
+          REQUIRE(merged["limits"]["disk"]["kind"] == "nvme");
+        }
+
+        DYNAMIC_THEN("non-object values in the overlay replace whatever was there", idx) {
+          REQUIRE(merged["tags"] == "none");
+          REQUIRE(merged["replicas"]["min"] == 1);
+          REQUIRE(merged["replicas"]["max"] == 5);
+        }
+
+        DYNAMIC_THEN("the original object is unchanged", idx) {
+          REQUIRE(base.size() == 4U);
+          REQUIRE(base["limits"]["memory"] == 512);
+          REQUIRE(base["limits"]["disk"]["kind"] == "ssd");
+          REQUIRE(base["tags"]["env"] == "prod");
+        }
+      }
+
+      DYNAMIC_WHEN("an empty object is merged", idx) {
+        auto merged = base.deep_merge(pkt::make_object());
+        DYNAMIC_THEN("it results in the original object", idx) {
+          REQUIRE(merged == base);
+        }
+      }
+
+      DYNAMIC_WHEN("a non-object is merged", idx) {
+        DYNAMIC_THEN("it refuses", idx) {
+          REQUIRE_THROWS_AS(base.deep_merge(base["replicas"]), dart::type_error);
+        }
+      }
+    });
+  }
+
+  GIVEN("a finalized object with nested objects") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto base = pkt::make_object(
+        "a", pkt::make_object("b", pkt::make_object("c", 1, "dd", "two"), "e", 3.5),
+        "f", true
+      ).finalize();
+      auto overlay = pkt::make_object(
+        "a", pkt::make_object("b", pkt::make_object("c", "one", "ggg", 4), "hhhh", nullptr),
+        "i", 5
+      ).finalize();
+
+      DYNAMIC_WHEN("they are merged", idx) {
+        auto merged = base.deep_merge(overlay);
+        auto expected = pkt::make_object(
+          "a", pkt::make_object("b", pkt::make_object("c", "one", "dd", "two", "ggg", 4), "e", 3.5, "hhhh", nullptr),
+          "f", true,
+          "i", 5
+        ).finalize();
+
+        DYNAMIC_THEN("the layout is identical to finalizing the merged result", idx) {
+          REQUIRE(merged == expected);
+          auto bytes = merged.get_bytes(), expected_bytes = expected.get_bytes();
+          REQUIRE(bytes.size() == expected_bytes.size());
+          REQUIRE(std::memcmp(bytes.data(), expected_bytes.data(), bytes.size()) == 0);
+        }
+      }
+    });
+  }
 }
 
 SCENARIO("objects can project a subset of keys", "[object unit]") {
@@ -1239,6 +2179,124 @@ SCENARIO("objects can project a subset of keys", "[object unit]") {
       }
     });
   }
+
+  GIVEN("a finalized object") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto obj = pkt::make_object("pi", 3.14159, "c", 2.99792f, "truth", true, "lies", false).finalize();
+
+      DYNAMIC_WHEN("far more keys are requested than the object contains", idx) {
+        std::vector<std::string> requested {"pi", "truth"};
+        for (auto i = 0; i < 256; ++i) requested.push_back("missing" + std::to_string(i));
+        auto projected = obj.project(requested);
+        auto expected = pkt::make_object("pi", 3.14159, "truth", true).finalize();
+
+        DYNAMIC_THEN("only the present keys are laid out", idx) {
+          REQUIRE(projected == expected);
+          auto bytes = projected.get_bytes(), expected_bytes = expected.get_bytes();
+          REQUIRE(bytes.size() == expected_bytes.size());
+          REQUIRE(std::memcmp(bytes.data(), expected_bytes.data(), bytes.size()) == 0);
+        }
+      }
+    });
+  }
+}
+
+SCENARIO("finalized objects can safely reuse memory", "[object unit]") {
+  GIVEN("a finalized object") {
+    dart::finalized_api_test([] (auto tag, auto idx) {
+      using pkt = typename decltype(tag)::type;
+
+      auto obj = pkt::make_object("a", 1, "bb", "two", "ccc", 3.0, "dddd", true).finalize();
+      auto bytes = obj.get_bytes();
+      std::vector<gsl::byte> original {std::begin(bytes), std::end(bytes)};
+
+      DYNAMIC_WHEN("a similarly sized object is built, released, and the original is rebuilt", idx) {
+        {
+          auto noise = pkt::make_object("zz", "zzzzzzzzzzzzzz", "yy", 0xFFFFFFFFLL, "x", -1.0).finalize();
+          auto injected = noise.inject("w", "wwwwwwwwwwwwwwww");
+          auto projected = injected.project({"zz", "w"});
+        }
+        pkt rebuilt = pkt::make_object("a", 1, "bb", "two", "ccc", 3.0, "dddd", true).finalize();
+        auto merged = obj.inject("bb", "two");
+        auto projected = merged.project({"a", "bb", "ccc", "dddd"});
+
+        DYNAMIC_THEN("every rebuild is bitwise identical to the original", idx) {
+          for (auto& other : {rebuilt, merged, projected}) {
+            auto other_bytes = other.get_bytes();
+            REQUIRE(other_bytes.size() == original.size());
+            REQUIRE(std::memcmp(other_bytes.data(), original.data(), original.size()) == 0);
+            REQUIRE(other == obj);
+          }
+        }
+      }
+
+      DYNAMIC_WHEN("an object is finalized on one thread and released on another", idx) {
+        auto copy = obj.inject("eeeee", "five");
+        std::thread worker([held = std::move(copy)] () mutable { held = pkt::make_null(); });
+        worker.join();
+        auto again = obj.inject("eeeee", "five");
+
+        DYNAMIC_THEN("subsequent finalizations are unaffected", idx) {
+          REQUIRE(again.size() == 5U);
+          REQUIRE(again["eeeee"] == "five");
+          REQUIRE(again.project({"a", "bb", "ccc", "dddd"}) == obj);
+        }
+      }
+    });
+  }
+
+  GIVEN("a dynamic object containing nested aggregates") {
+    auto build = [] {
+      auto arr = dart::heap::make_array(1, "two", 3.0, false, nullptr, dart::heap::make_array("x"));
+      auto nested = dart::heap::make_object("e", arr, "fffff", 6, "gg", dart::heap::make_object("h", "i"));
+      return dart::heap::make_object("a", arr, "bbb", nested, "cc", "ccc", "d", 4.5);
+    };
+    auto original = build().finalize();
+
+    WHEN("it is finalized again after unrelated memory has been released") {
+      for (auto i = 0; i < 16; ++i) {
+        auto noise = dart::heap::make_object("zzzzzzz", dart::heap::make_array(i, "zzz", i * 1.5));
+        auto buf = noise.finalize();
+      }
+      auto again = build().finalize();
+
+      THEN("all padding is zeroed and the buffers are bitwise identical") {
+        auto lhs = original.get_bytes(), rhs = again.get_bytes();
+        REQUIRE(lhs.size() == rhs.size());
+        REQUIRE(std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+      }
+    }
+  }
+
+#ifdef DART_USE_BUFFER_POOL
+  GIVEN("a thread-caching buffer pool") {
+    dart::detail::buffer_pool::trim();
+    WHEN("a finalized object is released") {
+      gsl::byte const* first;
+      {
+        auto obj = dart::heap::make_object("hello", "world").finalize();
+        first = obj.get_bytes().data();
+      }
+
+      THEN("its memory is cached, and handed back out for the next finalization") {
+        REQUIRE(dart::detail::buffer_pool::cached_bytes() > 0U);
+        auto obj = dart::heap::make_object("howdy", "earth").finalize();
+        REQUIRE(obj.get_bytes().data() == first);
+        REQUIRE(obj["howdy"] == "earth");
+      }
+    }
+
+    WHEN("the pool is trimmed") {
+      { auto obj = dart::heap::make_object("hello", "world").finalize(); }
+      dart::detail::buffer_pool::trim();
+      THEN("it no longer holds onto any memory") {
+        REQUIRE(dart::detail::buffer_pool::cached_bytes() == 0U);
+      }
+    }
+  }
+#endif
 }
 
 SCENARIO("objects can be embedded inside each other", "[object unit]") {
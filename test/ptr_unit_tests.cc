@@ -1,3 +1,9 @@
+/*----- System Includes -----*/
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
 /*----- Local Includes -----*/
 
 #include "dart_tests.h"
@@ -581,3 +587,298 @@ SCENARIO("skinny array pointers can use subscript indexing", "[pointer unit]") {
     }
   }
 }
+
+SCENARIO("biased pointers can share contents across multiple instance", "[pointer unit]") {
+  GIVEN("a biased pointer with some contents") {
+    auto ptr = dart::make_biased<dart::packet>(dart::packet::object("hello", "world"));
+
+    WHEN("the pointer is copied") {
+      auto copy = ptr;
+      THEN("ownership is shared between the instances") {
+        REQUIRE(copy.get() == ptr.get());
+        REQUIRE(copy.use_count() == 2);
+        REQUIRE_FALSE(copy.unique());
+        REQUIRE((*copy)["hello"] == "world");
+      }
+
+      WHEN("the original pointer is reset") {
+        ptr.reset();
+        THEN("it relinquishes shared ownership") {
+          REQUIRE(ptr.get() == nullptr);
+          REQUIRE(copy.use_count() == 1);
+          REQUIRE(copy.unique());
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("biased pointers can be shared across threads", "[pointer unit]") {
+  struct tracked {
+    tracked(std::atomic<int>& live) : live(live) {
+      ++live;
+    }
+    ~tracked() {
+      --live;
+    }
+    std::atomic<int>& live;
+  };
+
+  GIVEN("a biased pointer owned by the current thread") {
+    std::atomic<int> live {0};
+    auto ptr = dart::make_biased<tracked>(live);
+
+    WHEN("the only reference is handed off and released on another thread") {
+      std::thread worker([held = std::move(ptr)] () mutable { held.reset(); });
+      worker.join();
+
+      // The count lives entirely in our half, so the other thread has to settle it.
+      THEN("the object is destroyed immediately") {
+        REQUIRE(live == 0);
+      }
+    }
+
+    WHEN("several copies are handed off and released on another thread") {
+      std::vector<dart::biased_ptr<tracked>> copies(4, ptr);
+      ptr.reset();
+      std::thread worker([held = std::move(copies)] () mutable { held.clear(); });
+      worker.join();
+
+      THEN("the object is destroyed without this thread releasing anything else") {
+        REQUIRE(live == 0);
+      }
+    }
+
+    WHEN("copies are released concurrently on the owning thread and another thread") {
+      for (auto i = 0; i < 1000; ++i) {
+        auto obj = dart::make_biased<tracked>(live);
+        std::vector<dart::biased_ptr<tracked>> copies(4, obj);
+        std::thread worker([held = std::move(copies)] () mutable { held.clear(); });
+        obj.reset();
+        worker.join();
+      }
+      ptr.reset();
+
+      THEN("every object is destroyed exactly once") {
+        REQUIRE(live == 0);
+      }
+    }
+
+    WHEN("copies are made and released on many threads at once") {
+      std::vector<std::thread> workers;
+      for (auto i = 0; i < 8; ++i) {
+        workers.emplace_back([held = ptr] {
+          for (auto j = 0; j < 1000; ++j) {
+            auto copy = held;
+            (void) copy;
+          }
+        });
+      }
+      for (auto& worker : workers) worker.join();
+      THEN("the count is exact once they've finished") {
+        REQUIRE(ptr.use_count() == 1);
+        ptr.reset();
+        REQUIRE(live == 0);
+      }
+    }
+
+    WHEN("the owning thread exits before the last reference is released") {
+      dart::biased_ptr<tracked> orphan;
+      std::thread owner([&] { orphan = dart::make_biased<tracked>(live); });
+      owner.join();
+      orphan.reset();
+      ptr.reset();
+      THEN("the object is still destroyed") {
+        REQUIRE(live == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("biased packets can be used like any other packet", "[pointer unit]") {
+  GIVEN("a finalized biased packet") {
+    auto obj = dart::biased_packet::make_object("hello", "world", "nested", dart::biased_packet::make_object("a", 1));
+    obj.finalize();
+
+    WHEN("the packet is copied onto another thread") {
+      dart::biased_packet seen;
+      std::thread worker([&seen, copy = obj] { seen = copy["nested"]; });
+      worker.join();
+      THEN("the copy is fully usable") {
+        REQUIRE(seen["a"] == 1);
+        REQUIRE(obj["hello"] == "world");
+      }
+    }
+  }
+}
+
+SCENARIO("pointers made in place manage the lifetime of their contents", "[pointer unit]") {
+  struct tracked {
+    tracked(std::atomic<int>& live, bool fail) : live(live) {
+      if (fail) throw std::runtime_error("construction failed");
+      ++live;
+    }
+    ~tracked() {
+      --live;
+    }
+    std::atomic<int>& live;
+  };
+
+  GIVEN("an unsafe pointer made in place") {
+    std::atomic<int> live {0};
+    auto ptr = dart::make_unsafe<tracked>(live, false);
+
+    WHEN("the pointer is copied and released") {
+      auto copy = ptr;
+      REQUIRE(live == 1);
+      REQUIRE(copy.use_count() == 2);
+      ptr.reset();
+      copy.reset();
+      THEN("the contents are destroyed exactly once") {
+        REQUIRE(live == 0);
+      }
+    }
+
+    WHEN("construction of the contents fails") {
+      THEN("the exception propagates, and nothing is left behind") {
+        REQUIRE_THROWS_AS(dart::make_skinny<tracked>(live, true), std::runtime_error);
+        REQUIRE(live == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("buffer allocations can share storage with their reference count", "[pointer unit]") {
+  GIVEN("buffer reference counters of every flavor") {
+    auto check = [] (auto tag) {
+      using refcount_type = typename decltype(tag)::type;
+      gsl::byte* bytes = nullptr;
+      auto ref = dart::allocate_shareable<refcount_type>(100, 16, &bytes);
+
+      REQUIRE(bytes != nullptr);
+      REQUIRE(ref.get() == bytes);
+      REQUIRE(ref.use_count() == 1);
+      REQUIRE(reinterpret_cast<uintptr_t>(bytes) % 16 == 0);
+
+      // The whole block must be writable, and stay valid while shared.
+      std::fill_n(bytes, 100, static_cast<gsl::byte>(0x2A));
+      auto copy = ref;
+      ref = nullptr;
+      REQUIRE(copy.use_count() == 1);
+      REQUIRE(copy.get()[99] == static_cast<gsl::byte>(0x2A));
+
+      // Alignments wider than the control block must still be honored.
+      gsl::byte* wide = nullptr;
+      auto over = dart::allocate_shareable<refcount_type>(256, 64, &wide);
+      REQUIRE(over.get() == wide);
+      REQUIRE(reinterpret_cast<uintptr_t>(wide) % 64 == 0);
+      std::fill_n(wide, 256, static_cast<gsl::byte>(0x2A));
+    };
+
+    WHEN("allocating through each of them") {
+      THEN("the allocations are aligned, usable, and owned") {
+        check(dart::meta::identity<std::shared_ptr<gsl::byte const>> {});
+        check(dart::meta::identity<dart::unsafe_ptr<gsl::byte const>> {});
+        check(dart::meta::identity<dart::skinny_ptr<gsl::byte const>> {});
+        check(dart::meta::identity<dart::biased_ptr<gsl::byte const>> {});
+        check(dart::meta::identity<dart::obtuse_ptr<gsl::byte const>> {});
+      }
+    }
+  }
+}
+
+SCENARIO("split pointers count correctly across threads", "[pointer unit]") {
+  GIVEN("a published split buffer") {
+    dart::split_buffer obj {dart::split_heap::make_object("hello", "world")};
+    dart::publisher<dart::split_buffer> pub {obj};
+
+    WHEN("copies are made and released on many threads at once") {
+      std::vector<std::thread> workers;
+      for (auto i = 0; i < 8; ++i) {
+        workers.emplace_back([&pub, held = obj] {
+          std::vector<dart::split_buffer> copies;
+          for (auto j = 0; j < 1000; ++j) copies.push_back(held);
+          auto moved = std::move(copies);
+          std::thread([moved = std::move(moved)] { (void) moved; }).join();
+          for (auto j = 0; j < 1000; ++j) copies.push_back(pub.load());
+        });
+      }
+      for (auto& worker : workers) worker.join();
+      THEN("the count is exact once they've finished") {
+        REQUIRE(obj.refcount() == 3);
+      }
+
+      WHEN("the buffer is retracted") {
+        pub.store(dart::split_buffer {});
+        THEN("the count is still exact") {
+          REQUIRE(obj.refcount() == 1);
+          REQUIRE(obj["hello"] == "world");
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("split pointers can take ownership of existing allocations", "[pointer unit]") {
+  GIVEN("a split pointer adopting a raw pointer") {
+    dart::split_ptr<int> ptr {new int(42)};
+
+    WHEN("it's published, copied, and retracted") {
+      using publication = dart::detail::publication<dart::split_ptr<int>>;
+      static_assert(noexcept(publication::retract(ptr)), "retraction must be safe to call from destructors");
+
+      publication::publish(ptr);
+      auto copy = ptr;
+      publication::retract(ptr);
+      THEN("the count and the contents survive") {
+        REQUIRE(ptr.use_count() == 2);
+        REQUIRE(*copy == 42);
+      }
+    }
+  }
+}
+
+SCENARIO("publishers allow packets to be swapped out from under readers", "[pointer unit]") {
+  GIVEN("a publisher holding a packet") {
+    dart::publisher<dart::packet> pub {dart::packet::make_object("version", 0)};
+
+    WHEN("the current version is loaded") {
+      auto snapshot = pub.load();
+      THEN("it's a finalized copy") {
+        REQUIRE(snapshot.is_finalized());
+        REQUIRE(snapshot["version"] == 0);
+      }
+
+      WHEN("a new version is stored") {
+        auto prev = pub.exchange(dart::packet::make_object("version", 1));
+        THEN("readers see the new version, and old snapshots are still valid") {
+          REQUIRE(pub.load()["version"] == 1);
+          REQUIRE(prev["version"] == 0);
+          REQUIRE(snapshot["version"] == 0);
+        }
+      }
+    }
+
+    WHEN("readers load continuously while a writer swaps versions") {
+      std::atomic<bool> done {false}, ordered {true};
+      std::vector<std::thread> readers;
+      for (auto i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+          int64_t last = 0;
+          while (!done) {
+            auto curr = pub.load()["version"].integer();
+            if (curr < last) ordered = false;
+            last = curr;
+          }
+        });
+      }
+      for (auto i = 1; i <= 200; ++i) pub.store(dart::packet::make_object("version", i));
+      done = true;
+      for (auto& reader : readers) reader.join();
+      THEN("readers never go back in time, and the last version wins") {
+        REQUIRE(ordered);
+        REQUIRE(pub.load()["version"] == 200);
+      }
+    }
+  }
+}
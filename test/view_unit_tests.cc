@@ -1,9 +1,12 @@
 /*----- System Includes -----*/
 
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <condition_variable>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -391,3 +394,129 @@ SCENARIO("object views can export all current values", "[view unit]") {
     });
   }
 }
+
+SCENARIO("atomic buffers hand out views that survive new versions", "[view unit]") {
+  GIVEN("an atomic buffer holding an object") {
+    dart::buffer initial {dart::heap::make_object("version", 0)};
+    dart::atomic_buffer slot {initial};
+    REQUIRE(slot.version() == 0ULL);
+    static_assert(noexcept(slot.load_view()), "dart library is misconfigured");
+
+    WHEN("a view is loaded") {
+      auto first = slot.load_view();
+      THEN("it sees the current version, and loading again doesn't copy") {
+        auto refs = initial.refcount();
+        REQUIRE(first["version"] == 0);
+        REQUIRE(slot.load_view()["version"] == 0);
+        REQUIRE(initial.refcount() == refs);
+      }
+
+      WHEN("a new version is stored") {
+        auto snapshot = slot.load();
+        slot.store(dart::buffer {dart::heap::make_object("version", 1)});
+        THEN("old views and snapshots remain valid, and new views see the new version") {
+          REQUIRE(slot.version() == 1ULL);
+          REQUIRE(first["version"] == 0);
+          REQUIRE(snapshot["version"] == 0);
+          REQUIRE(slot.load()["version"] == 1);
+          REQUIRE(slot.load_view()["version"] == 1);
+        }
+      }
+
+      WHEN("new versions are stored while this thread moves on") {
+        auto refs = initial.refcount();
+        slot.store(dart::buffer {dart::heap::make_object("version", 1)});
+        auto held = initial.refcount();
+        auto second = slot.load_view();
+        auto still_held = initial.refcount();
+        slot.store(dart::buffer {dart::heap::make_object("version", 2)});
+        THEN("the viewed version is kept alive until the first store after this thread views another") {
+          REQUIRE(held == refs);
+          REQUIRE(still_held == refs);
+          REQUIRE(initial.refcount() == 1);
+          REQUIRE(second["version"] == 1);
+        }
+      }
+
+      WHEN("the calling thread trims its pin") {
+        dart::atomic_buffer::trim();
+        slot.store(dart::buffer {dart::heap::make_object("version", 1)});
+        THEN("the old version is released by the next store") {
+          REQUIRE(initial.refcount() == 1);
+        }
+      }
+
+      WHEN("the calling thread views another instance") {
+        dart::atomic_buffer other {dart::buffer {dart::heap::make_object("other", true)}};
+        REQUIRE(other.load_view()["other"]);
+        slot.store(dart::buffer {dart::heap::make_object("version", 1)});
+        THEN("its pin moves, and the old version is released by the next store") {
+          REQUIRE(initial.refcount() == 1);
+        }
+      }
+    }
+
+    WHEN("a version viewed by another thread is replaced") {
+      bool seen = false;
+      std::thread([&] { seen = slot.load_view()["version"] == 0; }).join();
+      slot.store(dart::buffer {dart::heap::make_object("version", 1)});
+      THEN("threads that have exited don't keep it alive") {
+        REQUIRE(seen);
+        REQUIRE(initial.refcount() == 1);
+      }
+    }
+
+    WHEN("an instance another thread is still viewing is destroyed") {
+      dart::buffer contents {dart::heap::make_object("other", true)};
+      auto other = std::make_unique<dart::atomic_buffer>(contents);
+      std::mutex lock;
+      std::condition_variable cond;
+      bool seen = false, viewed = false, destroyed = false;
+      std::thread reader([&] {
+        seen = other->load_view()["other"].boolean();
+        std::unique_lock<std::mutex> guard(lock);
+        viewed = true;
+        cond.notify_all();
+        cond.wait(guard, [&] { return destroyed; });
+      });
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        cond.wait(guard, [&] { return viewed; });
+      }
+      other.reset();
+      auto refs = contents.refcount();
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        destroyed = true;
+      }
+      cond.notify_all();
+      reader.join();
+      THEN("its versions are released right away") {
+        REQUIRE(seen);
+        REQUIRE(refs == 1);
+      }
+    }
+
+    WHEN("readers view it continuously while a writer stores new versions") {
+      std::atomic<bool> done {false}, ordered {true};
+      std::vector<std::thread> readers;
+      for (auto i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+          int64_t last = 0;
+          while (!done) {
+            auto curr = slot.load_view()["version"].integer();
+            if (curr < last) ordered = false;
+            last = curr;
+          }
+        });
+      }
+      for (auto i = 1; i <= 200; ++i) slot.store(dart::buffer {dart::heap::make_object("version", i)});
+      done = true;
+      for (auto& reader : readers) reader.join();
+      THEN("readers never go back in time, and the last version wins") {
+        REQUIRE(ordered);
+        REQUIRE(slot.load_view()["version"] == 200);
+      }
+    }
+  }
+}